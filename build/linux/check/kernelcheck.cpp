@@ -0,0 +1,681 @@
+/* ====================================================================================================================
+
+  The copyright in this software is being made available under the License included below.
+  This software may be subject to other third party and   contributor rights, including patent rights, and no such
+  rights are granted under this license.
+
+  Copyright (c) 2010, SAMSUNG ELECTRONICS CO., LTD. and BRITISH BROADCASTING CORPORATION
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, are permitted only for
+  the purpose of developing standards within the Joint Collaborative Team on Video Coding and for testing and
+  promoting such standards. The following conditions are required to be met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+      the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+      the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of SAMSUNG ELECTRONICS CO., LTD. nor the name of the BRITISH BROADCASTING CORPORATION
+      may be used to endorse or promote products derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ * ====================================================================================================================
+*/
+
+/** \file     kernelcheck.cpp
+    \brief    bit-exactness check of the ENABLE_SSE2 sample kernels against the scalar loops they replace
+
+    Every kernel of the release libraries is run on random blocks next to a plain copy of the scalar code it replaced,
+    and the whole destination buffer, including the samples around the block, has to be identical. The blocks cover
+    every width from 1 to 64 at unaligned positions, and the inputs include values that overflow 16 bits.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "TLibCommon/CommonDef.h"
+#include "TLibCommon/TComRom.h"
+#include "TLibCommon/TComYuv.h"
+#include "TLibCommon/TComPrediction.h"
+#include "TLibEncoder/TEncGOP.h"
+
+// ====================================================================================================================
+// Test data
+// ====================================================================================================================
+
+#define CHECK_STRIDE      88                          ///< stride of the test blocks, wider than 64 plus the offset
+#define CHECK_ROWS        70                          ///< rows of the test blocks, higher than 64 plus the offset
+#define CHECK_SIZE        ( CHECK_STRIDE * CHECK_ROWS )
+
+/// sample ranges of the random inputs
+enum CheckRange
+{
+  CHECK_SAMPLE = 0,                                   ///< 0 to g_uiIBDI_MAX
+  CHECK_RESIDUAL,                                     ///< -g_uiIBDI_MAX to g_uiIBDI_MAX
+  CHECK_FULL,                                         ///< whole 16-bit range, sums and differences overflow
+  CHECK_NUM_RANGES
+};
+
+static const Char* s_apchRangeName[CHECK_NUM_RANGES] = { "sample", "residual", "16-bit" };
+
+/// deterministic noise, the same sequence on every platform
+static UInt s_uiSeed = 1;
+static Int xNoise( Int iMin, Int iMax )
+{
+  s_uiSeed = s_uiSeed * 1103515245u + 12345u;
+  UInt uiBits = ( s_uiSeed >> 8 ) & 0xffff;
+  s_uiSeed = s_uiSeed * 1103515245u + 12345u;
+  uiBits = ( uiBits << 16 ) | ( ( s_uiSeed >> 8 ) & 0xffff );
+  return iMin + (Int)( uiBits % (UInt)( iMax - iMin + 1 ) );
+}
+
+static Void xFill( Pel* p, Int iNum, Int iRange )
+{
+  Int iMax = (Int)g_uiIBDI_MAX;
+  for ( Int i = 0; i < iNum; i++ )
+  {
+    switch ( iRange )
+    {
+      case CHECK_SAMPLE:   p[i] = (Pel)xNoise( 0, iMax );        break;
+      case CHECK_RESIDUAL: p[i] = (Pel)xNoise( -iMax, iMax );    break;
+      default:             p[i] = (Pel)xNoise( -32768, 32767 );  break;
+    }
+  }
+}
+
+static Int s_iNumFailed = 0;
+
+/// compare two buffers and report the first difference
+static Bool xCompare( const Char* pchName, Pel* pTest, Pel* pRef, Int iNum, Int iWidth, Int iHeight, Int iRange )
+{
+  for ( Int i = 0; i < iNum; i++ )
+  {
+    if ( pTest[i] != pRef[i] )
+    {
+      printf( "MISMATCH %s: %dx%d, %s inputs, bit-depth max %d, sample %d: %d instead of %d\n",
+              pchName, iWidth, iHeight, s_apchRangeName[iRange], g_uiIBDI_MAX, i, pTest[i], pRef[i] );
+      s_iNumFailed++;
+      return false;
+    }
+  }
+  return true;
+}
+
+static Void xReport( const Char* pchName, Int iNumBlocks, Bool bOk )
+{
+  printf( "%-40s %7d blocks  %s\n", pchName, iNumBlocks, bOk ? "ok" : "FAILED" );
+}
+
+// ====================================================================================================================
+// Scalar reference loops (TComYuv before the ENABLE_SSE2 kernels)
+// ====================================================================================================================
+
+static Pel xRefClip( Pel x )
+{
+  return ( (x < 0) ? 0 : (x > (Pel)g_uiIBDI_MAX) ? (Pel)g_uiIBDI_MAX : x );
+}
+
+static Void xRefSubtract( Pel* pDst, Int iDstStride, Pel* pSrc0, Int iSrc0Stride, Pel* pSrc1, Int iSrc1Stride, Int iWidth, Int iHeight )
+{
+  for ( Int y = 0; y < iHeight; y++ )
+  {
+    for ( Int x = 0; x < iWidth; x++ )
+    {
+      pDst[x] = pSrc0[x] - pSrc1[x];
+    }
+    pSrc0 += iSrc0Stride;
+    pSrc1 += iSrc1Stride;
+    pDst  += iDstStride;
+  }
+}
+
+static Void xRefAddClip( Pel* pDst, Int iDstStride, Pel* pSrc0, Int iSrc0Stride, Pel* pSrc1, Int iSrc1Stride, Int iWidth, Int iHeight )
+{
+  for ( Int y = 0; y < iHeight; y++ )
+  {
+    for ( Int x = 0; x < iWidth; x++ )
+    {
+      pDst[x] = xRefClip( pSrc0[x] + pSrc1[x] );
+    }
+    pSrc0 += iSrc0Stride;
+    pSrc1 += iSrc1Stride;
+    pDst  += iDstStride;
+  }
+}
+
+static Void xRefAddAvg( Pel* pDst, Int iDstStride, Pel* pSrc0, Int iSrc0Stride, Pel* pSrc1, Int iSrc1Stride, Int iWidth, Int iHeight, Int iRound )
+{
+  for ( Int y = 0; y < iHeight; y++ )
+  {
+    for ( Int x = 0; x < iWidth; x++ )
+    {
+      pDst[x] = (pSrc0[x] + pSrc1[x] + iRound) >> 1;
+    }
+    pSrc0 += iSrc0Stride;
+    pSrc1 += iSrc1Stride;
+    pDst  += iDstStride;
+  }
+}
+
+static Void xRefRemoveHighFreq( Pel* pDst, Int iDstStride, Pel* pSrc, Int iSrcStride, Int iWidth, Int iHeight )
+{
+  for ( Int y = 0; y < iHeight; y++ )
+  {
+    for ( Int x = 0; x < iWidth; x++ )
+    {
+      pDst[x] = xRefClip( (pDst[x]<<1) - pSrc[x] );
+    }
+    pSrc += iSrcStride;
+    pDst += iDstStride;
+  }
+}
+
+// ====================================================================================================================
+// TComYuv block kernels
+// ====================================================================================================================
+
+static const Int s_aiHeights[] = { 1, 2, 3, 4, 8, 16, 64 };
+#define NUM_HEIGHTS ( sizeof(s_aiHeights) / sizeof(s_aiHeights[0]) )
+
+/// TComYuv kernel under test, iMode selects subtract, addClip, addAvg without and with rounding, removeHighFreq
+static Void xCheckYuvKernel( const Char* pchName, Int iMode )
+{
+  Pel* pSrc0    = new Pel[CHECK_SIZE];
+  Pel* pSrc1    = new Pel[CHECK_SIZE];
+  Pel* pDstTest = new Pel[CHECK_SIZE];
+  Pel* pDstRef  = new Pel[CHECK_SIZE];
+  Int  iBlocks  = 0;
+  Bool bOk      = true;
+
+  for ( Int iRange = 0; iRange < CHECK_NUM_RANGES && bOk; iRange++ )
+  {
+    for ( Int iWidth = 1; iWidth <= 64 && bOk; iWidth++ )
+    {
+      for ( UInt h = 0; h < NUM_HEIGHTS && bOk; h++ )
+      {
+        Int iHeight = s_aiHeights[h];
+        Int iOffset = xNoise( 0, 7 ) + xNoise( 0, 5 ) * CHECK_STRIDE;
+
+        xFill( pSrc0,    CHECK_SIZE, iRange );
+        xFill( pSrc1,    CHECK_SIZE, iRange );
+        xFill( pDstTest, CHECK_SIZE, iRange );
+        ::memcpy( pDstRef, pDstTest, sizeof(Pel) * CHECK_SIZE );
+
+        Pel* p0 = pSrc0 + iOffset;
+        Pel* p1 = pSrc1 + iOffset + 1;
+        switch ( iMode )
+        {
+          case 0:
+            TComYuv::xSubtractBlk( pDstTest + iOffset, CHECK_STRIDE, p0, CHECK_STRIDE, p1, CHECK_STRIDE, iWidth, iHeight );
+            xRefSubtract         ( pDstRef  + iOffset, CHECK_STRIDE, p0, CHECK_STRIDE, p1, CHECK_STRIDE, iWidth, iHeight );
+            break;
+          case 1:
+            TComYuv::xAddClipBlk ( pDstTest + iOffset, CHECK_STRIDE, p0, CHECK_STRIDE, p1, CHECK_STRIDE, iWidth, iHeight );
+            xRefAddClip          ( pDstRef  + iOffset, CHECK_STRIDE, p0, CHECK_STRIDE, p1, CHECK_STRIDE, iWidth, iHeight );
+            break;
+          case 2:
+          case 3:
+            TComYuv::xAddAvgBlk  ( pDstTest + iOffset, CHECK_STRIDE, p0, CHECK_STRIDE, p1, CHECK_STRIDE, iWidth, iHeight, iMode - 2 );
+            xRefAddAvg           ( pDstRef  + iOffset, CHECK_STRIDE, p0, CHECK_STRIDE, p1, CHECK_STRIDE, iWidth, iHeight, iMode - 2 );
+            break;
+          default:
+            TComYuv::xRemoveHighFreqBlk( pDstTest + iOffset, CHECK_STRIDE, p0, CHECK_STRIDE, iWidth, iHeight );
+            xRefRemoveHighFreq         ( pDstRef  + iOffset, CHECK_STRIDE, p0, CHECK_STRIDE, iWidth, iHeight );
+            break;
+        }
+        bOk = xCompare( pchName, pDstTest, pDstRef, CHECK_SIZE, iWidth, iHeight, iRange );
+        iBlocks++;
+      }
+    }
+  }
+  xReport( pchName, iBlocks, bOk );
+
+  delete [] pSrc0;
+  delete [] pSrc1;
+  delete [] pDstTest;
+  delete [] pDstRef;
+}
+
+// ====================================================================================================================
+// TComYuv entry points, luma and chroma of whole 64x64 buffers
+// ====================================================================================================================
+
+static Void xFillYuv( TComYuv* pcYuv, Int iRange )
+{
+  xFill( pcYuv->getLumaAddr(), pcYuv->getStride()  * pcYuv->getHeight(),  iRange );
+  xFill( pcYuv->getCbAddr(),   pcYuv->getCStride() * pcYuv->getCHeight(), iRange );
+  xFill( pcYuv->getCrAddr(),   pcYuv->getCStride() * pcYuv->getCHeight(), iRange );
+}
+
+static Bool xCompareYuv( const Char* pchName, TComYuv* pcTest, TComYuv* pcRef, Int iWidth, Int iHeight, Int iRange )
+{
+  return xCompare( pchName, pcTest->getLumaAddr(), pcRef->getLumaAddr(), pcRef->getStride()  * pcRef->getHeight(),  iWidth,    iHeight,    iRange )
+      && xCompare( pchName, pcTest->getCbAddr(),   pcRef->getCbAddr(),   pcRef->getCStride() * pcRef->getCHeight(), iWidth>>1, iHeight>>1, iRange )
+      && xCompare( pchName, pcTest->getCrAddr(),   pcRef->getCrAddr(),   pcRef->getCStride() * pcRef->getCHeight(), iWidth>>1, iHeight>>1, iRange );
+}
+
+/// subtract and addClip per transform unit, luma with the transform size and chroma with half of it
+static Void xCheckYuvTransformUnits( TComYuv* pcSrc0, TComYuv* pcSrc1, TComYuv* pcTest, TComYuv* pcRef )
+{
+  Int  iBlocks = 0;
+  Bool bOk     = true;
+
+  for ( Int iAdd = 0; iAdd < 2; iAdd++ )
+  {
+    const Char* pchName = iAdd ? "TComYuv::addClip" : "TComYuv::subtract";
+    for ( Int iRange = 0; iRange < CHECK_NUM_RANGES && bOk; iRange++ )
+    {
+      for ( UInt uiSize = 4; uiSize <= 64 && bOk; uiSize <<= 1 )
+      {
+        UInt uiNumUnits = ( 64 / uiSize ) * ( 64 / uiSize );
+        for ( UInt uiUnit = 0; uiUnit < uiNumUnits && bOk; uiUnit++ )
+        {
+          xFillYuv( pcSrc0, iRange );
+          xFillYuv( pcSrc1, iRange );
+          xFillYuv( pcTest, iRange );
+          pcTest->copyToYuv( pcRef );
+
+          UInt uiCSize = uiSize >> 1;
+          if ( iAdd )
+          {
+            pcTest->addClip( pcSrc0, pcSrc1, uiUnit, uiSize );
+            xRefAddClip( pcRef->getLumaAddr( uiUnit, uiSize ), pcRef->getStride(), pcSrc0->getLumaAddr( uiUnit, uiSize ), pcSrc0->getStride(), pcSrc1->getLumaAddr( uiUnit, uiSize ), pcSrc1->getStride(), uiSize, uiSize );
+            xRefAddClip( pcRef->getCbAddr( uiUnit, uiCSize ), pcRef->getCStride(), pcSrc0->getCbAddr( uiUnit, uiCSize ), pcSrc0->getCStride(), pcSrc1->getCbAddr( uiUnit, uiCSize ), pcSrc1->getCStride(), uiCSize, uiCSize );
+            xRefAddClip( pcRef->getCrAddr( uiUnit, uiCSize ), pcRef->getCStride(), pcSrc0->getCrAddr( uiUnit, uiCSize ), pcSrc0->getCStride(), pcSrc1->getCrAddr( uiUnit, uiCSize ), pcSrc1->getCStride(), uiCSize, uiCSize );
+          }
+          else
+          {
+            pcTest->subtract( pcSrc0, pcSrc1, uiUnit, uiSize );
+            xRefSubtract( pcRef->getLumaAddr( uiUnit, uiSize ), pcRef->getStride(), pcSrc0->getLumaAddr( uiUnit, uiSize ), pcSrc0->getStride(), pcSrc1->getLumaAddr( uiUnit, uiSize ), pcSrc1->getStride(), uiSize, uiSize );
+            xRefSubtract( pcRef->getCbAddr( uiUnit, uiCSize ), pcRef->getCStride(), pcSrc0->getCbAddr( uiUnit, uiCSize ), pcSrc0->getCStride(), pcSrc1->getCbAddr( uiUnit, uiCSize ), pcSrc1->getCStride(), uiCSize, uiCSize );
+            xRefSubtract( pcRef->getCrAddr( uiUnit, uiCSize ), pcRef->getCStride(), pcSrc0->getCrAddr( uiUnit, uiCSize ), pcSrc0->getCStride(), pcSrc1->getCrAddr( uiUnit, uiCSize ), pcSrc1->getCStride(), uiCSize, uiCSize );
+          }
+          bOk = xCompareYuv( pchName, pcTest, pcRef, uiSize, uiSize, iRange );
+          iBlocks++;
+        }
+      }
+    }
+    xReport( pchName, iBlocks, bOk );
+    iBlocks = 0;
+    bOk     = true;
+  }
+}
+
+/// prediction unit shapes of a 64x64 CU down to 4x4, including the rectangular partitions
+static const Int s_aiPUSizes[][2] = { {64,64}, {64,32}, {32,64}, {32,32}, {32,16}, {16,32}, {16,16}, {16,8}, {8,16}, {8,8}, {8,4}, {4,8}, {4,4} };
+#define NUM_PU_SIZES ( sizeof(s_aiPUSizes) / sizeof(s_aiPUSizes[0]) )
+
+/// addAvg with both rounding modes and removeHighFreq of whole buffers and of partitions, per prediction unit
+static Void xCheckYuvPredictionUnits( TComYuv* pcSrc0, TComYuv* pcSrc1, TComYuv* pcTest, TComYuv* pcRef )
+{
+  const Char* apchName[4] = { "TComYuv::addAvg (bRound=0)", "TComYuv::addAvg (bRound=1)", "TComYuv::removeHighFreq (part)", "TComYuv::removeHighFreq (whole)" };
+
+  for ( Int iMode = 0; iMode < 4; iMode++ )
+  {
+    Int  iBlocks = 0;
+    Bool bOk     = true;
+    for ( Int iRange = 0; iRange < CHECK_NUM_RANGES && bOk; iRange++ )
+    {
+      for ( UInt s = 0; s < NUM_PU_SIZES && bOk; s++ )
+      {
+        Int iWidth  = s_aiPUSizes[s][0];
+        Int iHeight = s_aiPUSizes[s][1];
+        for ( UInt uiPartIdx = 0; uiPartIdx < 256 && bOk; uiPartIdx++ )
+        {
+          Int iPelX = g_auiRasterToPelX[ g_auiZscanToRaster[uiPartIdx] ];
+          Int iPelY = g_auiRasterToPelY[ g_auiZscanToRaster[uiPartIdx] ];
+          if ( iPelX % iWidth || iPelY % iHeight || ( iMode == 3 && uiPartIdx ) )
+          {
+            continue;
+          }
+
+          xFillYuv( pcSrc0, iRange );
+          xFillYuv( pcSrc1, iRange );
+          xFillYuv( pcTest, iRange );
+          pcTest->copyToYuv( pcRef );
+
+          Pel* apRef [3] = { pcRef ->getLumaAddr( uiPartIdx ), pcRef ->getCbAddr( uiPartIdx ), pcRef ->getCrAddr( uiPartIdx ) };
+          Pel* apSrc0[3] = { pcSrc0->getLumaAddr( uiPartIdx ), pcSrc0->getCbAddr( uiPartIdx ), pcSrc0->getCrAddr( uiPartIdx ) };
+          Pel* apSrc1[3] = { pcSrc1->getLumaAddr( uiPartIdx ), pcSrc1->getCbAddr( uiPartIdx ), pcSrc1->getCrAddr( uiPartIdx ) };
+          switch ( iMode )
+          {
+            case 0:
+#ifdef ROUNDING_CONTROL_BIPRED
+              pcTest->addAvg( pcSrc0, pcSrc1, uiPartIdx, iWidth, iHeight, false );
+              break;
+#endif
+            case 1:
+              pcTest->addAvg( pcSrc0, pcSrc1, uiPartIdx, iWidth, iHeight );
+              break;
+            case 2:
+              pcTest->removeHighFreq( pcSrc0, uiPartIdx, iWidth, iHeight );
+              break;
+            default:
+              pcTest->removeHighFreq( pcSrc0, iWidth, iHeight );
+              break;
+          }
+          for ( Int c = 0; c < 3; c++ )
+          {
+            Int iStride = c ? pcRef->getCStride() : pcRef->getStride();
+            Int iW      = c ? iWidth  >> 1 : iWidth;
+            Int iH      = c ? iHeight >> 1 : iHeight;
+            if ( iMode < 2 )
+            {
+#ifdef ROUNDING_CONTROL_BIPRED
+              xRefAddAvg( apRef[c], iStride, apSrc0[c], iStride, apSrc1[c], iStride, iW, iH, iMode );
+#else
+              xRefAddAvg( apRef[c], iStride, apSrc0[c], iStride, apSrc1[c], iStride, iW, iH, 1 );
+#endif
+            }
+            else
+            {
+              xRefRemoveHighFreq( apRef[c], iStride, apSrc0[c], iStride, iW, iH );
+            }
+          }
+          bOk = xCompareYuv( apchName[iMode], pcTest, pcRef, iWidth, iHeight, iRange );
+          iBlocks++;
+        }
+      }
+    }
+    xReport( apchName[iMode], iBlocks, bOk );
+  }
+}
+
+static Void xCheckYuv()
+{
+  xCheckYuvKernel( "TComYuv::xSubtractBlk",            0 );
+  xCheckYuvKernel( "TComYuv::xAddClipBlk",             1 );
+  xCheckYuvKernel( "TComYuv::xAddAvgBlk (iRound=0)",   2 );
+  xCheckYuvKernel( "TComYuv::xAddAvgBlk (iRound=1)",   3 );
+  xCheckYuvKernel( "TComYuv::xRemoveHighFreqBlk",      4 );
+
+  TComYuv cSrc0, cSrc1, cTest, cRef;
+  cSrc0.create( 64, 64 );
+  cSrc1.create( 64, 64 );
+  cTest.create( 64, 64 );
+  cRef .create( 64, 64 );
+
+  xCheckYuvTransformUnits ( &cSrc0, &cSrc1, &cTest, &cRef );
+  xCheckYuvPredictionUnits( &cSrc0, &cSrc1, &cTest, &cRef );
+
+  cSrc0.destroy();
+  cSrc1.destroy();
+  cTest.destroy();
+  cRef .destroy();
+}
+
+// ====================================================================================================================
+// TComPrediction intra kernels
+// ====================================================================================================================
+
+/// access to the protected intra kernels
+class TComPredictionCheck : public TComPrediction
+{
+public:
+  using TComPrediction::xFillBlk;
+  using TComPrediction::xPredIntraAngRow;
+  using TComPrediction::xPredIntraLinRow;
+  using TComPrediction::xTransposeBlk;
+};
+
+static Void xCheckIntra()
+{
+  Pel* pSrc     = new Pel[CHECK_SIZE];
+  Pel* pDstTest = new Pel[CHECK_SIZE];
+  Pel* pDstRef  = new Pel[CHECK_SIZE];
+  Int  aiAdd[64];
+  Int  iBlocks;
+  Bool bOk;
+
+  // DC fill, all widths and heights of the ADI and angular DC predictors
+  iBlocks = 0;
+  bOk     = true;
+  for ( Int iWidth = 1; iWidth <= 64 && bOk; iWidth++ )
+  {
+    for ( UInt h = 0; h < NUM_HEIGHTS && bOk; h++ )
+    {
+      Int iHeight = s_aiHeights[h];
+      Int iOffset = xNoise( 0, 7 ) + xNoise( 0, 5 ) * CHECK_STRIDE;
+      Pel iVal    = (Pel)xNoise( 0, g_uiIBDI_MAX );
+
+      xFill( pDstTest, CHECK_SIZE, CHECK_FULL );
+      ::memcpy( pDstRef, pDstTest, sizeof(Pel) * CHECK_SIZE );
+
+      TComPredictionCheck::xFillBlk( pDstTest + iOffset, CHECK_STRIDE, iWidth, iHeight, iVal );
+      for ( Int y = 0; y < iHeight; y++ )
+      {
+        for ( Int x = 0; x < iWidth; x++ )
+        {
+          pDstRef[iOffset + y*CHECK_STRIDE + x] = iVal;
+        }
+      }
+      bOk = xCompare( "TComPrediction::xFillBlk", pDstTest, pDstRef, CHECK_SIZE, iWidth, iHeight, CHECK_SAMPLE );
+      iBlocks++;
+    }
+  }
+  xReport( "TComPrediction::xFillBlk", iBlocks, bOk );
+
+  // angular rows, every fraction from 0 to 31 over reference samples
+  iBlocks = 0;
+  bOk     = true;
+  for ( Int iWidth = 1; iWidth <= 64 && bOk; iWidth++ )
+  {
+    for ( Int iFract = 0; iFract < 32 && bOk; iFract++ )
+    {
+      Int iOffset = xNoise( 0, 7 );
+
+      xFill( pSrc,     CHECK_SIZE, CHECK_SAMPLE );
+      xFill( pDstTest, CHECK_SIZE, CHECK_FULL );
+      ::memcpy( pDstRef, pDstTest, sizeof(Pel) * CHECK_SIZE );
+
+      TComPredictionCheck::xPredIntraAngRow( pDstTest + iOffset, pSrc + iOffset, iFract, iWidth );
+      for ( Int x = 0; x < iWidth; x++ )
+      {
+        pDstRef[iOffset + x] = (Pel) ( ( (32-iFract)*pSrc[iOffset+x] + iFract*pSrc[iOffset+x+1] + 16 ) >> 5 );
+      }
+      bOk = xCompare( "TComPrediction::xPredIntraAngRow", pDstTest, pDstRef, CHECK_SIZE, iWidth, 1, CHECK_SAMPLE );
+      iBlocks++;
+    }
+  }
+  xReport( "TComPrediction::xPredIntraAngRow", iBlocks, bOk );
+
+  // clipped linear ramps of the planar and ADI plane predictors, with and without the per-sample term;
+  // bases, steps and terms go beyond the sample range so that both ends of the clip are reached
+  iBlocks = 0;
+  bOk     = true;
+  for ( Int iWidth = 1; iWidth <= 64 && bOk; iWidth++ )
+  {
+    for ( Int iShift = 1; iShift <= 12 && bOk; iShift++ )
+    {
+      for ( Int iUseAdd = 0; iUseAdd < 2 && bOk; iUseAdd++ )
+      {
+        Int iRange  = ( g_uiIBDI_MAX + 1 ) << iShift;
+        Int iBase   = xNoise( -iRange, 2*iRange );
+        Int iStep   = xNoise( -iRange, iRange ) / 32;
+        Int iOffset = xNoise( 0, 7 );
+        for ( Int x = 0; x < iWidth; x++ )
+        {
+          aiAdd[x] = xNoise( -iRange, iRange );
+        }
+        Int* piAdd = iUseAdd ? aiAdd : NULL;
+
+        xFill( pDstTest, CHECK_SIZE, CHECK_FULL );
+        ::memcpy( pDstRef, pDstTest, sizeof(Pel) * CHECK_SIZE );
+
+        TComPredictionCheck::xPredIntraLinRow( pDstTest + iOffset, piAdd, iBase, iStep, iShift, iWidth );
+        for ( Int x = 0; x < iWidth; x++ )
+        {
+          Int iVal = iBase + x*iStep + ( piAdd ? piAdd[x] : 0 );
+          pDstRef[iOffset + x] = Clip( iVal >> iShift );
+        }
+        bOk = xCompare( "TComPrediction::xPredIntraLinRow", pDstTest, pDstRef, CHECK_SIZE, iWidth, 1, CHECK_SAMPLE );
+        iBlocks++;
+      }
+    }
+  }
+  xReport( "TComPrediction::xPredIntraLinRow", iBlocks, bOk );
+
+  // transposition of the horizontal angular predictions, square blocks of every size
+  iBlocks = 0;
+  bOk     = true;
+  for ( Int iSize = 1; iSize <= 64 && bOk; iSize++ )
+  {
+    Int iOffset = xNoise( 0, 7 ) + xNoise( 0, 5 ) * CHECK_STRIDE;
+
+    xFill( pSrc,     CHECK_SIZE, CHECK_FULL );
+    xFill( pDstTest, CHECK_SIZE, CHECK_FULL );
+    ::memcpy( pDstRef, pDstTest, sizeof(Pel) * CHECK_SIZE );
+
+    TComPredictionCheck::xTransposeBlk( pDstTest + iOffset, CHECK_STRIDE, pSrc + 1, iSize, iSize );
+    for ( Int y = 0; y < iSize; y++ )
+    {
+      for ( Int x = 0; x < iSize; x++ )
+      {
+        pDstRef[iOffset + x*CHECK_STRIDE + y] = pSrc[1 + y*iSize + x];
+      }
+    }
+    bOk = xCompare( "TComPrediction::xTransposeBlk", pDstTest, pDstRef, CHECK_SIZE, iSize, iSize, CHECK_FULL );
+    iBlocks++;
+  }
+  xReport( "TComPrediction::xTransposeBlk", iBlocks, bOk );
+
+  delete [] pSrc;
+  delete [] pDstTest;
+  delete [] pDstRef;
+}
+
+// ====================================================================================================================
+// TEncGOP distortion kernel
+// ====================================================================================================================
+
+/// access to the protected SSE kernel of the PSNR and frame distortion
+class TEncGOPCheck : public TEncGOP
+{
+public:
+  using TEncGOP::xGetSSE;
+};
+
+static UInt64 xRefSSE( Pel* pSrc0, Int iStride0, Pel* pSrc1, Int iStride1, Int iWidth, Int iHeight, UInt uiShift )
+{
+  UInt64 uiSSE = 0;
+  for ( Int y = 0; y < iHeight; y++ )
+  {
+    for ( Int x = 0; x < iWidth; x++ )
+    {
+      Int iTemp = pSrc0[x] - pSrc1[x];
+      uiSSE += (iTemp*iTemp) >> uiShift;
+    }
+    pSrc0 += iStride0;
+    pSrc1 += iStride1;
+  }
+  return uiSSE;
+}
+
+static Bool xCompareSSE( UInt64 uiTest, UInt64 uiRef, Int iWidth, Int iHeight, UInt uiShift )
+{
+  if ( uiTest != uiRef )
+  {
+    printf( "MISMATCH TEncGOP::xGetSSE: %dx%d, shift %d, bit-depth max %d: %llu instead of %llu\n",
+            iWidth, iHeight, uiShift, g_uiIBDI_MAX, (unsigned long long)uiTest, (unsigned long long)uiRef );
+    s_iNumFailed++;
+    return false;
+  }
+  return true;
+}
+
+static Void xCheckSSE()
+{
+  Pel* pSrc0   = new Pel[CHECK_SIZE];
+  Pel* pSrc1   = new Pel[CHECK_SIZE];
+  Int  iBlocks = 0;
+  Bool bOk     = true;
+
+  // every width at the shifts of the PSNR (none) and of the frame distortion (twice the bit increment)
+  for ( Int iWidth = 1; iWidth <= 64 && bOk; iWidth++ )
+  {
+    for ( UInt h = 0; h < NUM_HEIGHTS && bOk; h++ )
+    {
+      for ( UInt uiShift = 0; uiShift <= 8 && bOk; uiShift += 2 )
+      {
+        Int iHeight = s_aiHeights[h];
+        Int iOffset = xNoise( 0, 7 ) + xNoise( 0, 5 ) * CHECK_STRIDE;
+
+        xFill( pSrc0, CHECK_SIZE, CHECK_SAMPLE );
+        xFill( pSrc1, CHECK_SIZE, CHECK_SAMPLE );
+
+        UInt64 uiTest = TEncGOPCheck::xGetSSE( pSrc0 + iOffset, CHECK_STRIDE, pSrc1 + iOffset + 1, CHECK_STRIDE, iWidth, iHeight, uiShift );
+        UInt64 uiRef  = xRefSSE              ( pSrc0 + iOffset, CHECK_STRIDE, pSrc1 + iOffset + 1, CHECK_STRIDE, iWidth, iHeight, uiShift );
+        bOk = xCompareSSE( uiTest, uiRef, iWidth, iHeight, uiShift );
+        iBlocks++;
+      }
+    }
+  }
+
+  // 1920x1080 picture with the largest difference in every sample, the sum does not fit in 32 bits
+  if ( bOk )
+  {
+    Int  iWidth  = 1920;
+    Int  iHeight = 1080;
+    Pel* pPic0   = new Pel[iWidth * iHeight];
+    Pel* pPic1   = new Pel[iWidth * iHeight];
+    for ( Int i = 0; i < iWidth * iHeight; i++ )
+    {
+      pPic0[i] = ( i & 1 ) ? (Pel)g_uiIBDI_MAX : 0;
+      pPic1[i] = ( i & 1 ) ? 0 : (Pel)g_uiIBDI_MAX;
+    }
+    UInt64 uiTest = TEncGOPCheck::xGetSSE( pPic0, iWidth, pPic1, iWidth, iWidth, iHeight, 0 );
+    bOk = xCompareSSE( uiTest, xRefSSE( pPic0, iWidth, pPic1, iWidth, iWidth, iHeight, 0 ), iWidth, iHeight, 0 );
+    iBlocks++;
+    delete [] pPic0;
+    delete [] pPic1;
+  }
+  xReport( "TEncGOP::xGetSSE", iBlocks, bOk );
+
+  delete [] pSrc0;
+  delete [] pSrc1;
+}
+
+// ====================================================================================================================
+// Main function
+// ====================================================================================================================
+
+int main( int argc, char* argv[] )
+{
+  printf( "SSE2 kernels: %s\n", ENABLE_SSE2 ? "enabled" : "disabled, the scalar code is compared with itself" );
+
+  // partition order of a 64x64 CU with 4x4 partitions, as set up by TEncCu and TDecCu
+  initROM();
+  g_uiMaxCUWidth  = 64;
+  g_uiMaxCUHeight = 64;
+  g_uiMaxCUDepth  = 4;
+  UInt* piTmp = &g_auiZscanToRaster[0];
+  initZscanToRaster( g_uiMaxCUDepth, 1, 0, piTmp );
+  initRasterToZscan( g_uiMaxCUWidth, g_uiMaxCUHeight, g_uiMaxCUDepth );
+  initRasterToPelXY( g_uiMaxCUWidth, g_uiMaxCUHeight, g_uiMaxCUDepth );
+
+  // 8-bit, 10-bit and 12-bit internal sample ranges
+  static const UInt auiBitDepth[] = { 8, 10, 12 };
+  for ( Int i = 0; i < 3; i++ )
+  {
+    g_uiBitIncrement = auiBitDepth[i] - g_uiBitDepth;
+    g_uiIBDI_MAX     = ( 1 << auiBitDepth[i] ) - 1;
+    printf( "\n%d-bit samples\n", auiBitDepth[i] );
+
+    xCheckYuv();
+    xCheckIntra();
+    xCheckSSE();
+  }
+
+  destroyROM();
+
+  printf( "\n%s\n", s_iNumFailed ? "kernel check FAILED" : "all kernels are bit-exact" );
+  return s_iNumFailed ? 1 : 0;
+}
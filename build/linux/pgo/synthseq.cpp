@@ -0,0 +1,121 @@
+/* ====================================================================================================================
+
+  The copyright in this software is being made available under the License included below.
+  This software may be subject to other third party and   contributor rights, including patent rights, and no such
+  rights are granted under this license.
+
+  Copyright (c) 2010, SAMSUNG ELECTRONICS CO., LTD. and BRITISH BROADCASTING CORPORATION
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, are permitted only for
+  the purpose of developing standards within the Joint Collaborative Team on Video Coding and for testing and
+  promoting such standards. The following conditions are required to be met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+      the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+      the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of SAMSUNG ELECTRONICS CO., LTD. nor the name of the BRITISH BROADCASTING CORPORATION
+      may be used to endorse or promote products derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ * ====================================================================================================================
+*/
+
+/** \file     synthseq.cpp
+    \brief    synthetic 8-bit 4:2:0 sequence for the profile training run of the PGO build
+
+    The content exercises the usual coding decisions without shipping a test sequence: a smooth gradient panning
+    to the right, a textured block moving diagonally, a static checkerboard corner with sharp edges and a scene cut
+    in the second half of the sequence.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/// deterministic noise, the same sequence on every platform
+static unsigned int s_uiSeed = 1;
+static int xNoise( int iRange )
+{
+  s_uiSeed = s_uiSeed * 1103515245u + 12345u;
+  return (int)( ( s_uiSeed >> 16 ) % (unsigned int)( 2 * iRange + 1 ) ) - iRange;
+}
+
+static unsigned char xClip( int i )
+{
+  return (unsigned char)( i < 0 ? 0 : ( i > 255 ? 255 : i ) );
+}
+
+int main( int argc, char* argv[] )
+{
+  if ( argc != 5 )
+  {
+    fprintf( stderr, "usage: synthseq <output.yuv> <width> <height> <frames>\n" );
+    return 1;
+  }
+
+  int iWidth  = atoi( argv[2] );
+  int iHeight = atoi( argv[3] );
+  int iFrames = atoi( argv[4] );
+  FILE* fp    = fopen( argv[1], "wb" );
+  if ( fp == NULL || iWidth <= 0 || iHeight <= 0 || ( iWidth | iHeight ) & 1 )
+  {
+    fprintf( stderr, "synthseq: invalid output file or size\n" );
+    return 1;
+  }
+
+  unsigned char* pucY = new unsigned char[ iWidth * iHeight ];
+  unsigned char* pucC = new unsigned char[ iWidth * iHeight / 4 ];
+
+  for ( int f = 0; f < iFrames; f++ )
+  {
+    // the scene cut changes the gradient direction and the brightness
+    bool bCut  = f >= iFrames / 2 + 1;
+    int  iPanX = 2 * f;
+    int  iBlkX = ( 8 + 3 * f ) % ( iWidth  - 32 );
+    int  iBlkY = ( 8 + 2 * f ) % ( iHeight - 32 );
+
+    for ( int y = 0; y < iHeight; y++ )
+    {
+      for ( int x = 0; x < iWidth; x++ )
+      {
+        int iVal = bCut ? 200 - ( ( y * 3 + x ) >> 2 ) : 40 + ( ( ( x + iPanX ) * 2 + y ) >> 2 );
+        if ( x >= iBlkX && x < iBlkX + 32 && y >= iBlkY && y < iBlkY + 32 )
+        {
+          iVal = 128 + ( ( ( x - iBlkX ) ^ ( y - iBlkY ) ) & 8 ? 50 : -50 ) + xNoise( 6 );
+        }
+        else if ( x < 24 && y < 24 )
+        {
+          iVal = ( ( x >> 2 ) + ( y >> 2 ) ) & 1 ? 235 : 16;
+        }
+        pucY[ y * iWidth + x ] = xClip( iVal + xNoise( 2 ) );
+      }
+    }
+    fwrite( pucY, 1, iWidth * iHeight, fp );
+
+    for ( int c = 0; c < 2; c++ )
+    {
+      for ( int y = 0; y < iHeight / 2; y++ )
+      {
+        for ( int x = 0; x < iWidth / 2; x++ )
+        {
+          int iVal = 128 + ( c ? 1 : -1 ) * ( ( ( x + f ) >> 2 ) - ( y >> 3 ) ) + ( bCut ? 20 : 0 );
+          pucC[ y * ( iWidth / 2 ) + x ] = xClip( iVal );
+        }
+      }
+      fwrite( pucC, 1, iWidth * iHeight / 4, fp );
+    }
+  }
+
+  delete [] pucY;
+  delete [] pucC;
+  fclose( fp );
+  return 0;
+}
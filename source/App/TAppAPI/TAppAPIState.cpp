@@ -0,0 +1,104 @@
+/* ====================================================================================================================
+
+  The copyright in this software is being made available under the License included below.
+  This software may be subject to other third party and   contributor rights, including patent rights, and no such
+  rights are granted under this license.
+
+  Copyright (c) 2010, SAMSUNG ELECTRONICS CO., LTD. and BRITISH BROADCASTING CORPORATION
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, are permitted only for
+  the purpose of developing standards within the Joint Collaborative Team on Video Coding and for testing and
+  promoting such standards. The following conditions are required to be met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+      the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+      the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of SAMSUNG ELECTRONICS CO., LTD. nor the name of the BRITISH BROADCASTING CORPORATION
+      may be used to endorse or promote products derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ * ====================================================================================================================
+*/
+
+/** \file     TAppAPIState.cpp
+    \brief    Per-instance global state of the library interface
+*/
+
+#include <string.h>
+#include "TAppAPIState.h"
+
+#if API_LOCK_THREAD
+#include <pthread.h>
+
+static pthread_mutex_t s_cAPIMutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+// ====================================================================================================================
+// Constructor / destructor / initialization / destroy
+// ====================================================================================================================
+
+TAppAPIState::TAppAPIState()
+{
+  save();
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+Void TAppAPIState::save()
+{
+  m_uiMaxCUWidth   = g_uiMaxCUWidth;
+  m_uiMaxCUHeight  = g_uiMaxCUHeight;
+  m_uiMaxCUDepth   = g_uiMaxCUDepth;
+  m_uiAddCUDepth   = g_uiAddCUDepth;
+  m_uiBitDepth     = g_uiBitDepth;
+  m_uiBitIncrement = g_uiBitIncrement;
+  m_uiBASE_MAX     = g_uiBASE_MAX;
+  m_uiIBDI_MAX     = g_uiIBDI_MAX;
+
+  ::memcpy( m_auiZscanToRaster, g_auiZscanToRaster, sizeof( m_auiZscanToRaster ) );
+  ::memcpy( m_auiRasterToZscan, g_auiRasterToZscan, sizeof( m_auiRasterToZscan ) );
+  ::memcpy( m_auiRasterToPelX,  g_auiRasterToPelX,  sizeof( m_auiRasterToPelX  ) );
+  ::memcpy( m_auiRasterToPelY,  g_auiRasterToPelY,  sizeof( m_auiRasterToPelY  ) );
+}
+
+Void TAppAPIState::restore()
+{
+  g_uiMaxCUWidth   = m_uiMaxCUWidth;
+  g_uiMaxCUHeight  = m_uiMaxCUHeight;
+  g_uiMaxCUDepth   = m_uiMaxCUDepth;
+  g_uiAddCUDepth   = m_uiAddCUDepth;
+  g_uiBitDepth     = m_uiBitDepth;
+  g_uiBitIncrement = m_uiBitIncrement;
+  g_uiBASE_MAX     = m_uiBASE_MAX;
+  g_uiIBDI_MAX     = m_uiIBDI_MAX;
+
+  ::memcpy( g_auiZscanToRaster, m_auiZscanToRaster, sizeof( m_auiZscanToRaster ) );
+  ::memcpy( g_auiRasterToZscan, m_auiRasterToZscan, sizeof( m_auiRasterToZscan ) );
+  ::memcpy( g_auiRasterToPelX,  m_auiRasterToPelX,  sizeof( m_auiRasterToPelX  ) );
+  ::memcpy( g_auiRasterToPelY,  m_auiRasterToPelY,  sizeof( m_auiRasterToPelY  ) );
+}
+
+Void TAppAPIState::lock()
+{
+#if API_LOCK_THREAD
+  pthread_mutex_lock( &s_cAPIMutex );
+#endif
+}
+
+Void TAppAPIState::unlock()
+{
+#if API_LOCK_THREAD
+  pthread_mutex_unlock( &s_cAPIMutex );
+#endif
+}
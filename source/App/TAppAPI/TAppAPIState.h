@@ -0,0 +1,89 @@
+/* ====================================================================================================================
+
+  The copyright in this software is being made available under the License included below.
+  This software may be subject to other third party and   contributor rights, including patent rights, and no such
+  rights are granted under this license.
+
+  Copyright (c) 2010, SAMSUNG ELECTRONICS CO., LTD. and BRITISH BROADCASTING CORPORATION
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, are permitted only for
+  the purpose of developing standards within the Joint Collaborative Team on Video Coding and for testing and
+  promoting such standards. The following conditions are required to be met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+      the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+      the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of SAMSUNG ELECTRONICS CO., LTD. nor the name of the BRITISH BROADCASTING CORPORATION
+      may be used to endorse or promote products derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ * ====================================================================================================================
+*/
+
+/** \file     TAppAPIState.h
+    \brief    Per-instance global state of the library interface (header)
+*/
+
+#ifndef __TAPPAPISTATE__
+#define __TAPPAPISTATE__
+
+#include "../../Lib/TLibCommon/CommonDef.h"
+#include "../../Lib/TLibCommon/TComRom.h"
+
+// ====================================================================================================================
+// Constants
+// ====================================================================================================================
+
+#ifndef API_LOCK_THREAD
+#ifdef _WIN32
+#define API_LOCK_THREAD             0           ///< no POSIX threads, calls from different threads must not overlap
+#else
+#define API_LOCK_THREAD             1           ///< calls are serialized by a process wide mutex
+#endif
+#endif
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/** The libraries keep the CU geometry, the bit-depths and the z-scan tables derived from them in global variables.
+    Each encoder and decoder instance holds its own copy, which is restored before and saved after each call.
+    The configuration independent ROM tables are shared.
+ */
+class TAppAPIState
+{
+private:
+  UInt  m_uiMaxCUWidth;
+  UInt  m_uiMaxCUHeight;
+  UInt  m_uiMaxCUDepth;
+  UInt  m_uiAddCUDepth;
+  UInt  m_uiBitDepth;
+  UInt  m_uiBitIncrement;
+  UInt  m_uiBASE_MAX;
+  UInt  m_uiIBDI_MAX;
+
+  UInt  m_auiZscanToRaster[ MAX_NUM_SPU_W*MAX_NUM_SPU_W ];
+  UInt  m_auiRasterToZscan[ MAX_NUM_SPU_W*MAX_NUM_SPU_W ];
+  UInt  m_auiRasterToPelX [ MAX_NUM_SPU_W*MAX_NUM_SPU_W ];
+  UInt  m_auiRasterToPelY [ MAX_NUM_SPU_W*MAX_NUM_SPU_W ];
+
+public:
+  TAppAPIState();
+
+  Void  save    ();                                         ///< copy the global variables to the instance
+  Void  restore ();                                         ///< copy the instance to the global variables
+
+  static Void lock   ();                                    ///< enter a library call, the global variables are owned by the caller
+  static Void unlock ();                                    ///< leave a library call
+};
+
+#endif // __TAPPAPISTATE__
@@ -0,0 +1,351 @@
+/* ====================================================================================================================
+
+  The copyright in this software is being made available under the License included below.
+  This software may be subject to other third party and   contributor rights, including patent rights, and no such
+  rights are granted under this license.
+
+  Copyright (c) 2010, SAMSUNG ELECTRONICS CO., LTD. and BRITISH BROADCASTING CORPORATION
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, are permitted only for
+  the purpose of developing standards within the Joint Collaborative Team on Video Coding and for testing and
+  promoting such standards. The following conditions are required to be met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+      the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+      the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of SAMSUNG ELECTRONICS CO., LTD. nor the name of the BRITISH BROADCASTING CORPORATION
+      may be used to endorse or promote products derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ * ====================================================================================================================
+*/
+
+/** \file     TAppDecAPI.cpp
+    \brief    Decoder instance of the library interface and its C functions
+*/
+
+#include <string.h>
+#include <assert.h>
+
+#include "TAppDecAPI.h"
+
+// ====================================================================================================================
+// Local constants
+// ====================================================================================================================
+
+/// maximum bitstream buffer Size per 1 picture (1920*1080*1.5)
+#define BITS_BUF_SIZE     3110400
+
+// ====================================================================================================================
+// Constructor / destructor / initialization / destroy
+// ====================================================================================================================
+
+TAppDecAPI::TAppDecAPI()
+{
+  m_pcBitstream     = NULL;
+  m_iPOCLastDisplay = -1;
+  m_pfnPicCallback  = NULL;
+  m_pUser           = NULL;
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+/** \param pfnCallback  receives the decoded pictures
+    \param pUser        user pointer passed to the callback
+ */
+Void TAppDecAPI::open( tmuc_picture_callback pfnCallback, Void* pUser )
+{
+  m_pfnPicCallback = pfnCallback;
+  m_pUser          = pUser;
+
+  xEnter();
+
+  m_pcBitstream = new TComBitstream;
+  m_pcBitstream->create( BITS_BUF_SIZE );
+
+  m_cTDecTop.create();
+  m_cTDecTop.init();
+  m_cTDecTop.getGopDecoder()->setQuiet( true );
+
+  xLeave();
+}
+
+/** \param pucData  part of a byte stream of NAL units with start codes
+    \param iBytes   number of bytes
+    \retval         number of pictures output, -1 if a NAL unit exceeds the bitstream buffer
+ */
+Int TAppDecAPI::decode( const UChar* pucData, Int iBytes )
+{
+  m_cStream.insert( m_cStream.end(), pucData, pucData + iBytes );
+
+  xEnter();
+  Int iNumPics = xDecodeStream( false );
+  xLeave();
+
+  return iNumPics;
+}
+
+/** \retval number of pictures output, -1 if the last NAL unit exceeds the bitstream buffer
+ */
+Int TAppDecAPI::flush()
+{
+  xEnter();
+  Int iNumPics = xDecodeStream( true );
+  xLeave();
+
+  return iNumPics;
+}
+
+Void TAppDecAPI::close()
+{
+  xEnter();
+
+  m_cTDecTop.deletePicBuffer();
+  m_cTDecTop.destroy();
+
+  m_pcBitstream->destroy();
+  delete m_pcBitstream;
+  m_pcBitstream = NULL;
+
+  xLeave();
+}
+
+// ====================================================================================================================
+// Protected member functions
+// ====================================================================================================================
+
+Void TAppDecAPI::xEnter()
+{
+  TAppAPIState::lock();
+  m_cState.restore();
+}
+
+Void TAppDecAPI::xLeave()
+{
+  m_cState.save();
+  TAppAPIState::unlock();
+}
+
+/** A NAL unit ends at the next start code, zero bytes before it belong to the NAL unit as when reading a file.
+    \param bFlush  the last NAL unit ends at the end of the buffer
+    \retval        number of pictures output, -1 on error
+ */
+Int TAppDecAPI::xDecodeStream( Bool bFlush )
+{
+  Int          iNumPics = 0;
+  UInt         uiSize   = (UInt)m_cStream.size();
+  UInt         uiStart  = 0;
+  const UChar* pucData  = uiSize ? &m_cStream[0] : NULL;
+
+  // skip leading zero bytes to the first start code
+  while ( uiStart + 4 <= uiSize && !( pucData[uiStart] == 0 && pucData[uiStart+1] == 0 && pucData[uiStart+2] == 0 && pucData[uiStart+3] == 1 ) )
+  {
+    uiStart++;
+  }
+
+  for ( UInt uiPos = uiStart + 4; uiPos <= uiSize; uiPos++ )
+  {
+    Bool bStartCode = uiPos + 4 <= uiSize && pucData[uiPos] == 0 && pucData[uiPos+1] == 0 && pucData[uiPos+2] == 0 && pucData[uiPos+3] == 1;
+    Bool bEnd       = uiPos == uiSize && bFlush && uiPos > uiStart + 4;
+    if ( bStartCode || bEnd )
+    {
+      Int iNum = xDecodeNALUnit( pucData + uiStart + 4, uiPos - uiStart - 4 );
+      if ( iNum < 0 )
+      {
+        iNumPics = -1;
+        break;
+      }
+      iNumPics += iNum;
+      uiStart   = uiPos;
+      uiPos    += 3;
+    }
+  }
+
+  if ( bFlush || iNumPics < 0 )
+  {
+    m_cStream.clear();
+  }
+  else if ( uiStart > 0 )
+  {
+    m_cStream.erase( m_cStream.begin(), m_cStream.begin() + Min( uiStart, uiSize ) );
+  }
+  return iNumPics;
+}
+
+/** \retval number of pictures output, -1 if the NAL unit exceeds the bitstream buffer
+ */
+Int TAppDecAPI::xDecodeNALUnit( const UChar* pucData, UInt uiBytes )
+{
+  if ( uiBytes > BITS_BUF_SIZE )
+  {
+    return -1;
+  }
+
+  m_pcBitstream->rewindStreamPacket();
+  ::memcpy( m_pcBitstream->getBuffer(), pucData, uiBytes );
+#if HHI_NAL_UNIT_SYNTAX
+  m_pcBitstream->initParsingConvertPayloadToRBSP( uiBytes );
+#else
+  m_pcBitstream->initParsing( uiBytes );
+#endif
+
+  UInt                uiPOC;
+  TComList<TComPic*>* pcListPic;
+  m_cTDecTop.decode( false, m_pcBitstream, uiPOC, pcListPic );
+
+  return pcListPic ? xWriteOutput( pcListPic ) : 0;
+}
+
+/** same output order and reference release as the command line decoder
+    \param pcListPic  list of pictures sorted by POC
+    \retval           number of pictures output
+ */
+Int TAppDecAPI::xWriteOutput( TComList<TComPic*>* pcListPic )
+{
+  Int iNumPics = 0;
+  TComList<TComPic*>::iterator iterPic = pcListPic->begin();
+
+  while (iterPic != pcListPic->end())
+  {
+    TComPic* pcPic = *(iterPic);
+
+    if ( pcPic->getReconMark() && pcPic->getPOC() == (m_iPOCLastDisplay + 1) )
+    {
+      xOutputPicture( pcPic );
+      iNumPics++;
+
+      // update POC of display order
+      m_iPOCLastDisplay = pcPic->getPOC();
+
+      // erase non-referenced picture in the reference picture list after display
+      if ( !pcPic->getSlice()->isReferenced() && pcPic->getReconMark() == true )
+      {
+#if !DYN_REF_FREE
+        pcPic->setReconMark(false);
+
+        // mark it should be extended later
+        pcPic->getPicYuvRec()->setBorderExtension( false );
+#if HHI_INTERP_FILTER
+        pcPic->setRecFiltReady( false );
+#endif
+
+#else
+        pcPic->destroy();
+        pcListPic->erase( iterPic );
+        iterPic = pcListPic->begin(); // to the beginning, non-efficient way, have to be revised!
+        continue;
+#endif
+      }
+    }
+
+    iterPic++;
+  }
+  return iNumPics;
+}
+
+/** The reconstruction is at the internal bit-depth, it is descaled with rounding as when writing the file.
+ */
+Void TAppDecAPI::xOutputPicture( TComPic* pcPic )
+{
+  TComPicYuv* pcPicYuvRec = pcPic->getPicYuvRec();
+  Int*        aiPad       = pcPic->getSlice()->getSPS()->getPad();
+  Int         iWidth      = pcPicYuvRec->getWidth () - aiPad[0];
+  Int         iHeight     = pcPicYuvRec->getHeight() - aiPad[1];
+  Int         iShift      = g_uiBitIncrement;
+  Int         iOffset     = iShift > 0 ? 1 << ( iShift - 1 ) : 0;
+  Int         iMaxVal     = ( 1 << g_uiBitDepth ) - 1;
+
+  m_cPicBuffer.resize( iWidth * iHeight * 3 / 2 );
+
+  Pel*        apSrc   [3] = { pcPicYuvRec->getLumaAddr(), pcPicYuvRec->getCbAddr(),  pcPicYuvRec->getCrAddr()  };
+  Int         aiStride[3] = { pcPicYuvRec->getStride(),   pcPicYuvRec->getCStride(), pcPicYuvRec->getCStride() };
+  Short*      apDst   [3] = { &m_cPicBuffer[0], &m_cPicBuffer[iWidth * iHeight], &m_cPicBuffer[iWidth * iHeight * 5 / 4] };
+
+  tmuc_picture cPicture;
+  cPicture.width  = iWidth;
+  cPicture.height = iHeight;
+  cPicture.poc    = pcPic->getPOC();
+
+  for ( Int iComp = 0; iComp < 3; iComp++ )
+  {
+    Int    iCompWidth  = iComp ? iWidth  >> 1 : iWidth;
+    Int    iCompHeight = iComp ? iHeight >> 1 : iHeight;
+    Pel*   pSrc        = apSrc[iComp];
+    Short* pDst        = apDst[iComp];
+
+    for ( Int y = 0; y < iCompHeight; y++ )
+    {
+      for ( Int x = 0; x < iCompWidth; x++ )
+      {
+        pDst[x] = (Short)Clip3( 0, iMaxVal, ( pSrc[x] + iOffset ) >> iShift );
+      }
+      pSrc += aiStride[iComp];
+      pDst += iCompWidth;
+    }
+
+    cPicture.plane [iComp] = apDst[iComp];
+    cPicture.stride[iComp] = iCompWidth;
+  }
+
+  m_pfnPicCallback( m_pUser, &cPicture );
+}
+
+// ====================================================================================================================
+// C interface
+// ====================================================================================================================
+
+struct tmuc_decoder
+{
+  TAppDecAPI  cDecoder;
+};
+
+tmuc_decoder* tmuc_decoder_open( tmuc_picture_callback callback, void* user )
+{
+  if ( callback == NULL )
+  {
+    return NULL;
+  }
+
+  tmuc_decoder* decoder = new tmuc_decoder;
+  decoder->cDecoder.open( callback, user );
+  return decoder;
+}
+
+int tmuc_decoder_decode( tmuc_decoder* decoder, const unsigned char* data, int bytes )
+{
+  if ( decoder == NULL || ( data == NULL && bytes > 0 ) || bytes < 0 )
+  {
+    return -1;
+  }
+  return decoder->cDecoder.decode( data, bytes );
+}
+
+int tmuc_decoder_flush( tmuc_decoder* decoder )
+{
+  if ( decoder == NULL )
+  {
+    return -1;
+  }
+  return decoder->cDecoder.flush();
+}
+
+void tmuc_decoder_close( tmuc_decoder* decoder )
+{
+  if ( decoder == NULL )
+  {
+    return;
+  }
+  decoder->cDecoder.close();
+  delete decoder;
+}
@@ -0,0 +1,87 @@
+/* ====================================================================================================================
+
+  The copyright in this software is being made available under the License included below.
+  This software may be subject to other third party and   contributor rights, including patent rights, and no such
+  rights are granted under this license.
+
+  Copyright (c) 2010, SAMSUNG ELECTRONICS CO., LTD. and BRITISH BROADCASTING CORPORATION
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, are permitted only for
+  the purpose of developing standards within the Joint Collaborative Team on Video Coding and for testing and
+  promoting such standards. The following conditions are required to be met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+      the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+      the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of SAMSUNG ELECTRONICS CO., LTD. nor the name of the BRITISH BROADCASTING CORPORATION
+      may be used to endorse or promote products derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ * ====================================================================================================================
+*/
+
+/** \file     TAppDecAPI.h
+    \brief    Decoder instance of the library interface (header)
+*/
+
+#ifndef __TAPPDECAPI__
+#define __TAPPDECAPI__
+
+#include <vector>
+#include "../../Lib/TLibCommon/TComList.h"
+#include "../../Lib/TLibCommon/TComPicYuv.h"
+#include "../../Lib/TLibCommon/TComBitStream.h"
+#include "../../Lib/TLibDecoder/TDecTop.h"
+#include "TAppAPIState.h"
+#include "TMuCAPI.h"
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/** Decoder fed from memory, a NAL unit is decoded when the start code of the next one has been received.
+    Pictures are passed out in output order at the base bit-depth, cropped by the padding signalled in the SPS.
+ */
+class TAppDecAPI
+{
+private:
+  TDecTop                    m_cTDecTop;                    ///< decoder class
+  TComBitstream*             m_pcBitstream;                 ///< bitstream of one NAL unit
+  TAppAPIState               m_cState;                      ///< global variables of this instance
+
+  std::vector<UChar>         m_cStream;                     ///< received bytes which have not been decoded
+  Int                        m_iPOCLastDisplay;             ///< last POC in display order
+
+  tmuc_picture_callback      m_pfnPicCallback;              ///< receives the decoded pictures
+  Void*                      m_pUser;                       ///< user pointer of the callback
+  std::vector<Short>         m_cPicBuffer;                  ///< output picture at the base bit-depth
+
+protected:
+  Void  xEnter            ();                               ///< lock and load the global variables of the instance
+  Void  xLeave            ();                               ///< save the global variables of the instance and unlock
+
+  Int   xDecodeStream     ( Bool bFlush );                  ///< decode the complete NAL units of the stream buffer
+  Int   xDecodeNALUnit    ( const UChar* pucData, UInt uiBytes );  ///< decode one NAL unit without start code
+  Int   xWriteOutput      ( TComList<TComPic*>* pcListPic );       ///< pass the pictures in output order to the callback
+  Void  xOutputPicture    ( TComPic* pcPic );               ///< descale, crop and pass one picture
+
+public:
+  TAppDecAPI();
+  virtual ~TAppDecAPI() {}
+
+  Void  open      ( tmuc_picture_callback pfnCallback, Void* pUser );
+  Int   decode    ( const UChar* pucData, Int iBytes );
+  Int   flush     ();
+  Void  close     ();
+};
+
+#endif // __TAPPDECAPI__
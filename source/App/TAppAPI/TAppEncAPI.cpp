@@ -0,0 +1,457 @@
+/* ====================================================================================================================
+
+  The copyright in this software is being made available under the License included below.
+  This software may be subject to other third party and   contributor rights, including patent rights, and no such
+  rights are granted under this license.
+
+  Copyright (c) 2010, SAMSUNG ELECTRONICS CO., LTD. and BRITISH BROADCASTING CORPORATION
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, are permitted only for
+  the purpose of developing standards within the Joint Collaborative Team on Video Coding and for testing and
+  promoting such standards. The following conditions are required to be met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+      the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+      the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of SAMSUNG ELECTRONICS CO., LTD. nor the name of the BRITISH BROADCASTING CORPORATION
+      may be used to endorse or promote products derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ * ====================================================================================================================
+*/
+
+/** \file     TAppEncAPI.cpp
+    \brief    Encoder instance of the library interface and its C functions
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include "TAppEncAPI.h"
+
+// ====================================================================================================================
+// Constructor / destructor / initialization / destroy
+// ====================================================================================================================
+
+TAppEncAPI::TAppEncAPI()
+{
+  m_pcPicYuvOrg    = NULL;
+  m_bPicPending    = false;
+  m_bEos           = false;
+  m_iFrameRcvd     = 0;
+  m_pfnNALCallback = NULL;
+  m_pUser          = NULL;
+}
+
+TAppEncAPI::~TAppEncAPI()
+{
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+/** \param pcParam      encoder parameters
+    \param pfnCallback  receives the NAL units
+    \param pUser        user pointer passed to the callback
+    \retval             true when success, the instance has to be deleted without close() otherwise
+ */
+Bool TAppEncAPI::open( const tmuc_encoder_param* pcParam, tmuc_nal_callback pfnCallback, Void* pUser )
+{
+  m_pfnNALCallback = pfnCallback;
+  m_pUser          = pUser;
+
+  xEnter();
+
+  create();
+  m_bQuiet = ( pcParam->verbose == 0 );
+  if ( !xParseParam( pcParam ) )
+  {
+    destroy();
+    xLeave();
+    return false;
+  }
+
+  xInitLibCfg( &m_cTEncTop );
+  if ( !m_cTEncTop.create() )
+  {
+    m_cTEncTop.destroy();
+    destroy();
+    xLeave();
+    return false;
+  }
+  m_cTEncTop.init();
+
+  m_pcPicYuvOrg = new TComPicYuv;
+  m_pcPicYuvOrg->create( m_iSourceWidth, m_iSourceHeight, m_uiMaxCUWidth, m_uiMaxCUHeight, m_uiMaxCUDepth );
+
+  xLeave();
+  return true;
+}
+
+/** The previous picture is coded first, the picture itself is coded at once if it is the last one.
+    \param pcPicture    picture of the source size excluding padding
+    \retval             number of pictures coded, -1 after the last picture
+ */
+Int TAppEncAPI::encode( const tmuc_picture* pcPicture )
+{
+  if ( m_bEos || pcPicture->width != m_iSourceWidth - m_aiPad[0] || pcPicture->height != m_iSourceHeight - m_aiPad[1] )
+  {
+    return -1;
+  }
+
+  xEnter();
+
+  Int iNumEncoded = 0;
+  if ( m_bPicPending )
+  {
+    iNumEncoded += xEncode( false );
+  }
+
+  xCopyPicture( pcPicture );
+  m_bPicPending = true;
+  m_iFrameRcvd++;
+
+  if ( m_iFrameRcvd == m_iFrameToBeEncoded )
+  {
+    iNumEncoded += xEncode( true );
+  }
+
+  xLeave();
+  return iNumEncoded;
+}
+
+/** \retval number of pictures coded
+ */
+Int TAppEncAPI::flush()
+{
+  if ( !m_bPicPending )
+  {
+    m_bEos = true;
+    return 0;
+  }
+
+  xEnter();
+  Int iNumEncoded = xEncode( true );
+  xLeave();
+
+  return iNumEncoded;
+}
+
+Void TAppEncAPI::close()
+{
+  xEnter();
+
+#if FIX_TICKET67==1
+  m_cTEncTop.getSIFOEncoder()->destroy();
+#endif
+
+  m_pcPicYuvOrg->destroy();
+  delete m_pcPicYuvOrg;
+  m_pcPicYuvOrg = NULL;
+
+  m_cTEncTop.deletePicBuffer();
+  xDeleteBuffer();
+  m_cTEncTop.destroy();
+
+  destroy();
+
+  xLeave();
+}
+
+// ====================================================================================================================
+// Protected member functions
+// ====================================================================================================================
+
+Void TAppEncAPI::xEnter()
+{
+  TAppAPIState::lock();
+  m_cState.restore();
+
+  m_gcAnalyzeAll = m_acAnalyze[0];
+  m_gcAnalyzeI   = m_acAnalyze[1];
+  m_gcAnalyzeP   = m_acAnalyze[2];
+  m_gcAnalyzeB   = m_acAnalyze[3];
+}
+
+Void TAppEncAPI::xLeave()
+{
+  m_acAnalyze[0] = m_gcAnalyzeAll;
+  m_acAnalyze[1] = m_gcAnalyzeI;
+  m_acAnalyze[2] = m_gcAnalyzeP;
+  m_acAnalyze[3] = m_gcAnalyzeB;
+
+  m_cState.save();
+  TAppAPIState::unlock();
+}
+
+/** The parameter fields are appended after the configuration file and the options string, so they take precedence.
+    The configuration file is checked first, the option parser exits the process if it cannot be opened.
+ */
+Bool TAppEncAPI::xParseParam( const tmuc_encoder_param* pcParam )
+{
+  std::vector<std::string> cArgs;
+  Char                     acArg[64];
+
+  cArgs.push_back( "TAppEncoder" );
+
+  if ( pcParam->config_file )
+  {
+    FILE* fp = fopen( pcParam->config_file, "r" );
+    if ( fp == NULL )
+    {
+      return false;
+    }
+    fclose( fp );
+
+    cArgs.push_back( "-c" );
+    cArgs.push_back( pcParam->config_file );
+  }
+
+  if ( pcParam->options )
+  {
+    const Char* pch = pcParam->options;
+    while ( *pch )
+    {
+      while ( *pch == ' ' || *pch == '\t' || *pch == '\n' )
+      {
+        pch++;
+      }
+      const Char* pchEnd = pch;
+      while ( *pchEnd && *pchEnd != ' ' && *pchEnd != '\t' && *pchEnd != '\n' )
+      {
+        pchEnd++;
+      }
+      if ( pchEnd > pch )
+      {
+        cArgs.push_back( std::string( pch, pchEnd - pch ) );
+      }
+      pch = pchEnd;
+    }
+  }
+
+#define ADD_PARAM(name, value, set) if ( set ) { sprintf( acArg, "--%s=%d", name, value ); cArgs.push_back( acArg ); }
+  ADD_PARAM( "SourceWidth",       pcParam->width,          pcParam->width          > 0  );
+  ADD_PARAM( "SourceHeight",      pcParam->height,         pcParam->height         > 0  );
+  ADD_PARAM( "FrameRate",         pcParam->frame_rate,     pcParam->frame_rate     > 0  );
+  ADD_PARAM( "FramesToBeEncoded", pcParam->frames,         pcParam->frames         > 0  );
+  ADD_PARAM( "QP",                pcParam->qp,             pcParam->qp             >= 0 );
+  ADD_PARAM( "IntraPeriod",       pcParam->intra_period,   pcParam->intra_period   != 0 );
+  ADD_PARAM( "GOPSize",           pcParam->gop_size,       pcParam->gop_size       > 0  );
+  ADD_PARAM( "BitDepth",          pcParam->bit_depth,      pcParam->bit_depth      > 0  );
+  ADD_PARAM( "RateControl",       1,                       pcParam->target_bitrate > 0  );
+  ADD_PARAM( "TargetBitrate",     pcParam->target_bitrate, pcParam->target_bitrate > 0  );
+#undef ADD_PARAM
+
+  std::vector<Char*> cArgv;
+  for ( UInt ui = 0; ui < cArgs.size(); ui++ )
+  {
+    cArgv.push_back( const_cast<Char*>( cArgs[ui].c_str() ) );
+  }
+
+  return parseCfg( (Int)cArgv.size(), &cArgv[0] );
+}
+
+/** Samples beyond the picture size are replicated up to the padded source size, as done when reading the input file.
+ */
+Void TAppEncAPI::xCopyPicture( const tmuc_picture* pcPicture )
+{
+  Pel* apDst    [3] = { m_pcPicYuvOrg->getLumaAddr(), m_pcPicYuvOrg->getCbAddr(),  m_pcPicYuvOrg->getCrAddr()  };
+  Int  aiStride [3] = { m_pcPicYuvOrg->getStride(),   m_pcPicYuvOrg->getCStride(), m_pcPicYuvOrg->getCStride() };
+
+  for ( Int iComp = 0; iComp < 3; iComp++ )
+  {
+    Int          iShift      = iComp ? 1 : 0;
+    Int          iWidth      = pcPicture->width       >> iShift;
+    Int          iHeight     = pcPicture->height      >> iShift;
+    Int          iFullWidth  = m_pcPicYuvOrg->getWidth () >> iShift;
+    Int          iFullHeight = m_pcPicYuvOrg->getHeight() >> iShift;
+    const Short* pSrc        = pcPicture->plane[iComp];
+    Pel*         pDst        = apDst[iComp];
+    Int          x, y;
+
+    for ( y = 0; y < iHeight; y++ )
+    {
+      ::memcpy( pDst, pSrc, sizeof(Pel) * iWidth );
+      for ( x = iWidth; x < iFullWidth; x++ ) pDst[x] = pDst[x-1];
+      pSrc += pcPicture->stride[iComp];
+      pDst += aiStride[iComp];
+    }
+    for ( y = iHeight; y < iFullHeight; y++ )
+    {
+      ::memcpy( pDst, pDst - aiStride[iComp], sizeof(Pel) * iFullWidth );
+      pDst += aiStride[iComp];
+    }
+  }
+}
+
+/** \param bEos  the pending picture is the last one
+    \retval      number of pictures coded
+ */
+Int TAppEncAPI::xEncode( Bool bEos )
+{
+  TComPicYuv*    pcPicYuvRec = NULL;
+  TComBitstream* pcBitstream = NULL;
+  Int            iNumEncoded = 0;
+
+  xGetBuffer( pcPicYuvRec, pcBitstream );
+
+  m_cTEncTop.encode( bEos, m_pcPicYuvOrg, m_cListPicYuvRec, m_cListBitstream, iNumEncoded );
+  m_bPicPending = false;
+  m_bEos        = bEos;
+
+  if ( iNumEncoded > 0 )
+  {
+    xWriteOutput( iNumEncoded );
+  }
+  return iNumEncoded;
+}
+
+/** ring buffer of two GOPs as in the command line encoder, the reconstruction is not passed out
+ */
+Void TAppEncAPI::xGetBuffer( TComPicYuv*& rpcPicYuvRec, TComBitstream*& rpcBitStream )
+{
+  UInt uiNumBuffers = 2 * Max( m_iGOPSize, 1 );
+
+  if ( m_cListPicYuvRec.size() == uiNumBuffers )
+  {
+    rpcPicYuvRec = m_cListPicYuvRec.popFront();
+    rpcBitStream = m_cListBitstream.popFront();
+
+    rpcBitStream->rewindStreamPacket();
+  }
+  else
+  {
+    rpcPicYuvRec = new TComPicYuv;
+    rpcBitStream = new TComBitstream;
+
+    rpcPicYuvRec->create( m_iSourceWidth, m_iSourceHeight, m_uiMaxCUWidth, m_uiMaxCUHeight, m_uiMaxCUDepth );
+    rpcBitStream->create( (m_iSourceWidth * m_iSourceHeight * 3) >> 1 );
+  }
+  m_cListPicYuvRec.pushBack( rpcPicYuvRec );
+  m_cListBitstream.pushBack( rpcBitStream );
+}
+
+Void TAppEncAPI::xDeleteBuffer()
+{
+  while ( !m_cListPicYuvRec.empty() )
+  {
+    TComPicYuv*    pcPicYuvRec = m_cListPicYuvRec.popFront();
+    TComBitstream* pcBitstream = m_cListBitstream.popFront();
+
+    pcPicYuvRec->destroy();
+    pcBitstream->destroy();
+
+    delete pcPicYuvRec;
+    delete pcBitstream;
+  }
+}
+
+/** Each access unit is preceded by a start code and holds further start codes before the parameter sets and the slice.
+    It is split at the start codes, so each call of the callback receives one NAL unit with its start code.
+    \param iNumEncoded  number of coded pictures
+ */
+Void TAppEncAPI::xWriteOutput( Int iNumEncoded )
+{
+  TComList<TComBitstream*>::iterator iterBitstream = m_cListBitstream.begin();
+
+  for ( Int i = 0; i < iNumEncoded; i++ )
+  {
+    TComBitstream* pcBitstream = *(iterBitstream++);
+    UInt           uiBytes     = pcBitstream->getNumberOfWrittenBits() >> 3;
+    const UChar*   pucData     = reinterpret_cast<const UChar*>( pcBitstream->getStartStream() );
+
+    m_cNALBuffer.resize( uiBytes + 4 );
+    m_cNALBuffer[0] = 0;
+    m_cNALBuffer[1] = 0;
+    m_cNALBuffer[2] = 0;
+    m_cNALBuffer[3] = 1;
+    if ( uiBytes )
+    {
+      ::memcpy( &m_cNALBuffer[4], pucData, uiBytes );
+    }
+
+    const UChar* pucAU   = &m_cNALBuffer[0];
+    UInt         uiSize  = (UInt)m_cNALBuffer.size();
+    UInt         uiStart = 0;
+    for ( UInt uiPos = 4; uiPos + 4 <= uiSize; uiPos++ )
+    {
+      if ( pucAU[uiPos] == 0 && pucAU[uiPos+1] == 0 && pucAU[uiPos+2] == 0 && pucAU[uiPos+3] == 1 )
+      {
+        m_pfnNALCallback( m_pUser, pucAU + uiStart, uiPos - uiStart );
+        uiStart = uiPos;
+        uiPos  += 3;
+      }
+    }
+    m_pfnNALCallback( m_pUser, pucAU + uiStart, uiSize - uiStart );
+  }
+}
+
+// ====================================================================================================================
+// C interface
+// ====================================================================================================================
+
+struct tmuc_encoder
+{
+  TAppEncAPI  cEncoder;
+};
+
+void tmuc_encoder_param_default( tmuc_encoder_param* param )
+{
+  ::memset( param, 0, sizeof( tmuc_encoder_param ) );
+  param->qp = -1;
+}
+
+tmuc_encoder* tmuc_encoder_open( const tmuc_encoder_param* param, tmuc_nal_callback callback, void* user )
+{
+  if ( param == NULL || callback == NULL )
+  {
+    return NULL;
+  }
+
+  tmuc_encoder* encoder = new tmuc_encoder;
+  if ( !encoder->cEncoder.open( param, callback, user ) )
+  {
+    delete encoder;
+    return NULL;
+  }
+  return encoder;
+}
+
+int tmuc_encoder_encode( tmuc_encoder* encoder, const tmuc_picture* picture )
+{
+  if ( encoder == NULL || picture == NULL )
+  {
+    return -1;
+  }
+  return encoder->cEncoder.encode( picture );
+}
+
+int tmuc_encoder_flush( tmuc_encoder* encoder )
+{
+  if ( encoder == NULL )
+  {
+    return -1;
+  }
+  return encoder->cEncoder.flush();
+}
+
+void tmuc_encoder_close( tmuc_encoder* encoder )
+{
+  if ( encoder == NULL )
+  {
+    return;
+  }
+  encoder->cEncoder.close();
+  delete encoder;
+}
@@ -0,0 +1,95 @@
+/* ====================================================================================================================
+
+  The copyright in this software is being made available under the License included below.
+  This software may be subject to other third party and   contributor rights, including patent rights, and no such
+  rights are granted under this license.
+
+  Copyright (c) 2010, SAMSUNG ELECTRONICS CO., LTD. and BRITISH BROADCASTING CORPORATION
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, are permitted only for
+  the purpose of developing standards within the Joint Collaborative Team on Video Coding and for testing and
+  promoting such standards. The following conditions are required to be met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+      the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+      the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of SAMSUNG ELECTRONICS CO., LTD. nor the name of the BRITISH BROADCASTING CORPORATION
+      may be used to endorse or promote products derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ * ====================================================================================================================
+*/
+
+/** \file     TAppEncAPI.h
+    \brief    Encoder instance of the library interface (header)
+*/
+
+#ifndef __TAPPENCAPI__
+#define __TAPPENCAPI__
+
+#include <vector>
+#include <string>
+#include "../../Lib/TLibEncoder/TEncTop.h"
+#include "../../Lib/TLibEncoder/TEncAnalyze.h"
+#include "../../Lib/TLibCommon/TComBitStream.h"
+#include "../TAppEncoder/TAppEncCfg.h"
+#include "TAppAPIState.h"
+#include "TMuCAPI.h"
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/** Encoder configured like the command line encoder, pictures are passed in and NAL units are passed out by callback.
+    The last picture has to be known when it is coded, so each picture is held back until the next one arrives.
+ */
+class TAppEncAPI : public TAppEncCfg
+{
+private:
+  TEncTop                    m_cTEncTop;                    ///< encoder class
+  TAppAPIState               m_cState;                      ///< global variables of this instance
+  TEncAnalyze                m_acAnalyze[4];                ///< PSNR and rate statistics of this instance, all, I, P and B
+
+  TComList<TComPicYuv*>      m_cListPicYuvRec;              ///< list of reconstruction YUV buffers, two GOPs
+  TComList<TComBitstream*>   m_cListBitstream;              ///< list of bitstreams
+
+  TComPicYuv*                m_pcPicYuvOrg;                 ///< picture held back until the next call
+  Bool                       m_bPicPending;                 ///< m_pcPicYuvOrg holds a picture which has not been coded
+  Bool                       m_bEos;                        ///< the last picture has been coded
+  Int                        m_iFrameRcvd;                  ///< number of received frames
+
+  tmuc_nal_callback          m_pfnNALCallback;              ///< receives the NAL units
+  Void*                      m_pUser;                       ///< user pointer of the callback
+  std::vector<UChar>         m_cNALBuffer;                  ///< access unit with its leading start code
+
+protected:
+  Void  xEnter            ();                               ///< lock and load the global variables of the instance
+  Void  xLeave            ();                               ///< save the global variables of the instance and unlock
+
+  Bool  xParseParam       ( const tmuc_encoder_param* pcParam );  ///< build the command line and parse it
+  Void  xCopyPicture      ( const tmuc_picture* pcPicture );      ///< copy to the original buffer and pad it
+  Int   xEncode           ( Bool bEos );                    ///< code the pending picture
+  Void  xGetBuffer        ( TComPicYuv*& rpcPicYuvRec, TComBitstream*& rpcBitStream );
+  Void  xDeleteBuffer     ();
+  Void  xWriteOutput      ( Int iNumEncoded );              ///< pass the NAL units of the coded pictures to the callback
+
+public:
+  TAppEncAPI();
+  virtual ~TAppEncAPI();
+
+  Bool  open      ( const tmuc_encoder_param* pcParam, tmuc_nal_callback pfnCallback, Void* pUser );
+  Int   encode    ( const tmuc_picture* pcPicture );
+  Int   flush     ();
+  Void  close     ();
+};
+
+#endif // __TAPPENCAPI__
@@ -0,0 +1,142 @@
+/* ====================================================================================================================
+
+  The copyright in this software is being made available under the License included below.
+  This software may be subject to other third party and   contributor rights, including patent rights, and no such
+  rights are granted under this license.
+
+  Copyright (c) 2010, SAMSUNG ELECTRONICS CO., LTD. and BRITISH BROADCASTING CORPORATION
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, are permitted only for
+  the purpose of developing standards within the Joint Collaborative Team on Video Coding and for testing and
+  promoting such standards. The following conditions are required to be met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+      the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+      the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of SAMSUNG ELECTRONICS CO., LTD. nor the name of the BRITISH BROADCASTING CORPORATION
+      may be used to endorse or promote products derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ * ====================================================================================================================
+*/
+
+/** \file     TMuCAPI.h
+    \brief    C interface of the encoder and decoder libraries
+
+    Encoder and decoder instances are opaque handles. Pictures are passed as three planes of 16-bit samples at the
+    base bit-depth, the sample type and plane layout of TComPicYuv. Bitstreams are byte streams of NAL units, each
+    preceded by the start code 0x00000001, as written by the command line encoder.
+
+    Several instances can coexist in one process. The libraries keep configuration dependent tables in global
+    variables, the interface swaps them per instance and serializes all calls with a process wide lock, so calls
+    from different threads are safe but do not run in parallel.
+
+    The libraries print nothing to stdout unless verbose is set in the encoder parameters, failures are reported by
+    the return values only.
+*/
+
+#ifndef __TMUCAPI__
+#define __TMUCAPI__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TMUC_API_VERSION      2
+
+// ====================================================================================================================
+// Types
+// ====================================================================================================================
+
+typedef struct tmuc_encoder tmuc_encoder;
+typedef struct tmuc_decoder tmuc_decoder;
+
+/// picture planes, chroma planes have half the width and height of the luma plane
+typedef struct tmuc_picture
+{
+  int             width;                  ///< luma width in samples
+  int             height;                 ///< luma height in samples
+  const short*    plane [3];              ///< Y, U and V samples at the base bit-depth
+  int             stride[3];              ///< distance between rows in samples
+  int             poc;                    ///< picture order count, set for decoded pictures
+} tmuc_picture;
+
+/// encoder parameters, fields with the value 0 (qp: -1) keep the value of the configuration file or the encoder default
+typedef struct tmuc_encoder_param
+{
+  const char*     config_file;            ///< encoder configuration file, e.g. cfg/encoder_randomaccess.cfg, or NULL
+  const char*     options;                ///< further options in command line syntax, e.g. "--ALF=0 --SearchRange=32", or NULL
+  int             width;                  ///< source width, required
+  int             height;                 ///< source height, required
+  int             frame_rate;             ///< frame rate, required
+  int             frames;                 ///< max. number of pictures to be encoded, required
+  int             qp;                     ///< QP of the key pictures
+  int             intra_period;           ///< period of intra pictures, -1 for the first picture only
+  int             gop_size;               ///< GOP size of the hierarchical structure
+  int             bit_depth;              ///< base bit-depth of the pictures
+  int             target_bitrate;         ///< target bitrate in bits per second, enables the rate control
+  int             verbose;                ///< print the per-picture and summary messages of the command line encoder to stdout
+} tmuc_encoder_param;
+
+/// receives one NAL unit with its start code, the data is valid during the call only
+typedef void (*tmuc_nal_callback)     ( void* user, const unsigned char* data, int bytes );
+
+/// receives one decoded picture in output order, the picture is valid during the call only
+typedef void (*tmuc_picture_callback) ( void* user, const tmuc_picture* picture );
+
+// ====================================================================================================================
+// Encoder
+// ====================================================================================================================
+
+/// set all parameters to 0, except qp which is set to -1
+void            tmuc_encoder_param_default  ( tmuc_encoder_param* param );
+
+/** Options are applied in the order configuration file, options string, parameter fields.
+    \returns encoder handle, NULL if the configuration is invalid or a configuration or two-pass statistics file cannot be opened
+ */
+tmuc_encoder*   tmuc_encoder_open           ( const tmuc_encoder_param* param, tmuc_nal_callback callback, void* user );
+
+/** Queues one picture of the configured size. The NAL units of a GOP are delivered when the GOP has been coded.
+    \returns number of pictures coded during the call, -1 on error
+ */
+int             tmuc_encoder_encode         ( tmuc_encoder* encoder, const tmuc_picture* picture );
+
+/** Codes the queued pictures, no pictures can be added afterwards.
+    \returns number of pictures coded during the call, -1 on error
+ */
+int             tmuc_encoder_flush          ( tmuc_encoder* encoder );
+
+void            tmuc_encoder_close          ( tmuc_encoder* encoder );
+
+// ====================================================================================================================
+// Decoder
+// ====================================================================================================================
+
+tmuc_decoder*   tmuc_decoder_open           ( tmuc_picture_callback callback, void* user );
+
+/** Decodes a part of a byte stream, NAL units may be split across calls.
+    \returns number of pictures output during the call, -1 on error
+ */
+int             tmuc_decoder_decode         ( tmuc_decoder* decoder, const unsigned char* data, int bytes );
+
+/** Decodes the last NAL unit and outputs the remaining pictures.
+    \returns number of pictures output during the call, -1 on error
+ */
+int             tmuc_decoder_flush          ( tmuc_decoder* decoder );
+
+void            tmuc_decoder_close          ( tmuc_decoder* decoder );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __TMUCAPI__
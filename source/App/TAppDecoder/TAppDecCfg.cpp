@@ -33,6 +33,9 @@
     \brief    Decoder configuration class
 */
 
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
 #include "TAppDecCfg.h"
 
 // ====================================================================================================================
@@ -52,10 +55,18 @@ Bool TAppDecCfg::parseCfg( Int argc, Char* argv[] )
   m_apcOpt->addUsage( "options: (if only -b is specified, YUV writing is skipped)" );
   m_apcOpt->addUsage( "  -b  bitstream file name" );
   m_apcOpt->addUsage( "  -o  decoded YUV output file name" );
+  m_apcOpt->addUsage( "  -d  bit-depth of YUV output file, 8 to 16 (default: bitstream bit-depth, >8 writes 16-bit little-endian samples)" );
+  m_apcOpt->addUsage( "  -s  POC of the first picture to be written (default: 0)" );
+  m_apcOpt->addUsage( "  -x  random access index file name, decoding starts at the random access point before -s" );
+  m_apcOpt->addUsage( "  -t  benchmark mode, no output and no per-picture messages, reports frames, bins and stage times per second" );
 
   // set command line option strings/characters
   m_apcOpt->setCommandOption( 'b' );
   m_apcOpt->setCommandOption( 'o' );
+  m_apcOpt->setCommandOption( 'd' );
+  m_apcOpt->setCommandOption( 's' );
+  m_apcOpt->setCommandOption( 'x' );
+  m_apcOpt->setCommandFlag  ( 't' );
 
   // command line parsing
   m_apcOpt->processCommandArgs( argc, argv );
@@ -70,9 +81,26 @@ Bool TAppDecCfg::parseCfg( Int argc, Char* argv[] )
   // set configuration
   xSetCfgCommand( m_apcOpt );
 
+  // check range of parameters, the file is written with 8-bit or 16-bit little-endian samples
+  if ( m_apcOpt->getValue( 'd' ) && ( m_iOutputBitDepth < 8 || m_iOutputBitDepth > 16 ) )
+  {
+    printf( "Error: Output bit-depth must be in the range of 8 to 16\n" );
+    m_apcOpt->printUsage();
+    delete m_apcOpt;
+    m_apcOpt = NULL;
+    return false;
+  }
+
   return true;
 }
 
+/** The decoded YUV file named "-" is written to stdout, the application then moves its console output to stderr.
+ */
+Bool TAppDecCfg::writesStdout()
+{
+  return m_pchReconFile && strcmp( m_pchReconFile, "-" ) == 0;
+}
+
 // ====================================================================================================================
 // Protected member functions
 // ====================================================================================================================
@@ -81,10 +109,23 @@ Bool TAppDecCfg::parseCfg( Int argc, Char* argv[] )
  */
 Void TAppDecCfg::xSetCfgCommand   ( TAppOption* pcOpt )
 {
-  m_pchBitstreamFile = m_pchReconFile = NULL;
+  m_pchBitstreamFile = m_pchReconFile = m_pchRAIndexFile = NULL;
+  m_iOutputBitDepth  = 0;
+  m_iStartPOC        = 0;
+  m_bBenchmark       = false;
 
   if ( pcOpt->getValue( 'b' ) ) m_pchBitstreamFile = pcOpt->getValue( 'b' );
   if ( pcOpt->getValue( 'o' ) ) m_pchReconFile     = pcOpt->getValue( 'o' );
+  if ( pcOpt->getValue( 'd' ) ) m_iOutputBitDepth  = atoi( pcOpt->getValue( 'd' ) );
+  if ( pcOpt->getValue( 's' ) ) m_iStartPOC        = atoi( pcOpt->getValue( 's' ) );
+  if ( pcOpt->getValue( 'x' ) ) m_pchRAIndexFile   = pcOpt->getValue( 'x' );
+  if ( pcOpt->getFlag ( 't' ) ) m_bBenchmark       = true;
+
+  // benchmark mode measures decoding only
+  if ( m_bBenchmark )
+  {
+    m_pchReconFile = NULL;
+  }
 }
 
 
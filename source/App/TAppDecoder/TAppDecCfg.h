@@ -54,6 +54,10 @@ protected:
   TAppOption*   m_apcOpt;                             ///< option handling class
   char*         m_pchBitstreamFile;                   ///< input bitstream file name
   char*         m_pchReconFile;                       ///< output reconstruction file name
+  Int           m_iOutputBitDepth;                    ///< bit-depth of the output file (0: bit-depth of the bitstream)
+  Int           m_iStartPOC;                          ///< first POC to be written
+  char*         m_pchRAIndexFile;                     ///< random access index file name, written by the encoder
+  Bool          m_bBenchmark;                         ///< decode only, no per-picture messages, throughput report
 
   Void  xSetCfgCommand  ( TAppOption* pcOpt );        ///< initialize member variables from option class
 
@@ -62,6 +66,7 @@ public:
   virtual ~TAppDecCfg() {}
 
   Bool  parseCfg        ( Int argc, Char* argv[] );   ///< initialize option class from configuration
+  Bool  writesStdout    ();                           ///< true if the YUV output file name is "-"
 };
 
 #endif
@@ -37,6 +37,12 @@
 #include <stdio.h>
 #include <fcntl.h>
 #include <assert.h>
+#include <time.h>
+#ifdef _WIN32
+#include <sys/timeb.h>
+#else
+#include <sys/time.h>
+#endif
 
 #include "TAppDecTop.h"
 
@@ -49,6 +55,27 @@
  */
 #define BITS_BUF_SIZE     3110400
 
+/// number of decoded pictures that can be queued for the output writer thread
+#define OUTPUT_QUEUE_SIZE 4
+
+// ====================================================================================================================
+// Local functions
+// ====================================================================================================================
+
+/// wall-clock time in seconds
+static Double xGetWallTime()
+{
+#ifdef _WIN32
+  struct _timeb sTime;
+  _ftime( &sTime );
+  return (Double)sTime.time + sTime.millitm * 0.001;
+#else
+  struct timeval sTime;
+  gettimeofday( &sTime, NULL );
+  return (Double)sTime.tv_sec + sTime.tv_usec * 0.000001;
+#endif
+}
+
 // ====================================================================================================================
 // Constructor / destructor / initialization / destroy
 // ====================================================================================================================
@@ -57,6 +84,8 @@ TAppDecTop::TAppDecTop()
 {
   ::memset (m_abDecFlag, 0, sizeof (m_abDecFlag));
   m_iPOCLastDisplay  = -1;
+  m_dStartupTime     = 0;
+  m_dLaunchTime      = xGetWallTime();
 }
 
 Void TAppDecTop::create()
@@ -99,14 +128,24 @@ Void TAppDecTop::decode()
   TComBitstream*      pcBitstream = m_apcBitstream;
   UInt                uiPOC;
   TComList<TComPic*>* pcListPic;
-  Bool                bAlloc = false;
 
   // create & initialize internal classes
   xCreateDecLib();
   xInitDecLib  ();
 
+  // skip to the random access point before the first output picture
+  if ( m_iStartPOC > 0 && m_pchRAIndexFile )
+  {
+    xSeekRAPoint( pcBitstream );
+  }
+
+  // per-picture messages are only printed when not benchmarking
+  m_cTDecTop.getGopDecoder()->setBenchmark( m_bBenchmark );
+
   // main decoder loop
   Bool  bEos        = false;
+  Int   iNumPics    = 0;
+  long  lBefore     = clock();
   while ( !bEos )
   {
     bEos = m_cTVideoIOBitstreamFile.readBits( pcBitstream );
@@ -115,20 +154,26 @@ Void TAppDecTop::decode()
       break;
     }
 
+    if ( m_dStartupTime == 0 )
+    {
+      m_dStartupTime = xGetWallTime() - m_dLaunchTime;
+    }
+
     // call actual decoding function
     m_cTDecTop.decode( bEos, pcBitstream, uiPOC, pcListPic );
 
     if( pcListPic )
     {
+      iNumPics++;
+
       // write reconstuction to file
-      xWriteOutput( pcListPic, bAlloc );
+      xWriteOutput( pcListPic );
     }
   }
 
-  // delete temporary buffer
-  if ( bAlloc )
+  if ( m_bBenchmark )
   {
-    m_cTempPicYuv.destroy();
+    xPrintBenchmark( iNumPics, (Double)( clock() - lBefore ) / CLOCKS_PER_SEC );
   }
 
   // delete buffers
@@ -147,10 +192,7 @@ Void TAppDecTop::xCreateDecLib()
   // open bitstream file
   m_cTVideoIOBitstreamFile.openBits( m_pchBitstreamFile, false);  // read mode
 
-  if ( m_pchReconFile )
-  {
-    m_cTVideoIOYuvReconFile.open( m_pchReconFile, true );         // write mode
-  }
+  // the reconstruction file is opened with the first output picture, when the bit-depths are known
 
   // create decoder class
   m_cTDecTop.create();
@@ -161,11 +203,19 @@ Void TAppDecTop::xDestroyDecLib()
   // close bitstream file
   m_cTVideoIOBitstreamFile.closeBits();
 
-  if ( m_pchReconFile )
+  if ( m_cTVideoIOYuvReconFile.isOpen() )
   {
     m_cTVideoIOYuvReconFile. close();
   }
 
+  // delete output pictures, all of them have been written when the file is closed
+  while ( !m_cListPicYuvOut.empty() )
+  {
+    TComPicYuv* pcPicYuvOut = m_cListPicYuvOut.popFront();
+    pcPicYuvOut->destroy();
+    delete pcPicYuvOut;
+  }
+
   // destroy decoder class
   m_cTDecTop.destroy();
 }
@@ -177,10 +227,9 @@ Void TAppDecTop::xInitDecLib()
 }
 
 /** \param pcListPic list of pictures to be written to file
-    \aram  bFirst    first picture?
     \todo            DYN_REF_FREE should be revised
  */
-Void TAppDecTop::xWriteOutput( TComList<TComPic*>* pcListPic, Bool& rbAlloc )
+Void TAppDecTop::xWriteOutput( TComList<TComPic*>* pcListPic )
 {
   TComList<TComPic*>::iterator iterPic   = pcListPic->begin();
 
@@ -190,39 +239,21 @@ Void TAppDecTop::xWriteOutput( TComList<TComPic*>* pcListPic, Bool& rbAlloc )
 
     if ( pcPic->getReconMark() && pcPic->getPOC() == (m_iPOCLastDisplay + 1) )
     {
-      // descaling case: IBDI
-      if ( g_uiBitIncrement )
+      if ( m_pchReconFile && pcPic->getPOC() >= m_iStartPOC )
       {
-        TComPicYuv* pcPicD = &m_cTempPicYuv;
-
-        // allocate temporary buffer if first time
-        if ( !rbAlloc )
+        // open the file at the first output picture, IBDI descaling is done by the file writer
+        if ( !m_cTVideoIOYuvReconFile.isOpen() )
         {
-          m_cTempPicYuv.create( pcPic->getPicYuvRec()->getWidth (),
-                                pcPic->getPicYuvRec()->getHeight(),
-                                g_uiMaxCUWidth,
-                                g_uiMaxCUHeight,
-                                g_uiMaxCUDepth );
-          rbAlloc = true;
+          Int iOutputBitDepth = m_iOutputBitDepth ? m_iOutputBitDepth : g_uiBitDepth;
+          m_cTVideoIOYuvReconFile.open( m_pchReconFile, iOutputBitDepth, g_uiBitDepth + g_uiBitIncrement, OUTPUT_QUEUE_SIZE ); // write mode
         }
 
-        // descaling of frame
-        xDeScalePic( pcPic, pcPicD );
+        // the picture buffer is released below, the writer gets a copy
+        TComPicYuv* pcPicYuvOut = xGetOutputBuffer( pcPic->getPicYuvRec() );
+        pcPic->getPicYuvRec()->copyToPic( pcPicYuvOut );
 
         // write to file
-        if ( m_pchReconFile )
-        {
-          m_cTVideoIOYuvReconFile.write( pcPicD, pcPic->getSlice()->getSPS()->getPad() );
-        }
-      }
-      // normal case
-      else
-      {
-        // write to file
-        if ( m_pchReconFile )
-        {
-          m_cTVideoIOYuvReconFile.write( pcPic->getPicYuvRec(), pcPic->getSlice()->getSPS()->getPad() );
-        }
+        m_cTVideoIOYuvReconFile.write( pcPicYuvOut, pcPic->getSlice()->getSPS()->getPad() );
       }
 
       // update POC of display order
@@ -237,7 +268,7 @@ Void TAppDecTop::xWriteOutput( TComList<TComPic*>* pcListPic, Bool& rbAlloc )
         // mark it should be extended later
         pcPic->getPicYuvRec()->setBorderExtension( false );
 #if HHI_INTERP_FILTER
-        pcPic->getPicYuvRecFilt()->setBorderExtension( false );
+        pcPic->setRecFiltReady( false );
 #endif
 
 #else
@@ -253,67 +284,105 @@ Void TAppDecTop::xWriteOutput( TComList<TComPic*>* pcListPic, Bool& rbAlloc )
   }
 }
 
-/** \param    pcPic   input picture to be descaled
-    \retval   pcPicD  output picture which is descaled
+/** The ring holds one picture more than the writer queue, so a picture can be filled while the queue is full.
+    \param pcPicYuvRec reconstructed picture, gives the picture size
+    \returns           output picture which is not queued for writing
  */
-Void TAppDecTop::xDeScalePic( TComPic* pcPic, TComPicYuv* pcPicD )
+TComPicYuv* TAppDecTop::xGetOutputBuffer( TComPicYuv* pcPicYuvRec )
 {
-  Pel*  pRecD   = pcPicD->getLumaAddr();
-  Pel*  pRecDCb = pcPicD->getCbAddr();
-  Pel*  pRecDCr = pcPicD->getCrAddr();
-  Pel*  pRec    = pcPic->getPicYuvRec()->getLumaAddr();
-  Pel*  pRecCb  = pcPic->getPicYuvRec()->getCbAddr();
-  Pel*  pRecCr  = pcPic->getPicYuvRec()->getCrAddr();
-  Int   iStride = pcPic->getStride();
+  TComPicYuv* pcPicYuvOut;
 
-  Int   iWidth  = pcPic->getPicYuvRec()->getWidth();
-  Int   iHeight = pcPic->getPicYuvRec()->getHeight();
-  Int   offset  = (g_uiBitIncrement>0)?(1<<(g_uiBitIncrement-1)):0;
+  if ( m_cListPicYuvOut.size() == OUTPUT_QUEUE_SIZE + 1 )
+  {
+    pcPicYuvOut = m_cListPicYuvOut.popFront();
+    m_cTVideoIOYuvReconFile.waitRelease( pcPicYuvOut );
+  }
+  else
+  {
+    pcPicYuvOut = new TComPicYuv;
+    pcPicYuvOut->create( pcPicYuvRec->getWidth(), pcPicYuvRec->getHeight(), g_uiMaxCUWidth, g_uiMaxCUHeight, g_uiMaxCUDepth );
+  }
+  m_cListPicYuvOut.pushBack( pcPicYuvOut );
 
-  Int   x, y;
+  return pcPicYuvOut;
+}
 
-  // ------------------------------------------------------------------------------------------------------------------
-  // Luma descaling
-  // ------------------------------------------------------------------------------------------------------------------
+/** The index holds the POC and bitstream position of each clean random access point, one per line.
+    The parameter sets at the start of the bitstream are decoded before the seek.
+    \param pcBitstream bitstream buffer
+ */
+Void TAppDecTop::xSeekRAPoint( TComBitstream* pcBitstream )
+{
+  FILE* fp = fopen( m_pchRAIndexFile, "r" );
+  if ( fp == NULL )
+  {
+    printf("\nfailed to open random access index file\n");
+    exit(0);
+  }
 
-  for( y = iHeight-1; y >= 0; y-- )
+  // last random access point at or before the start POC
+  Int   iRAPOC      = 0;
+  Int64 iRAPosition = 0;
+  Char  acLine[256];
+  while ( fgets( acLine, sizeof(acLine), fp ) )
   {
-    for( x = iWidth-1; x >= 0; x-- )
+    Int       iPOC;
+    long long iPosition;
+    if ( acLine[0] != '#' && sscanf( acLine, "%d %lld", &iPOC, &iPosition ) == 2 && iPOC <= m_iStartPOC && iPOC >= iRAPOC )
     {
-#if IBDI_NOCLIP_RANGE
-      pRecD[x] = ( pRec[x] + offset ) >> g_uiBitIncrement;
-#else
-      pRecD[x] = ClipMax( ( pRec[x] + offset ) >> g_uiBitIncrement );
-#endif
+      iRAPOC      = iPOC;
+      iRAPosition = iPosition;
     }
-    pRecD += iStride;
-    pRec  += iStride;
   }
+  fclose( fp );
 
-  // ------------------------------------------------------------------------------------------------------------------
-  // Chroma descaling
-  // ------------------------------------------------------------------------------------------------------------------
-
-  iHeight >>= 1;
-  iWidth  >>= 1;
-  iStride >>= 1;
+  if ( iRAPosition == 0 )
+  {
+    return;
+  }
 
-  for( y = iHeight-1; y >= 0; y-- )
+#if HHI_NAL_UNIT_SYNTAX
+  UInt                uiPOC;
+  TComList<TComPic*>* pcListPic;
+  while ( !m_cTVideoIOBitstreamFile.readBits( pcBitstream ) )
   {
-    for( x = iWidth-1; x >= 0; x-- )
+    const UChar* pucBuffer = reinterpret_cast<const UChar*>(pcBitstream->getStartStream());
+    if ( NalUnitType( pucBuffer[0] & 31 ) == NAL_UNIT_CODED_SLICE )
     {
-#if IBDI_NOCLIP_RANGE
-      pRecDCb[x] = ( pRecCb[x] + offset) >> g_uiBitIncrement;
-      pRecDCr[x] = ( pRecCr[x] + offset) >> g_uiBitIncrement;
-#else
-      pRecDCb[x] = ClipMax( ( pRecCb[x] + offset) >> g_uiBitIncrement );
-      pRecDCr[x] = ClipMax( ( pRecCr[x] + offset) >> g_uiBitIncrement );
-#endif
+      break;
     }
-    pRecDCb += iStride;
-    pRecCb  += iStride;
-    pRecDCr += iStride;
-    pRecCr  += iStride;
+    m_cTDecTop.decode( false, pcBitstream, uiPOC, pcListPic );
   }
+
+  m_cTVideoIOBitstreamFile.seekBits( iRAPosition );
+  m_cTDecTop.setFirstPOC( iRAPOC );
+  m_iPOCLastDisplay = iRAPOC - 1;
+#else
+  // the parameter sets are sent with the first picture, decoding starts at the beginning of the bitstream
+#endif
 }
 
+/** \param iNumPics  number of decoded pictures
+    \param dTime     decoding time in seconds, including bitstream reading
+ */
+Void TAppDecTop::xPrintBenchmark( Int iNumPics, Double dTime )
+{
+  TDecGop* pcGopDecoder = m_cTDecTop.getGopDecoder();
+  Double   dBits        = (Double)m_cTVideoIOBitstreamFile.getPosition() * 8;
+  Double   dSliceTime   = pcGopDecoder->getSliceTime();
+  Double   dLFTime      = pcGopDecoder->getLoopFilterTime();
+  Double   dALFTime     = pcGopDecoder->getALFTime();
+
+  dTime = Max( dTime, 1e-6 );
+
+  printf("\n\nBenchmark\n");
+  printf("  Decoded pictures             : %d\n",                 iNumPics );
+  printf("  Decoding time                : %.3f sec.\n",          dTime );
+  printf("  Frames per second            : %.2f\n",               iNumPics / dTime );
+  printf("  Bitstream                    : %.3f Mbit/s\n",        dBits / dTime / 1e6 );
+  printf("  Bins                         : %.3f Mbin/s (%llu bins, 0 with CAVLC)\n", pcGopDecoder->getNumBins() / dTime / 1e6, (unsigned long long)pcGopDecoder->getNumBins() );
+  printf("  Slice decoding               : %.3f sec. (%4.1f%%)\n", dSliceTime, 100 * dSliceTime / dTime );
+  printf("  Deblocking filter            : %.3f sec. (%4.1f%%)\n", dLFTime,    100 * dLFTime    / dTime );
+  printf("  Adaptive loop filter         : %.3f sec. (%4.1f%%)\n", dALFTime,   100 * dALFTime   / dTime );
+  printf("  Other                        : %.3f sec. (%4.1f%%)\n", dTime - dSliceTime - dLFTime - dALFTime, 100 * ( dTime - dSliceTime - dLFTime - dALFTime ) / dTime );
+}
@@ -64,14 +64,14 @@ private:
 #else
   TVideoIOBits                    m_cTVideoIOBitstreamFile;       ///< file I/O class
 #endif
-  TVideoIOYuv                     m_cTVideoIOYuvReconFile;        ///< reconstruction YUV class
+  TVideoIOYuvWriter               m_cTVideoIOYuvReconFile;        ///< reconstruction YUV class, written by a separate thread
+  TComList<TComPicYuv*>           m_cListPicYuvOut;               ///< ring of output pictures handed to the writer
 
   // for output control
   Bool                            m_abDecFlag[ MAX_GOP ];         ///< decoded flag in one GOP
   Int                             m_iPOCLastDisplay;              ///< last POC in display order
-
-  // temporary buffer for IBDI
-  TComPicYuv                      m_cTempPicYuv;                  ///< temporary buffer for IBDI
+  Double                          m_dLaunchTime;                  ///< wall-clock time at which the decoder application was constructed
+  Double                          m_dStartupTime;                 ///< wall-clock time from launch until the first picture is decoded
 
 public:
   TAppDecTop();
@@ -80,14 +80,17 @@ public:
   Void  create            (); ///< create internal members
   Void  destroy           (); ///< destroy internal members
   Void  decode            (); ///< main decoding function
+  Double getStartupTime   () { return m_dStartupTime; } ///< return startup time in seconds
 
 protected:
   Void  xCreateDecLib     (); ///< create internal classes
   Void  xDestroyDecLib    (); ///< destroy internal classes
   Void  xInitDecLib       (); ///< initialize decoder class
 
-  Void  xWriteOutput      ( TComList<TComPic*>* pcListPic, Bool& rbAlloc ); ///< write YUV to file
-  Void  xDeScalePic       ( TComPic* pcPic, TComPicYuv* pcPicD );           ///< descaling of picture
+  Void  xWriteOutput      ( TComList<TComPic*>* pcListPic ); ///< write YUV to file
+  Void  xSeekRAPoint      ( TComBitstream* pcBitstream );   ///< continue decoding at the random access point before the start POC
+  Void  xPrintBenchmark   ( Int iNumPics, Double dTime );   ///< print throughput and stage times
+  TComPicYuv* xGetOutputBuffer ( TComPicYuv* pcPicYuvRec );  ///< get a free output picture from the ring
 };
 
 #endif
@@ -45,14 +45,6 @@ int main(int argc, char* argv[])
 {
   TAppDecTop  cTAppDecTop;
 
-  // print information
-  fprintf( stdout, "\n" );
-  fprintf( stdout, "TMuC SW candidate: Decoder Version [%s]", NV_VERSION );
-  fprintf( stdout, NVM_ONOS );
-  fprintf( stdout, NVM_COMPILEDBY );
-  fprintf( stdout, NVM_BITS );
-  fprintf( stdout, "\n" );
-
   // create application decoder class
   cTAppDecTop.create();
 
@@ -63,6 +55,20 @@ int main(int argc, char* argv[])
     return 1;
   }
 
+  // an output file of "-" is written to stdout, console output goes to stderr then
+  if ( cTAppDecTop.writesStdout() )
+  {
+    TVideoIOStream::reserveStdout();
+  }
+
+  // print information
+  fprintf( stdout, "\n" );
+  fprintf( stdout, "TMuC SW candidate: Decoder Version [%s]", NV_VERSION );
+  fprintf( stdout, NVM_ONOS );
+  fprintf( stdout, NVM_COMPILEDBY );
+  fprintf( stdout, NVM_BITS );
+  fprintf( stdout, "\n" );
+
   // starting time
   double dResult;
   long lBefore = clock();
@@ -73,6 +79,7 @@ int main(int argc, char* argv[])
   // ending time
   dResult = (double)(clock()-lBefore) / CLOCKS_PER_SEC;
   printf("\n Total Time: %12.3f sec.\n", dResult);
+  printf(" Startup Time: %10.3f sec. (wall clock)\n", cTAppDecTop.getStartupTime());
 
   // destroy application decoder class
   cTAppDecTop.destroy();
@@ -61,6 +61,9 @@ void doOldStyleCmdlineOff(po::Options& opts, const std::string& arg);
  */
 #define MAX_PAD_SIZE                16
 
+/// max. motion search range of the first pass of two-pass encoding
+#define FIRST_PASS_SEARCH_RANGE     16
+
 // ====================================================================================================================
 // Constructor / destructor / initialization / destroy
 // ====================================================================================================================
@@ -69,6 +72,8 @@ TAppEncCfg::TAppEncCfg()
 {
   m_aidQP = NULL;
   m_pchGRefMode = NULL;
+  m_pchStatsFile = NULL;
+  m_bQuiet = false;
 }
 
 TAppEncCfg::~TAppEncCfg()
@@ -102,7 +107,9 @@ Bool TAppEncCfg::parseCfg( Int argc, Char* argv[] )
   string cfg_InputFile;
   string cfg_BitstreamFile;
   string cfg_ReconFile;
+  string cfg_RAIndexFile;
   string cfg_dQPFile;
+  string cfg_StatsFile;
   string cfg_GRefMode;
   po::Options opts;
   opts.addOptions()
@@ -113,11 +120,14 @@ Bool TAppEncCfg::parseCfg( Int argc, Char* argv[] )
     ("InputFile,i",     cfg_InputFile,     string(""), "original YUV input file name")
     ("BitstreamFile,b", cfg_BitstreamFile, string(""), "bitstream output file name")
     ("ReconFile,o",     cfg_ReconFile,     string(""), "reconstructed YUV output file name")
+    ("RandomAccessIndexFile", cfg_RAIndexFile, string(""), "random access index output file name (POC and bitstream offset of each clean intra picture)")
 
     ("SourceWidth,-wdt",      m_iSourceWidth,  0, "Source picture width")
     ("SourceHeight,-hgt",     m_iSourceHeight, 0, "Source picture height")
     ("BitDepth",              m_uiBitDepth,    8u)
     ("BitIncrement",          m_uiBitIncrement,4u, "bit-depth increasement")
+    ("InputBitDepth",         m_uiInputBitDepth,  0u, "bit-depth of input file, >8 reads 16-bit little-endian samples (default: BitDepth)")
+    ("OutputBitDepth",        m_uiOutputBitDepth, 0u, "bit-depth of reconstructed file, >8 writes 16-bit little-endian samples (default: BitDepth)")
     ("HorizontalPadding,-pdx",m_aiPad[0],      0, "horizontal source padding size")
     ("VerticalPadding,-pdy",  m_aiPad[1],      0, "vertical source padding size")
     ("PAD",                   m_bUsePAD,   false, "automatic source padding of multiple of 16" )
@@ -160,6 +170,9 @@ Bool TAppEncCfg::parseCfg( Int argc, Char* argv[] )
     ("QBO", m_bUseQBO, false, "skip refers highest quality picture")
     ("NRF", m_bUseNRF,  true, "non-reference frame marking in last layer")
     ("BQP", m_bUseBQP, false, "hier-P style QP assignment in low-delay mode")
+    ("Lookahead", m_bUseLookahead, false, "scene-cut and motion analysis of the input pictures")
+    ("SceneCutThreshold", m_iSceneCutThreshold, 40, "intra picture if prediction from the previous picture saves less than this percentage (0: off)")
+    ("MotionGOPThreshold", m_iMotionGOPThreshold, 8, "halve the GOP if the mean motion in samples exceeds this value (0: off)")
     ("-ldm", doOldStyleCmdlineLDM, "recommended low-delay setting (with LDC), (0=slow sequence, 1=fast sequence)")
 
     /* Interpolation filter options */
@@ -201,11 +214,21 @@ Bool TAppEncCfg::parseCfg( Int argc, Char* argv[] )
     ("MaxDeltaQP,d",  m_iMaxDeltaQP,        0, "max dQp offset for block")
     ("dQPFile,m",     cfg_dQPFile, string(""), "dQP file name")
     ("RDOQ",          m_bUseRDOQ, true)
+    ("FastRDOQ",      m_bUseFastRDOQ, false, "fast RDOQ during mode decision")
+    ("FastRDOQFinal", m_bUseFastRDOQFinal, false, "fast RDOQ when coding the selected mode")
     ("TemporalLayerQPOffset_L0,-tq0", m_aiTLayerQPOffset[0], MAX_QP + 1, "QP offset of temporal layer 0")
     ("TemporalLayerQPOffset_L1,-tq1", m_aiTLayerQPOffset[1], MAX_QP + 1, "QP offset of temporal layer 1")
     ("TemporalLayerQPOffset_L2,-tq2", m_aiTLayerQPOffset[2], MAX_QP + 1, "QP offset of temporal layer 2")
     ("TemporalLayerQPOffset_L3,-tq3", m_aiTLayerQPOffset[3], MAX_QP + 1, "QP offset of temporal layer 3")
 
+    /* Rate control */
+    ("RateControl",         m_bUseRateCtrl,    false, "rate control instead of constant QP")
+    ("TargetBitrate",       m_iTargetBitrate,      0, "target bitrate in bits per second")
+    ("VBVBufferSize",       m_iVBVBufferSize,      0, "VBV buffer size in bits (0: unconstrained)")
+    ("LCULevelRateControl", m_bUseLCURateCtrl,  true, "LCU level lambda and QP adaptation")
+    ("TwoPass",             m_iTwoPass,            0, "two-pass encoding, 1: fast first pass writing StatsFile, 2: second pass at TargetBitrate reading StatsFile")
+    ("StatsFile",           cfg_StatsFile, string(""), "two-pass statistics file name")
+
     /* Entropy coding parameters */
     ("SymbolMode,-sym", m_iSymbolMode, 1, "symbol mode (0=VLC, 1=SBAC)")
     ("SBACRD", m_bUseSBACRD, true, "SBAC based RD estimation")
@@ -263,8 +286,10 @@ Bool TAppEncCfg::parseCfg( Int argc, Char* argv[] )
 
   if (argc == 1 || do_help) {
     /* argc == 1: no options have been specified */
-    po::doHelp(cout, opts);
-    xPrintUsage();
+    if (!m_bQuiet) {
+      po::doHelp(cout, opts);
+      xPrintUsage();
+    }
     return false;
   }
 
@@ -275,8 +300,10 @@ Bool TAppEncCfg::parseCfg( Int argc, Char* argv[] )
   m_pchInputFile = cfg_InputFile.empty() ? NULL : strdup(cfg_InputFile.c_str());
   m_pchBitstreamFile = cfg_BitstreamFile.empty() ? NULL : strdup(cfg_BitstreamFile.c_str());
   m_pchReconFile = cfg_ReconFile.empty() ? NULL : strdup(cfg_ReconFile.c_str());
+  m_pchRAIndexFile = cfg_RAIndexFile.empty() ? NULL : strdup(cfg_RAIndexFile.c_str());
   m_pchdQPFile = cfg_dQPFile.empty() ? NULL : strdup(cfg_dQPFile.c_str());
   m_pchGRefMode = cfg_GRefMode.empty() ? NULL : strdup(cfg_GRefMode.c_str());
+  m_pchStatsFile = cfg_StatsFile.empty() ? NULL : strdup(cfg_StatsFile.c_str());
 
   if (m_iRateGOPSize == -1) {
     /* if rateGOPSize has not been specified, the default value is GOPSize */
@@ -335,31 +362,73 @@ Bool TAppEncCfg::parseCfg( Int argc, Char* argv[] )
     }
   }
 
+  // file bit-depths default to the base bit-depth
+  if ( m_uiInputBitDepth  == 0 ) m_uiInputBitDepth  = m_uiBitDepth;
+  if ( m_uiOutputBitDepth == 0 ) m_uiOutputBitDepth = m_uiBitDepth;
+
+  // the first pass of two-pass encoding only collects statistics, it runs with a fast configuration
+  if ( m_iTwoPass == 1 )
+  {
+    if ( m_iSearchRange == 0 || m_iSearchRange > FIRST_PASS_SEARCH_RANGE )
+    {
+      m_iSearchRange = FIRST_PASS_SEARCH_RANGE;
+    }
+    m_bUseAMP  = false;
+    m_bUseALF  = false;
+    m_bUseRDOQ = false;
+#if HHI_INTERP_FILTER && defined(QC_SIFO)
+    if ( m_iInterpFilterType == IPF_QC_SIFO )
+    {
+      m_iInterpFilterType = IPF_SAMSUNG_DIF_DEFAULT;
+    }
+#endif
+#ifdef QC_SIFO_PRED
+    m_bUseSIFO_Pred = false;
+#endif
+  }
+
   // check validity of input parameters
-  xCheckParameter();
+  if ( !xCheckParameter() )
+  {
+    return false;
+  }
 
   // set global varibles
   xSetGlobal();
 
-  // print-out parameters
-  xPrintParameter();
-
   return true;
 }
 
+/** Output files named "-" are written to stdout, the application then moves its console output to stderr.
+ */
+Bool TAppEncCfg::writesStdout()
+{
+  const char* apchFile[4] = { m_pchBitstreamFile, m_pchReconFile, m_pchRAIndexFile, m_iTwoPass == 1 ? m_pchStatsFile : NULL };
+  for ( Int i = 0; i < 4; i++ )
+  {
+    if ( apchFile[i] && strcmp( apchFile[i], "-" ) == 0 )
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
 // ====================================================================================================================
 // Private member functions
 // ====================================================================================================================
 
-Bool confirmPara(Bool bflag, const char* message);
+Bool confirmPara(Bool bflag, const char* message, Bool bQuiet);
 
-Void TAppEncCfg::xCheckParameter()
+Bool TAppEncCfg::xCheckParameter()
 {
   bool check_failed = false; /* abort if there is a fatal configuration problem */
-#define xConfirmPara(a,b) check_failed |= confirmPara(a,b)
+#define xConfirmPara(a,b) check_failed |= confirmPara(a,b,m_bQuiet)
   // check range of parameters
   xConfirmPara( m_iFrameRate <= 0,                                                          "Frame rate must be more than 1" );
   xConfirmPara( m_iFrameSkip < 0,                                                           "Frame Skipping must be more than 0" );
+  xConfirmPara( m_uiInputBitDepth  < 8 || m_uiInputBitDepth  > 15,                          "Input bit-depth must be in the range of 8 to 15" );
+  xConfirmPara( m_uiOutputBitDepth < 8 || m_uiOutputBitDepth > 15,                          "Output bit-depth must be in the range of 8 to 15" );
   xConfirmPara( m_iFrameToBeEncoded <= 0,                                                   "Total Number Of Frames encoded must be more than 1" );
   xConfirmPara( m_iGOPSize < 1 ,                                                            "GOP Size must be more than 1" );
   xConfirmPara( m_iGOPSize > 1 &&  m_iGOPSize % 2,                                          "GOP Size must be a multiple of 2, if GOP Size is greater than 1" );
@@ -369,6 +438,15 @@ Void TAppEncCfg::xCheckParameter()
   xConfirmPara( m_iLoopFilterBetaOffset < -26 || m_iLoopFilterBetaOffset > 26,              "Loop Filter Beta Offset exceeds supported range (-26 to 26)");
   xConfirmPara( m_iFastSearch < 0 || m_iFastSearch > 2,                                     "Fast Search Mode is not supported value (0:Full search  1:Diamond  2:PMVFAST)" );
   xConfirmPara( m_iSearchRange < 0 ,                                                        "Search Range must be more than 0" );
+  xConfirmPara( m_iSceneCutThreshold < 0 || m_iSceneCutThreshold > 100,                     "SceneCutThreshold must be in the range of 0 to 100" );
+  xConfirmPara( m_iMotionGOPThreshold < 0,                                                  "MotionGOPThreshold must be 0 or more" );
+  xConfirmPara( m_bUseRateCtrl && m_iTargetBitrate <= 0,                                    "TargetBitrate must be more than 0 with rate control" );
+  xConfirmPara( m_bUseRateCtrl && m_uiDeltaQpRD > 0,                                        "DeltaQpRD is not supported with rate control" );
+  xConfirmPara( m_iVBVBufferSize < 0,                                                       "VBVBufferSize must be 0 or more" );
+  xConfirmPara( m_iTwoPass < 0 || m_iTwoPass > 2,                                           "TwoPass must be 0, 1 or 2" );
+  xConfirmPara( m_iTwoPass && m_pchStatsFile == NULL,                                       "StatsFile must be given for two-pass encoding" );
+  xConfirmPara( m_iTwoPass && m_bUseRateCtrl,                                               "Two-pass encoding and rate control cannot be combined" );
+  xConfirmPara( m_iTwoPass == 2 && m_iTargetBitrate <= 0,                                   "TargetBitrate must be more than 0 for the second pass" );
   xConfirmPara( m_iMaxDeltaQP > 7,                                                          "Absolute Delta QP exceeds supported range (0 to 7)" );
   xConfirmPara( m_iFrameToBeEncoded != 1 && m_iFrameToBeEncoded <= m_iGOPSize,              "Total Number of Frames to be encoded must be larger than GOP size");
   xConfirmPara( (m_uiMaxCUWidth  >> m_uiMaxCUDepth) < 4,                                    "Minimum partition width size should be larger than or equal to 4");
@@ -465,9 +543,138 @@ Void TAppEncCfg::xCheckParameter()
 #endif //EDGE_BASED_PREDICTION
 
 #undef xConfirmPara
-  if (check_failed) {
-    exit(EXIT_FAILURE);
-  }
+  return !check_failed;
+}
+
+/** \param pcTEncCfg  configuration of the encoder library
+ */
+Void TAppEncCfg::xInitLibCfg( TEncCfg* pcTEncCfg )
+{
+  pcTEncCfg->setFrameRate                    ( m_iFrameRate );
+  pcTEncCfg->setFrameSkip                    ( m_iFrameSkip );
+  pcTEncCfg->setSourceWidth                  ( m_iSourceWidth );
+  pcTEncCfg->setSourceHeight                 ( m_iSourceHeight );
+  pcTEncCfg->setFrameToBeEncoded             ( m_iFrameToBeEncoded );
+  pcTEncCfg->setQuiet                        ( m_bQuiet );
+
+  //====== Coding Structure ========
+  pcTEncCfg->setIntraPeriod                  ( m_iIntraPeriod );
+  pcTEncCfg->setGOPSize                      ( m_iGOPSize );
+  pcTEncCfg->setRateGOPSize                  ( m_iRateGOPSize );
+  pcTEncCfg->setNumOfReference               ( m_iNumOfReference );
+  pcTEncCfg->setNumOfReferenceB_L0           ( m_iNumOfReferenceB_L0 );
+  pcTEncCfg->setNumOfReferenceB_L1           ( m_iNumOfReferenceB_L1 );
+  pcTEncCfg->setUseLookahead                 ( m_bUseLookahead );
+  pcTEncCfg->setSceneCutThreshold            ( m_iSceneCutThreshold );
+  pcTEncCfg->setMotionGOPThreshold           ( m_iMotionGOPThreshold );
+
+  pcTEncCfg->setQP                           ( m_iQP );
+
+  pcTEncCfg->setTemporalLayerQPOffset        ( m_aiTLayerQPOffset );
+  pcTEncCfg->setPad                          ( m_aiPad );
+
+  pcTEncCfg->setMinTrDepth                   ( m_uiMinTrDepth );
+  pcTEncCfg->setMaxTrDepth                   ( m_uiMaxTrDepth );
+
+  //===== Slice ========
+  pcTEncCfg->setHierarchicalCoding           ( m_bHierarchicalCoding );
+
+  //====== Entropy Coding ========
+  pcTEncCfg->setSymbolMode                   ( m_iSymbolMode );
+  pcTEncCfg->setMCWThreshold                 ( m_uiMCWThreshold );
+  pcTEncCfg->setMaxPIPEDelay                 ( m_uiMaxPIPEDelay );
+  pcTEncCfg->setBalancedCPUs                 ( m_uiBalancedCPUs );
+
+  //====== Loop/Deblock Filter ========
+  pcTEncCfg->setLoopFilterDisable            ( m_bLoopFilterDisable       );
+  pcTEncCfg->setLoopFilterAlphaC0Offset      ( m_iLoopFilterAlphaC0Offset );
+  pcTEncCfg->setLoopFilterBetaOffset         ( m_iLoopFilterBetaOffset    );
+
+#if HHI_ALF
+  pcTEncCfg->setALFSeparateQt                ( m_bALFUseSeparateQT        ); //MS
+  pcTEncCfg->setALFSymmetry                  ( m_bALFFilterSymmetry       ); //MS
+  pcTEncCfg->setALFMinLength                 ( m_iAlfMinLength            ); //MS
+  pcTEncCfg->setALFMaxLength                 ( m_iAlfMaxLength            ); //MS
+#endif
+
+  //====== Motion search ========
+  pcTEncCfg->setFastSearch                   ( m_iFastSearch  );
+  pcTEncCfg->setSearchRange                  ( m_iSearchRange );
+  pcTEncCfg->setMaxDeltaQP                   ( m_iMaxDeltaQP  );
+
+  //====== Rate control ========
+  pcTEncCfg->setUseRateCtrl                  ( m_bUseRateCtrl    );
+  pcTEncCfg->setTargetBitrate                ( m_iTargetBitrate  );
+  pcTEncCfg->setVBVBufferSize                ( m_iVBVBufferSize  );
+  pcTEncCfg->setUseLCURateCtrl               ( m_bUseLCURateCtrl );
+  pcTEncCfg->setTwoPass                      ( m_iTwoPass        );
+  pcTEncCfg->setStatsFile                    ( m_pchStatsFile    );
+#if SAMSUNG_CHROMA_IF_EXT
+  pcTEncCfg->setDIFTapC                      ( m_iDIFTapC     );
+#endif
+
+  //====== Tool list ========
+  pcTEncCfg->setGRefMode                     ( m_pchGRefMode  );
+  pcTEncCfg->setUseSBACRD                    ( m_bUseSBACRD   );
+  pcTEncCfg->setDeltaQpRD                    ( m_uiDeltaQpRD  );
+  pcTEncCfg->setUseASR                       ( m_bUseASR      );
+  pcTEncCfg->setUseHADME                     ( m_bUseHADME    );
+  pcTEncCfg->setUseALF                       ( m_bUseALF      );
+  pcTEncCfg->setUseGPB                       ( m_bUseGPB      );
+  pcTEncCfg->setdQPs                         ( m_aidQP        );
+  pcTEncCfg->setUseRDOQ                      ( m_bUseRDOQ     );
+  pcTEncCfg->setUseFastRDOQ                  ( m_bUseFastRDOQ );
+  pcTEncCfg->setUseFastRDOQFinal             ( m_bUseFastRDOQFinal );
+  pcTEncCfg->setUseLDC                       ( m_bUseLDC      );
+  pcTEncCfg->setUsePAD                       ( m_bUsePAD      );
+#if HHI_RQT
+  pcTEncCfg->setQuadtreeTUFlag               ( m_bQuadtreeTUFlag );
+  pcTEncCfg->setQuadtreeTULog2MaxSize        ( m_uiQuadtreeTULog2MaxSize );
+  pcTEncCfg->setQuadtreeTULog2MinSize        ( m_uiQuadtreeTULog2MinSize );
+#if HHI_RQT_DEPTH
+  pcTEncCfg->setQuadtreeTUMaxDepth           ( m_uiQuadtreeTUMaxDepth );
+#endif
+#endif
+  pcTEncCfg->setMaxTrSize                    ( m_uiMaxTrSize  );
+  pcTEncCfg->setUseQBO                       ( m_bUseQBO      );
+  pcTEncCfg->setUseNRF                       ( m_bUseNRF      );
+  pcTEncCfg->setUseBQP                       ( m_bUseBQP      );
+  pcTEncCfg->setDIFTap                       ( m_iDIFTap      );
+  pcTEncCfg->setUseFastEnc                   ( m_bUseFastEnc  );
+#ifdef EDGE_BASED_PREDICTION
+  pcTEncCfg->setEdgePredictionEnable         ( m_bEdgePredictionEnable );
+  pcTEncCfg->setEdgeDetectionThreshold       ( m_iEdgeDetectionThreshold );
+#endif //EDGE_BASED_PREDICTION
+#if HHI_ALLOW_CIP_SWITCH
+	pcTEncCfg->setUseCIP                       ( m_bUseCIP      );
+#endif
+	pcTEncCfg->setUseROT                       ( m_bUseROT			);
+#if HHI_AIS
+  pcTEncCfg->setUseAIS                       ( m_bUseAIS      ); // BB:
+#endif
+#if HHI_MRG
+  pcTEncCfg->setUseMRG                       ( m_bUseMRG      ); // SOPH:
+#endif
+#if HHI_IMVP
+  pcTEncCfg->setUseIMP                       ( m_bUseIMP      ); // SOPH:
+#endif
+#if HHI_INTERP_FILTER
+  pcTEncCfg->setInterpFilterType             ( m_iInterpFilterType );
+#endif
+#ifdef QC_AMVRES
+    pcTEncCfg->setUseAMVRes                      ( m_bUseAMVRes      );
+#endif
+#ifdef QC_SIFO_PRED
+    pcTEncCfg->setUseSIFO_Pred                ( m_bUseSIFO_Pred );
+#endif
+#ifdef DCM_PBIC 
+  pcTEncCfg->setUseIC                        ( m_bUseIC       );
+#endif
+    pcTEncCfg->setUseAMP                      ( m_bUseAMP );
+#if HHI_RMP_SWITCH
+    pcTEncCfg->setUseRMP                     ( m_bUseRMP );
+#endif
+
 }
 
 /** \todo use of global variables should be removed later
@@ -516,6 +723,10 @@ Void TAppEncCfg::xPrintParameter()
   printf("Input          File          : %s\n", m_pchInputFile          );
   printf("Bitstream      File          : %s\n", m_pchBitstreamFile      );
   printf("Reconstruction File          : %s\n", m_pchReconFile          );
+  if ( m_pchRAIndexFile )
+  {
+    printf("Random access index File     : %s\n", m_pchRAIndexFile        );
+  }
   printf("Real     Format              : %dx%d %dHz\n", m_iSourceWidth - m_aiPad[0], m_iSourceHeight-m_aiPad[1], m_iFrameRate );
   printf("Internal Format              : %dx%d %dHz\n", m_iSourceWidth, m_iSourceHeight, m_iFrameRate );
   printf("Frame index                  : %d - %d (%d frames)\n", m_iFrameSkip, m_iFrameSkip+m_iFrameToBeEncoded-1, m_iFrameToBeEncoded );
@@ -533,8 +744,21 @@ Void TAppEncCfg::xPrintParameter()
   printf("QP                           : %5.2f\n", m_fQP );
   printf("GOP size                     : %d\n", m_iGOPSize );
   printf("Rate GOP size                : %d\n", m_iRateGOPSize );
+  if ( m_bUseRateCtrl )
+  {
+    printf("Rate control                 : %d bps, VBV %d bits, %s level\n", m_iTargetBitrate, m_iVBVBufferSize, m_bUseLCURateCtrl ? "LCU" : "picture" );
+  }
+  if ( m_iTwoPass )
+  {
+    printf("Two-pass encoding            : pass %d, %s%s\n", m_iTwoPass, m_pchStatsFile, m_iTwoPass == 1 ? " (fast first pass)" : "" );
+  }
+  if ( m_bUseLookahead )
+  {
+    printf("Lookahead                    : scene-cut %d%%, motion GOP %d\n", m_iSceneCutThreshold, m_iMotionGOPThreshold );
+  }
   printf("Max physical trans. size     : %d\n", m_uiMaxTrSize );
   printf("Bit increment                : %d\n", m_uiBitIncrement );
+  printf("File bit-depth (in / out)    : %d / %d\n", m_uiInputBitDepth, m_uiOutputBitDepth );
 
 #if HHI_INTERP_FILTER
   switch ( m_iInterpFilterType )
@@ -632,6 +856,8 @@ Void TAppEncCfg::xPrintParameter()
   printf("HAD:%d ", m_bUseHADME           );
   printf("SRD:%d ", m_bUseSBACRD          );
   printf("RDQ:%d ", m_bUseRDOQ            );
+  printf("FRQ:%d ", m_bUseFastRDOQ        );
+  printf("FRF:%d ", m_bUseFastRDOQFinal   );
   printf("SQP:%d ", m_uiDeltaQpRD         );
   printf("ASR:%d ", m_bUseASR             );
   printf("PAD:%d ", m_bUsePAD             );
@@ -719,12 +945,13 @@ Void TAppEncCfg::xPrintUsage()
   printf("              -> QP 32, IPPP with hierarchical-B of GOP 4 style QP, 9 frames, 64x64-8x8 CU (~4x4 PU)\n\n");
 }
 
-Bool confirmPara(Bool bflag, const char* message)
+Bool confirmPara(Bool bflag, const char* message, Bool bQuiet)
 {
   if (!bflag)
     return false;
 
-  printf("Error: %s\n",message);
+  if (!bQuiet)
+    printf("Error: %s\n",message);
   return true;
 }
 
@@ -37,6 +37,7 @@
 #define __TAPPENCCFG__
 
 #include "../../Lib/TLibCommon/CommonDef.h"
+#include "../../Lib/TLibEncoder/TEncCfg.h"
 
 // ====================================================================================================================
 // Class definition
@@ -50,6 +51,8 @@ protected:
   char*     m_pchInputFile;                                   ///< source file name
   char*     m_pchBitstreamFile;                               ///< output bitstream file
   char*     m_pchReconFile;                                   ///< output reconstruction file
+  char*     m_pchRAIndexFile;                                 ///< output random access index file
+  Bool      m_bQuiet;                                         ///< no messages on stdout, set by the library interface
 
   // source specification
   Int       m_iFrameRate;                                     ///< source frame-rates (Hz)
@@ -72,6 +75,9 @@ protected:
   Bool      m_bUseNRF;                                        ///< flag for using non-referenced frame in hierarchical structure
   Bool      m_bUseGPB;                                        ///< flag for using generalized P & B structure
   Bool      m_bUseQBO;                                        ///< flag for using quality-based reference ordering for skip mode
+  Bool      m_bUseLookahead;                                  ///< flag for using scene-cut and motion analysis of the input pictures
+  Int       m_iSceneCutThreshold;                             ///< min. saving in % of prediction from the previous picture
+  Int       m_iMotionGOPThreshold;                            ///< mean motion in samples which halves the GOP
 #ifdef QC_AMVRES
 	Bool      m_bUseAMVRes;
 #endif
@@ -87,6 +93,14 @@ protected:
   Int       m_iMaxDeltaQP;                                    ///< max. |delta QP|
   UInt      m_uiDeltaQpRD;                                    ///< dQP range for multi-pass slice QP optimization
 
+  // rate control
+  Bool      m_bUseRateCtrl;                                   ///< flag for using rate control instead of constant QP
+  Int       m_iTargetBitrate;                                 ///< target bitrate in bits per second
+  Int       m_iVBVBufferSize;                                 ///< VBV buffer size in bits, 0 if unconstrained
+  Bool      m_bUseLCURateCtrl;                                ///< flag for using LCU level rate control
+  Int       m_iTwoPass;                                       ///< two-pass encoding, 0: off, 1: first pass, 2: second pass
+  char*     m_pchStatsFile;                                   ///< two-pass statistics file
+
   // coding unit (CU) definition
   UInt      m_uiMaxCUWidth;                                   ///< max. CU width in pixel
   UInt      m_uiMaxCUHeight;                                  ///< max. CU height in pixel
@@ -108,6 +122,8 @@ protected:
   // coding tools (bit-depth)
   UInt      m_uiBitDepth;                                     ///< base bit-depth
   UInt      m_uiBitIncrement;                                 ///< bit-depth increment
+  UInt      m_uiInputBitDepth;                                ///< bit-depth of the input file (0: base bit-depth)
+  UInt      m_uiOutputBitDepth;                               ///< bit-depth of the reconstruction file (0: base bit-depth)
 
   // coding tools (inter - motion)
   char*     m_pchGRefMode;                                    ///< array of generated reference modes
@@ -171,6 +187,8 @@ protected:
   Bool      m_bUseASR;                                        ///< flag for using adaptive motion search range
   Bool      m_bUseHADME;                                      ///< flag for using HAD in sub-pel ME
   Bool      m_bUseRDOQ;                                       ///< flag for using RD optimized quantization
+  Bool      m_bUseFastRDOQ;                                   ///< flag for using fast RDOQ during mode decision
+  Bool      m_bUseFastRDOQFinal;                              ///< flag for using fast RDOQ when coding the selected mode
   Bool      m_bUseBQP;                                        ///< flag for using B-slice based QP assignment in low-delay hier. structure
   Int       m_iFastSearch;                                    ///< ME mode, 0 = full, 1 = diamond, 2 = PMVFAST
   Int       m_iSearchRange;                                   ///< ME search range
@@ -188,9 +206,10 @@ protected:
 
   // internal member functions
   Void  xSetGlobal      ();                                   ///< set global variables
-  Void  xCheckParameter ();                                   ///< check validity of configuration values
+  Bool  xCheckParameter ();                                   ///< check validity of configuration values
   Void  xPrintParameter ();                                   ///< print configuration values
   Void  xPrintUsage     ();                                   ///< print usage
+  Void  xInitLibCfg     ( TEncCfg* pcTEncCfg );               ///< set the configuration values of the encoder library
 
 public:
   TAppEncCfg();
@@ -200,6 +219,7 @@ public:
   Void  create    ();                                         ///< create option handling class
   Void  destroy   ();                                         ///< destroy option handling class
   Bool  parseCfg  ( Int argc, Char* argv[] );                 ///< parse configuration file to fill member variables
+  Bool  writesStdout ();                                      ///< true if an output file name is "-"
 
 };// END CLASS DEFINITION TAppEncCfg
 
@@ -37,9 +37,33 @@
 #include <stdio.h>
 #include <fcntl.h>
 #include <assert.h>
+#include <time.h>
+#ifdef _WIN32
+#include <sys/timeb.h>
+#else
+#include <sys/time.h>
+#endif
 
 #include "TAppEncTop.h"
 
+// ====================================================================================================================
+// Local functions
+// ====================================================================================================================
+
+/// wall-clock time in seconds
+static Double xGetWallTime()
+{
+#ifdef _WIN32
+  struct _timeb sTime;
+  _ftime( &sTime );
+  return (Double)sTime.time + sTime.millitm * 0.001;
+#else
+  struct timeval sTime;
+  gettimeofday( &sTime, NULL );
+  return (Double)sTime.tv_sec + sTime.tv_usec * 0.000001;
+#endif
+}
+
 // ====================================================================================================================
 // Constructor / destructor / initialization / destroy
 // ====================================================================================================================
@@ -47,136 +71,27 @@
 TAppEncTop::TAppEncTop()
 {
   m_iFrameRcvd = 0;
+  m_dStartupTime = 0;
+  m_dLaunchTime = xGetWallTime();
 }
 
 TAppEncTop::~TAppEncTop()
 {
 }
 
-Void TAppEncTop::xInitLibCfg()
-{
-  m_cTEncTop.setFrameRate                    ( m_iFrameRate );
-  m_cTEncTop.setFrameSkip                    ( m_iFrameSkip );
-  m_cTEncTop.setSourceWidth                  ( m_iSourceWidth );
-  m_cTEncTop.setSourceHeight                 ( m_iSourceHeight );
-  m_cTEncTop.setFrameToBeEncoded             ( m_iFrameToBeEncoded );
-
-  //====== Coding Structure ========
-  m_cTEncTop.setIntraPeriod                  ( m_iIntraPeriod );
-  m_cTEncTop.setGOPSize                      ( m_iGOPSize );
-  m_cTEncTop.setRateGOPSize                  ( m_iRateGOPSize );
-  m_cTEncTop.setNumOfReference               ( m_iNumOfReference );
-  m_cTEncTop.setNumOfReferenceB_L0           ( m_iNumOfReferenceB_L0 );
-  m_cTEncTop.setNumOfReferenceB_L1           ( m_iNumOfReferenceB_L1 );
-
-  m_cTEncTop.setQP                           ( m_iQP );
-
-  m_cTEncTop.setTemporalLayerQPOffset        ( m_aiTLayerQPOffset );
-  m_cTEncTop.setPad                          ( m_aiPad );
-
-  m_cTEncTop.setMinTrDepth                   ( m_uiMinTrDepth );
-  m_cTEncTop.setMaxTrDepth                   ( m_uiMaxTrDepth );
-
-  //===== Slice ========
-  m_cTEncTop.setHierarchicalCoding           ( m_bHierarchicalCoding );
-
-  //====== Entropy Coding ========
-  m_cTEncTop.setSymbolMode                   ( m_iSymbolMode );
-  m_cTEncTop.setMCWThreshold                 ( m_uiMCWThreshold );
-  m_cTEncTop.setMaxPIPEDelay                 ( m_uiMaxPIPEDelay );
-  m_cTEncTop.setBalancedCPUs                 ( m_uiBalancedCPUs );
-
-  //====== Loop/Deblock Filter ========
-  m_cTEncTop.setLoopFilterDisable            ( m_bLoopFilterDisable       );
-  m_cTEncTop.setLoopFilterAlphaC0Offset      ( m_iLoopFilterAlphaC0Offset );
-  m_cTEncTop.setLoopFilterBetaOffset         ( m_iLoopFilterBetaOffset    );
-
-#if HHI_ALF
-  m_cTEncTop.setALFSeparateQt                ( m_bALFUseSeparateQT        ); //MS
-  m_cTEncTop.setALFSymmetry                  ( m_bALFFilterSymmetry       ); //MS
-  m_cTEncTop.setALFMinLength                 ( m_iAlfMinLength            ); //MS
-  m_cTEncTop.setALFMaxLength                 ( m_iAlfMaxLength            ); //MS
-#endif
-
-  //====== Motion search ========
-  m_cTEncTop.setFastSearch                   ( m_iFastSearch  );
-  m_cTEncTop.setSearchRange                  ( m_iSearchRange );
-  m_cTEncTop.setMaxDeltaQP                   ( m_iMaxDeltaQP  );
-#if SAMSUNG_CHROMA_IF_EXT
-  m_cTEncTop.setDIFTapC                      ( m_iDIFTapC     );
-#endif
-
-  //====== Tool list ========
-  m_cTEncTop.setGRefMode                     ( m_pchGRefMode  );
-  m_cTEncTop.setUseSBACRD                    ( m_bUseSBACRD   );
-  m_cTEncTop.setDeltaQpRD                    ( m_uiDeltaQpRD  );
-  m_cTEncTop.setUseASR                       ( m_bUseASR      );
-  m_cTEncTop.setUseHADME                     ( m_bUseHADME    );
-  m_cTEncTop.setUseALF                       ( m_bUseALF      );
-  m_cTEncTop.setUseGPB                       ( m_bUseGPB      );
-  m_cTEncTop.setdQPs                         ( m_aidQP        );
-  m_cTEncTop.setUseRDOQ                      ( m_bUseRDOQ     );
-  m_cTEncTop.setUseLDC                       ( m_bUseLDC      );
-  m_cTEncTop.setUsePAD                       ( m_bUsePAD      );
-#if HHI_RQT
-  m_cTEncTop.setQuadtreeTUFlag               ( m_bQuadtreeTUFlag );
-  m_cTEncTop.setQuadtreeTULog2MaxSize        ( m_uiQuadtreeTULog2MaxSize );
-  m_cTEncTop.setQuadtreeTULog2MinSize        ( m_uiQuadtreeTULog2MinSize );
-#if HHI_RQT_DEPTH
-  m_cTEncTop.setQuadtreeTUMaxDepth           ( m_uiQuadtreeTUMaxDepth );
-#endif
-#endif
-  m_cTEncTop.setMaxTrSize                    ( m_uiMaxTrSize  );
-  m_cTEncTop.setUseQBO                       ( m_bUseQBO      );
-  m_cTEncTop.setUseNRF                       ( m_bUseNRF      );
-  m_cTEncTop.setUseBQP                       ( m_bUseBQP      );
-  m_cTEncTop.setDIFTap                       ( m_iDIFTap      );
-  m_cTEncTop.setUseFastEnc                   ( m_bUseFastEnc  );
-#ifdef EDGE_BASED_PREDICTION
-  m_cTEncTop.setEdgePredictionEnable         ( m_bEdgePredictionEnable );
-  m_cTEncTop.setEdgeDetectionThreshold       ( m_iEdgeDetectionThreshold );
-#endif //EDGE_BASED_PREDICTION
-#if HHI_ALLOW_CIP_SWITCH
-	m_cTEncTop.setUseCIP                       ( m_bUseCIP      );
-#endif
-	m_cTEncTop.setUseROT                       ( m_bUseROT			);
-#if HHI_AIS
-  m_cTEncTop.setUseAIS                       ( m_bUseAIS      ); // BB:
-#endif
-#if HHI_MRG
-  m_cTEncTop.setUseMRG                       ( m_bUseMRG      ); // SOPH:
-#endif
-#if HHI_IMVP
-  m_cTEncTop.setUseIMP                       ( m_bUseIMP      ); // SOPH:
-#endif
-#if HHI_INTERP_FILTER
-  m_cTEncTop.setInterpFilterType             ( m_iInterpFilterType );
-#endif
-#ifdef QC_AMVRES
-    m_cTEncTop.setUseAMVRes                      ( m_bUseAMVRes      );
-#endif
-#ifdef QC_SIFO_PRED
-    m_cTEncTop.setUseSIFO_Pred                ( m_bUseSIFO_Pred );
-#endif
-#ifdef DCM_PBIC 
-  m_cTEncTop.setUseIC                        ( m_bUseIC       );
-#endif
-    m_cTEncTop.setUseAMP                      ( m_bUseAMP );
-#if HHI_RMP_SWITCH
-    m_cTEncTop.setUseRMP                     ( m_bUseRMP );
-#endif
-
-}
-
 Void TAppEncTop::xCreateLib()
 {
   // Video I/O
-  m_cTVideoIOYuvInputFile.open( m_pchInputFile,     false );  // read  mode
-  m_cTVideoIOYuvReconFile.open( m_pchReconFile,     true  );  // write mode
+  m_cTVideoIOYuvInputFile.open( m_pchInputFile,     false, m_uiInputBitDepth,  m_uiBitDepth );  // read  mode
+  m_cTVideoIOYuvReconFile.open( m_pchReconFile,            m_uiOutputBitDepth, m_uiBitDepth, Max( m_iGOPSize, 1 ) );  // write mode
   m_cTVideoIOBitsFile.openBits( m_pchBitstreamFile, true  );  // write mode
 
   // Neo Decoder
-  m_cTEncTop.create();
+  if ( !m_cTEncTop.create() )
+  {
+    printf( m_iTwoPass == 1 ? "\nfailed to write two-pass statistics file\n" : "\nfailed to open two-pass statistics file\n" );
+    exit(0);
+  }
 }
 
 Void TAppEncTop::xDestroyLib()
@@ -186,6 +101,11 @@ Void TAppEncTop::xDestroyLib()
   m_cTVideoIOYuvReconFile.close();
   m_cTVideoIOBitsFile.closeBits();
 
+  if ( m_pchRAIndexFile )
+  {
+    xWriteRAIndex();
+  }
+
   // Neo Decoder
   m_cTEncTop.destroy();
 }
@@ -213,8 +133,11 @@ Void TAppEncTop::encode()
   TComPicYuv*       pcPicYuvRec = NULL;
   TComBitstream*    pcBitstream = NULL;
 
+  // print-out parameters
+  xPrintParameter();
+
   // initialize internal class & member variables
-  xInitLibCfg();
+  xInitLibCfg( &m_cTEncTop );
   xCreateLib();
   xInitLib();
 
@@ -240,6 +163,11 @@ Void TAppEncTop::encode()
     bEos = ( m_cTVideoIOYuvInputFile.isEof() == 1 ?   true : false  );
     bEos = ( m_iFrameRcvd == m_iFrameToBeEncoded ?    true : bEos   );
 
+    if ( m_iFrameRcvd == 1 )
+    {
+      m_dStartupTime = xGetWallTime() - m_dLaunchTime;
+    }
+
     // call encoding function for one frame
     m_cTEncTop.encode( bEos, pcPicYuvOrg, m_cListPicYuvRec, m_cListBitstream, iNumEncoded );
 
@@ -260,6 +188,9 @@ Void TAppEncTop::encode()
   // delete used buffers in encoder class
   m_cTEncTop.deletePicBuffer();
 
+  // the reconstruction buffers may still be queued for output
+  m_cTVideoIOYuvReconFile.flush();
+
   // delete buffers & classes
   xDeleteBuffer();
   xDestroyLib();
@@ -272,43 +203,26 @@ Void TAppEncTop::encode()
 // ====================================================================================================================
 
 /**
-    - application has picture buffer list with size of GOP
+    - application has picture buffer list with size of two GOPs
     - picture buffer list acts as ring buffer
     - end of the list has the latest picture
     .
  */
 Void TAppEncTop::xGetBuffer( TComPicYuv*& rpcPicYuvRec, TComBitstream*& rpcBitStream )
 {
-  if ( m_iGOPSize == 0 )
-  {
-    if (m_cListPicYuvRec.size() == 0)
-    {
-      rpcPicYuvRec = new TComPicYuv;
-      rpcBitStream = new TComBitstream;
-
-      rpcPicYuvRec->create( m_iSourceWidth, m_iSourceHeight, m_uiMaxCUWidth, m_uiMaxCUHeight, m_uiMaxCUDepth );
-      rpcBitStream->create( (m_iSourceWidth * m_iSourceHeight * 3) >> 1 );
-
-      m_cListPicYuvRec.pushBack( rpcPicYuvRec );
-      m_cListBitstream.pushBack( rpcBitStream );
-    }
-
-    rpcPicYuvRec = m_cListPicYuvRec.popFront();
-    rpcBitStream = m_cListBitstream.popFront();
-
-    m_cListPicYuvRec.pushBack( rpcPicYuvRec );
-    m_cListBitstream.pushBack( rpcBitStream );
-
-    return;
-  }
+  // one GOP is written by the output thread while the next one is encoded
+  UInt uiNumBuffers = 2 * Max( m_iGOPSize, 1 );
 
   // org. buffer
-  if ( m_cListPicYuvRec.size() == (UInt)m_iGOPSize )
+  if ( m_cListPicYuvRec.size() == uiNumBuffers )
   {
     rpcPicYuvRec = m_cListPicYuvRec.popFront();
     rpcBitStream = m_cListBitstream.popFront();
 
     rpcBitStream->rewindStreamPacket();
+
+    // the oldest reconstruction may still be queued for output
+    m_cTVideoIOYuvReconFile.waitRelease( rpcPicYuvRec );
   }
   else
   {
@@ -362,8 +276,62 @@ Void TAppEncTop::xWriteOutput( Int iNumEncoded )
     TComPicYuv*  pcPicYuvRec  = *(iterPicYuvRec++);
     TComBitstream* pcBitstream = *(iterBitstream++);
 
+    if ( m_pchRAIndexFile )
+    {
+      TEncGOP* pcGOPEncoder = m_cTEncTop.getGOPEncoder();
+      xUpdateRAIndex( pcGOPEncoder->getCodedPOC( i ), pcGOPEncoder->getCodedMinRefPOC( i ), m_cTVideoIOBitsFile.getPosition() );
+    }
+
     m_cTVideoIOYuvReconFile.write( pcPicYuvRec, m_aiPad );
     m_cTVideoIOBitsFile.writeBits( pcBitstream );
   }
 }
 
+/** Intra pictures are random access points unless a later picture, which follows them in display order,
+    references a picture before them. Pictures between the intra picture and such a reference could not be decoded.
+    \param iPOC        POC of the coded picture, in coding order
+    \param iMinRefPOC  lowest POC referenced by the picture, iPOC for intra pictures
+    \param iPosition   bitstream position of the picture
+ */
+Void TAppEncTop::xUpdateRAIndex( Int iPOC, Int iMinRefPOC, Int64 iPosition )
+{
+  for ( UInt ui = 0; ui < m_cRAPoints.size(); ui++ )
+  {
+    if ( iPOC > m_cRAPoints[ui].iPOC && iMinRefPOC < m_cRAPoints[ui].iPOC )
+    {
+      m_cRAPoints[ui].bClean = false;
+    }
+  }
+
+  if ( iMinRefPOC == iPOC )
+  {
+    RAPoint cPoint;
+    cPoint.iPOC      = iPOC;
+    cPoint.iPosition = iPosition;
+    cPoint.bClean    = true;
+    m_cRAPoints.push_back( cPoint );
+  }
+}
+
+/** one line per random access point in coding order, "POC position"
+ */
+Void TAppEncTop::xWriteRAIndex()
+{
+  FILE* fp = fopen( m_pchRAIndexFile, "w" );
+  if ( fp == NULL )
+  {
+    printf("\nfailed to write random access index file\n");
+    return;
+  }
+
+  fprintf( fp, "# POC bitstream-position\n" );
+  for ( UInt ui = 0; ui < m_cRAPoints.size(); ui++ )
+  {
+    if ( m_cRAPoints[ui].bClean )
+    {
+      fprintf( fp, "%d %lld\n", m_cRAPoints[ui].iPOC, (long long)m_cRAPoints[ui].iPosition );
+    }
+  }
+  fclose( fp );
+}
+
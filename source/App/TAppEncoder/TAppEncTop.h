@@ -36,6 +36,7 @@
 #ifndef __TAPPENCTOP__
 #define __TAPPENCTOP__
 
+#include <vector>
 #include "../../Lib/TLibEncoder/TEncTop.h"
 #include "../../Lib/TLibVideoIO/TVideoIOYuv.h"
 #include "../../Lib/TLibVideoIO/TVideoIOBits.h"
@@ -53,22 +54,32 @@ private:
   // class interface
   TEncTop                    m_cTEncTop;                    ///< encoder class
   TVideoIOYuv                m_cTVideoIOYuvInputFile;       ///< input YUV file
-  TVideoIOYuv                m_cTVideoIOYuvReconFile;       ///< output reconstruction file
+  TVideoIOYuvWriter          m_cTVideoIOYuvReconFile;       ///< output reconstruction file, written by a separate thread
 #if HHI_NAL_UNIT_SYNTAX
   TVideoIOBitsStartCode      m_cTVideoIOBitsFile;           ///< output bitstream file
 #else
   TVideoIOBits               m_cTVideoIOBitsFile;           ///< output bitstream file
 #endif
 
-  TComList<TComPicYuv*>      m_cListPicYuvRec;              ///< list of reconstruction YUV files
+  TComList<TComPicYuv*>      m_cListPicYuvRec;              ///< list of reconstruction YUV files, two GOPs
   TComList<TComBitstream*>   m_cListBitstream;              ///< list of bitstreams
 
   Int                        m_iFrameRcvd;                  ///< number of received frames
+  Double                     m_dLaunchTime;                 ///< wall-clock time at which the encoder application was constructed
+  Double                     m_dStartupTime;                ///< wall-clock time from launch until the first frame is encoded
+
+  /// random access point candidate, an intra picture with its bitstream position
+  struct RAPoint
+  {
+    Int   iPOC;
+    Int64 iPosition;
+    Bool  bClean;                                           ///< no later picture references across it
+  };
+  std::vector<RAPoint>       m_cRAPoints;                   ///< random access point candidates in coding order
 
 protected:
   // initialization
   Void  xCreateLib        ();                               ///< create files & encoder class
-  Void  xInitLibCfg       ();                               ///< initialize internal variables
   Void  xInitLib          ();                               ///< initialize encoder class
   Void  xDestroyLib       ();                               ///< destroy encoder class
 
@@ -81,6 +92,8 @@ protected:
 
   // file I/O
   Void  xWriteOutput      ( Int iNumEncoded );              ///< write bitstream to file
+  Void  xUpdateRAIndex    ( Int iPOC, Int iMinRefPOC, Int64 iPosition ); ///< track random access points
+  Void  xWriteRAIndex     ();                               ///< write random access index file
 
 public:
   TAppEncTop();
@@ -88,6 +101,7 @@ public:
 
   Void        encode      ();                               ///< main encoding function
   TEncTop&    getTEncTop  ()   { return  m_cTEncTop; }      ///< return encoder class pointer reference
+  Double      getStartupTime() { return  m_dStartupTime; }  ///< return startup time in seconds
 
 };// END CLASS DEFINITION TAppEncTop
 
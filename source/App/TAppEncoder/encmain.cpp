@@ -44,14 +44,6 @@ int main(int argc, char* argv[])
 {
   TAppEncTop  cTAppEncTop;
 
-  // print information
-  fprintf( stdout, "\n" );
-  fprintf( stdout, "TMuC SW candidate: Encoder Version [%s]", NV_VERSION );
-  fprintf( stdout, NVM_ONOS );
-  fprintf( stdout, NVM_COMPILEDBY );
-  fprintf( stdout, NVM_BITS );
-  fprintf( stdout, "\n" );
-
   // create application encoder class
   cTAppEncTop.create();
 
@@ -62,6 +54,20 @@ int main(int argc, char* argv[])
     return 1;
   }
 
+  // an output file of "-" is written to stdout, console output goes to stderr then
+  if ( cTAppEncTop.writesStdout() )
+  {
+    TVideoIOStream::reserveStdout();
+  }
+
+  // print information
+  fprintf( stdout, "\n" );
+  fprintf( stdout, "TMuC SW candidate: Encoder Version [%s]", NV_VERSION );
+  fprintf( stdout, NVM_ONOS );
+  fprintf( stdout, NVM_COMPILEDBY );
+  fprintf( stdout, NVM_BITS );
+  fprintf( stdout, "\n" );
+
   // starting time
   double dResult;
   long lBefore = clock();
@@ -72,6 +78,7 @@ int main(int argc, char* argv[])
   // ending time
   dResult = (double)(clock()-lBefore) / CLOCKS_PER_SEC;
   printf("\n Total Time: %12.3f sec.\n", dResult);
+  printf(" Startup Time: %10.3f sec. (wall clock)\n", cTAppEncTop.getStartupTime());
 
   // destroy application encoder class
   cTAppEncTop.destroy();
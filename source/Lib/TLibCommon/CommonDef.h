@@ -152,6 +152,8 @@
 #define GRF_MAX_NUM_EFF             2           ///< maximum number of effects
 #define GRF_MAX_NUM_WEFF            2           ///< maximum number of wp effects
 #define GRF_WP_CHROMA               1           ///< weighted prediction of chroma
+#define GRF_WP_MAX_BANDS            64          ///< maximum number of row bands weighted on demand
+#define GRF_WP_ROW_MARGIN           8           ///< extra rows around a block for the interpolation taps
 
 // ROT: rotational transform
 #define ROT_DICT                    5           ///< intra ROT dictionary size (1, 2, 4, 5, 9)
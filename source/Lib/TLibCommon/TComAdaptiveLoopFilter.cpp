@@ -1030,6 +1030,44 @@ Void TComAdaptiveLoopFilter:: error(const char *text, int code)
 }
 
 
+Void TComAlfArena::create( size_t uiSize )
+{
+  destroy();
+  if ( !( m_pucBuffer = (UChar*)calloc( uiSize + ALF_ARENA_ALIGN, 1 ) ) )
+    FATAL_ERROR_0("TComAlfArena::create: memory allocation problem\n", -1);
+  m_pucBase = m_pucBuffer + ( ( ALF_ARENA_ALIGN - ( (size_t)m_pucBuffer & ( ALF_ARENA_ALIGN - 1 ) ) ) & ( ALF_ARENA_ALIGN - 1 ) );
+  m_uiSize  = uiSize;
+  m_uiUsed  = 0;
+}
+
+Void TComAlfArena::destroy()
+{
+  if ( m_pucBuffer )
+  {
+    free( m_pucBuffer );
+  }
+  m_pucBuffer = NULL;
+  m_pucBase   = NULL;
+  m_uiSize    = 0;
+  m_uiUsed    = 0;
+}
+
+Void TComAlfArena::reset()
+{
+  memset( m_pucBase, 0, m_uiUsed );
+  m_uiUsed = 0;
+}
+
+Void* TComAlfArena::alloc( size_t uiSize )
+{
+  uiSize = xAlign( uiSize );
+  if ( m_uiUsed + uiSize > m_uiSize )
+    FATAL_ERROR_0("TComAlfArena::alloc: arena too small\n", -1);
+  Void* p = m_pucBase + m_uiUsed;
+  m_uiUsed += uiSize;
+  return p;
+}
+
 Void TComAdaptiveLoopFilter:: no_mem_exit(const char *where)
 {
    char errortext[200];
@@ -1267,18 +1305,29 @@ Void TComAdaptiveLoopFilter::create( Int iPicWidth, Int iPicHeight, UInt uiMaxCU
 #if QC_ALF
 	img_height = iPicHeight;
 	img_width = iPicWidth;
-	initMatrix_imgpel(&imgY_var, img_height, img_width); 
+
+  // all picture size arrays live in one arena, allocated here once and reused for every picture
+  size_t uiArenaSize = TComAlfArena::getMatrixSize<imgpel>( img_height, img_width )
+                     + TComAlfArena::getMatrixSize<Int>( img_height+2*VAR_SIZE+3, img_width+2*VAR_SIZE+3 )
+                     + 4 * TComAlfArena::getMatrixSize<Int>( NO_VAR_BINS, MAX_SQR_FILT_LENGTH );
 #if !ALF_MEM_PATCH
-	initMatrix_imgpel(&ImgDec, img_height, img_width); 
-	initMatrix_imgpel(&ImgRest, img_height, img_width); 
-    initMatrix_imgpel(&imgY_pad, img_height+2*(FILTER_LENGTH/2), img_width+2*(FILTER_LENGTH/2));
+  uiArenaSize += 2 * TComAlfArena::getMatrixSize<imgpel>( img_height, img_width )
+               + TComAlfArena::getMatrixSize<imgpel>( img_height+2*(FILTER_LENGTH/2), img_width+2*(FILTER_LENGTH/2) );
 #endif
-    initMatrix_int(&imgY_temp, img_height+2*VAR_SIZE+3, img_width+2*VAR_SIZE+3);
+  m_cArena.create( uiArenaSize );
 
-    initMatrix_int(&filterCoeffSym, NO_VAR_BINS, MAX_SQR_FILT_LENGTH);
-    initMatrix_int(&filterCoeffPrevSelected, NO_VAR_BINS, MAX_SQR_FILT_LENGTH); 
-	initMatrix_int(&filterCoeffTmp, NO_VAR_BINS, MAX_SQR_FILT_LENGTH);      
-	initMatrix_int(&filterCoeffSymTmp, NO_VAR_BINS, MAX_SQR_FILT_LENGTH);   
+	m_cArena.initMatrix(&imgY_var, img_height, img_width); 
+#if !ALF_MEM_PATCH
+	m_cArena.initMatrix(&ImgDec, img_height, img_width); 
+	m_cArena.initMatrix(&ImgRest, img_height, img_width); 
+    m_cArena.initMatrix(&imgY_pad, img_height+2*(FILTER_LENGTH/2), img_width+2*(FILTER_LENGTH/2));
+#endif
+    m_cArena.initMatrix(&imgY_temp, img_height+2*VAR_SIZE+3, img_width+2*VAR_SIZE+3);
+
+    m_cArena.initMatrix(&filterCoeffSym, NO_VAR_BINS, MAX_SQR_FILT_LENGTH);
+    m_cArena.initMatrix(&filterCoeffPrevSelected, NO_VAR_BINS, MAX_SQR_FILT_LENGTH); 
+	m_cArena.initMatrix(&filterCoeffTmp, NO_VAR_BINS, MAX_SQR_FILT_LENGTH);      
+	m_cArena.initMatrix(&filterCoeffSymTmp, NO_VAR_BINS, MAX_SQR_FILT_LENGTH);   
 #endif
 }
 
@@ -1290,19 +1339,7 @@ Void TComAdaptiveLoopFilter::destroy()
 		delete m_pcTempPicYuv;
 	}
 #if QC_ALF
-	destroyMatrix_imgpel(imgY_var); 
-#if !ALF_MEM_PATCH
-	destroyMatrix_imgpel(imgY_pad);
-	destroyMatrix_imgpel(ImgDec); 
-	destroyMatrix_imgpel(ImgRest);
-	destroyMatrix_int(imgY_temp);
-#endif
-
-	destroyMatrix_int(filterCoeffSym);
-	destroyMatrix_int(filterCoeffPrevSelected);
-	destroyMatrix_int(filterCoeffTmp);
-	destroyMatrix_int(filterCoeffSymTmp);
-
+	m_cArena.destroy();
 #endif
 }
 
@@ -92,6 +92,69 @@ extern Int depthInt5x5Sym[8];
 extern Int *pDepthIntTab[NO_TEST_FILT];
 void destroyMatrix_int(int **m2D);
 void initMatrix_int(int ***m2D, int d1, int d2);
+
+#define ALF_ARENA_ALIGN       16                                      ///< alignment of arrays carved from the ALF arena
+
+/// contiguous working storage for the ALF arrays, sized once for a picture size and reused for every picture
+class TComAlfArena
+{
+private:
+  UChar*  m_pucBuffer;                                                ///< allocated block
+  UChar*  m_pucBase;                                                  ///< aligned start of the arena
+  size_t  m_uiSize;                                                   ///< arena size in bytes
+  size_t  m_uiUsed;                                                   ///< bytes carved so far
+
+  static size_t xAlign( size_t uiSize ) { return ( uiSize + ALF_ARENA_ALIGN - 1 ) & ~(size_t)( ALF_ARENA_ALIGN - 1 ); }
+
+public:
+  TComAlfArena() : m_pucBuffer( NULL ), m_pucBase( NULL ), m_uiSize( 0 ), m_uiUsed( 0 ) {}
+  ~TComAlfArena() { destroy(); }
+
+  Void  create    ( size_t uiSize );                                  ///< allocate a zeroed arena of uiSize bytes
+  Void  destroy   ();
+  Void  reset     ();                                                 ///< zero the arena and carve again from its start
+  Bool  isCreated () { return m_pucBuffer != NULL; }
+  Void* alloc     ( size_t uiSize );                                  ///< carve uiSize bytes, aborts if the arena is too small
+
+  // arena bytes needed by the arrays below
+  template <typename T> static size_t getArraySize    ( Int d1 )                          { return xAlign( d1 * sizeof(T) ); }
+  template <typename T> static size_t getMatrixSize   ( Int d1, Int d2 )                  { return getArraySize<T*>( d1 ) + getArraySize<T>( d1 * d2 ); }
+  template <typename T> static size_t getMatrix3DSize ( Int d1, Int d2, Int d3 )          { return getArraySize<T**>( d1 ) + getMatrixSize<T>( d1 * d2, d3 ); }
+  template <typename T> static size_t getMatrix4DSize ( Int d1, Int d2, Int d3, Int d4 )  { return getArraySize<T***>( d1 ) + getMatrix3DSize<T>( d1 * d2, d3, d4 ); }
+
+  // arrays carved from the arena, the data of each array is one contiguous block
+  template <typename T> Void initArray( T** ppT, Int d1 )
+  {
+    *ppT = (T*)alloc( d1 * sizeof(T) );
+  }
+  template <typename T> Void initMatrix( T*** pppT, Int d1, Int d2 )
+  {
+    initArray( pppT, d1 );
+    initArray( *pppT, d1 * d2 );
+    for ( Int i = 1; i < d1; i++ )
+    {
+      (*pppT)[i] = (*pppT)[i-1] + d2;
+    }
+  }
+  template <typename T> Void initMatrix3D( T**** ppppT, Int d1, Int d2, Int d3 )
+  {
+    initArray( ppppT, d1 );
+    initMatrix( *ppppT, d1 * d2, d3 );
+    for ( Int i = 1; i < d1; i++ )
+    {
+      (*ppppT)[i] = (*ppppT)[i-1] + d2;
+    }
+  }
+  template <typename T> Void initMatrix4D( T***** pppppT, Int d1, Int d2, Int d3, Int d4 )
+  {
+    initArray( pppppT, d1 );
+    initMatrix3D( *pppppT, d1 * d2, d3, d4 );
+    for ( Int i = 1; i < d1; i++ )
+    {
+      (*pppppT)[i] = (*pppppT)[i-1] + d2;
+    }
+  }
+};
 #endif
 #endif
 
@@ -216,6 +279,8 @@ protected:
   Int **filterCoeffTmp;
   Int **filterCoeffSymTmp;
 
+  TComAlfArena m_cArena;                                              ///< storage of the picture size arrays above
+
 	/// ALF for luma component
   Void	xALFLuma_qc				( TComPic* pcPic, ALFParam* pcAlfParam, TComPicYuv* pcPicDec, TComPicYuv* pcPicRest );
   Void	xCUAdaptive_qc			( TComPic*	  pcPic, ALFParam* pcAlfParam, imgpel **imgY_rec_post, imgpel **imgY_rec );
@@ -103,6 +103,8 @@ TComDataCU::TComDataCU()
 #endif
 
   m_bDecSubCu          = false;
+  m_pucPartStorage     = NULL;
+  m_uiNumAllocPart     = 0;
 }
 
 TComDataCU::~TComDataCU()
@@ -119,56 +121,77 @@ Void TComDataCU::create(UInt uiNumPartition, UInt uiWidth, UInt uiHeight, Bool b
 
   if ( !bDecSubCu )
   {
-    m_phQP               = (UChar*    )xMalloc(UChar,    uiNumPartition);
-    m_puhDepth           = (UChar*    )xMalloc(UChar,    uiNumPartition);
-    m_puhWidth           = (UChar*    )xMalloc(UChar,    uiNumPartition);
-    m_puhHeight          = (UChar*    )xMalloc(UChar,    uiNumPartition);
-    m_pePartSize         = (PartSize* )xMalloc(PartSize, uiNumPartition);
-    m_pePredMode         = (PredMode* )xMalloc(PredMode, uiNumPartition);
-
-    m_puiAlfCtrlFlag     = (UInt*  )xMalloc(UInt,   uiNumPartition);
-
+    // all per-partition arrays share one block, sized from the enabled tools. Arrays of the same element size
+    // and initial value are adjacent, so that the init functions clear each group with a single memset
+    UInt uiNumIntZero   = 1;                                            // ALF flags
+#if PLANAR_INTRA
+    uiNumIntZero       += 4;                                            // planar info
+#endif
+    UInt uiNumIntMinus1 = 4;                                            // MVP indices and numbers
+#ifdef DCM_PBIC
+    uiNumIntMinus1     += 2;                                            // ICP indices and numbers
+#endif
+    UInt uiNumByteZero  = 8;                                            // chroma intra dir, inter dir, TrIdx, CBFs, ROT, CIP
 #if HHI_MRG
-    m_pbMergeFlag        = (Bool*  )xMalloc(Bool,   uiNumPartition);
-    m_puhMergeIndex      = (UChar* )xMalloc(UChar,  uiNumPartition);
+    uiNumByteZero      += 2;                                            // merge flag and index
 #endif
-
-    m_puhLumaIntraDir    = (UChar* )xMalloc(UChar,  uiNumPartition);
+    UInt uiNumByte      = 5;                                            // QP, luma intra dir, depth, width, height
 #if HHI_AIS
-    m_pbLumaIntraFiltFlag= (Bool*  )xMalloc(Bool,   uiNumPartition);
+    uiNumByte          += 1;                                            // intra smoothing flags
 #endif
-    m_puhChromaIntraDir  = (UChar* )xMalloc(UChar,  uiNumPartition);
-    m_puhInterDir        = (UChar* )xMalloc(UChar,  uiNumPartition);
-
-    m_puhTrIdx           = (UChar* )xMalloc(UChar,  uiNumPartition);
+    UInt uiNumCoeff     = uiWidth*uiHeight;
 
-    m_puhCbf[0]          = (UChar* )xMalloc(UChar,  uiNumPartition);
-    m_puhCbf[1]          = (UChar* )xMalloc(UChar,  uiNumPartition);
-    m_puhCbf[2]          = (UChar* )xMalloc(UChar,  uiNumPartition);
+    m_uiNumAllocPart     = uiNumPartition;
+    m_pucPartStorage     = (UChar*)xMalloc( UChar, sizeof(TCoeff)*( uiNumCoeff + ( uiNumCoeff >> 1 ) )
+                                                 + ( sizeof(Int)*( uiNumIntZero + uiNumIntMinus1 ) + sizeof(PartSize) + sizeof(PredMode)
+                                                   + uiNumByteZero + uiNumByte ) * uiNumPartition );
+    UChar* pucBlock      = m_pucPartStorage;
 
-    m_pROTindex          = (UChar* )xMalloc(UChar,  uiNumPartition);
-    m_pCIPflag           = (UChar* )xMalloc(UChar,  uiNumPartition);
+    m_pcTrCoeffY         = xTakePartArray<TCoeff>  ( pucBlock, uiNumCoeff      );
+    m_pcTrCoeffCb        = xTakePartArray<TCoeff>  ( pucBlock, uiNumCoeff >> 2 );
+    m_pcTrCoeffCr        = xTakePartArray<TCoeff>  ( pucBlock, uiNumCoeff >> 2 );
 
+    m_puiAlfCtrlFlag     = xTakePartArray<UInt>    ( pucBlock, uiNumPartition );
 #if PLANAR_INTRA
-    m_piPlanarInfo[0]    = (Int*   )xMalloc(Int,    uiNumPartition);
-    m_piPlanarInfo[1]    = (Int*   )xMalloc(Int,    uiNumPartition);
-    m_piPlanarInfo[2]    = (Int*   )xMalloc(Int,    uiNumPartition);
-    m_piPlanarInfo[3]    = (Int*   )xMalloc(Int,    uiNumPartition);
+    m_piPlanarInfo[0]    = xTakePartArray<Int>     ( pucBlock, uiNumPartition );
+    m_piPlanarInfo[1]    = xTakePartArray<Int>     ( pucBlock, uiNumPartition );
+    m_piPlanarInfo[2]    = xTakePartArray<Int>     ( pucBlock, uiNumPartition );
+    m_piPlanarInfo[3]    = xTakePartArray<Int>     ( pucBlock, uiNumPartition );
 #endif
 
-    m_apiMVPIdx[0]       = (Int*   )xMalloc(Int,  uiNumPartition);
-    m_apiMVPIdx[1]       = (Int*   )xMalloc(Int,  uiNumPartition);
-    m_apiMVPNum[0]       = (Int*   )xMalloc(Int,  uiNumPartition);
-    m_apiMVPNum[1]       = (Int*   )xMalloc(Int,  uiNumPartition);
-
+    m_apiMVPIdx[0]       = xTakePartArray<Int>     ( pucBlock, uiNumPartition );
+    m_apiMVPIdx[1]       = xTakePartArray<Int>     ( pucBlock, uiNumPartition );
+    m_apiMVPNum[0]       = xTakePartArray<Int>     ( pucBlock, uiNumPartition );
+    m_apiMVPNum[1]       = xTakePartArray<Int>     ( pucBlock, uiNumPartition );
 #ifdef DCM_PBIC
-    m_piICPIdx           = (Int*   )xMalloc(Int,  uiNumPartition);
-    m_piICPNum           = (Int*   )xMalloc(Int,  uiNumPartition);
+    m_piICPIdx           = xTakePartArray<Int>     ( pucBlock, uiNumPartition );
+    m_piICPNum           = xTakePartArray<Int>     ( pucBlock, uiNumPartition );
 #endif
 
-    m_pcTrCoeffY         = (TCoeff*)xMalloc(TCoeff, uiWidth*uiHeight);
-    m_pcTrCoeffCb        = (TCoeff*)xMalloc(TCoeff, uiWidth*uiHeight/4);
-    m_pcTrCoeffCr        = (TCoeff*)xMalloc(TCoeff, uiWidth*uiHeight/4);
+    m_pePartSize         = xTakePartArray<PartSize>( pucBlock, uiNumPartition );
+    m_pePredMode         = xTakePartArray<PredMode>( pucBlock, uiNumPartition );
+
+#if HHI_MRG
+    m_pbMergeFlag        = xTakePartArray<Bool>    ( pucBlock, uiNumPartition );
+    m_puhMergeIndex      = xTakePartArray<UChar>   ( pucBlock, uiNumPartition );
+#endif
+    m_puhChromaIntraDir  = xTakePartArray<UChar>   ( pucBlock, uiNumPartition );
+    m_puhInterDir        = xTakePartArray<UChar>   ( pucBlock, uiNumPartition );
+    m_puhTrIdx           = xTakePartArray<UChar>   ( pucBlock, uiNumPartition );
+    m_puhCbf[0]          = xTakePartArray<UChar>   ( pucBlock, uiNumPartition );
+    m_puhCbf[1]          = xTakePartArray<UChar>   ( pucBlock, uiNumPartition );
+    m_puhCbf[2]          = xTakePartArray<UChar>   ( pucBlock, uiNumPartition );
+    m_pROTindex          = xTakePartArray<UChar>   ( pucBlock, uiNumPartition );
+    m_pCIPflag           = xTakePartArray<UChar>   ( pucBlock, uiNumPartition );
+
+    m_phQP               = xTakePartArray<UChar>   ( pucBlock, uiNumPartition );
+    m_puhLumaIntraDir    = xTakePartArray<UChar>   ( pucBlock, uiNumPartition );
+#if HHI_AIS
+    m_pbLumaIntraFiltFlag= xTakePartArray<Bool>    ( pucBlock, uiNumPartition );
+#endif
+    m_puhDepth           = xTakePartArray<UChar>   ( pucBlock, uiNumPartition );
+    m_puhWidth           = xTakePartArray<UChar>   ( pucBlock, uiNumPartition );
+    m_puhHeight          = xTakePartArray<UChar>   ( pucBlock, uiNumPartition );
 
     m_acCUMvField[0].create( uiNumPartition );
     m_acCUMvField[1].create( uiNumPartition );
@@ -213,47 +236,7 @@ Void TComDataCU::destroy()
   // encoder-side buffer free
   if ( !m_bDecSubCu )
   {
-    if ( m_phQP               ) { xFree(m_phQP);                m_phQP              = NULL; }
-    if ( m_puhDepth           ) { xFree(m_puhDepth);            m_puhDepth          = NULL; }
-    if ( m_puhWidth           ) { xFree(m_puhWidth);            m_puhWidth          = NULL; }
-    if ( m_puhHeight          ) { xFree(m_puhHeight);           m_puhHeight         = NULL; }
-    if ( m_pePartSize         ) { xFree(m_pePartSize);          m_pePartSize        = NULL; }
-    if ( m_pePredMode         ) { xFree(m_pePredMode);          m_pePredMode        = NULL; }
-    if ( m_puhCbf[0]          ) { xFree(m_puhCbf[0]);           m_puhCbf[0]         = NULL; }
-    if ( m_puhCbf[1]          ) { xFree(m_puhCbf[1]);           m_puhCbf[1]         = NULL; }
-    if ( m_puhCbf[2]          ) { xFree(m_puhCbf[2]);           m_puhCbf[2]         = NULL; }
-    if ( m_puiAlfCtrlFlag     ) { xFree(m_puiAlfCtrlFlag);      m_puiAlfCtrlFlag    = NULL; }
-    if ( m_puhInterDir        ) { xFree(m_puhInterDir);         m_puhInterDir       = NULL; }
-#if PLANAR_INTRA
-    if ( m_piPlanarInfo[0]    ) { xFree(m_piPlanarInfo[0]);     m_piPlanarInfo[0]   = NULL; }
-    if ( m_piPlanarInfo[1]    ) { xFree(m_piPlanarInfo[1]);     m_piPlanarInfo[1]   = NULL; }
-    if ( m_piPlanarInfo[2]    ) { xFree(m_piPlanarInfo[2]);     m_piPlanarInfo[2]   = NULL; }
-    if ( m_piPlanarInfo[3]    ) { xFree(m_piPlanarInfo[3]);     m_piPlanarInfo[3]   = NULL; }
-#endif
-#if HHI_MRG
-    if ( m_pbMergeFlag        ) { xFree(m_pbMergeFlag);         m_pbMergeFlag       = NULL; }
-    if ( m_puhMergeIndex      ) { xFree(m_puhMergeIndex);       m_puhMergeIndex     = NULL; }
-#endif
-    if ( m_puhLumaIntraDir    ) { xFree(m_puhLumaIntraDir);     m_puhLumaIntraDir   = NULL; }
-#if HHI_AIS
-    if ( m_pbLumaIntraFiltFlag) { xFree(m_pbLumaIntraFiltFlag); m_pbLumaIntraFiltFlag = NULL; }
-#endif
-    if ( m_puhChromaIntraDir  ) { xFree(m_puhChromaIntraDir);   m_puhChromaIntraDir = NULL; }
-    if ( m_puhTrIdx           ) { xFree(m_puhTrIdx);            m_puhTrIdx          = NULL; }
-    if ( m_pcTrCoeffY         ) { xFree(m_pcTrCoeffY);          m_pcTrCoeffY        = NULL; }
-    if ( m_pcTrCoeffCb        ) { xFree(m_pcTrCoeffCb);         m_pcTrCoeffCb       = NULL; }
-    if ( m_pcTrCoeffCr        ) { xFree(m_pcTrCoeffCr);         m_pcTrCoeffCr       = NULL; }
-    if ( m_pROTindex          ) { xFree(m_pROTindex);           m_pROTindex         = NULL; }
-    if ( m_pCIPflag           ) { xFree(m_pCIPflag);            m_pCIPflag          = NULL; }
-    if ( m_apiMVPIdx[0]       ) { xFree(m_apiMVPIdx[0]);        m_apiMVPIdx[0]      = NULL; }
-    if ( m_apiMVPIdx[1]       ) { xFree(m_apiMVPIdx[1]);        m_apiMVPIdx[1]      = NULL; }
-    if ( m_apiMVPNum[0]       ) { xFree(m_apiMVPNum[0]);        m_apiMVPNum[0]      = NULL; }
-    if ( m_apiMVPNum[1]       ) { xFree(m_apiMVPNum[1]);        m_apiMVPNum[1]      = NULL; }
-
-#ifdef DCM_PBIC
-    if ( m_piICPIdx           ) { xFree(m_piICPIdx);            m_piICPIdx      = NULL; }
-    if ( m_piICPNum           ) { xFree(m_piICPNum);            m_piICPNum      = NULL; }
-#endif
+    if ( m_pucPartStorage     ) { xFree(m_pucPartStorage);      m_pucPartStorage    = NULL; }
 
     m_acCUMvField[0].destroy();
     m_acCUMvField[1].destroy();
@@ -304,31 +287,15 @@ Void TComDataCU::initCU( TComPic* pcPic, UInt iCUAddr )
   m_uiNumPartition     = pcPic->getNumPartInCU();
 
   Int iSizeInUchar = sizeof( UChar ) * m_uiNumPartition;
-  Int iSizeInUInt  = sizeof( UInt  ) * m_uiNumPartition;
-#if HHI_AIS || HHI_MRG
+#if HHI_AIS
   Int iSizeInBool  = sizeof( Bool  ) * m_uiNumPartition;
 #endif
-#if PLANAR_INTRA
-  Int iSizeInInt   = sizeof( Int   ) * m_uiNumPartition;
-#endif
 
   memset( m_phQP,              m_pcPic->getSlice()->getSliceQp(), iSizeInUchar );
-
-  memset( m_puiAlfCtrlFlag,     0, iSizeInUInt  );
-#if HHI_MRG
-  memset( m_pbMergeFlag,        0, iSizeInBool  );
-  memset( m_puhMergeIndex,      0, iSizeInUchar );
-#endif
   memset( m_puhLumaIntraDir,    2, iSizeInUchar );
 #if HHI_AIS
   memset( m_pbLumaIntraFiltFlag,1, iSizeInBool  );
 #endif
-  memset( m_puhChromaIntraDir,  0, iSizeInUchar );
-  memset( m_puhInterDir,        0, iSizeInUchar );
-  memset( m_puhTrIdx,           0, iSizeInUchar );
-  memset( m_puhCbf[0],          0, iSizeInUchar );
-  memset( m_puhCbf[1],          0, iSizeInUchar );
-  memset( m_puhCbf[2],          0, iSizeInUchar );
   memset( m_puhDepth,           0, iSizeInUchar );
 
   UChar uhWidth  = g_uiMaxCUWidth;
@@ -336,29 +303,27 @@ Void TComDataCU::initCU( TComPic* pcPic, UInt iCUAddr )
   memset( m_puhWidth,          uhWidth,  iSizeInUchar );
   memset( m_puhHeight,         uhHeight, iSizeInUchar );
 
-  memset( m_pROTindex,         0, iSizeInUchar );
-  memset( m_pCIPflag,          0, iSizeInUchar );
-
+  // ALF flags and planar info, MVP (and ICP) indices and numbers, and the zero initialized byte arrays
 #if PLANAR_INTRA
-  memset( m_piPlanarInfo[0],   0, iSizeInInt );
-  memset( m_piPlanarInfo[1],   0, iSizeInInt );
-  memset( m_piPlanarInfo[2],   0, iSizeInInt );
-  memset( m_piPlanarInfo[3],   0, iSizeInInt );
+  xSetPartArrays( m_puiAlfCtrlFlag,  0, 5, sizeof( Int ) );
+#else
+  xSetPartArrays( m_puiAlfCtrlFlag,  0, 1, sizeof( Int ) );
+#endif
+#ifdef DCM_PBIC
+  xSetPartArrays( m_apiMVPIdx[0],   -1, 6, sizeof( Int ) );
+#else
+  xSetPartArrays( m_apiMVPIdx[0],   -1, 4, sizeof( Int ) );
+#endif
+#if HHI_MRG
+  xSetPartArrays( m_pbMergeFlag,     0, 10, sizeof( UChar ) );
+#else
+  xSetPartArrays( m_puhChromaIntraDir, 0, 8, sizeof( UChar ) );
 #endif
 
   for (UInt ui = 0; ui < m_uiNumPartition; ui++)
   {
     m_pePartSize[ui] = SIZE_NONE;
     m_pePredMode[ui] = MODE_NONE;
-
-    m_apiMVPIdx[0][ui] = -1;
-    m_apiMVPIdx[1][ui] = -1;
-    m_apiMVPNum[0][ui] = -1;
-    m_apiMVPNum[1][ui] = -1;
-#ifdef DCM_PBIC
-    m_piICPIdx[ui] = -1;
-    m_piICPNum[ui] = -1;
-#endif
   }
 
   m_acCUMvField[0].clearMvField();
@@ -416,6 +381,23 @@ Void TComDataCU::initCU( TComPic* pcPic, UInt iCUAddr )
   }
 }
 
+Void TComDataCU::xSetPartArrays( Void* pFirst, Int iValue, UInt uiNumFields, UInt uiElemSize )
+{
+  UChar* puc      = (UChar*)pFirst;
+  UInt   uiSize   = uiElemSize * m_uiNumPartition;
+  UInt   uiStride = uiElemSize * m_uiNumAllocPart;
+
+  if ( uiSize == uiStride )
+  {
+    memset( puc, iValue, uiSize * uiNumFields );
+    return;
+  }
+  for ( UInt ui = 0; ui < uiNumFields; ui++, puc += uiStride )
+  {
+    memset( puc, iValue, uiSize );
+  }
+}
+
 // initialize prediction data
 Void TComDataCU::initEstData()
 {
@@ -423,56 +405,38 @@ Void TComDataCU::initEstData()
   m_uiTotalDistortion  = 0;
   m_uiTotalBits        = 0;
 
-  Int iSizeInUchar = sizeof( UChar  ) * m_uiNumPartition;
-  Int iSizeInUInt  = sizeof( UInt   ) * m_uiNumPartition;
-#if HHI_AIS || HHI_MRG
-  Int iSizeInBool  = sizeof( Bool   ) * m_uiNumPartition;
-#endif
-#if PLANAR_INTRA
-  Int iSizeInInt   = sizeof( Int   ) * m_uiNumPartition;
+  Int iSizeInUchar = sizeof( UChar ) * m_uiNumPartition;
+#if HHI_AIS
+  Int iSizeInBool  = sizeof( Bool  ) * m_uiNumPartition;
 #endif
 
   memset( m_phQP,              m_pcPic->getSlice()->getSliceQp(), iSizeInUchar );
-
-  memset( m_puiAlfCtrlFlag,     0, iSizeInUInt );
-#if HHI_MRG
-  memset( m_pbMergeFlag,        0, iSizeInBool  );
-  memset( m_puhMergeIndex,      0, iSizeInUchar );
-#endif
   memset( m_puhLumaIntraDir,    2, iSizeInUchar );
 #if HHI_AIS
   memset( m_pbLumaIntraFiltFlag,1, iSizeInBool  );
 #endif
-  memset( m_puhChromaIntraDir,  0, iSizeInUchar );
-  memset( m_puhInterDir,        0, iSizeInUchar );
-  memset( m_puhTrIdx,           0, iSizeInUchar );
-  memset( m_puhCbf[0],          0, iSizeInUchar );
-  memset( m_puhCbf[1],          0, iSizeInUchar );
-  memset( m_puhCbf[2],          0, iSizeInUchar );
-
-  memset( m_pROTindex,         0, iSizeInUchar );
-  memset( m_pCIPflag,          0, iSizeInUchar );
 
+  // ALF flags and planar info, MVP (and ICP) indices and numbers, and the zero initialized byte arrays
 #if PLANAR_INTRA
-  memset( m_piPlanarInfo[0],   0, iSizeInInt );
-  memset( m_piPlanarInfo[1],   0, iSizeInInt );
-  memset( m_piPlanarInfo[2],   0, iSizeInInt );
-  memset( m_piPlanarInfo[3],   0, iSizeInInt );
+  xSetPartArrays( m_puiAlfCtrlFlag,  0, 5, sizeof( Int ) );
+#else
+  xSetPartArrays( m_puiAlfCtrlFlag,  0, 1, sizeof( Int ) );
+#endif
+#ifdef DCM_PBIC
+  xSetPartArrays( m_apiMVPIdx[0],   -1, 6, sizeof( Int ) );
+#else
+  xSetPartArrays( m_apiMVPIdx[0],   -1, 4, sizeof( Int ) );
+#endif
+#if HHI_MRG
+  xSetPartArrays( m_pbMergeFlag,     0, 10, sizeof( UChar ) );
+#else
+  xSetPartArrays( m_puhChromaIntraDir, 0, 8, sizeof( UChar ) );
 #endif
 
   for (UInt ui = 0; ui < m_uiNumPartition; ui++)
   {
     m_pePartSize[ui] = SIZE_NONE;
     m_pePredMode[ui] = MODE_NONE;
-
-    m_apiMVPIdx[0][ui] = -1;
-    m_apiMVPIdx[1][ui] = -1;
-    m_apiMVPNum[0][ui] = -1;
-    m_apiMVPNum[1][ui] = -1;
-#ifdef DCM_PBIC
-    m_piICPIdx[ui] = -1;
-    m_piICPNum[ui] = -1;
-#endif
   }
 
   UInt uiTmp = m_puhWidth[0]*m_puhHeight[0];
@@ -511,32 +475,16 @@ Void TComDataCU::initSubCU( TComDataCU* pcCU, UInt uiPartUnitIdx, UInt uiDepth )
 
   m_uiNumPartition     = pcCU->getTotalNumPart() >> 2;
 
-  Int iSizeInUchar = sizeof( UChar  ) * m_uiNumPartition;
-  Int iSizeInUInt  = sizeof( UInt   ) * m_uiNumPartition;
-#if HHI_AIS || HHI_MRG
-  Int iSizeInBool  = sizeof( Bool   ) * m_uiNumPartition;
-#endif
-#if PLANAR_INTRA
-  Int iSizeInInt   = sizeof( Int    ) * m_uiNumPartition;
+  Int iSizeInUchar = sizeof( UChar ) * m_uiNumPartition;
+#if HHI_AIS
+  Int iSizeInBool  = sizeof( Bool  ) * m_uiNumPartition;
 #endif
 
   memset( m_phQP,              m_pcPic->getSlice()->getSliceQp(), iSizeInUchar );
-
-  memset( m_puiAlfCtrlFlag,     0, iSizeInUInt );
-#if HHI_MRG
-  memset( m_pbMergeFlag,        0, iSizeInBool  );
-  memset( m_puhMergeIndex,      0, iSizeInUchar );
-#endif
   memset( m_puhLumaIntraDir,    2, iSizeInUchar );
 #if HHI_AIS
   memset( m_pbLumaIntraFiltFlag,1, iSizeInBool  );
 #endif
-  memset( m_puhChromaIntraDir,  0, iSizeInUchar );
-  memset( m_puhInterDir,        0, iSizeInUchar );
-  memset( m_puhTrIdx,           0, iSizeInUchar );
-  memset( m_puhCbf[0],          0, iSizeInUchar );
-  memset( m_puhCbf[1],          0, iSizeInUchar );
-  memset( m_puhCbf[2],          0, iSizeInUchar );
   memset( m_puhDepth,     uiDepth, iSizeInUchar );
 
   UChar uhWidth  = g_uiMaxCUWidth  >> uiDepth;
@@ -544,30 +492,27 @@ Void TComDataCU::initSubCU( TComDataCU* pcCU, UInt uiPartUnitIdx, UInt uiDepth )
   memset( m_puhWidth,          uhWidth,  iSizeInUchar );
   memset( m_puhHeight,         uhHeight, iSizeInUchar );
 
-  memset( m_pROTindex,         0, iSizeInUchar );
-  memset( m_pCIPflag,          0, iSizeInUchar );
-
+  // ALF flags and planar info, MVP (and ICP) indices and numbers, and the zero initialized byte arrays
 #if PLANAR_INTRA
-  memset( m_piPlanarInfo[0],   0, iSizeInInt );
-  memset( m_piPlanarInfo[1],   0, iSizeInInt );
-  memset( m_piPlanarInfo[2],   0, iSizeInInt );
-  memset( m_piPlanarInfo[3],   0, iSizeInInt );
+  xSetPartArrays( m_puiAlfCtrlFlag,  0, 5, sizeof( Int ) );
+#else
+  xSetPartArrays( m_puiAlfCtrlFlag,  0, 1, sizeof( Int ) );
+#endif
+#ifdef DCM_PBIC
+  xSetPartArrays( m_apiMVPIdx[0],   -1, 6, sizeof( Int ) );
+#else
+  xSetPartArrays( m_apiMVPIdx[0],   -1, 4, sizeof( Int ) );
+#endif
+#if HHI_MRG
+  xSetPartArrays( m_pbMergeFlag,     0, 10, sizeof( UChar ) );
+#else
+  xSetPartArrays( m_puhChromaIntraDir, 0, 8, sizeof( UChar ) );
 #endif
 
   for (UInt ui = 0; ui < m_uiNumPartition; ui++)
   {
     m_pePartSize[ui] = SIZE_NONE;
     m_pePredMode[ui] = MODE_NONE;
-
-    m_apiMVPIdx[0][ui] = -1;
-    m_apiMVPIdx[1][ui] = -1;
-    m_apiMVPNum[0][ui] = -1;
-    m_apiMVPNum[1][ui] = -1;
-#ifdef DCM_PBIC
-    m_piICPIdx[ui] = -1;
-    m_piICPNum[ui] = -1;
-#endif
-
   }
 
   UInt uiTmp = m_puhWidth[0]*m_puhHeight[0];
@@ -2174,154 +2119,12 @@ Void TComDataCU::setLumaIntraFiltFlagSubParts( Bool bFlag, UInt uiAbsPartIdx, UI
 #if HHI_MRG_PU
 Void TComDataCU::setSubPartUChar( UInt uiParameter, UChar* puhBaseLCU, UInt uiCUAddr, UInt uiCUDepth, UInt uiPUIdx )
 {
-  UInt uiCurrPartNumQ = (m_pcPic->getNumPartInCU() >> (uiCUDepth << 1)) >> 2;
-  switch ( m_pePartSize[ uiCUAddr ] )
-  {
-  case SIZE_2Nx2N:
-    memset( puhBaseLCU + uiCUAddr, uiParameter, sizeof(UChar)*uiCurrPartNumQ << 2 );                      break;
-  case SIZE_2NxN:
-    memset( puhBaseLCU + uiCUAddr, uiParameter, sizeof(UChar)*uiCurrPartNumQ << 1 );                      break;
-  case SIZE_Nx2N:
-    memset( puhBaseLCU + uiCUAddr, uiParameter, sizeof(UChar)*uiCurrPartNumQ );
-    memset( puhBaseLCU + uiCUAddr + ( uiCurrPartNumQ << 1 ), uiParameter, sizeof(UChar)*uiCurrPartNumQ ); break;
-  case SIZE_NxN:
-    memset( puhBaseLCU + uiCUAddr, uiParameter, sizeof(UChar)*uiCurrPartNumQ );                           break;
-  case SIZE_2NxnU:
-    {
-      memset( puhBaseLCU + uiCUAddr, uiParameter, sizeof(UChar)*(uiCurrPartNumQ>>1) );
-      if( uiPUIdx == 0 )
-        memset( puhBaseLCU + uiCUAddr + uiCurrPartNumQ, uiParameter, sizeof(UChar)*(uiCurrPartNumQ>>1) );
-      else
-        memset( puhBaseLCU + uiCUAddr + uiCurrPartNumQ, uiParameter, sizeof(UChar)*( (uiCurrPartNumQ>>1) + (uiCurrPartNumQ<<1) ) );
-      break;
-    }
-  case SIZE_2NxnD:
-    {
-      if( uiPUIdx == 0 )
-      {
-        memset( puhBaseLCU + uiCUAddr, uiParameter, sizeof(UChar)*( (uiCurrPartNumQ>>1) + (uiCurrPartNumQ<<1) ) );
-        memset( puhBaseLCU + uiCUAddr + ( uiCurrPartNumQ + (uiCurrPartNumQ<<1) ), uiParameter, sizeof(UChar)*(uiCurrPartNumQ>>1) );
-      }
-      else
-      {
-        memset( puhBaseLCU + uiCUAddr, uiParameter, sizeof(UChar)*(uiCurrPartNumQ>>1) );
-        memset( puhBaseLCU + uiCUAddr + uiCurrPartNumQ, uiParameter, sizeof(UChar)*(uiCurrPartNumQ>>1) );
-      }
-      break;
-    }
-  case SIZE_nLx2N:
-    {
-      memset( puhBaseLCU + uiCUAddr, uiParameter, sizeof(UChar)*(uiCurrPartNumQ>>2) );
-      memset( puhBaseLCU + uiCUAddr + (uiCurrPartNumQ<<1), uiParameter, sizeof(UChar)*(uiCurrPartNumQ>>2) );
-      if( uiPUIdx == 0 )
-      {
-        memset( puhBaseLCU + uiCUAddr + (uiCurrPartNumQ>>1), uiParameter, sizeof(UChar)*(uiCurrPartNumQ>>2) );
-        memset( puhBaseLCU + uiCUAddr + (uiCurrPartNumQ<<1) + (uiCurrPartNumQ>>1), uiParameter, sizeof(UChar)*(uiCurrPartNumQ>>2) );
-      }
-      else
-      {
-        memset( puhBaseLCU + uiCUAddr + (uiCurrPartNumQ>>1), uiParameter, sizeof(UChar)*( (uiCurrPartNumQ>>2) + uiCurrPartNumQ ) );
-        memset( puhBaseLCU + uiCUAddr + (uiCurrPartNumQ<<1) + (uiCurrPartNumQ>>1), uiParameter, sizeof(UChar)*( (uiCurrPartNumQ>>2) + uiCurrPartNumQ ) );
-      }
-      break;
-    }
-  case SIZE_nRx2N:
-    {
-      if( uiPUIdx == 0 )
-      {
-        memset( puhBaseLCU + uiCUAddr, uiParameter, sizeof(UChar)*( (uiCurrPartNumQ>>2) + uiCurrPartNumQ ) );
-        memset( puhBaseLCU + uiCUAddr + uiCurrPartNumQ + (uiCurrPartNumQ>>1), uiParameter, sizeof(UChar)*(uiCurrPartNumQ>>2) );
-        memset( puhBaseLCU + uiCUAddr + (uiCurrPartNumQ<<1), uiParameter, sizeof(UChar)*( (uiCurrPartNumQ>>2) + uiCurrPartNumQ ) );
-        memset( puhBaseLCU + uiCUAddr + (uiCurrPartNumQ<<1) + uiCurrPartNumQ + (uiCurrPartNumQ>>1), uiParameter, sizeof(UChar)*(uiCurrPartNumQ>>2) );
-      }
-      else
-      {
-        memset( puhBaseLCU + uiCUAddr, uiParameter, sizeof(UChar)*(uiCurrPartNumQ>>2) );
-        memset( puhBaseLCU + uiCUAddr + (uiCurrPartNumQ>>1), uiParameter, sizeof(UChar)*(uiCurrPartNumQ>>2) );
-        memset( puhBaseLCU + uiCUAddr + (uiCurrPartNumQ<<1), uiParameter, sizeof(UChar)*(uiCurrPartNumQ>>2) );
-        memset( puhBaseLCU + uiCUAddr + (uiCurrPartNumQ<<1) + (uiCurrPartNumQ>>1), uiParameter, sizeof(UChar)*(uiCurrPartNumQ>>2) );
-      }
-      break;
-    }
-  default:
-    assert( 0 );
-  }
+  setPURuns( puhBaseLCU + uiCUAddr, (UChar)uiParameter, m_pePartSize[ uiCUAddr ], uiPUIdx, m_pcPic->getNumPartInCU() >> ( uiCUDepth << 1 ) );
 }
 
 Void TComDataCU::setSubPartBool( Bool bParameter, Bool* pbBaseLCU, UInt uiCUAddr, UInt uiCUDepth, UInt uiPUIdx )
 {
-  UInt uiQuaterCUPartNum = (m_pcPic->getNumPartInCU() >> (uiCUDepth << 1)) >> 2;
-  switch ( m_pePartSize[ uiCUAddr ] )
-  {
-  case SIZE_2Nx2N:
-    memset( pbBaseLCU + uiCUAddr, bParameter, sizeof(Bool)*uiQuaterCUPartNum << 2 );                      break;
-  case SIZE_2NxN:
-    memset( pbBaseLCU + uiCUAddr, bParameter, sizeof(Bool)*uiQuaterCUPartNum << 1 );                      break;
-  case SIZE_Nx2N:
-    memset( pbBaseLCU + uiCUAddr, bParameter, sizeof(Bool)*uiQuaterCUPartNum );
-    memset( pbBaseLCU + uiCUAddr + ( uiQuaterCUPartNum << 1 ), bParameter, sizeof(Bool)*uiQuaterCUPartNum ); break;
-  case SIZE_NxN:
-    memset( pbBaseLCU + uiCUAddr, bParameter, sizeof(Bool)*uiQuaterCUPartNum );                           break;
-  case SIZE_2NxnU:
-    {
-      memset( pbBaseLCU + uiCUAddr, bParameter, sizeof(Bool)*(uiQuaterCUPartNum>>1) );
-      if( uiPUIdx == 0 )
-        memset( pbBaseLCU + uiCUAddr + uiQuaterCUPartNum, bParameter, sizeof(Bool)*(uiQuaterCUPartNum>>1) );
-      else
-        memset( pbBaseLCU + uiCUAddr + uiQuaterCUPartNum, bParameter, sizeof(Bool)*( (uiQuaterCUPartNum>>1) + (uiQuaterCUPartNum<<1) ) );
-      break;
-    }
-  case SIZE_2NxnD:
-    {
-      if( uiPUIdx == 0 )
-      {
-        memset( pbBaseLCU + uiCUAddr, bParameter, sizeof(Bool)*( (uiQuaterCUPartNum>>1) + (uiQuaterCUPartNum<<1) ) );
-        memset( pbBaseLCU + uiCUAddr + ( uiQuaterCUPartNum + (uiQuaterCUPartNum<<1) ), bParameter, sizeof(Bool)*(uiQuaterCUPartNum>>1) );
-      }
-      else
-      {
-        memset( pbBaseLCU + uiCUAddr, bParameter, sizeof(Bool)*(uiQuaterCUPartNum>>1) );
-        memset( pbBaseLCU + uiCUAddr + uiQuaterCUPartNum, bParameter, sizeof(Bool)*(uiQuaterCUPartNum>>1) );
-      }
-      break;
-    }
-  case SIZE_nLx2N:
-    {
-      memset( pbBaseLCU + uiCUAddr, bParameter, sizeof(Bool)*(uiQuaterCUPartNum>>2) );
-      memset( pbBaseLCU + uiCUAddr + (uiQuaterCUPartNum<<1), bParameter, sizeof(Bool)*(uiQuaterCUPartNum>>2) );
-      if( uiPUIdx == 0 )
-      {
-        memset( pbBaseLCU + uiCUAddr + (uiQuaterCUPartNum>>1), bParameter, sizeof(Bool)*(uiQuaterCUPartNum>>2) );
-        memset( pbBaseLCU + uiCUAddr + (uiQuaterCUPartNum<<1) + (uiQuaterCUPartNum>>1), bParameter, sizeof(Bool)*(uiQuaterCUPartNum>>2) );
-      }
-      else
-      {
-        memset( pbBaseLCU + uiCUAddr + (uiQuaterCUPartNum>>1), bParameter, sizeof(Bool)*( (uiQuaterCUPartNum>>2) + uiQuaterCUPartNum ) );
-        memset( pbBaseLCU + uiCUAddr + (uiQuaterCUPartNum<<1) + (uiQuaterCUPartNum>>1), bParameter, sizeof(Bool)*( (uiQuaterCUPartNum>>2) + uiQuaterCUPartNum ) );
-      }
-      break;
-    }
-  case SIZE_nRx2N:
-    {
-      if( uiPUIdx == 0 )
-      {
-        memset( pbBaseLCU + uiCUAddr, bParameter, sizeof(Bool)*( (uiQuaterCUPartNum>>2) + uiQuaterCUPartNum ) );
-        memset( pbBaseLCU + uiCUAddr + uiQuaterCUPartNum + (uiQuaterCUPartNum>>1), bParameter, sizeof(Bool)*(uiQuaterCUPartNum>>2) );
-        memset( pbBaseLCU + uiCUAddr + (uiQuaterCUPartNum<<1), bParameter, sizeof(Bool)*( (uiQuaterCUPartNum>>2) + uiQuaterCUPartNum ) );
-        memset( pbBaseLCU + uiCUAddr + (uiQuaterCUPartNum<<1) + uiQuaterCUPartNum + (uiQuaterCUPartNum>>1), bParameter, sizeof(Bool)*(uiQuaterCUPartNum>>2) );
-      }
-      else
-      {
-        memset( pbBaseLCU + uiCUAddr, bParameter, sizeof(Bool)*(uiQuaterCUPartNum>>2) );
-        memset( pbBaseLCU + uiCUAddr + (uiQuaterCUPartNum>>1), bParameter, sizeof(Bool)*(uiQuaterCUPartNum>>2) );
-        memset( pbBaseLCU + uiCUAddr + (uiQuaterCUPartNum<<1), bParameter, sizeof(Bool)*(uiQuaterCUPartNum>>2) );
-        memset( pbBaseLCU + uiCUAddr + (uiQuaterCUPartNum<<1) + (uiQuaterCUPartNum>>1), bParameter, sizeof(Bool)*(uiQuaterCUPartNum>>2) );
-      }
-      break;
-    }
-  default:
-    assert( 0 );
-  }
+  setPURuns( pbBaseLCU + uiCUAddr, bParameter, m_pePartSize[ uiCUAddr ], uiPUIdx, m_pcPic->getNumPartInCU() >> ( uiCUDepth << 1 ) );
 }
 #endif
 
@@ -2387,796 +2190,29 @@ Void TComDataCU::setInterDirSubParts( UInt uiDir, UInt uiAbsPartIdx, UInt uiPart
 #else
 Void TComDataCU::setInterDirSubParts( UInt uiDir, UInt uiAbsPartIdx, UInt uiPartIdx, UInt uiDepth )
 {
-  UInt uiCurrPartNumQ = (m_pcPic->getNumPartInCU() >> (uiDepth << 1)) >> 2;
-
-  switch ( m_pePartSize[ uiAbsPartIdx ] )
-  {
-  case SIZE_2Nx2N:
-    memset( m_puhInterDir + uiAbsPartIdx, uiDir, sizeof(UChar)*uiCurrPartNumQ << 2 );                      break;
-  case SIZE_2NxN:
-    memset( m_puhInterDir + uiAbsPartIdx, uiDir, sizeof(UChar)*uiCurrPartNumQ << 1 );                      break;
-  case SIZE_Nx2N:
-    memset( m_puhInterDir + uiAbsPartIdx, uiDir, sizeof(UChar)*uiCurrPartNumQ );
-    memset( m_puhInterDir + uiAbsPartIdx + ( uiCurrPartNumQ << 1 ), uiDir, sizeof(UChar)*uiCurrPartNumQ ); break;
-  case SIZE_NxN:
-    memset( m_puhInterDir + uiAbsPartIdx, uiDir, sizeof(UChar)*uiCurrPartNumQ );                           break;
-  case SIZE_2NxnU:
-    {
-      memset( m_puhInterDir + uiAbsPartIdx, uiDir, sizeof(UChar)*(uiCurrPartNumQ>>1) );
-      if( uiPartIdx == 0 )
-        memset( m_puhInterDir + uiAbsPartIdx + uiCurrPartNumQ, uiDir, sizeof(UChar)*(uiCurrPartNumQ>>1) );
-      else
-        memset( m_puhInterDir + uiAbsPartIdx + uiCurrPartNumQ, uiDir, sizeof(UChar)*( (uiCurrPartNumQ>>1) + (uiCurrPartNumQ<<1) ) );
-      break;
-    }
-  case SIZE_2NxnD:
-    {
-      if( uiPartIdx == 0 )
-      {
-        memset( m_puhInterDir + uiAbsPartIdx, uiDir, sizeof(UChar)*( (uiCurrPartNumQ>>1) + (uiCurrPartNumQ<<1) ) );
-        memset( m_puhInterDir + uiAbsPartIdx + ( uiCurrPartNumQ + (uiCurrPartNumQ<<1) ), uiDir, sizeof(UChar)*(uiCurrPartNumQ>>1) );
-      }
-      else
-      {
-        memset( m_puhInterDir + uiAbsPartIdx, uiDir, sizeof(UChar)*(uiCurrPartNumQ>>1) );
-        memset( m_puhInterDir + uiAbsPartIdx + uiCurrPartNumQ, uiDir, sizeof(UChar)*(uiCurrPartNumQ>>1) );
-      }
-      break;
-    }
-  case SIZE_nLx2N:
-    {
-      memset( m_puhInterDir + uiAbsPartIdx, uiDir, sizeof(UChar)*(uiCurrPartNumQ>>2) );
-      memset( m_puhInterDir + uiAbsPartIdx + (uiCurrPartNumQ<<1), uiDir, sizeof(UChar)*(uiCurrPartNumQ>>2) );
-      if( uiPartIdx == 0 )
-      {
-        memset( m_puhInterDir + uiAbsPartIdx + (uiCurrPartNumQ>>1), uiDir, sizeof(UChar)*(uiCurrPartNumQ>>2) );
-        memset( m_puhInterDir + uiAbsPartIdx + (uiCurrPartNumQ<<1) + (uiCurrPartNumQ>>1), uiDir, sizeof(UChar)*(uiCurrPartNumQ>>2) );
-      }
-      else
-      {
-        memset( m_puhInterDir + uiAbsPartIdx + (uiCurrPartNumQ>>1), uiDir, sizeof(UChar)*( (uiCurrPartNumQ>>2) + uiCurrPartNumQ ) );
-        memset( m_puhInterDir + uiAbsPartIdx + (uiCurrPartNumQ<<1) + (uiCurrPartNumQ>>1), uiDir, sizeof(UChar)*( (uiCurrPartNumQ>>2) + uiCurrPartNumQ ) );
-      }
-      break;
-    }
-  case SIZE_nRx2N:
-    {
-      if( uiPartIdx == 0 )
-      {
-        memset( m_puhInterDir + uiAbsPartIdx, uiDir, sizeof(UChar)*( (uiCurrPartNumQ>>2) + uiCurrPartNumQ ) );
-        memset( m_puhInterDir + uiAbsPartIdx + uiCurrPartNumQ + (uiCurrPartNumQ>>1), uiDir, sizeof(UChar)*(uiCurrPartNumQ>>2) );
-        memset( m_puhInterDir + uiAbsPartIdx + (uiCurrPartNumQ<<1), uiDir, sizeof(UChar)*( (uiCurrPartNumQ>>2) + uiCurrPartNumQ ) );
-        memset( m_puhInterDir + uiAbsPartIdx + (uiCurrPartNumQ<<1) + uiCurrPartNumQ + (uiCurrPartNumQ>>1), uiDir, sizeof(UChar)*(uiCurrPartNumQ>>2) );
-      }
-      else
-      {
-        memset( m_puhInterDir + uiAbsPartIdx, uiDir, sizeof(UChar)*(uiCurrPartNumQ>>2) );
-        memset( m_puhInterDir + uiAbsPartIdx + (uiCurrPartNumQ>>1), uiDir, sizeof(UChar)*(uiCurrPartNumQ>>2) );
-        memset( m_puhInterDir + uiAbsPartIdx + (uiCurrPartNumQ<<1), uiDir, sizeof(UChar)*(uiCurrPartNumQ>>2) );
-        memset( m_puhInterDir + uiAbsPartIdx + (uiCurrPartNumQ<<1) + (uiCurrPartNumQ>>1), uiDir, sizeof(UChar)*(uiCurrPartNumQ>>2) );
-      }
-      break;
-    }
-  default:
-    assert( 0 );
-  }
+  setPURuns( m_puhInterDir + uiAbsPartIdx, (UChar)uiDir, m_pePartSize[ uiAbsPartIdx ], uiPartIdx, m_pcPic->getNumPartInCU() >> ( uiDepth << 1 ) );
 }
 #endif
 
 Void TComDataCU::setMVPIdxSubParts( Int iMVPIdx, RefPicList eRefPicList, UInt uiAbsPartIdx, UInt uiPartIdx, UInt uiDepth )
 {
-  UInt uiCurrPartNumQ = m_pcPic->getNumPartInCU() >> (uiDepth << 1) >> 2;
-  Int i;
-  Int* pi;
-  switch ( m_pePartSize[ uiAbsPartIdx ] )
-  {
-  case SIZE_2Nx2N:
-    {
-      pi = m_apiMVPIdx[eRefPicList] + uiAbsPartIdx;
-      for (i = 0; i < (uiCurrPartNumQ << 2); i++)
-      {
-        pi[i] = iMVPIdx;
-      }
-   }
-  break;
-  case SIZE_2NxN:
-    {
-      pi = m_apiMVPIdx[eRefPicList] + uiAbsPartIdx;
-      for (i = 0; i < (uiCurrPartNumQ << 1); i++)
-      {
-        pi[i] = iMVPIdx;
-      }
-   }
-  break;
-  case SIZE_Nx2N:
-    {
-      Int* pi2 = m_apiMVPIdx[eRefPicList] + uiAbsPartIdx + ( uiCurrPartNumQ << 1 );
-      pi = m_apiMVPIdx[eRefPicList] + uiAbsPartIdx;
-      for (i = 0; i < uiCurrPartNumQ; i++)
-      {
-        pi [i] = iMVPIdx;
-        pi2[i] = iMVPIdx;
-      }
-      break;
-    }
-  case SIZE_NxN:
-    {
-      pi = m_apiMVPIdx[eRefPicList] + uiAbsPartIdx;
-      for (i = 0; i < uiCurrPartNumQ; i++)
-      {
-        pi[i] = iMVPIdx;
-      }
-      break;
-    }
-  case SIZE_2NxnU:
-    {
-      if( uiPartIdx == 0 )
-      {
-             pi  = m_apiMVPIdx[eRefPicList] + uiAbsPartIdx;
-        Int* pi2 = m_apiMVPIdx[eRefPicList] + uiAbsPartIdx + uiCurrPartNumQ;
-        for (i = 0; i < (uiCurrPartNumQ>>1); i++)
-        {
-          pi [i] = iMVPIdx;
-          pi2[i] = iMVPIdx;
-        }
-      }
-      else
-      {
-        pi = m_apiMVPIdx[eRefPicList] + uiAbsPartIdx;
-        for (i = 0; i < (uiCurrPartNumQ>>1); i++)
-        {
-          pi[i] = iMVPIdx;
-        }
+  setPURuns( m_apiMVPIdx[eRefPicList] + uiAbsPartIdx, iMVPIdx, m_pePartSize[ uiAbsPartIdx ], uiPartIdx, m_pcPic->getNumPartInCU() >> ( uiDepth << 1 ) );
+}
 
-        pi = m_apiMVPIdx[eRefPicList] + uiAbsPartIdx + uiCurrPartNumQ;
-        for (i = 0; i < ( (uiCurrPartNumQ>>1) + (uiCurrPartNumQ<<1) ); i++)
-        {
-          pi[i] = iMVPIdx;
-        }
-      }
-      break;
-    }
-  case SIZE_2NxnD:
-    {
-      if( uiPartIdx == 0 )
-      {
-        pi = m_apiMVPIdx[eRefPicList] + uiAbsPartIdx;
-        for (i = 0; i < ( (uiCurrPartNumQ>>1) + (uiCurrPartNumQ<<1) ); i++)
-        {
-          pi[i] = iMVPIdx;
-        }
-        pi = m_apiMVPIdx[eRefPicList] + uiAbsPartIdx + ( uiCurrPartNumQ + (uiCurrPartNumQ<<1) );
-        for (i = 0; i < (uiCurrPartNumQ>>1); i++)
-        {
-          pi[i] = iMVPIdx;
-        }
-      }
-      else
-      {
-             pi  = m_apiMVPIdx[eRefPicList] + uiAbsPartIdx;
-        Int* pi2 = m_apiMVPIdx[eRefPicList] + uiAbsPartIdx + uiCurrPartNumQ;
-        for (i = 0; i < (uiCurrPartNumQ>>1); i++)
-        {
-          pi [i] = iMVPIdx;
-          pi2[i] = iMVPIdx;
-        }
-      }
-      break;
-    }
-  case SIZE_nLx2N:
-    {
-      if( uiPartIdx == 0 )
-      {
-             pi  = m_apiMVPIdx[eRefPicList] + uiAbsPartIdx;
-        Int* pi2 = m_apiMVPIdx[eRefPicList] + uiAbsPartIdx + (uiCurrPartNumQ<<1);
-        Int* pi3 = m_apiMVPIdx[eRefPicList] + uiAbsPartIdx + (uiCurrPartNumQ>>1);
-        Int* pi4 = m_apiMVPIdx[eRefPicList] + uiAbsPartIdx + (uiCurrPartNumQ<<1) + (uiCurrPartNumQ>>1);
-
-        for (i = 0; i < (uiCurrPartNumQ>>2); i++)
-        {
-          pi [i] = iMVPIdx;
-          pi2[i] = iMVPIdx;
-          pi3[i] = iMVPIdx;
-          pi4[i] = iMVPIdx;
-        }
-      }
-      else
-      {
-             pi  = m_apiMVPIdx[eRefPicList] + uiAbsPartIdx;
-        Int* pi2 = m_apiMVPIdx[eRefPicList] + uiAbsPartIdx + (uiCurrPartNumQ<<1);
-        for (i = 0; i < (uiCurrPartNumQ>>2); i++)
-        {
-          pi [i] = iMVPIdx;
-          pi2[i] = iMVPIdx;
-        }
-
-        pi  = m_apiMVPIdx[eRefPicList] + uiAbsPartIdx + (uiCurrPartNumQ>>1);
-        pi2 = m_apiMVPIdx[eRefPicList] + uiAbsPartIdx + (uiCurrPartNumQ<<1) + (uiCurrPartNumQ>>1);
-        for (i = 0; i < ( (uiCurrPartNumQ>>2) + uiCurrPartNumQ ); i++)
-        {
-          pi [i] = iMVPIdx;
-          pi2[i] = iMVPIdx;
-        }
-      }
-      break;
-    }
-  case SIZE_nRx2N:
-    {
-      if( uiPartIdx == 0 )
-      {
-             pi  = m_apiMVPIdx[eRefPicList] + uiAbsPartIdx;
-        Int* pi2 = m_apiMVPIdx[eRefPicList] + uiAbsPartIdx + (uiCurrPartNumQ<<1);
-        for (i = 0; i < ( (uiCurrPartNumQ>>2) + uiCurrPartNumQ ); i++)
-        {
-          pi [i] = iMVPIdx;
-          pi2[i] = iMVPIdx;
-        }
-
-        pi  = m_apiMVPIdx[eRefPicList] + uiAbsPartIdx + uiCurrPartNumQ + (uiCurrPartNumQ>>1);
-        pi2 = m_apiMVPIdx[eRefPicList] + uiAbsPartIdx + (uiCurrPartNumQ<<1) + uiCurrPartNumQ + (uiCurrPartNumQ>>1);
-        for (i = 0; i < (uiCurrPartNumQ>>2); i++)
-        {
-          pi [i] = iMVPIdx;
-          pi2[i] = iMVPIdx;
-        }
-      }
-      else
-      {
-             pi  = m_apiMVPIdx[eRefPicList] + uiAbsPartIdx;
-        Int* pi2 = m_apiMVPIdx[eRefPicList] + uiAbsPartIdx + (uiCurrPartNumQ>>1);
-        Int* pi3 = m_apiMVPIdx[eRefPicList] + uiAbsPartIdx + (uiCurrPartNumQ<<1);
-        Int* pi4 = m_apiMVPIdx[eRefPicList] + uiAbsPartIdx + (uiCurrPartNumQ<<1) + (uiCurrPartNumQ>>1);
-        for (i = 0; i < (uiCurrPartNumQ>>2); i++)
-        {
-          pi [i] = iMVPIdx;
-          pi2[i] = iMVPIdx;
-          pi3[i] = iMVPIdx;
-          pi4[i] = iMVPIdx;
-        }
-      }
-      break;
-    }
-  default:
-    assert( 0 );
-  }
-}
-
-Void TComDataCU::setMVPNumSubParts( Int iMVPNum, RefPicList eRefPicList, UInt uiAbsPartIdx, UInt uiPartIdx, UInt uiDepth )
-{
-  UInt uiCurrPartNumQ = m_pcPic->getNumPartInCU() >> (uiDepth << 1) >> 2;
-  Int i;
-  Int* pi;
-  switch ( m_pePartSize[ uiAbsPartIdx ] )
-  {
-  case SIZE_2Nx2N:
-    {
-      pi = m_apiMVPNum[eRefPicList] + uiAbsPartIdx;
-      for (i = 0; i < (uiCurrPartNumQ << 2); i++)
-      {
-        pi[i] = iMVPNum;
-      }
-   }
-  break;
-  case SIZE_2NxN:
-    {
-      pi = m_apiMVPNum[eRefPicList] + uiAbsPartIdx;
-      for (i = 0; i < (uiCurrPartNumQ << 1); i++)
-      {
-        pi[i] = iMVPNum;
-      }
-   }
-  break;
-  case SIZE_Nx2N:
-    {
-      pi = m_apiMVPNum[eRefPicList] + uiAbsPartIdx;
-      for (i = 0; i < uiCurrPartNumQ; i++)
-      {
-        pi[i] = iMVPNum;
-      }
-      pi = m_apiMVPNum[eRefPicList] + uiAbsPartIdx + ( uiCurrPartNumQ << 1 );
-      for (i = 0; i < uiCurrPartNumQ; i++)
-      {
-        pi[i] = iMVPNum;
-      }
-   }
-  break;
-  case SIZE_NxN:
-    {
-      pi = m_apiMVPNum[eRefPicList] + uiAbsPartIdx;
-      for (i = 0; i < uiCurrPartNumQ; i++)
-      {
-        pi[i] = iMVPNum;
-      }
-   }
-  break;
-  case SIZE_2NxnU:
-    {
-      if( uiPartIdx == 0 )
-      {
-             pi  = m_apiMVPNum[eRefPicList] + uiAbsPartIdx;
-        Int* pi2 = m_apiMVPNum[eRefPicList] + uiAbsPartIdx + uiCurrPartNumQ;
-        for (i = 0; i < (uiCurrPartNumQ>>1); i++)
-        {
-          pi [i] = iMVPNum;
-          pi2[i] = iMVPNum;
-        }
-      }
-      else
-      {
-        pi = m_apiMVPNum[eRefPicList] + uiAbsPartIdx;
-        for (i = 0; i < (uiCurrPartNumQ>>1); i++)
-        {
-          pi[i] = iMVPNum;
-        }
-
-        pi = m_apiMVPNum[eRefPicList] + uiAbsPartIdx + uiCurrPartNumQ;
-        for (i = 0; i < ( (uiCurrPartNumQ>>1) + (uiCurrPartNumQ<<1) ); i++)
-        {
-          pi[i] = iMVPNum;
-        }
-      }
-      break;
-    }
-  case SIZE_2NxnD:
-    {
-      if( uiPartIdx == 0 )
-      {
-        pi = m_apiMVPNum[eRefPicList] + uiAbsPartIdx;
-        for (i = 0; i < ( (uiCurrPartNumQ>>1) + (uiCurrPartNumQ<<1) ); i++)
-        {
-          pi[i] = iMVPNum;
-        }
-        pi = m_apiMVPNum[eRefPicList] + uiAbsPartIdx + ( uiCurrPartNumQ + (uiCurrPartNumQ<<1) );
-        for (i = 0; i < (uiCurrPartNumQ>>1); i++)
-        {
-          pi[i] = iMVPNum;
-        }
-      }
-      else
-      {
-             pi  = m_apiMVPNum[eRefPicList] + uiAbsPartIdx;
-        Int* pi2 = m_apiMVPNum[eRefPicList] + uiAbsPartIdx + uiCurrPartNumQ;
-        for (i = 0; i < (uiCurrPartNumQ>>1); i++)
-        {
-          pi [i] = iMVPNum;
-          pi2[i] = iMVPNum;
-        }
-      }
-      break;
-    }
-  case SIZE_nLx2N:
-    {
-      if( uiPartIdx == 0 )
-      {
-             pi  = m_apiMVPNum[eRefPicList] + uiAbsPartIdx;
-        Int* pi2 = m_apiMVPNum[eRefPicList] + uiAbsPartIdx + (uiCurrPartNumQ<<1);
-        Int* pi3 = m_apiMVPNum[eRefPicList] + uiAbsPartIdx + (uiCurrPartNumQ>>1);
-        Int* pi4 = m_apiMVPNum[eRefPicList] + uiAbsPartIdx + (uiCurrPartNumQ<<1) + (uiCurrPartNumQ>>1);
-
-        for (i = 0; i < (uiCurrPartNumQ>>2); i++)
-        {
-          pi [i] = iMVPNum;
-          pi2[i] = iMVPNum;
-          pi3[i] = iMVPNum;
-          pi4[i] = iMVPNum;
-        }
-      }
-      else
-      {
-             pi  = m_apiMVPNum[eRefPicList] + uiAbsPartIdx;
-        Int* pi2 = m_apiMVPNum[eRefPicList] + uiAbsPartIdx + (uiCurrPartNumQ<<1);
-        for (i = 0; i < (uiCurrPartNumQ>>2); i++)
-        {
-          pi [i] = iMVPNum;
-          pi2[i] = iMVPNum;
-        }
-
-        pi  = m_apiMVPNum[eRefPicList] + uiAbsPartIdx + (uiCurrPartNumQ>>1);
-        pi2 = m_apiMVPNum[eRefPicList] + uiAbsPartIdx + (uiCurrPartNumQ<<1) + (uiCurrPartNumQ>>1);
-        for (i = 0; i < ( (uiCurrPartNumQ>>2) + uiCurrPartNumQ ); i++)
-        {
-          pi [i] = iMVPNum;
-          pi2[i] = iMVPNum;
-        }
-      }
-      break;
-    }
-  case SIZE_nRx2N:
-    {
-      if( uiPartIdx == 0 )
-      {
-             pi  = m_apiMVPNum[eRefPicList] + uiAbsPartIdx;
-        Int* pi2 = m_apiMVPNum[eRefPicList] + uiAbsPartIdx + (uiCurrPartNumQ<<1);
-        for (i = 0; i < ( (uiCurrPartNumQ>>2) + uiCurrPartNumQ ); i++)
-        {
-          pi [i] = iMVPNum;
-          pi2[i] = iMVPNum;
-        }
-
-        pi  = m_apiMVPNum[eRefPicList] + uiAbsPartIdx + uiCurrPartNumQ + (uiCurrPartNumQ>>1);
-        pi2 = m_apiMVPNum[eRefPicList] + uiAbsPartIdx + uiCurrPartNumQ + (uiCurrPartNumQ>>1) + (uiCurrPartNumQ<<1);
-        for (i = 0; i < (uiCurrPartNumQ>>2); i++)
-        {
-          pi [i] = iMVPNum;
-          pi2[i] = iMVPNum;
-        }
-      }
-      else
-      {
-             pi  = m_apiMVPNum[eRefPicList] + uiAbsPartIdx;
-        Int* pi2 = m_apiMVPNum[eRefPicList] + uiAbsPartIdx + (uiCurrPartNumQ>>1);
-        Int* pi3 = m_apiMVPNum[eRefPicList] + uiAbsPartIdx + (uiCurrPartNumQ<<1);
-        Int* pi4 = m_apiMVPNum[eRefPicList] + uiAbsPartIdx + (uiCurrPartNumQ<<1) + (uiCurrPartNumQ>>1);
-        for (i = 0; i < (uiCurrPartNumQ>>2); i++)
-        {
-          pi [i] = iMVPNum;
-          pi2[i] = iMVPNum;
-          pi3[i] = iMVPNum;
-          pi4[i] = iMVPNum;
-        }
-      }
-      break;
-    }
-  default:
-    assert( 0 );
-  }
-}
+Void TComDataCU::setMVPNumSubParts( Int iMVPNum, RefPicList eRefPicList, UInt uiAbsPartIdx, UInt uiPartIdx, UInt uiDepth )
+{
+  setPURuns( m_apiMVPNum[eRefPicList] + uiAbsPartIdx, iMVPNum, m_pePartSize[ uiAbsPartIdx ], uiPartIdx, m_pcPic->getNumPartInCU() >> ( uiDepth << 1 ) );
+}
 
 #ifdef DCM_PBIC
 Void TComDataCU::setICPIdxSubParts( Int iICPIdx, UInt uiAbsPartIdx, UInt uiPartIdx, UInt uiDepth )
 {
-  UInt uiCurrPartNumQ = m_pcPic->getNumPartInCU() >> (uiDepth << 1) >> 2;
-  Int i;
-  Int* pi;
-  switch ( m_pePartSize[ uiAbsPartIdx ] )
-  {
-  case SIZE_2Nx2N:
-    {
-      pi = m_piICPIdx + uiAbsPartIdx;
-      for (i = 0; i < (uiCurrPartNumQ << 2); i++)
-      {
-        pi[i] = iICPIdx;
-      }
-   }
-  break;
-  case SIZE_2NxN:
-    {
-      pi = m_piICPIdx + uiAbsPartIdx;
-      for (i = 0; i < (uiCurrPartNumQ << 1); i++)
-      {
-        pi[i] = iICPIdx;
-      }
-   }
-  break;
-  case SIZE_Nx2N:
-    {
-      Int* pi2 = m_piICPIdx + uiAbsPartIdx + ( uiCurrPartNumQ << 1 );
-      pi = m_piICPIdx + uiAbsPartIdx;
-      for (i = 0; i < uiCurrPartNumQ; i++)
-      {
-        pi [i] = iICPIdx;
-        pi2[i] = iICPIdx;
-      }
-      break;
-    }
-  case SIZE_NxN:
-    {
-      pi = m_piICPIdx + uiAbsPartIdx;
-      for (i = 0; i < uiCurrPartNumQ; i++)
-      {
-        pi[i] = iICPIdx;
-      }
-      break;
-    }
-  case SIZE_2NxnU:
-    {
-      if( uiPartIdx == 0 )
-      {
-             pi  = m_piICPIdx + uiAbsPartIdx;
-        Int* pi2 = m_piICPIdx + uiAbsPartIdx + uiCurrPartNumQ;
-        for (i = 0; i < (uiCurrPartNumQ>>1); i++)
-        {
-          pi [i] = iICPIdx;
-          pi2[i] = iICPIdx;
-        }
-      }
-      else
-      {
-        pi = m_piICPIdx + uiAbsPartIdx;
-        for (i = 0; i < (uiCurrPartNumQ>>1); i++)
-        {
-          pi[i] = iICPIdx;
-        }
-
-        pi = m_piICPIdx + uiAbsPartIdx + uiCurrPartNumQ;
-        for (i = 0; i < ( (uiCurrPartNumQ>>1) + (uiCurrPartNumQ<<1) ); i++)
-        {
-          pi[i] = iICPIdx;
-        }
-      }
-      break;
-    }
-  case SIZE_2NxnD:
-    {
-      if( uiPartIdx == 0 )
-      {
-        pi = m_piICPIdx + uiAbsPartIdx;
-        for (i = 0; i < ( (uiCurrPartNumQ>>1) + (uiCurrPartNumQ<<1) ); i++)
-        {
-          pi[i] = iICPIdx;
-        }
-        pi = m_piICPIdx + uiAbsPartIdx + ( uiCurrPartNumQ + (uiCurrPartNumQ<<1) );
-        for (i = 0; i < (uiCurrPartNumQ>>1); i++)
-        {
-          pi[i] = iICPIdx;
-        }
-      }
-      else
-      {
-             pi  = m_piICPIdx + uiAbsPartIdx;
-        Int* pi2 = m_piICPIdx + uiAbsPartIdx + uiCurrPartNumQ;
-        for (i = 0; i < (uiCurrPartNumQ>>1); i++)
-        {
-          pi [i] = iICPIdx;
-          pi2[i] = iICPIdx;
-        }
-      }
-      break;
-    }
-  case SIZE_nLx2N:
-    {
-      if( uiPartIdx == 0 )
-      {
-             pi  = m_piICPIdx + uiAbsPartIdx;
-        Int* pi2 = m_piICPIdx + uiAbsPartIdx + (uiCurrPartNumQ<<1);
-        Int* pi3 = m_piICPIdx + uiAbsPartIdx + (uiCurrPartNumQ>>1);
-        Int* pi4 = m_piICPIdx + uiAbsPartIdx + (uiCurrPartNumQ<<1) + (uiCurrPartNumQ>>1);
-
-        for (i = 0; i < (uiCurrPartNumQ>>2); i++)
-        {
-          pi [i] = iICPIdx;
-          pi2[i] = iICPIdx;
-          pi3[i] = iICPIdx;
-          pi4[i] = iICPIdx;
-        }
-      }
-      else
-      {
-             pi  = m_piICPIdx + uiAbsPartIdx;
-        Int* pi2 = m_piICPIdx + uiAbsPartIdx + (uiCurrPartNumQ<<1);
-        for (i = 0; i < (uiCurrPartNumQ>>2); i++)
-        {
-          pi [i] = iICPIdx;
-          pi2[i] = iICPIdx;
-        }
-
-        pi  = m_piICPIdx + uiAbsPartIdx + (uiCurrPartNumQ>>1);
-        pi2 = m_piICPIdx + uiAbsPartIdx + (uiCurrPartNumQ<<1) + (uiCurrPartNumQ>>1);
-        for (i = 0; i < ( (uiCurrPartNumQ>>2) + uiCurrPartNumQ ); i++)
-        {
-          pi [i] = iICPIdx;
-          pi2[i] = iICPIdx;
-        }
-      }
-      break;
-    }
-  case SIZE_nRx2N:
-    {
-      if( uiPartIdx == 0 )
-      {
-             pi  = m_piICPIdx + uiAbsPartIdx;
-        Int* pi2 = m_piICPIdx + uiAbsPartIdx + (uiCurrPartNumQ<<1);
-        for (i = 0; i < ( (uiCurrPartNumQ>>2) + uiCurrPartNumQ ); i++)
-        {
-          pi [i] = iICPIdx;
-          pi2[i] = iICPIdx;
-        }
-
-        pi  = m_piICPIdx + uiAbsPartIdx + uiCurrPartNumQ + (uiCurrPartNumQ>>1);
-        pi2 = m_piICPIdx + uiAbsPartIdx + (uiCurrPartNumQ<<1) + uiCurrPartNumQ + (uiCurrPartNumQ>>1);
-        for (i = 0; i < (uiCurrPartNumQ>>2); i++)
-        {
-          pi [i] = iICPIdx;
-          pi2[i] = iICPIdx;
-        }
-      }
-      else
-      {
-             pi  = m_piICPIdx + uiAbsPartIdx;
-        Int* pi2 = m_piICPIdx + uiAbsPartIdx + (uiCurrPartNumQ>>1);
-        Int* pi3 = m_piICPIdx + uiAbsPartIdx + (uiCurrPartNumQ<<1);
-        Int* pi4 = m_piICPIdx + uiAbsPartIdx + (uiCurrPartNumQ<<1) + (uiCurrPartNumQ>>1);
-        for (i = 0; i < (uiCurrPartNumQ>>2); i++)
-        {
-          pi [i] = iICPIdx;
-          pi2[i] = iICPIdx;
-          pi3[i] = iICPIdx;
-          pi4[i] = iICPIdx;
-        }
-      }
-      break;
-    }
-  default:
-    assert( 0 );
-  }
+  setPURuns( m_piICPIdx + uiAbsPartIdx, iICPIdx, m_pePartSize[ uiAbsPartIdx ], uiPartIdx, m_pcPic->getNumPartInCU() >> ( uiDepth << 1 ) );
 }
 
 Void TComDataCU::setICPNumSubParts( Int iICPNum, UInt uiAbsPartIdx, UInt uiPartIdx, UInt uiDepth )
 {
-  UInt uiCurrPartNumQ = m_pcPic->getNumPartInCU() >> (uiDepth << 1) >> 2;
-  Int i;
-  Int* pi;
-  switch ( m_pePartSize[ uiAbsPartIdx ] )
-  {
-  case SIZE_2Nx2N:
-    {
-      pi = m_piICPNum + uiAbsPartIdx;
-      for (i = 0; i < (uiCurrPartNumQ << 2); i++)
-      {
-        pi[i] = iICPNum;
-      }
-   }
-  break;
-  case SIZE_2NxN:
-    {
-      pi = m_piICPNum + uiAbsPartIdx;
-      for (i = 0; i < (uiCurrPartNumQ << 1); i++)
-      {
-        pi[i] = iICPNum;
-      }
-   }
-  break;
-  case SIZE_Nx2N:
-    {
-      Int* pi2 = m_piICPNum + uiAbsPartIdx + ( uiCurrPartNumQ << 1 );
-      pi = m_piICPNum + uiAbsPartIdx;
-      for (i = 0; i < uiCurrPartNumQ; i++)
-      {
-        pi [i] = iICPNum;
-        pi2[i] = iICPNum;
-      }
-      break;
-    }
-  case SIZE_NxN:
-    {
-      pi = m_piICPNum + uiAbsPartIdx;
-      for (i = 0; i < uiCurrPartNumQ; i++)
-      {
-        pi[i] = iICPNum;
-      }
-      break;
-    }
-  case SIZE_2NxnU:
-    {
-      if( uiPartIdx == 0 )
-      {
-             pi  = m_piICPNum + uiAbsPartIdx;
-        Int* pi2 = m_piICPNum + uiAbsPartIdx + uiCurrPartNumQ;
-        for (i = 0; i < (uiCurrPartNumQ>>1); i++)
-        {
-          pi [i] = iICPNum;
-          pi2[i] = iICPNum;
-        }
-      }
-      else
-      {
-        pi = m_piICPNum + uiAbsPartIdx;
-        for (i = 0; i < (uiCurrPartNumQ>>1); i++)
-        {
-          pi[i] = iICPNum;
-        }
-
-        pi = m_piICPNum + uiAbsPartIdx + uiCurrPartNumQ;
-        for (i = 0; i < ( (uiCurrPartNumQ>>1) + (uiCurrPartNumQ<<1) ); i++)
-        {
-          pi[i] = iICPNum;
-        }
-      }
-      break;
-    }
-  case SIZE_2NxnD:
-    {
-      if( uiPartIdx == 0 )
-      {
-        pi = m_piICPNum + uiAbsPartIdx;
-        for (i = 0; i < ( (uiCurrPartNumQ>>1) + (uiCurrPartNumQ<<1) ); i++)
-        {
-          pi[i] = iICPNum;
-        }
-        pi = m_piICPNum + uiAbsPartIdx + ( uiCurrPartNumQ + (uiCurrPartNumQ<<1) );
-        for (i = 0; i < (uiCurrPartNumQ>>1); i++)
-        {
-          pi[i] = iICPNum;
-        }
-      }
-      else
-      {
-             pi  = m_piICPNum + uiAbsPartIdx;
-        Int* pi2 = m_piICPNum + uiAbsPartIdx + uiCurrPartNumQ;
-        for (i = 0; i < (uiCurrPartNumQ>>1); i++)
-        {
-          pi [i] = iICPNum;
-          pi2[i] = iICPNum;
-        }
-      }
-      break;
-    }
-  case SIZE_nLx2N:
-    {
-      if( uiPartIdx == 0 )
-      {
-             pi  = m_piICPNum + uiAbsPartIdx;
-        Int* pi2 = m_piICPNum + uiAbsPartIdx + (uiCurrPartNumQ<<1);
-        Int* pi3 = m_piICPNum + uiAbsPartIdx + (uiCurrPartNumQ>>1);
-        Int* pi4 = m_piICPNum + uiAbsPartIdx + (uiCurrPartNumQ<<1) + (uiCurrPartNumQ>>1);
-
-        for (i = 0; i < (uiCurrPartNumQ>>2); i++)
-        {
-          pi [i] = iICPNum;
-          pi2[i] = iICPNum;
-          pi3[i] = iICPNum;
-          pi4[i] = iICPNum;
-        }
-      }
-      else
-      {
-             pi  = m_piICPNum + uiAbsPartIdx;
-        Int* pi2 = m_piICPNum + uiAbsPartIdx + (uiCurrPartNumQ<<1);
-        for (i = 0; i < (uiCurrPartNumQ>>2); i++)
-        {
-          pi [i] = iICPNum;
-          pi2[i] = iICPNum;
-        }
-
-        pi  = m_piICPNum + uiAbsPartIdx + (uiCurrPartNumQ>>1);
-        pi2 = m_piICPNum + uiAbsPartIdx + (uiCurrPartNumQ<<1) + (uiCurrPartNumQ>>1);
-        for (i = 0; i < ( (uiCurrPartNumQ>>2) + uiCurrPartNumQ ); i++)
-        {
-          pi [i] = iICPNum;
-          pi2[i] = iICPNum;
-        }
-      }
-      break;
-    }
-  case SIZE_nRx2N:
-    {
-      if( uiPartIdx == 0 )
-      {
-             pi  = m_piICPNum + uiAbsPartIdx;
-        Int* pi2 = m_piICPNum + uiAbsPartIdx + (uiCurrPartNumQ<<1);
-        for (i = 0; i < ( (uiCurrPartNumQ>>2) + uiCurrPartNumQ ); i++)
-        {
-          pi [i] = iICPNum;
-          pi2[i] = iICPNum;
-        }
-
-        pi  = m_piICPNum + uiAbsPartIdx + uiCurrPartNumQ + (uiCurrPartNumQ>>1);
-        pi2 = m_piICPNum + uiAbsPartIdx + (uiCurrPartNumQ<<1) + uiCurrPartNumQ + (uiCurrPartNumQ>>1);
-        for (i = 0; i < (uiCurrPartNumQ>>2); i++)
-        {
-          pi [i] = iICPNum;
-          pi2[i] = iICPNum;
-        }
-      }
-      else
-      {
-             pi  = m_piICPNum + uiAbsPartIdx;
-        Int* pi2 = m_piICPNum + uiAbsPartIdx + (uiCurrPartNumQ>>1);
-        Int* pi3 = m_piICPNum + uiAbsPartIdx + (uiCurrPartNumQ<<1);
-        Int* pi4 = m_piICPNum + uiAbsPartIdx + (uiCurrPartNumQ<<1) + (uiCurrPartNumQ>>1);
-        for (i = 0; i < (uiCurrPartNumQ>>2); i++)
-        {
-          pi [i] = iICPNum;
-          pi2[i] = iICPNum;
-          pi3[i] = iICPNum;
-          pi4[i] = iICPNum;
-        }
-      }
-      break;
-    }
-  default:
-    assert( 0 );
-  }
+  setPURuns( m_piICPNum + uiAbsPartIdx, iICPNum, m_pePartSize[ uiAbsPartIdx ], uiPartIdx, m_pcPic->getNumPartInCU() >> ( uiDepth << 1 ) );
 }
 #endif //DCM_PBIC
 
@@ -181,12 +181,21 @@ private:
   // -------------------------------------------------------------------------------------------------------------------
 
   Bool          m_bDecSubCu;          ///< indicates decoder-mode
+  UChar*        m_pucPartStorage;     ///< single block holding all per-partition arrays of this CU
+  UInt          m_uiNumAllocPart;     ///< number of partitions the per-partition arrays are allocated for
   Double        m_dTotalCost;         ///< sum of partition RD costs
   UInt          m_uiTotalDistortion;  ///< sum of partition distortion
   UInt          m_uiTotalBits;        ///< sum of partition bits
 
 protected:
 
+  /// take an array of uiNum elements from the per-partition block
+  template <typename T>
+  static T*     xTakePartArray        ( UChar*& rpucBlock, UInt uiNum ) { T* p = (T*)rpucBlock; rpucBlock += sizeof(T)*uiNum; return p; }
+
+  /// set uiNumFields adjacent per-partition arrays to one byte value
+  Void          xSetPartArrays        ( Void* pFirst, Int iValue, UInt uiNumFields, UInt uiElemSize );
+
   /// add possible motion vector predictor candidates
   Bool          xAddMVPCand           ( AMVPInfo* pInfo, RefPicList eRefPicList, Int iRefIdx, UInt uiPartUnitIdx, MVP_DIR eDir );
 
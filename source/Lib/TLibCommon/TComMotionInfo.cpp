@@ -35,6 +35,7 @@
 
 #include <memory.h>
 #include "TComMotionInfo.h"
+#include "TComRom.h"
 #include "assert.h"
 #include <stdlib.h>
 
@@ -167,526 +168,17 @@ Void TComCUMvField::copyMvTo( TComCUMvField* pcCUMvFieldDst, Int iPartAddrDst )
 
 Void TComCUMvField::setAllMv( TComMv& rcMv, PartSize eCUMode, Int iPartAddr, Int iPartIdx, UInt uiDepth )
 {
-  Int i;
-  TComMv* pcMv = m_pcMv + iPartAddr;
-  register TComMv cMv = rcMv;
-  Int iNumPartition = m_uiNumPartition >> (uiDepth<<1);
-
-  switch( eCUMode )
-  {
-  case SIZE_2Nx2N:
-    for ( i = iNumPartition - 1; i >= 0; i-- )
-    {
-      pcMv[ i ] = cMv;
-    }
-    break;
-  case SIZE_2NxN:
-    for ( i = ( iNumPartition >> 1 ) - 1; i >= 0; i-- )
-    {
-      pcMv[ i ] = cMv;
-    }
-    break;
-  case SIZE_Nx2N:
-    {
-      UInt uiOffset = iNumPartition >> 1;
-      for ( i = ( iNumPartition >> 2 ) - 1; i >= 0; i-- )
-      {
-        pcMv[ i ] = cMv;
-        pcMv[ i + uiOffset ] = cMv;
-      }
-      break;
-    }
-  case SIZE_NxN:
-    for ( i = ( iNumPartition >> 2 ) - 1; i >= 0; i-- )
-    {
-      pcMv[ i ] = cMv;
-    }
-    break;
-  case SIZE_2NxnU:
-    {
-      Int iCurrPartNumQ = iNumPartition>>2;
-      if( iPartIdx == 0 )
-      {
-        TComMv* pi  = pcMv;
-        TComMv* pi2 = pcMv + iCurrPartNumQ;
-        for (i = 0; i < (iCurrPartNumQ>>1); i++)
-        {
-          pi [i] = cMv;
-          pi2[i] = cMv;
-        }
-      }
-      else
-      {
-        TComMv* pi  = pcMv;
-        for (i = 0; i < (iCurrPartNumQ>>1); i++)
-        {
-          pi[i] = cMv;
-        }
-
-        pi = pcMv + iCurrPartNumQ;
-        for (i = 0; i < ( (iCurrPartNumQ>>1) + (iCurrPartNumQ<<1) ); i++)
-        {
-          pi[i] = cMv;
-        }
-      }
-      break;
-    }
-  case SIZE_2NxnD:
-    {
-      Int iCurrPartNumQ = iNumPartition>>2;
-      if( iPartIdx == 0 )
-      {
-        TComMv* pi  = pcMv;
-        for (i = 0; i < ( (iCurrPartNumQ>>1) + (iCurrPartNumQ<<1) ); i++)
-        {
-          pi[i] = cMv;
-        }
-        pi = pcMv + ( iNumPartition - iCurrPartNumQ );
-        for (i = 0; i < (iCurrPartNumQ>>1); i++)
-        {
-          pi[i] = cMv;
-        }
-      }
-      else
-      {
-        TComMv* pi  = pcMv;
-        TComMv* pi2 = pcMv + iCurrPartNumQ;
-        for (i = 0; i < (iCurrPartNumQ>>1); i++)
-        {
-          pi [i] = cMv;
-          pi2[i] = cMv;
-        }
-      }
-      break;
-    }
-  case SIZE_nLx2N:
-    {
-      Int iCurrPartNumQ = iNumPartition>>2;
-      if( iPartIdx == 0 )
-      {
-        TComMv* pi  = pcMv;
-        TComMv* pi2 = pcMv + (iCurrPartNumQ<<1);
-        TComMv* pi3 = pcMv + (iCurrPartNumQ>>1);
-        TComMv* pi4 = pcMv + (iCurrPartNumQ<<1) + (iCurrPartNumQ>>1);
-
-        for (i = 0; i < (iCurrPartNumQ>>2); i++)
-        {
-          pi [i] = cMv;
-          pi2[i] = cMv;
-          pi3[i] = cMv;
-          pi4[i] = cMv;
-        }
-      }
-      else
-      {
-        TComMv* pi  = pcMv;
-        TComMv* pi2 = pcMv + (iCurrPartNumQ<<1);
-        for (i = 0; i < (iCurrPartNumQ>>2); i++)
-        {
-          pi [i] = cMv;
-          pi2[i] = cMv;
-        }
-
-        pi  = pcMv + (iCurrPartNumQ>>1);
-        pi2 = pcMv + (iCurrPartNumQ<<1) + (iCurrPartNumQ>>1);
-        for (i = 0; i < ( (iCurrPartNumQ>>2) + iCurrPartNumQ ); i++)
-        {
-          pi [i] = cMv;
-          pi2[i] = cMv;
-        }
-      }
-      break;
-    }
-  case SIZE_nRx2N:
-    {
-      Int iCurrPartNumQ = iNumPartition>>2;
-      if( iPartIdx == 0 )
-      {
-        TComMv* pi  = pcMv;
-        TComMv* pi2 = pcMv + (iCurrPartNumQ<<1);
-        for (i = 0; i < ( (iCurrPartNumQ>>2) + iCurrPartNumQ ); i++)
-        {
-          pi [i] = cMv;
-          pi2[i] = cMv;
-        }
-
-        pi  = pcMv + iCurrPartNumQ + (iCurrPartNumQ>>1);
-        pi2 = pcMv + iNumPartition - iCurrPartNumQ + (iCurrPartNumQ>>1);
-        for (i = 0; i < (iCurrPartNumQ>>2); i++)
-        {
-          pi [i] = cMv;
-          pi2[i] = cMv;
-        }
-      }
-      else
-      {
-        TComMv* pi  = pcMv;
-        TComMv* pi2 = pcMv + (iCurrPartNumQ>>1);
-        TComMv* pi3 = pcMv + (iCurrPartNumQ<<1);
-        TComMv* pi4 = pcMv + (iCurrPartNumQ<<1) + (iCurrPartNumQ>>1);
-        for (i = 0; i < (iCurrPartNumQ>>2); i++)
-        {
-          pi [i] = cMv;
-          pi2[i] = cMv;
-          pi3[i] = cMv;
-          pi4[i] = cMv;
-        }
-      }
-      break;
-    }
-  default:
-    assert(0);
-    break;
-  }
+  setPURuns( m_pcMv + iPartAddr, rcMv, eCUMode, iPartIdx, m_uiNumPartition >> ( uiDepth << 1 ) );
 }
 
 Void TComCUMvField::setAllMvd( TComMv& rcMvd, PartSize eCUMode, Int iPartAddr, Int iPartIdx, UInt uiDepth )
 {
-  Int i;
-  TComMv* pcMvd = m_pcMvd + iPartAddr;
-  register TComMv cMvd = rcMvd;
-  Int iNumPartition = m_uiNumPartition >> (uiDepth<<1);
-
-  switch( eCUMode )
-  {
-  case SIZE_2Nx2N:
-    for ( i = iNumPartition - 1; i >= 0; i-- )
-    {
-      pcMvd[ i ] = cMvd;
-    }
-    break;
-  case SIZE_2NxN:
-    for ( i = ( iNumPartition >> 1 ) - 1; i >= 0; i-- )
-    {
-      pcMvd[ i ] = cMvd;
-    }
-    break;
-  case SIZE_Nx2N:
-    {
-      UInt uiOffset = iNumPartition >> 1;
-      for ( i = ( iNumPartition >> 2 ) - 1; i >= 0; i-- )
-      {
-        pcMvd[ i ] = cMvd;
-        pcMvd[ i + uiOffset ] = cMvd;
-      }
-      break;
-    }
-  case SIZE_NxN:
-    for ( i = ( iNumPartition >> 2 ) - 1; i >= 0; i-- )
-    {
-      pcMvd[ i ] = cMvd;
-    }
-    break;
-  case SIZE_2NxnU:
-    {
-      Int iCurrPartNumQ = iNumPartition>>2;
-      if( iPartIdx == 0 )
-      {
-        TComMv* pi  = pcMvd;
-        TComMv* pi2 = pcMvd + iCurrPartNumQ;
-        for (i = 0; i < (iCurrPartNumQ>>1); i++)
-        {
-          pi [i] = cMvd;
-          pi2[i] = cMvd;
-        }
-      }
-      else
-      {
-        TComMv* pi  = pcMvd;
-        for (i = 0; i < (iCurrPartNumQ>>1); i++)
-        {
-          pi[i] = cMvd;
-        }
-
-        pi = pcMvd + iCurrPartNumQ;
-        for (i = 0; i < ( (iCurrPartNumQ>>1) + (iCurrPartNumQ<<1) ); i++)
-        {
-          pi[i] = cMvd;
-        }
-      }
-      break;
-    }
-  case SIZE_2NxnD:
-    {
-      Int iCurrPartNumQ = iNumPartition>>2;
-      if( iPartIdx == 0 )
-      {
-        TComMv* pi  = pcMvd;
-        for (i = 0; i < ( (iCurrPartNumQ>>1) + (iCurrPartNumQ<<1) ); i++)
-        {
-          pi[i] = cMvd;
-        }
-        pi = pcMvd + ( iNumPartition - iCurrPartNumQ );
-        for (i = 0; i < (iCurrPartNumQ>>1); i++)
-        {
-          pi[i] = cMvd;
-        }
-      }
-      else
-      {
-        TComMv* pi  = pcMvd;
-        TComMv* pi2 = pcMvd + iCurrPartNumQ;
-        for (i = 0; i < (iCurrPartNumQ>>1); i++)
-        {
-          pi [i] = cMvd;
-          pi2[i] = cMvd;
-        }
-      }
-      break;
-    }
-  case SIZE_nLx2N:
-    {
-      Int iCurrPartNumQ = iNumPartition>>2;
-      if( iPartIdx == 0 )
-      {
-        TComMv* pi  = pcMvd;
-        TComMv* pi2 = pcMvd + (iCurrPartNumQ<<1);
-        TComMv* pi3 = pcMvd + (iCurrPartNumQ>>1);
-        TComMv* pi4 = pcMvd + (iCurrPartNumQ<<1) + (iCurrPartNumQ>>1);
-
-        for (i = 0; i < (iCurrPartNumQ>>2); i++)
-        {
-          pi [i] = cMvd;
-          pi2[i] = cMvd;
-          pi3[i] = cMvd;
-          pi4[i] = cMvd;
-        }
-      }
-      else
-      {
-        TComMv* pi  = pcMvd;
-        TComMv* pi2 = pcMvd + (iCurrPartNumQ<<1);
-        for (i = 0; i < (iCurrPartNumQ>>2); i++)
-        {
-          pi [i] = cMvd;
-          pi2[i] = cMvd;
-        }
-
-        pi  = pcMvd + (iCurrPartNumQ>>1);
-        pi2 = pcMvd + (iCurrPartNumQ<<1) + (iCurrPartNumQ>>1);
-        for (i = 0; i < ( (iCurrPartNumQ>>2) + iCurrPartNumQ ); i++)
-        {
-          pi [i] = cMvd;
-          pi2[i] = cMvd;
-        }
-      }
-      break;
-    }
-  case SIZE_nRx2N:
-    {
-      Int iCurrPartNumQ = iNumPartition>>2;
-      if( iPartIdx == 0 )
-      {
-        TComMv* pi  = pcMvd;
-        TComMv* pi2 = pcMvd + (iCurrPartNumQ<<1);
-        for (i = 0; i < ( (iCurrPartNumQ>>2) + iCurrPartNumQ ); i++)
-        {
-          pi [i] = cMvd;
-          pi2[i] = cMvd;
-        }
-
-        pi  = pcMvd + iCurrPartNumQ + (iCurrPartNumQ>>1);
-        pi2 = pcMvd + iNumPartition - iCurrPartNumQ + (iCurrPartNumQ>>1);
-        for (i = 0; i < (iCurrPartNumQ>>2); i++)
-        {
-          pi [i] = cMvd;
-          pi2[i] = cMvd;
-        }
-      }
-      else
-      {
-        TComMv* pi  = pcMvd;
-        TComMv* pi2 = pcMvd + (iCurrPartNumQ>>1);
-        TComMv* pi3 = pcMvd + (iCurrPartNumQ<<1);
-        TComMv* pi4 = pcMvd + (iCurrPartNumQ<<1) + (iCurrPartNumQ>>1);
-        for (i = 0; i < (iCurrPartNumQ>>2); i++)
-        {
-          pi [i] = cMvd;
-          pi2[i] = cMvd;
-          pi3[i] = cMvd;
-          pi4[i] = cMvd;
-        }
-      }
-      break;
-    }
-  default:
-    assert(0);
-    break;
-  }
+  setPURuns( m_pcMvd + iPartAddr, rcMvd, eCUMode, iPartIdx, m_uiNumPartition >> ( uiDepth << 1 ) );
 }
 
 Void TComCUMvField::setAllRefIdx ( Int iRefIdx, PartSize eCUMode, Int iPartAddr, Int iPartIdx, UInt uiDepth )
 {
-  Int i;
-  Int* piRefIdx = m_piRefIdx + iPartAddr;
-  Int iNumPartition = m_uiNumPartition >> (uiDepth<<1);
-
-  switch( eCUMode )
-  {
-  case SIZE_2Nx2N:
-    for ( i = iNumPartition - 1; i >= 0; i-- )
-    {
-      piRefIdx[ i ] = iRefIdx;
-    }
-    break;
-  case SIZE_2NxN:
-    for ( i = ( iNumPartition >> 1 ) - 1; i >= 0; i-- )
-    {
-      piRefIdx[ i ] = iRefIdx;
-    }
-    break;
-  case SIZE_Nx2N:
-    {
-      UInt uiOffset = iNumPartition >> 1;
-      for ( i = ( iNumPartition >> 2 ) - 1; i >= 0; i-- )
-      {
-        piRefIdx[ i ] = iRefIdx;
-        piRefIdx[ i + uiOffset ] = iRefIdx;
-      }
-      break;
-    }
-  case SIZE_NxN:
-    for ( i = ( iNumPartition >> 2 ) - 1; i >= 0; i-- )
-    {
-      piRefIdx[ i ] = iRefIdx;
-    }
-    break;
-  case SIZE_2NxnU:
-    {
-      Int iCurrPartNumQ = iNumPartition>>2;
-      if( iPartIdx == 0 )
-      {
-        Int* pi  = piRefIdx;
-        Int* pi2 = piRefIdx + iCurrPartNumQ;
-        for (i = 0; i < (iCurrPartNumQ>>1); i++)
-        {
-          pi [i] = iRefIdx;
-          pi2[i] = iRefIdx;
-        }
-      }
-      else
-      {
-        Int* pi  = piRefIdx;
-        for (i = 0; i < (iCurrPartNumQ>>1); i++)
-        {
-          pi[i] = iRefIdx;
-        }
-
-        pi = piRefIdx + iCurrPartNumQ;
-        for (i = 0; i < ( (iCurrPartNumQ>>1) + (iCurrPartNumQ<<1) ); i++)
-        {
-          pi[i] = iRefIdx;
-        }
-      }
-      break;
-    }
-  case SIZE_2NxnD:
-    {
-      Int iCurrPartNumQ = iNumPartition>>2;
-      if( iPartIdx == 0 )
-      {
-        Int* pi  = piRefIdx;
-        for (i = 0; i < ( (iCurrPartNumQ>>1) + (iCurrPartNumQ<<1) ); i++)
-        {
-          pi[i] = iRefIdx;
-        }
-        pi = piRefIdx + iNumPartition - iCurrPartNumQ;
-        for (i = 0; i < (iCurrPartNumQ>>1); i++)
-        {
-          pi[i] = iRefIdx;
-        }
-      }
-      else
-      {
-        Int* pi  = piRefIdx;
-        Int* pi2 = piRefIdx + iCurrPartNumQ;
-        for (i = 0; i < (iCurrPartNumQ>>1); i++)
-        {
-          pi [i] = iRefIdx;
-          pi2[i] = iRefIdx;
-        }
-      }
-      break;
-    }
-  case SIZE_nLx2N:
-    {
-      Int iCurrPartNumQ = iNumPartition>>2;
-      if( iPartIdx == 0 )
-      {
-        Int* pi  = piRefIdx;
-        Int* pi2 = piRefIdx + (iCurrPartNumQ<<1);
-        Int* pi3 = piRefIdx + (iCurrPartNumQ>>1);
-        Int* pi4 = piRefIdx + (iCurrPartNumQ<<1) + (iCurrPartNumQ>>1);
-
-        for (i = 0; i < (iCurrPartNumQ>>2); i++)
-        {
-          pi [i] = iRefIdx;
-          pi2[i] = iRefIdx;
-          pi3[i] = iRefIdx;
-          pi4[i] = iRefIdx;
-        }
-      }
-      else
-      {
-        Int* pi  = piRefIdx;
-        Int* pi2 = piRefIdx + (iCurrPartNumQ<<1);
-        for (i = 0; i < (iCurrPartNumQ>>2); i++)
-        {
-          pi [i] = iRefIdx;
-          pi2[i] = iRefIdx;
-        }
-
-        pi  = piRefIdx + (iCurrPartNumQ>>1);
-        pi2 = piRefIdx + (iCurrPartNumQ<<1) + (iCurrPartNumQ>>1);
-        for (i = 0; i < ( (iCurrPartNumQ>>2) + iCurrPartNumQ ); i++)
-        {
-          pi [i] = iRefIdx;
-          pi2[i] = iRefIdx;
-        }
-      }
-      break;
-    }
-  case SIZE_nRx2N:
-    {
-      Int iCurrPartNumQ = iNumPartition>>2;
-      if( iPartIdx == 0 )
-      {
-        Int* pi  = piRefIdx;
-        Int* pi2 = piRefIdx + (iCurrPartNumQ<<1);
-        for (i = 0; i < ( (iCurrPartNumQ>>2) + iCurrPartNumQ ); i++)
-        {
-          pi [i] = iRefIdx;
-          pi2[i] = iRefIdx;
-        }
-
-        pi  = piRefIdx + iCurrPartNumQ + (iCurrPartNumQ>>1);
-        pi2 = piRefIdx + iNumPartition - iCurrPartNumQ + (iCurrPartNumQ>>1);
-        for (i = 0; i < (iCurrPartNumQ>>2); i++)
-        {
-          pi [i] = iRefIdx;
-          pi2[i] = iRefIdx;
-        }
-      }
-      else
-      {
-        Int* pi  = piRefIdx;
-        Int* pi2 = piRefIdx + (iCurrPartNumQ>>1);
-        Int* pi3 = piRefIdx + (iCurrPartNumQ<<1);
-        Int* pi4 = piRefIdx + (iCurrPartNumQ<<1) + (iCurrPartNumQ>>1);
-        for (i = 0; i < (iCurrPartNumQ>>2); i++)
-        {
-          pi [i] = iRefIdx;
-          pi2[i] = iRefIdx;
-          pi3[i] = iRefIdx;
-          pi4[i] = iRefIdx;
-        }
-      }
-      break;
-    }
-  default:
-    assert(0);
-    break;
-  }
+  setPURuns( m_piRefIdx + iPartAddr, iRefIdx, eCUMode, iPartIdx, m_uiNumPartition >> ( uiDepth << 1 ) );
 }
 
 Void TComCUMvField::setAllMvField ( TComMv& rcMv, Int iRefIdx, PartSize eCUMode, Int iPartAddr, Int iPartIdx, UInt uiDepth )
@@ -710,176 +202,7 @@ Void TComCUMvField::setAllMvField_AMVRes ( TComMv& rcMv, Int iRefIdx, PartSize e
 }
 Void TComCUMvField::setAllMVRes( Bool bMVRes, PartSize eCUMode, Int iPartAddr, Int iPartIdx, UInt uiDepth )
 {
-  Int i;
-  Bool* pbMVRes = m_bMVRes + iPartAddr;
-  Int iNumPartition = m_uiNumPartition >> (uiDepth<<1);
-
-  switch( eCUMode )
-  {
-  case SIZE_2Nx2N:
-    for ( i = iNumPartition - 1; i >= 0; i-- )
-    {
-      pbMVRes[ i ] = bMVRes;
-    }
-    break;
-  case SIZE_2NxN:
-    for ( i = ( iNumPartition >> 1 ) - 1; i >= 0; i-- )
-    {
-      pbMVRes[ i ] = bMVRes;
-    }
-    break;
-  case SIZE_Nx2N:
-    {
-      UInt uiOffset = iNumPartition >> 1;
-      for ( i = ( iNumPartition >> 2 ) - 1; i >= 0; i-- )
-      {
-        pbMVRes[ i ] = bMVRes;
-        pbMVRes[ i + uiOffset ] = bMVRes;
-      }
-      break;
-    }
-  case SIZE_NxN:
-    for ( i = ( iNumPartition >> 2 ) - 1; i >= 0; i-- )
-    {
-      pbMVRes[ i ] = bMVRes;
-    }
-    break;
-  case SIZE_2NxnU:
-    {
-      Int iCurrPartNumQ = iNumPartition>>2;
-      if( iPartIdx == 0 )
-      {
-        Bool* pi  = pbMVRes;
-        Bool* pi2 = pbMVRes + iCurrPartNumQ;
-        for (i = 0; i < (iCurrPartNumQ>>1); i++)
-        {
-          pi [i] = bMVRes;
-          pi2[i] = bMVRes;
-        }
-      }
-      else
-      {
-        Bool* pi  = pbMVRes;
-        for (i = 0; i < (iCurrPartNumQ>>1); i++)
-        {
-          pi[i] = bMVRes;
-        }
-
-        pi = pbMVRes + iCurrPartNumQ;
-        for (i = 0; i < ( (iCurrPartNumQ>>1) + (iCurrPartNumQ<<1) ); i++)
-        {
-          pi[i] = bMVRes;
-        }
-      }
-      break;
-    }
-  case SIZE_2NxnD:
-    {
-      Int iCurrPartNumQ = iNumPartition>>2;
-      if( iPartIdx == 0 )
-      {
-        Bool* pi  = pbMVRes;
-        for (i = 0; i < ( (iCurrPartNumQ>>1) + (iCurrPartNumQ<<1) ); i++)
-        {
-          pi[i] = bMVRes;
-        }
-        pi = pbMVRes + iNumPartition - iCurrPartNumQ;
-        for (i = 0; i < (iCurrPartNumQ>>1); i++)
-        {
-          pi[i] = bMVRes;
-        }
-      }
-      else
-      {
-        Bool* pi  = pbMVRes;
-        Bool* pi2 = pbMVRes + iCurrPartNumQ;
-        for (i = 0; i < (iCurrPartNumQ>>1); i++)
-        {
-          pi [i] = bMVRes;
-          pi2[i] = bMVRes;
-        }
-      }
-      break;
-    }
-  case SIZE_nLx2N:
-    {
-      Int iCurrPartNumQ = iNumPartition>>2;
-      if( iPartIdx == 0 )
-      {
-        Bool* pi  = pbMVRes;
-        Bool* pi2 = pbMVRes + (iCurrPartNumQ<<1);
-        Bool* pi3 = pbMVRes + (iCurrPartNumQ>>1);
-        Bool* pi4 = pbMVRes + (iCurrPartNumQ<<1) + (iCurrPartNumQ>>1);
-
-        for (i = 0; i < (iCurrPartNumQ>>2); i++)
-        {
-          pi [i] = bMVRes;
-          pi2[i] = bMVRes;
-          pi3[i] = bMVRes;
-          pi4[i] = bMVRes;
-        }
-      }
-      else
-      {
-        Bool* pi  = pbMVRes;
-        Bool* pi2 = pbMVRes + (iCurrPartNumQ<<1);
-        for (i = 0; i < (iCurrPartNumQ>>2); i++)
-        {
-          pi [i] = bMVRes;
-          pi2[i] = bMVRes;
-        }
-
-        pi  = pbMVRes + (iCurrPartNumQ>>1);
-        pi2 = pbMVRes + (iCurrPartNumQ<<1) + (iCurrPartNumQ>>1);
-        for (i = 0; i < ( (iCurrPartNumQ>>2) + iCurrPartNumQ ); i++)
-        {
-          pi [i] = bMVRes;
-          pi2[i] = bMVRes;
-        }
-      }
-      break;
-    }
-  case SIZE_nRx2N:
-    {
-      Int iCurrPartNumQ = iNumPartition>>2;
-      if( iPartIdx == 0 )
-      {
-        Bool* pi  = pbMVRes;
-        Bool* pi2 = pbMVRes + (iCurrPartNumQ<<1);
-        for (i = 0; i < ( (iCurrPartNumQ>>2) + iCurrPartNumQ ); i++)
-        {
-          pi [i] = bMVRes;
-          pi2[i] = bMVRes;
-        }
-
-        pi  = pbMVRes + iCurrPartNumQ + (iCurrPartNumQ>>1);
-        pi2 = pbMVRes + iNumPartition - iCurrPartNumQ + (iCurrPartNumQ>>1);
-        for (i = 0; i < (iCurrPartNumQ>>2); i++)
-        {
-          pi [i] = bMVRes;
-          pi2[i] = bMVRes;
-        }
-      }
-      else
-      {
-        Bool* pi  = pbMVRes;
-        Bool* pi2 = pbMVRes + (iCurrPartNumQ>>1);
-        Bool* pi3 = pbMVRes + (iCurrPartNumQ<<1);
-        Bool* pi4 = pbMVRes + (iCurrPartNumQ<<1) + (iCurrPartNumQ>>1);
-        for (i = 0; i < (iCurrPartNumQ>>2); i++)
-        {
-          pi [i] = bMVRes;
-          pi2[i] = bMVRes;
-          pi3[i] = bMVRes;
-          pi4[i] = bMVRes;
-        }
-      }
-      break;
-    }
-  default:
-    assert(0);
-    break;
-  }
+  setPURuns( m_bMVRes + iPartAddr, bMVRes, eCUMode, iPartIdx, m_uiNumPartition >> ( uiDepth << 1 ) );
 }
 
 
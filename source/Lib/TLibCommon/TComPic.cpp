@@ -34,6 +34,9 @@
 */
 
 #include "TComPic.h"
+#if HHI_INTERP_FILTER
+#include "TComPredFilterMOMS.h"
+#endif
 
 // ====================================================================================================================
 // Constructor / destructor / create / destroy
@@ -46,6 +49,7 @@ TComPic::TComPic()
   m_apcPicYuv[1]      = NULL;
 #if HHI_INTERP_FILTER
   m_apcPicYuv[2]      = NULL;
+  m_bRecFiltReady     = false;
 #endif
   m_pcPicYuvPred      = NULL;
   m_pcPicYuvResi      = NULL;
@@ -57,39 +61,69 @@ TComPic::~TComPic()
 {
 }
 
-Void TComPic::create( Int iWidth, Int iHeight, UInt uiMaxWidth, UInt uiMaxHeight, UInt uiMaxDepth, Bool bIsVirtual )
+Void TComPic::create( Int iWidth, Int iHeight, UInt uiMaxWidth, UInt uiMaxHeight, UInt uiMaxDepth, Bool bIsVirtual, Bool bAllocRec )
 {
   m_apcPicSym     = new TComPicSym;  m_apcPicSym   ->create( iWidth, iHeight, uiMaxWidth, uiMaxHeight, uiMaxDepth );
   if (!bIsVirtual)
   {
     m_apcPicYuv[0]  = new TComPicYuv;  m_apcPicYuv[0]->create( iWidth, iHeight, uiMaxWidth, uiMaxHeight, uiMaxDepth );
   }
-  m_apcPicYuv[1]  = new TComPicYuv;  m_apcPicYuv[1]->create( iWidth, iHeight, uiMaxWidth, uiMaxHeight, uiMaxDepth );
+  // a virtual reference gets its reconstruction buffer from createPicYuvRec() only while a slice reads it
+  if (bAllocRec)
+  {
+    m_apcPicYuv[1]  = new TComPicYuv;  m_apcPicYuv[1]->create( iWidth, iHeight, uiMaxWidth, uiMaxHeight, uiMaxDepth );
+  }
 
-#if HHI_INTERP_FILTER
-  // buffer for filtered reconstructed pic
-  m_apcPicYuv[2]  = new TComPicYuv;  m_apcPicYuv[2]->create( iWidth, iHeight, uiMaxWidth, uiMaxHeight, uiMaxDepth );
-#endif
+  // buffer for filtered reconstructed pic is allocated by prepareRecFilt() once the picture is used as a MOMS reference
 
   return;
 }
 
-Void TComPic::destroy()
+#if HHI_INTERP_FILTER
+/** Compute the MOMS expansion coefficients of the reconstructed picture on its first use as a MOMS reference.
+    The buffer is only allocated when needed and is kept for the following pictures coded into this buffer.
+    \param iInterpFilterType interpolation filter of the slice referencing this picture
+ */
+Void TComPic::prepareRecFilt( Int iInterpFilterType )
 {
-  if (m_apcPicSym)
+  if ( iInterpFilterType != IPF_HHI_4TAP_MOMS && iInterpFilterType != IPF_HHI_6TAP_MOMS )
   {
-    m_apcPicSym->destroy();
-    delete m_apcPicSym;
-    m_apcPicSym = NULL;
+    return;
   }
 
-  if (m_apcPicYuv[0])
+  if ( m_apcPicYuv[2] == NULL )
   {
-    m_apcPicYuv[0]->destroy();
-    delete m_apcPicYuv[0];
-    m_apcPicYuv[0]  = NULL;
+    TComPicYuv* pcPicYuvRec = getPicYuvRec();
+    m_apcPicYuv[2]  = new TComPicYuv;  m_apcPicYuv[2]->create( pcPicYuvRec->getWidth(), pcPicYuvRec->getHeight(), g_uiMaxCUWidth, g_uiMaxCUHeight, g_uiMaxCUDepth );
+    m_bRecFiltReady = false;
   }
 
+  if ( !m_bRecFiltReady )
+  {
+    TComCoeffCalcMOMS cCoeffCalc;
+    cCoeffCalc.calcCoeffs( getPicYuvRec(), m_apcPicYuv[2], iInterpFilterType );
+
+    m_apcPicYuv[2]->setBorderExtension( false );
+    m_apcPicYuv[2]->extendPicBorder( iInterpFilterType );
+    m_bRecFiltReady = true;
+  }
+}
+#endif
+
+/** Allocate the reconstruction buffer of a virtual reference.
+ */
+Void TComPic::createPicYuvRec( Int iWidth, Int iHeight )
+{
+  if ( m_apcPicYuv[1] == NULL )
+  {
+    m_apcPicYuv[1]  = new TComPicYuv;  m_apcPicYuv[1]->create( iWidth, iHeight, g_uiMaxCUWidth, g_uiMaxCUHeight, g_uiMaxCUDepth );
+  }
+}
+
+/** Free the reconstruction buffer of a virtual reference, together with its MOMS coefficients.
+ */
+Void TComPic::destroyPicYuvRec()
+{
   if (m_apcPicYuv[1])
   {
     m_apcPicYuv[1]->destroy();
@@ -105,6 +139,24 @@ Void TComPic::destroy()
     m_apcPicYuv[2]  = NULL;
   }
 #endif
+}
+
+Void TComPic::destroy()
+{
+  if (m_apcPicSym)
+  {
+    m_apcPicSym->destroy();
+    delete m_apcPicSym;
+    m_apcPicSym = NULL;
+  }
+
+  if (m_apcPicYuv[0])
+  {
+    m_apcPicYuv[0]->destroy();
+    delete m_apcPicYuv[0];
+    m_apcPicYuv[0]  = NULL;
+  }
 
+  destroyPicYuvRec();
 }
 
@@ -61,12 +61,15 @@ private:
   TComPicYuv*           m_pcPicYuvPred;           //  Prediction
   TComPicYuv*           m_pcPicYuvResi;           //  Residual
   Bool                  m_bReconstructed;
+#if HHI_INTERP_FILTER
+  Bool                  m_bRecFiltReady;          //  MOMS coefficients of the current reconstruction are valid
+#endif
 
 public:
   TComPic();
   virtual ~TComPic();
 
-  Void          create( Int iWidth, Int iHeight, UInt uiMaxWidth, UInt uiMaxHeight, UInt uiMaxDepth, Bool bIsVirtual = false );
+  Void          create( Int iWidth, Int iHeight, UInt uiMaxWidth, UInt uiMaxHeight, UInt uiMaxDepth, Bool bIsVirtual = false, Bool bAllocRec = true );
   Void          destroy();
 
   TComPicSym*   getPicSym()           { return  m_apcPicSym;    }
@@ -78,9 +81,13 @@ public:
 
   TComPicYuv*   getPicYuvOrg()        { return  m_apcPicYuv[0]; }
   TComPicYuv*   getPicYuvRec()        { return  m_apcPicYuv[1]; }
+  Void          createPicYuvRec( Int iWidth, Int iHeight );
+  Void          destroyPicYuvRec();
 
 #if HHI_INTERP_FILTER
   TComPicYuv*   getPicYuvRecFilt()    { return  m_apcPicYuv[2]; }
+  Void          setRecFiltReady( Bool b ) { m_bRecFiltReady = b; }
+  Void          prepareRecFilt( Int iInterpFilterType );
 #endif
 
   TComPicYuv*   getPicYuvPred()       { return  m_pcPicYuvPred; }
@@ -45,6 +45,10 @@
 
 #include "TComPicYuv.h"
 
+#if ENABLE_SSE2
+#include <emmintrin.h>
+#endif
+
 TComPicYuv::TComPicYuv()
 {
   m_apiPicBufY      = NULL;   // Buffer (including margin)
@@ -271,39 +275,94 @@ Void TComPicYuv::extendPicBorder ()
 {
   if ( m_bIsBorderExtended ) return;
 
-  xExtendPicCompBorder( getLumaAddr(), getStride(),  getWidth(),      getHeight(),      m_iLumaMarginX,   m_iLumaMarginY   );
-  xExtendPicCompBorder( getCbAddr()  , getCStride(), getWidth() >> 1, getHeight() >> 1, m_iChromaMarginX, m_iChromaMarginY );
-  xExtendPicCompBorder( getCrAddr()  , getCStride(), getWidth() >> 1, getHeight() >> 1, m_iChromaMarginX, m_iChromaMarginY );
+  Int iNumRows = ( m_iPicHeight + m_iCuHeight - 1 ) / m_iCuHeight;
+  for ( Int iRow = 0; iRow < iNumRows; iRow++ )
+  {
+    extendPicBorderLCURow( iRow );
+  }
 
   m_bIsBorderExtended = true;
 }
 
-Void TComPicYuv::xExtendPicCompBorder  (Pel* piTxt, Int iStride, Int iWidth, Int iHeight, Int iMarginX, Int iMarginY)
+/** extend the left and right margins of the samples of one LCU row
+    \param iRow LCU row index, the first and the last row also fill the top and bottom margins
+    \note the border extension flag is not changed, it is up to the caller to set it once all rows are extended
+ */
+Void TComPicYuv::extendPicBorderLCURow ( Int iRow )
 {
-  Int   x, y;
+  Int iRowStart = iRow * m_iCuHeight;
+  Int iRowEnd   = Min( iRowStart + m_iCuHeight, m_iPicHeight );
+
+  xExtendPicCompBorder( getLumaAddr(), getStride(),  getWidth(),      getHeight(),      m_iLumaMarginX,   m_iLumaMarginY,   iRowStart,      iRowEnd      );
+  xExtendPicCompBorder( getCbAddr()  , getCStride(), getWidth() >> 1, getHeight() >> 1, m_iChromaMarginX, m_iChromaMarginY, iRowStart >> 1, iRowEnd >> 1 );
+  xExtendPicCompBorder( getCrAddr()  , getCStride(), getWidth() >> 1, getHeight() >> 1, m_iChromaMarginX, m_iChromaMarginY, iRowStart >> 1, iRowEnd >> 1 );
+}
+
+/// fill iNum samples with the same value
+Void TComPicYuv::xFillRow( Pel* pDst, Pel iVal, Int iNum )
+{
+  Int x = 0;
+#if ENABLE_SSE2
+  __m128i vVal = _mm_set1_epi16( iVal );
+  for ( ; x + 8 <= iNum; x += 8 )
+  {
+    _mm_storeu_si128( (__m128i*)( pDst + x ), vVal );
+  }
+#endif
+  for ( ; x < iNum; x++ )
+  {
+    pDst[x] = iVal;
+  }
+}
+
+/// write iNum samples in reverse order, pDst[x] = pSrc[-x]
+Void TComPicYuv::xReverseRow( Pel* pDst, Pel* pSrc, Int iNum )
+{
+  Int x = 0;
+#if ENABLE_SSE2
+  for ( ; x + 8 <= iNum; x += 8 )
+  {
+    __m128i v = _mm_loadu_si128( (const __m128i*)( pSrc - x - 7 ) );
+    v = _mm_shuffle_epi32( v, _MM_SHUFFLE( 0, 1, 2, 3 ) );
+    v = _mm_shufflehi_epi16( _mm_shufflelo_epi16( v, _MM_SHUFFLE( 2, 3, 0, 1 ) ), _MM_SHUFFLE( 2, 3, 0, 1 ) );
+    _mm_storeu_si128( (__m128i*)( pDst + x ), v );
+  }
+#endif
+  for ( ; x < iNum; x++ )
+  {
+    pDst[x] = pSrc[-x];
+  }
+}
+
+Void TComPicYuv::xExtendPicCompBorder  (Pel* piTxt, Int iStride, Int iWidth, Int iHeight, Int iMarginX, Int iMarginY, Int iRowStart, Int iRowEnd)
+{
+  Int   y;
   Pel*  pi;
 
-  pi = piTxt;
-  for ( y = 0; y < iHeight; y++)
+  pi = piTxt + iRowStart * iStride;
+  for ( y = iRowStart; y < iRowEnd; y++)
   {
-    for ( x = 0; x < iMarginX; x++ )
-    {
-      pi[ -iMarginX + x ] = pi[0];
-      pi[    iWidth + x ] = pi[iWidth-1];
-    }
+    xFillRow( pi - iMarginX, pi[0],        iMarginX );
+    xFillRow( pi + iWidth,   pi[iWidth-1], iMarginX );
     pi += iStride;
   }
 
-  pi -= (iStride + iMarginX);
-  for ( y = 0; y < iMarginY; y++ )
+  if ( iRowEnd == iHeight )
   {
-    ::memcpy( pi + (y+1)*iStride, pi, sizeof(Pel)*(iWidth + (iMarginX<<1)) );
+    pi = piTxt + (iHeight-1) * iStride - iMarginX;
+    for ( y = 0; y < iMarginY; y++ )
+    {
+      ::memcpy( pi + (y+1)*iStride, pi, sizeof(Pel)*(iWidth + (iMarginX<<1)) );
+    }
   }
 
-  pi -= ((iHeight-1) * iStride);
-  for ( y = 0; y < iMarginY; y++ )
+  if ( iRowStart == 0 )
   {
-    ::memcpy( pi - (y+1)*iStride, pi, sizeof(Pel)*(iWidth + (iMarginX<<1)) );
+    pi = piTxt - iMarginX;
+    for ( y = 0; y < iMarginY; y++ )
+    {
+      ::memcpy( pi - (y+1)*iStride, pi, sizeof(Pel)*(iWidth + (iMarginX<<1)) );
+    }
   }
 }
 
@@ -320,9 +379,9 @@ Void TComPicYuv::extendPicBorder ( Int iInterpFilterType )
   }
   else
   {
-    xExtendPicCompBorder( getLumaAddr(), getStride(),  getWidth(),      getHeight(),      m_iLumaMarginX,   m_iLumaMarginY   );
-    xExtendPicCompBorder( getCbAddr()  , getCStride(), getWidth() >> 1, getHeight() >> 1, m_iChromaMarginX, m_iChromaMarginY );
-    xExtendPicCompBorder( getCrAddr()  , getCStride(), getWidth() >> 1, getHeight() >> 1, m_iChromaMarginX, m_iChromaMarginY );
+    xExtendPicCompBorder( getLumaAddr(), getStride(),  getWidth(),      getHeight(),      m_iLumaMarginX,   m_iLumaMarginY,   0, getHeight()      );
+    xExtendPicCompBorder( getCbAddr()  , getCStride(), getWidth() >> 1, getHeight() >> 1, m_iChromaMarginX, m_iChromaMarginY, 0, getHeight() >> 1 );
+    xExtendPicCompBorder( getCrAddr()  , getCStride(), getWidth() >> 1, getHeight() >> 1, m_iChromaMarginX, m_iChromaMarginY, 0, getHeight() >> 1 );
   }
 
   m_bIsBorderExtended = true;
@@ -330,17 +389,14 @@ Void TComPicYuv::extendPicBorder ( Int iInterpFilterType )
 
 Void TComPicYuv::xMirrorPicCompBorder  (Pel* piTxt, Int iStride, Int iWidth, Int iHeight, Int iMarginX, Int iMarginY)
 {
-  Int   x, y;
+  Int   y;
   Pel*  pi;
 
   pi = piTxt;
   for ( y = 0; y < iHeight; y++)
   {
-    for ( x = 0; x < iMarginX; x++ )
-    {
-      pi[ -iMarginX + x ] = pi[iMarginX - x];
-      pi[    iWidth + x ] = pi[iWidth   - x - 2];
-    }
+    xReverseRow( pi - iMarginX, pi + iMarginX,  iMarginX );
+    xReverseRow( pi + iWidth,   pi + iWidth - 2, iMarginX );
     pi += iStride;
   }
 
@@ -81,7 +81,11 @@ private:
   Bool  m_bIsBorderExtended;
 
 protected:
-  Void  xExtendPicCompBorder (Pel* piTxt, Int iStride, Int iWidth, Int iHeight, Int iMarginX, Int iMarginY);
+  Void  xExtendPicCompBorder (Pel* piTxt, Int iStride, Int iWidth, Int iHeight, Int iMarginX, Int iMarginY, Int iRowStart, Int iRowEnd);
+
+  // Row kernels of the border extension, vectorized when ENABLE_SSE2 is set
+  static Void xFillRow       ( Pel* pDst, Pel iVal, Int iNum );
+  static Void xReverseRow    ( Pel* pDst, Pel* pSrc, Int iNum );
 
 #if HHI_INTERP_FILTER
   Void  xMirrorPicCompBorder (Pel* piTxt, Int iStride, Int iWidth, Int iHeight, Int iMarginX, Int iMarginY);
@@ -154,6 +158,7 @@ public:
 
   //  Extend function of picture buffer
   Void  extendPicBorder      ();
+  Void  extendPicBorderLCURow( Int iRow );
 
 #if HHI_INTERP_FILTER
   Void  extendPicBorder      ( Int iInterpFilterType );
@@ -273,6 +273,14 @@ public:
 
   __inline Void xCTI_FilterQuarter1Ver (Pel* piSrc, Int iSrcStride, Int iSrcStep, Int iWidth, Int iHeight, Int iDstStride, Int iDstStep, Int*& rpiDst , Int filter, Int Offset);
   __inline Void xCTI_FilterQuarter1Ver (Pel* piSrc, Int iSrcStride, Int iSrcStep, Int iWidth, Int iHeight, Int iDstStride, Int iDstStep, Pel*& rpiDst , Int filter, Int Offset);
+
+  // fixed-width SIFO kernels, used by the functions above for unit steps and 6- or 12-tap filters
+  template<Bool bVer, Bool bSym, Int iShift, typename SrcT, typename DstT>
+  __inline Bool xCTI_FilterSIFOFixed ( SrcT* piSrc, Int iSrcStride, Int iSrcStep, Int iWidth, Int iHeight, DstT* piDst, Int iDstStride, Int iDstStep, Int* piFilter, Int iOffset );
+  template<Int iTaps, Bool bVer, Bool bSym, Int iShift, typename SrcT, typename DstT>
+  static Bool xCTI_FilterSIFOSize ( SrcT* piSrc, Int iSrcStride, Int iWidth, Int iHeight, DstT* piDst, Int iDstStride, Int* piFilter, Int iOffset );
+  template<Int iWidth, Int iTaps, Bool bVer, Bool bSym, Int iShift, typename SrcT, typename DstT>
+  static Void xCTI_FilterSIFOw ( SrcT* piSrc, Int iSrcStride, Int iExtra, Int iHeight, DstT* piDst, Int iDstStride, Int* piFilter, Int iOffset );
 #endif
 #ifdef QC_AMVRES
   __inline Void xCTI_Filter2DVer (Pel* piSrc, Int iSrcStride,  Int iWidth, Int iHeight, Int iDstStride,  Int*& rpiDst, Int iMv);
@@ -2023,6 +2031,99 @@ __inline Int TComPredFilter::xCTI_Filter_VI12_QU1( Int* pSrc, Int* piCoeff, Int
 
 
 #ifdef QC_SIFO// with offset parameter
+// ------------------------------------------------------------------------------------------------
+// Fixed-width SIFO kernels
+// ------------------------------------------------------------------------------------------------
+
+template<Int iTaps, Bool bSym, typename SrcT>
+static __inline Int xCTI_FilterSIFOSum( SrcT* pSrc, Int* piCoeff, Int iStride )
+{
+  Int iSum = 0;
+  if ( bSym )
+  {
+    for ( Int k = 0; k < (iTaps>>1); k++ )
+    {
+      iSum += (pSrc[k*iStride]+pSrc[(iTaps-1-k)*iStride])*piCoeff[k];
+    }
+  }
+  else
+  {
+    for ( Int k = 0; k < iTaps; k++ )
+    {
+      iSum += pSrc[k*iStride]*piCoeff[k];
+    }
+  }
+  return iSum;
+}
+
+template<Int iShift>
+static __inline Void xCTI_FilterSIFOStore( Pel& rDst, Int iSum, Int iOffset )
+{
+  rDst = Clip( (iSum + ((1<<iShift)>>1)) >> iShift );
+  rDst = Clip( rDst + iOffset );
+}
+
+template<Int iShift>
+static __inline Void xCTI_FilterSIFOStore( Int& rDst, Int iSum, Int iOffset )
+{
+  rDst = iSum + iOffset;
+}
+
+/** filter iWidth+iExtra samples per row, iWidth of them with a compile-time trip count
+ * \param bVer   filter taps run down the columns, otherwise along the rows
+ * \param bSym   symmetric filter, only the first half of the coefficients is used
+ * \param iShift normalization of Pel outputs, 8 for Pel sources and 16 for Int sources
+ */
+template<Int iWidth, Int iTaps, Bool bVer, Bool bSym, Int iShift, typename SrcT, typename DstT>
+Void TComPredFilter::xCTI_FilterSIFOw( SrcT* piSrc, Int iSrcStride, Int iExtra, Int iHeight, DstT* piDst, Int iDstStride, Int* piFilter, Int iOffset )
+{
+  Int   iTapStride = bVer ? iSrcStride : 1;
+  SrcT* piSrcTmp;
+
+  for ( Int y = iHeight; y != 0; y-- )
+  {
+    piSrcTmp = piSrc - ((iTaps-2)>>1)*iTapStride;
+    for ( Int x = 0; x < iWidth; x++ )
+    {
+      xCTI_FilterSIFOStore<iShift>( piDst[x], xCTI_FilterSIFOSum<iTaps, bSym>( piSrcTmp + x, piFilter, iTapStride ), iOffset );
+    }
+    for ( Int x = iWidth; x < iWidth + iExtra; x++ )
+    {
+      xCTI_FilterSIFOStore<iShift>( piDst[x], xCTI_FilterSIFOSum<iTaps, bSym>( piSrcTmp + x, piFilter, iTapStride ), iOffset );
+    }
+    piSrc += iSrcStride;
+    piDst += iDstStride;
+  }
+}
+
+/// pick the widest registered kernel; the first pass of 2D positions covers the filter margin in iExtra
+template<Int iTaps, Bool bVer, Bool bSym, Int iShift, typename SrcT, typename DstT>
+Bool TComPredFilter::xCTI_FilterSIFOSize( SrcT* piSrc, Int iSrcStride, Int iWidth, Int iHeight, DstT* piDst, Int iDstStride, Int* piFilter, Int iOffset )
+{
+  if      ( iWidth >= 64 ) xCTI_FilterSIFOw<64, iTaps, bVer, bSym, iShift>( piSrc, iSrcStride, iWidth - 64, iHeight, piDst, iDstStride, piFilter, iOffset );
+  else if ( iWidth >= 32 ) xCTI_FilterSIFOw<32, iTaps, bVer, bSym, iShift>( piSrc, iSrcStride, iWidth - 32, iHeight, piDst, iDstStride, piFilter, iOffset );
+  else if ( iWidth >= 16 ) xCTI_FilterSIFOw<16, iTaps, bVer, bSym, iShift>( piSrc, iSrcStride, iWidth - 16, iHeight, piDst, iDstStride, piFilter, iOffset );
+  else if ( iWidth >=  8 ) xCTI_FilterSIFOw< 8, iTaps, bVer, bSym, iShift>( piSrc, iSrcStride, iWidth -  8, iHeight, piDst, iDstStride, piFilter, iOffset );
+  else if ( iWidth >=  4 ) xCTI_FilterSIFOw< 4, iTaps, bVer, bSym, iShift>( piSrc, iSrcStride, iWidth -  4, iHeight, piDst, iDstStride, piFilter, iOffset );
+  else return false;
+  return true;
+}
+
+template<Bool bVer, Bool bSym, Int iShift, typename SrcT, typename DstT>
+__inline Bool TComPredFilter::xCTI_FilterSIFOFixed( SrcT* piSrc, Int iSrcStride, Int iSrcStep, Int iWidth, Int iHeight, DstT* piDst, Int iDstStride, Int iDstStep, Int* piFilter, Int iOffset )
+{
+  if ( iSrcStep != 1 || iDstStep != 1 )
+  {
+    return false;
+  }
+  switch ( m_iDIFTap )
+  {
+  case 6:  return xCTI_FilterSIFOSize< 6, bVer, bSym, iShift>( piSrc, iSrcStride, iWidth, iHeight, piDst, iDstStride, piFilter, iOffset );
+  case 12: return xCTI_FilterSIFOSize<12, bVer, bSym, iShift>( piSrc, iSrcStride, iWidth, iHeight, piDst, iDstStride, piFilter, iOffset );
+  default: return false;
+  }
+}
+
 __inline Void TComPredFilter::xCTI_FilterHalfHor(Pel* piSrc, Int iSrcStride, Int iSrcStep, Int iWidth, Int iHeight, Int iDstStride, Int iDstStep, Pel*& rpiDst, Int filter, Int Offsets)
 {
   Pel*  piDst    = rpiDst;
@@ -2030,6 +2131,11 @@ __inline Void TComPredFilter::xCTI_FilterHalfHor(Pel* piSrc, Int iSrcStride, Int
   Pel*  piSrcTmp;
   Int*  piFilter = (m_iTapIdx==1)? SIFO_Filter6[filter][HAL_IDX] : SIFO_Filter12[filter][HAL_IDX];
 
+  if ( xCTI_FilterSIFOFixed<false, true, 8>( piSrc, iSrcStride, iSrcStep, iWidth, iHeight, rpiDst, iDstStride, iDstStep, piFilter, Offsets ) )
+  {
+    return;
+  }
+
   for ( Int y = iHeight; y != 0; y-- )
   {
     piSrcTmp = &piSrc[ (0-m_iLeftMargin)*iSrcStep ];
@@ -2053,6 +2159,11 @@ __inline Void TComPredFilter::xCTI_FilterHalfHor(Int* piSrc, Int iSrcStride, Int
   Int*  piSrcTmp;
   Int*  piFilter = (m_iTapIdx==1)? SIFO_Filter6[filter][HAL_IDX] : SIFO_Filter12[filter][HAL_IDX];
 
+  if ( xCTI_FilterSIFOFixed<false, true, 16>( piSrc, iSrcStride, iSrcStep, iWidth, iHeight, rpiDst, iDstStride, iDstStep, piFilter, Offsets ) )
+  {
+    return;
+  }
+
   for ( Int y = iHeight; y != 0; y-- )
   {
     piSrcTmp = &piSrc[ (0-m_iLeftMargin)*iSrcStep ];
@@ -2076,6 +2187,11 @@ __inline Void TComPredFilter::xCTI_FilterQuarter0Hor(Pel* piSrc, Int iSrcStride,
   Pel*  piSrcTmp;
   Int*  piFilter = (m_iTapIdx==1)? SIFO_Filter6[filter][QU0_IDX] : SIFO_Filter12[filter][QU0_IDX];
 
+  if ( xCTI_FilterSIFOFixed<false, false, 8>( piSrc, iSrcStride, iSrcStep, iWidth, iHeight, rpiDst, iDstStride, iDstStep, piFilter, Offsets ) )
+  {
+    return;
+  }
+
   for ( Int y = iHeight; y != 0; y-- )
   {
     piSrcTmp = &piSrc[ (0-m_iLeftMargin)*iSrcStep ];
@@ -2099,6 +2215,11 @@ __inline Void TComPredFilter::xCTI_FilterQuarter0Hor(Int* piSrc, Int iSrcStride,
   Int*  piSrcTmp;
   Int*  piFilter = (m_iTapIdx==1)? SIFO_Filter6[filter][QU0_IDX] : SIFO_Filter12[filter][QU0_IDX];
 
+  if ( xCTI_FilterSIFOFixed<false, false, 16>( piSrc, iSrcStride, iSrcStep, iWidth, iHeight, rpiDst, iDstStride, iDstStep, piFilter, Offsets ) )
+  {
+    return;
+  }
+
   for ( Int y = iHeight; y != 0; y-- )
   {
     piSrcTmp = &piSrc[ (0-m_iLeftMargin)*iSrcStep ];
@@ -2122,6 +2243,11 @@ __inline Void TComPredFilter::xCTI_FilterQuarter1Hor(Pel* piSrc, Int iSrcStride,
   Pel*  piSrcTmp;
   Int*  piFilter = (m_iTapIdx==1)? SIFO_Filter6[filter][QU1_IDX] : SIFO_Filter12[filter][QU1_IDX];
 
+  if ( xCTI_FilterSIFOFixed<false, false, 8>( piSrc, iSrcStride, iSrcStep, iWidth, iHeight, rpiDst, iDstStride, iDstStep, piFilter, Offsets ) )
+  {
+    return;
+  }
+
   for ( Int y = iHeight; y != 0; y-- )
   {
     piSrcTmp = &piSrc[ (0-m_iLeftMargin)*iSrcStep ];
@@ -2145,6 +2271,11 @@ __inline Void TComPredFilter::xCTI_FilterQuarter1Hor(Int* piSrc, Int iSrcStride,
   Int*  piSrcTmp;
   Int*  piFilter = (m_iTapIdx==1)? SIFO_Filter6[filter][QU1_IDX] : SIFO_Filter12[filter][QU1_IDX];
 
+  if ( xCTI_FilterSIFOFixed<false, false, 16>( piSrc, iSrcStride, iSrcStep, iWidth, iHeight, rpiDst, iDstStride, iDstStep, piFilter, Offsets ) )
+  {
+    return;
+  }
+
   for ( Int y = iHeight; y != 0; y-- )
   {
     piSrcTmp = &piSrc[ (0-m_iLeftMargin)*iSrcStep ];
@@ -2195,6 +2326,11 @@ __inline Void TComPredFilter::xCTI_FilterHalfVer (Pel* piSrc, Int iSrcStride, In
   Pel*  piSrcTmp;
   Int*  piFilter = (m_iTapIdx==1)? SIFO_Filter6[filter][HAL_IDX] : SIFO_Filter12[filter][HAL_IDX];
 
+  if ( xCTI_FilterSIFOFixed<true, true, 0>( piSrc, iSrcStride, iSrcStep, iWidth, iHeight, rpiDst, iDstStride, iDstStep, piFilter, Offsets ) )
+  {
+    return;
+  }
+
   for ( Int y = iHeight; y != 0; y-- )
   {
     piSrcTmp = &piSrc[ -m_iLeftMargin*iSrcStride ];
@@ -2218,6 +2354,11 @@ __inline Void TComPredFilter::xCTI_FilterHalfVer (Pel* piSrc, Int iSrcStride, In
   Pel*  piSrcTmp;
   Int*  piFilter = (m_iTapIdx==1)? SIFO_Filter6[filter][HAL_IDX] : SIFO_Filter12[filter][HAL_IDX];
 
+  if ( xCTI_FilterSIFOFixed<true, true, 8>( piSrc, iSrcStride, iSrcStep, iWidth, iHeight, rpiDst, iDstStride, iDstStep, piFilter, Offsets ) )
+  {
+    return;
+  }
+
   for ( Int y = iHeight; y != 0; y-- )
   {
     piSrcTmp = &piSrc[ -m_iLeftMargin*iSrcStride ];
@@ -2242,6 +2383,11 @@ __inline Void TComPredFilter::xCTI_FilterQuarter0Ver (Pel* piSrc, Int iSrcStride
   Pel*  piSrcTmp;
   Int*  piFilter = (m_iTapIdx==1)? SIFO_Filter6[filter][QU0_IDX] : SIFO_Filter12[filter][QU0_IDX];
 
+  if ( xCTI_FilterSIFOFixed<true, false, 0>( piSrc, iSrcStride, iSrcStep, iWidth, iHeight, rpiDst, iDstStride, iDstStep, piFilter, Offsets ) )
+  {
+    return;
+  }
+
   for ( Int y = iHeight; y != 0; y-- )
   {
     piSrcTmp = &piSrc[ -m_iLeftMargin*iSrcStride ];
@@ -2265,6 +2411,11 @@ __inline Void TComPredFilter::xCTI_FilterQuarter0Ver (Pel* piSrc, Int iSrcStride
   Pel*  piSrcTmp;
   Int*  piFilter = (m_iTapIdx==1)? SIFO_Filter6[filter][QU0_IDX] : SIFO_Filter12[filter][QU0_IDX];
 
+  if ( xCTI_FilterSIFOFixed<true, false, 8>( piSrc, iSrcStride, iSrcStep, iWidth, iHeight, rpiDst, iDstStride, iDstStep, piFilter, Offsets ) )
+  {
+    return;
+  }
+
   for ( Int y = iHeight; y != 0; y-- )
   {
     piSrcTmp = &piSrc[ -m_iLeftMargin*iSrcStride ];
@@ -2288,6 +2439,11 @@ __inline Void TComPredFilter::xCTI_FilterQuarter1Ver (Pel* piSrc, Int iSrcStride
   Pel*  piSrcTmp;
   Int*  piFilter = (m_iTapIdx==1)? SIFO_Filter6[filter][QU1_IDX] : SIFO_Filter12[filter][QU1_IDX];
 
+  if ( xCTI_FilterSIFOFixed<true, false, 0>( piSrc, iSrcStride, iSrcStep, iWidth, iHeight, rpiDst, iDstStride, iDstStep, piFilter, Offsets ) )
+  {
+    return;
+  }
+
   for ( Int y = iHeight; y != 0; y-- )
   {
     piSrcTmp = &piSrc[ -m_iLeftMargin*iSrcStride ];
@@ -2312,6 +2468,11 @@ __inline Void TComPredFilter::xCTI_FilterQuarter1Ver (Pel* piSrc, Int iSrcStride
   Pel*  piSrcTmp;
   Int*  piFilter = (m_iTapIdx==1)? SIFO_Filter6[filter][QU1_IDX] : SIFO_Filter12[filter][QU1_IDX];
 
+  if ( xCTI_FilterSIFOFixed<true, false, 8>( piSrc, iSrcStride, iSrcStep, iWidth, iHeight, rpiDst, iDstStride, iDstStep, piFilter, Offsets ) )
+  {
+    return;
+  }
+
   for ( Int y = iHeight; y != 0; y-- )
   {
     piSrcTmp = &piSrc[ -m_iLeftMargin*iSrcStride ];
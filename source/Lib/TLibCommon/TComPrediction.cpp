@@ -36,6 +36,10 @@
 #include <memory.h>
 #include "TComPrediction.h"
 
+#if ENABLE_SSE2
+#include <emmintrin.h>
+#endif
+
 // ====================================================================================================================
 // Constructor / destructor / initialize
 // ====================================================================================================================
@@ -43,6 +47,17 @@
 TComPrediction::TComPrediction()
 {
   m_piYuvExt = NULL;
+
+  m_fpPredInterLumaBlk   = &TComPrediction::xPredInterLumaBlk;
+  m_fpPredInterChromaBlk = &TComPrediction::xPredInterChromaBlk;
+  m_bPredInterScaleMvC   = false;
+#if HHI_INTERP_FILTER
+  m_bPredInterRecFilt    = false;
+  m_ePredInterFilt       = IPF_SAMSUNG_DIF_DEFAULT;
+#endif
+#ifdef DCM_PBIC
+  m_bPredInterIC         = false;
+#endif
 #ifdef EDGE_BASED_PREDICTION
   m_piYExtEdgeBased = NULL;
 #endif //EDGE_BASED_PREDICTION
@@ -104,6 +119,65 @@ Void TComPrediction::initTempBuff()
 #endif
 }
 
+/** The interpolation filter, MV resolution and illumination compensation do not change within a slice,
+    the block predictors are bound once so that motion compensation carries no per-block tool checks.
+    \param pcSlice  slice to be coded or decoded, its SPS has to be set
+ */
+Void TComPrediction::initInterTools( TComSlice* pcSlice )
+{
+#ifdef QC_AMVRES
+  Bool bAMVRes = pcSlice->getSPS()->getUseAMVRes();
+#else
+  Bool bAMVRes = false;
+#endif
+
+  m_fpPredInterChromaBlk = &TComPrediction::xPredInterChromaBlk;
+  m_bPredInterScaleMvC   = bAMVRes;
+#ifdef QC_SIFO
+  m_fpPredInterLumaBlk   = pcSlice->getUseSIFO() ? &TComPrediction::xPredInterLumaBlkSIFO : &TComPrediction::xPredInterLumaBlkDIF;
+#else
+  m_fpPredInterLumaBlk   = &TComPrediction::xPredInterLumaBlkDIF;
+#endif
+#ifdef QC_AMVRES
+  if ( bAMVRes )
+  {
+    m_fpPredInterLumaBlk = &TComPrediction::xPredInterLumaBlkHMV;
+  }
+#endif
+
+#if HHI_INTERP_FILTER
+  m_ePredInterFilt    = (InterpFilterType)pcSlice->getInterpFilterType();
+  m_bPredInterRecFilt = false;
+
+  switch ( m_ePredInterFilt )
+  {
+#if TEN_DIRECTIONAL_INTERP
+  case IPF_TEN_DIF:
+    m_fpPredInterLumaBlk   = &TComPrediction::xPredInterLumaBlk_TEN;
+    m_fpPredInterChromaBlk = &TComPrediction::xPredInterChromaBlk_TEN;
+    m_bPredInterScaleMvC   = false;
+    break;
+#endif
+  case IPF_HHI_4TAP_MOMS:
+  case IPF_HHI_6TAP_MOMS:
+#ifdef QC_AMVRES
+    m_fpPredInterLumaBlk   = bAMVRes ? &TComPrediction::xPredInterLumaBlkHAMMOMS : &TComPrediction::xPredInterLumaBlkMOMS;
+#else
+    m_fpPredInterLumaBlk   = &TComPrediction::xPredInterLumaBlkMOMS;
+#endif
+    m_fpPredInterChromaBlk = &TComPrediction::xPredInterChromaBlkMOMS;
+    m_bPredInterRecFilt    = true;
+    break;
+  default:
+    break;
+  }
+#endif
+
+#ifdef DCM_PBIC
+  m_bPredInterIC = pcSlice->getSPS()->getUseIC();
+#endif
+}
+
 // ====================================================================================================================
 // Public member functions
 // ====================================================================================================================
@@ -197,10 +271,15 @@ Void TComPrediction::xPredIntraPlanar( Int* pSrc, Int iSrcStride, Pel*& rpDst, I
     rightcolumn[k] = Clip(((firstWeight-k)*topright   + (k+1)*iSampleBottomRight + offset1D) >> shift1D);
   }
 
-  // Bilinear interpolation of the final planar samples
+  // Bilinear interpolation of the final planar samples, the vertical term is updated row by row
+  Int vertical[MAX_CU_SIZE];
+  for (l=0;l<iWidth;l++){
+    vertical[l] = toprow[l]*firstWeight + bottomrow[l];
+  }
   for (k=0;k<iHeight;k++){
+    xPredIntraLinRow( pDst+k*iDstStride, vertical, leftcolumn[k]*firstWeight + rightcolumn[k] + offset2D, rightcolumn[k] - leftcolumn[k], shift2D, iWidth );
     for (l=0;l<iWidth;l++){
-      pDst[k*iDstStride+l] = Clip(( leftcolumn[k]*(firstWeight-l) + rightcolumn[k]*(l+1) + toprow[l]*(firstWeight-k) + bottomrow[l]*(k+1) + offset2D) >> shift2D);
+      vertical[l] += bottomrow[l] - toprow[l];
     }
   }
 }
@@ -225,8 +304,7 @@ Void TComPrediction::predIntraPlanar( Int* piSrc, Int iSampleBottomRight, Pel* p
 Void TComPrediction::xPredIntraAng( Int* pSrc, Int iSrcStride, Pel*& rpDst, Int iDstStride, UInt iWidth, UInt iHeight, UInt uiDirMode, Bool bAbove, Bool bLeft )
 {
   Int k,l;
-  Int deltaInt, deltaFract, refMainIndex;
-  Int deltaIntSide, deltaFractSide, refSideIndex;
+  Int deltaInt, deltaFract, numSide;
   Int intraPredAngle = 0;
   Int absAng         = 0;
   Int signAng        = 0;
@@ -261,19 +339,17 @@ Void TComPrediction::xPredIntraAng( Int* pSrc, Int iSrcStride, Pel*& rpDst, Int
   {
     Pel dcval = predIntraGetPredValDC(pSrc, iSrcStride, iWidth, iHeight, bAbove, bLeft);
 
-    for (k=0;k<blkSize;k++){
-      for (l=0;l<blkSize;l++){
-        pDst[k*iDstStride+l] = dcval;
-      }
-    }
+    xFillBlk( pDst, iDstStride, blkSize, blkSize, dcval );
   }
 
   // Do angular predictions
   else
   {
-    Pel  tmp;
+    Pel  tmpBlk[MAX_CU_SIZE*MAX_CU_SIZE];
     Pel* refMain;
     Pel* refSide;
+    Pel* pRow;
+    Int  iRowStride;
 
     for (k=0;k<2*blkSize+1;k++)
       refAbove[k] = pSrc[k-iSrcStride-1];
@@ -283,14 +359,25 @@ Void TComPrediction::xPredIntraAng( Int* pSrc, Int iSrcStride, Pel*& rpDst, Int
     refMain = modeVer ? refAbove : refLeft;
     refSide = modeVer ? refLeft  : refAbove;
 
+    // Horizontal modes are predicted row-wise along the left reference and transposed afterwards
+    pRow       = modeHor ? tmpBlk  : pDst;
+    iRowStride = modeHor ? blkSize : iDstStride;
+
     if (intraPredAngle == 0){
       for (k=0;k<blkSize;k++){
-        for (l=0;l<blkSize;l++){
-          pDst[k*iDstStride+l] = refMain[l+1];
-        }
+        ::memcpy( pRow+k*iRowStride, refMain+1, sizeof(Pel)*blkSize );
       }
     }
     else{
+      // Side reference position of each column, the same for all rows
+      Int sideInt[MAX_CU_SIZE], sideFract[MAX_CU_SIZE];
+
+      if (intraPredAngle < 0){
+        for (l=0;l<blkSize;l++){
+          sideInt[l]   = (32*32*(l+1)/absAng) >> 5;
+          sideFract[l] = (32*32*(l+1)/absAng)  % 32;
+        }
+      }
 
       for (k=0;k<blkSize;k++){
 
@@ -298,54 +385,27 @@ Void TComPrediction::xPredIntraAng( Int* pSrc, Int iSrcStride, Pel*& rpDst, Int
         deltaFract = ((k+1)*absAng) % 32;
 
         if (intraPredAngle < 0){
-            deltaFract = (32 - deltaFract) % 32;
+          deltaFract = (32 - deltaFract) % 32;
         }
 
-        // If the angle is positive all samples are from the main reference
-        if (intraPredAngle > 0){
-          if (deltaFract){
-            // Do linear filtering
-            for (l=0;l<blkSize;l++){
-              refMainIndex        = l+deltaInt+1;
-              pDst[k*iDstStride+l] = (Pel) ( ((32-deltaFract)*refMain[refMainIndex]+deltaFract*refMain[refMainIndex+1]+16) >> 5 );
-            }
-          }
-          else{
-            // Just copy the integer samples
-            for (l=0;l<blkSize;l++){
-              pDst[k*iDstStride+l] = refMain[l+deltaInt+1];
-            }
-          }
-        }
-        else{
-          for (l=0;l<blkSize;l++){
-            refMainIndex = l+deltaInt+1;
-            if (refMainIndex >= 0)
-              pDst[k*iDstStride+l] = (Pel) ( ((32-deltaFract)*refMain[refMainIndex]+deltaFract*refMain[refMainIndex+1]+16) >> 5 );
-            else{
-              // Interpolate from the side reference
-              deltaIntSide   = (32*32*(l+1)/absAng) >> 5;
-              deltaFractSide = (32*32*(l+1)/absAng)  % 32;
-              refSideIndex   = k+1-deltaIntSide;
-              if (deltaFractSide)
-                pDst[k*iDstStride+l] = (Pel) ( ((32-deltaFractSide)*refSide[refSideIndex]+deltaFractSide*refSide[refSideIndex-1]+16) >> 5 );
-              else
-                pDst[k*iDstStride+l] = refSide[refSideIndex];
-            }
-          }
+        // Leading columns with a negative main reference index are interpolated from the side reference
+        numSide = intraPredAngle < 0 ? Max( 0, -deltaInt-1 ) : 0;
+        for (l=0;l<numSide;l++){
+          Int refSideIndex = k+1-sideInt[l];
+          if (sideFract[l])
+            pRow[k*iRowStride+l] = (Pel) ( ((32-sideFract[l])*refSide[refSideIndex]+sideFract[l]*refSide[refSideIndex-1]+16) >> 5 );
+          else
+            pRow[k*iRowStride+l] = refSide[refSideIndex];
         }
+
+        // The rest of the row is a two-tap interpolation of consecutive main reference samples
+        xPredIntraAngRow( pRow+k*iRowStride+numSide, refMain+numSide+deltaInt+1, deltaFract, blkSize-numSide );
       }
     }
 
     // Flip the block if this is the horizontal mode
     if (modeHor){
-      for (k=0;k<blkSize-1;k++){
-        for (l=k+1;l<blkSize;l++){
-          tmp                  = pDst[k*iDstStride+l];
-          pDst[k*iDstStride+l] = pDst[l*iDstStride+k];
-          pDst[l*iDstStride+k] = tmp;
-        }
-      }
+      xTransposeBlk( pDst, iDstStride, tmpBlk, blkSize, blkSize );
     }
   }
 }
@@ -873,14 +933,7 @@ Void TComPrediction::xPredIntraDCAdi( Int* pSrc, Int iSrcStride, Pel*& rpDst, In
     }
   }
 
-  for ( y = 0; y < iHeight; y++ )
-  {
-    for ( x = 0; x < iWidth; x++ )
-    {
-      pDst[x] = iDCValue;
-    }
-    pDst += iDstStride;
-  }
+  xFillBlk( pDst, iDstStride, iWidth, iHeight, (Pel)iDCValue );
 
   return;
 }
@@ -922,12 +975,7 @@ Void TComPrediction::xPredIntraPlaneAdi(Int* pSrc, Int iSrcStride, Pel*& rpDst,
   iTmp = iA - iH2*iC - iW2*iB + 16;
   for ( y = 0; y < iHeight; y++ )
   {
-    Int iTmp2 = iTmp;
-    for ( x = 0; x < iWidth; x++ )
-    {
-      pDst[x] = Clip( iTmp2 >> 5 );
-      iTmp2 += iB;
-    }
+    xPredIntraLinRow( pDst, NULL, iTmp, iB, 5, iWidth );
     iTmp += iC;
 
     pDst += iDstStride;
@@ -1009,6 +1057,200 @@ __inline Int TComPrediction::xGetContextPixel( UInt uiDirMode, UInt uiXYflag, In
   return iTempDn;
 }
 
+// ====================================================================================================================
+// Intra prediction kernels
+// ====================================================================================================================
+
+Void TComPrediction::xFillBlk( Pel* pDst, Int iDstStride, Int iWidth, Int iHeight, Pel iVal )
+{
+  Int x, y;
+#if ENABLE_SSE2
+  __m128i vVal = _mm_set1_epi16( iVal );
+#endif
+
+  for ( y = 0; y < iHeight; y++ )
+  {
+    x = 0;
+#if ENABLE_SSE2
+    for ( ; x + 8 <= iWidth; x += 8 )
+    {
+      _mm_storeu_si128( (__m128i*)( pDst + x ), vVal );
+    }
+    if ( x + 4 <= iWidth )
+    {
+      _mm_storel_epi64( (__m128i*)( pDst + x ), vVal );
+      x += 4;
+    }
+#endif
+    for ( ; x < iWidth; x++ )
+    {
+      pDst[x] = iVal;
+    }
+    pDst += iDstStride;
+  }
+}
+
+/** Two-tap interpolation of one row of angular prediction, pDst[x] = ( (32-iFract)*pRef[x] + iFract*pRef[x+1] + 16 ) >> 5
+    \param pDst   destination row
+    \param pRef   main reference sample projected onto the first destination sample
+    \param iFract fractional position in 1/32 sample, 0 copies the reference
+    \param iWidth number of samples
+ */
+Void TComPrediction::xPredIntraAngRow( Pel* pDst, Pel* pRef, Int iFract, Int iWidth )
+{
+  Int x = 0;
+
+  if ( iFract == 0 )
+  {
+    ::memcpy( pDst, pRef, sizeof(Pel)*iWidth );
+    return;
+  }
+
+#if ENABLE_SSE2
+  __m128i vWeight = _mm_set1_epi32( ( iFract << 16 ) | ( 32 - iFract ) );
+  __m128i vRound  = _mm_set1_epi32( 16 );
+
+  for ( ; x + 8 <= iWidth; x += 8 )
+  {
+    __m128i vA  = _mm_loadu_si128( (const __m128i*)( pRef + x     ) );
+    __m128i vB  = _mm_loadu_si128( (const __m128i*)( pRef + x + 1 ) );
+    __m128i vLo = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( vA, vB ), vWeight ), vRound ), 5 );
+    __m128i vHi = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( vA, vB ), vWeight ), vRound ), 5 );
+    _mm_storeu_si128( (__m128i*)( pDst + x ), _mm_packs_epi32( vLo, vHi ) );
+  }
+  if ( x + 4 <= iWidth )
+  {
+    __m128i vA  = _mm_loadl_epi64( (const __m128i*)( pRef + x     ) );
+    __m128i vB  = _mm_loadl_epi64( (const __m128i*)( pRef + x + 1 ) );
+    __m128i vLo = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( vA, vB ), vWeight ), vRound ), 5 );
+    _mm_storel_epi64( (__m128i*)( pDst + x ), _mm_packs_epi32( vLo, vLo ) );
+    x += 4;
+  }
+#endif
+  for ( ; x < iWidth; x++ )
+  {
+    pDst[x] = (Pel) ( ( (32-iFract)*pRef[x] + iFract*pRef[x+1] + 16 ) >> 5 );
+  }
+}
+
+/** Clipped linear ramp used by the planar predictors, pDst[x] = Clip( ( piAdd[x] + iBase + x*iStep ) >> iShift )
+    \param pDst   destination row
+    \param piAdd  per-sample term added to the ramp, may be NULL
+    \param iBase  ramp value at the first sample, including the rounding offset
+    \param iStep  ramp increment per sample
+    \param iShift normalization shift
+    \param iWidth number of samples
+ */
+Void TComPrediction::xPredIntraLinRow( Pel* pDst, Int* piAdd, Int iBase, Int iStep, Int iShift, Int iWidth )
+{
+  Int x = 0;
+
+#if ENABLE_SSE2
+  __m128i vShift = _mm_cvtsi32_si128( iShift );
+  __m128i vStep  = _mm_set1_epi32( iStep << 3 );
+  __m128i vAcc0  = _mm_add_epi32( _mm_set1_epi32( iBase ), _mm_set_epi32( 3*iStep, 2*iStep, iStep, 0 ) );
+  __m128i vAcc1  = _mm_add_epi32( vAcc0, _mm_set1_epi32( iStep << 2 ) );
+  __m128i vMax   = _mm_set1_epi16( (Pel)g_uiIBDI_MAX );
+  __m128i vZero  = _mm_setzero_si128();
+
+  for ( ; x + 8 <= iWidth; x += 8 )
+  {
+    __m128i v0 = vAcc0;
+    __m128i v1 = vAcc1;
+    if ( piAdd )
+    {
+      v0 = _mm_add_epi32( v0, _mm_loadu_si128( (const __m128i*)( piAdd + x     ) ) );
+      v1 = _mm_add_epi32( v1, _mm_loadu_si128( (const __m128i*)( piAdd + x + 4 ) ) );
+    }
+    __m128i vRes = _mm_packs_epi32( _mm_sra_epi32( v0, vShift ), _mm_sra_epi32( v1, vShift ) );
+    _mm_storeu_si128( (__m128i*)( pDst + x ), _mm_min_epi16( _mm_max_epi16( vRes, vZero ), vMax ) );
+    vAcc0 = _mm_add_epi32( vAcc0, vStep );
+    vAcc1 = _mm_add_epi32( vAcc1, vStep );
+  }
+  if ( x + 4 <= iWidth )
+  {
+    __m128i v0 = vAcc0;
+    if ( piAdd )
+    {
+      v0 = _mm_add_epi32( v0, _mm_loadu_si128( (const __m128i*)( piAdd + x ) ) );
+    }
+    v0 = _mm_sra_epi32( v0, vShift );
+    __m128i vRes = _mm_packs_epi32( v0, v0 );
+    _mm_storel_epi64( (__m128i*)( pDst + x ), _mm_min_epi16( _mm_max_epi16( vRes, vZero ), vMax ) );
+    x += 4;
+  }
+#endif
+  for ( ; x < iWidth; x++ )
+  {
+    Int iVal = iBase + x*iStep + ( piAdd ? piAdd[x] : 0 );
+    pDst[x] = Clip( iVal >> iShift );
+  }
+}
+
+/// transpose a square block, used to turn horizontal angular predictions into place
+Void TComPrediction::xTransposeBlk( Pel* pDst, Int iDstStride, Pel* pSrc, Int iSrcStride, Int iSize )
+{
+  Int x, y;
+
+#if ENABLE_SSE2
+  if ( ( iSize & 7 ) == 0 )
+  {
+    for ( y = 0; y < iSize; y += 8 )
+    {
+      for ( x = 0; x < iSize; x += 8 )
+      {
+        Pel* pS = pSrc + y*iSrcStride + x;
+        Pel* pD = pDst + x*iDstStride + y;
+
+        __m128i r0 = _mm_loadu_si128( (const __m128i*)( pS               ) );
+        __m128i r1 = _mm_loadu_si128( (const __m128i*)( pS +   iSrcStride ) );
+        __m128i r2 = _mm_loadu_si128( (const __m128i*)( pS + 2*iSrcStride ) );
+        __m128i r3 = _mm_loadu_si128( (const __m128i*)( pS + 3*iSrcStride ) );
+        __m128i r4 = _mm_loadu_si128( (const __m128i*)( pS + 4*iSrcStride ) );
+        __m128i r5 = _mm_loadu_si128( (const __m128i*)( pS + 5*iSrcStride ) );
+        __m128i r6 = _mm_loadu_si128( (const __m128i*)( pS + 6*iSrcStride ) );
+        __m128i r7 = _mm_loadu_si128( (const __m128i*)( pS + 7*iSrcStride ) );
+
+        __m128i t0 = _mm_unpacklo_epi16( r0, r1 );
+        __m128i t1 = _mm_unpackhi_epi16( r0, r1 );
+        __m128i t2 = _mm_unpacklo_epi16( r2, r3 );
+        __m128i t3 = _mm_unpackhi_epi16( r2, r3 );
+        __m128i t4 = _mm_unpacklo_epi16( r4, r5 );
+        __m128i t5 = _mm_unpackhi_epi16( r4, r5 );
+        __m128i t6 = _mm_unpacklo_epi16( r6, r7 );
+        __m128i t7 = _mm_unpackhi_epi16( r6, r7 );
+
+        __m128i u0 = _mm_unpacklo_epi32( t0, t2 );
+        __m128i u1 = _mm_unpackhi_epi32( t0, t2 );
+        __m128i u2 = _mm_unpacklo_epi32( t1, t3 );
+        __m128i u3 = _mm_unpackhi_epi32( t1, t3 );
+        __m128i u4 = _mm_unpacklo_epi32( t4, t6 );
+        __m128i u5 = _mm_unpackhi_epi32( t4, t6 );
+        __m128i u6 = _mm_unpacklo_epi32( t5, t7 );
+        __m128i u7 = _mm_unpackhi_epi32( t5, t7 );
+
+        _mm_storeu_si128( (__m128i*)( pD               ), _mm_unpacklo_epi64( u0, u4 ) );
+        _mm_storeu_si128( (__m128i*)( pD +   iDstStride ), _mm_unpackhi_epi64( u0, u4 ) );
+        _mm_storeu_si128( (__m128i*)( pD + 2*iDstStride ), _mm_unpacklo_epi64( u1, u5 ) );
+        _mm_storeu_si128( (__m128i*)( pD + 3*iDstStride ), _mm_unpackhi_epi64( u1, u5 ) );
+        _mm_storeu_si128( (__m128i*)( pD + 4*iDstStride ), _mm_unpacklo_epi64( u2, u6 ) );
+        _mm_storeu_si128( (__m128i*)( pD + 5*iDstStride ), _mm_unpackhi_epi64( u2, u6 ) );
+        _mm_storeu_si128( (__m128i*)( pD + 6*iDstStride ), _mm_unpacklo_epi64( u3, u7 ) );
+        _mm_storeu_si128( (__m128i*)( pD + 7*iDstStride ), _mm_unpackhi_epi64( u3, u7 ) );
+      }
+    }
+    return;
+  }
+#endif
+  for ( y = 0; y < iSize; y++ )
+  {
+    for ( x = 0; x < iSize; x++ )
+    {
+      pDst[x*iDstStride+y] = pSrc[y*iSrcStride+x];
+    }
+  }
+}
+
 Void TComPrediction::motionCompensation ( TComDataCU* pcCU, TComYuv* pcYuvPred, RefPicList eRefPicList, Int iPartIdx )
 {
   Int         iWidth;
@@ -1045,7 +1287,6 @@ Void TComPrediction::motionCompensation ( TComDataCU* pcCU, TComYuv* pcYuvPred,
   return;
 }
 
-#if HHI_INTERP_FILTER
 Void TComPrediction::xPredInterUni ( TComDataCU* pcCU, UInt uiPartAddr, Int iWidth, Int iHeight, RefPicList eRefPicList, TComYuv*& rpcYuvPred, Int iPartIdx )
 {
   Int         iRefIdx     = pcCU->getCUMvField( eRefPicList )->getRefIdx( uiPartAddr );           assert (iRefIdx >= 0);
@@ -1054,60 +1295,32 @@ Void TComPrediction::xPredInterUni ( TComDataCU* pcCU, UInt uiPartAddr, Int iWid
   TComIc      cIc         = pcCU->getCUIcField()->getIc( uiPartAddr );
 #endif
 
-  InterpFilterType ePFilt = (InterpFilterType)pcCU->getSlice()->getInterpFilterType();
-
   pcCU->clipMv(cMv);
+#if HHI_INTERP_FILTER
+  TComPicYuv* pcPicYuvRef = m_bPredInterRecFilt ? pcCU->getSlice()->getRefPicYuvRecFilt( eRefPicList, iRefIdx )
+                                                : xGetRefPicYuvRec( pcCU, uiPartAddr, iHeight, eRefPicList, iRefIdx, cMv.getVer(), cMv.getVer() );
+#else
+  TComPicYuv* pcPicYuvRef = xGetRefPicYuvRec( pcCU, uiPartAddr, iHeight, eRefPicList, iRefIdx, cMv.getVer(), cMv.getVer() );
+#endif
 #ifdef QC_SIFO
   (eRefPicList == REF_PIC_LIST_0)?setCurrList(0):setCurrList(1);
   setCurrRefFrame(iRefIdx);
 #endif
 
+  // the luma predictor may change the MV, the chroma MV is derived before
+  TComMv cMvc = cMv;
 #ifdef QC_AMVRES
-  if (pcCU->getSlice()->getSPS()->getUseAMVRes())
+  if ( m_bPredInterScaleMvC )
   {
-	  TComMv cMvc=cMv;
-      cMvc.scale_down();
-	  switch ( ePFilt )
-	  {
-#if TEN_DIRECTIONAL_INTERP
-  case IPF_TEN_DIF:
-    xPredInterLumaBlk_TEN   ( pcCU, pcCU->getSlice()->getRefPic( eRefPicList, iRefIdx )->getPicYuvRec()    , uiPartAddr, &cMv, iWidth, iHeight, rpcYuvPred );
-    xPredInterChromaBlk_TEN ( pcCU, pcCU->getSlice()->getRefPic( eRefPicList, iRefIdx )->getPicYuvRec()    , uiPartAddr, &cMv, iWidth, iHeight, rpcYuvPred );
-    break;
-#endif
-	  case IPF_HHI_4TAP_MOMS:
-	  case IPF_HHI_6TAP_MOMS:
-		  predInterLumaBlkHAM_MOMS ( pcCU, pcCU->getSlice()->getRefPic( eRefPicList, iRefIdx )->getPicYuvRecFilt(), uiPartAddr, &cMv , iWidth, iHeight, rpcYuvPred, ePFilt );	  
-		  predInterChromaBlkMOMS  ( pcCU, pcCU->getSlice()->getRefPic( eRefPicList, iRefIdx )->getPicYuvRecFilt(), uiPartAddr, &cMvc, iWidth, iHeight, rpcYuvPred, ePFilt );
-		  break;
-	  default:
-		  xPredInterLumaBlkHMV( pcCU, pcCU->getSlice()->getRefPic( eRefPicList, iRefIdx )->getPicYuvRec(), uiPartAddr, &cMv, iWidth, iHeight, rpcYuvPred );
-		  xPredInterChromaBlk ( pcCU, pcCU->getSlice()->getRefPic( eRefPicList, iRefIdx )->getPicYuvRec(), uiPartAddr, &cMvc, iWidth, iHeight, rpcYuvPred );
-	  }
+    cMvc.scale_down();
   }
-  else
-#endif
-  {
-	  switch ( ePFilt )
-	  {
-#if TEN_DIRECTIONAL_INTERP
-  case IPF_TEN_DIF:
-    xPredInterLumaBlk_TEN   ( pcCU, pcCU->getSlice()->getRefPic( eRefPicList, iRefIdx )->getPicYuvRec()    , uiPartAddr, &cMv, iWidth, iHeight, rpcYuvPred );
-    xPredInterChromaBlk_TEN ( pcCU, pcCU->getSlice()->getRefPic( eRefPicList, iRefIdx )->getPicYuvRec()    , uiPartAddr, &cMv, iWidth, iHeight, rpcYuvPred );
-    break;
 #endif
-	  case IPF_HHI_4TAP_MOMS:
-	  case IPF_HHI_6TAP_MOMS:  
-		predInterLumaBlkMOMS    ( pcCU, pcCU->getSlice()->getRefPic( eRefPicList, iRefIdx )->getPicYuvRecFilt(), uiPartAddr, &cMv, iWidth, iHeight, rpcYuvPred, ePFilt );
-		predInterChromaBlkMOMS  ( pcCU, pcCU->getSlice()->getRefPic( eRefPicList, iRefIdx )->getPicYuvRecFilt(), uiPartAddr, &cMv, iWidth, iHeight, rpcYuvPred, ePFilt );
-		break;
-	  default:
-	    xPredInterLumaBlk       ( pcCU, pcCU->getSlice()->getRefPic( eRefPicList, iRefIdx )->getPicYuvRec(), uiPartAddr, &cMv, iWidth, iHeight, rpcYuvPred );
-      xPredInterChromaBlk     ( pcCU, pcCU->getSlice()->getRefPic( eRefPicList, iRefIdx )->getPicYuvRec(), uiPartAddr, &cMv, iWidth, iHeight, rpcYuvPred );
-	  }
-  }
+
+  (this->*m_fpPredInterLumaBlk)  ( pcCU, pcPicYuvRef, uiPartAddr, &cMv,  iWidth, iHeight, rpcYuvPred );
+  (this->*m_fpPredInterChromaBlk)( pcCU, pcPicYuvRef, uiPartAddr, &cMvc, iWidth, iHeight, rpcYuvPred );
+
 #ifdef DCM_PBIC
-  if (pcCU->getSlice()->getSPS()->getUseIC())
+  if ( m_bPredInterIC )
   {
     xPredICompLumaBlk  ( &cIc, iWidth   , iHeight   , rpcYuvPred->getStride() , 1, rpcYuvPred->getLumaAddr(uiPartAddr), rpcYuvPred->getStride() , 1, rpcYuvPred->getLumaAddr(uiPartAddr), eRefPicList );
     xPredICompChromaBlk( &cIc, iWidth>>1, iHeight>>1, rpcYuvPred->getCStride(), 1, rpcYuvPred->getCbAddr(uiPartAddr)  , rpcYuvPred->getCStride(), 1, rpcYuvPred->getCbAddr(uiPartAddr)  , eRefPicList );
@@ -1115,45 +1328,31 @@ Void TComPrediction::xPredInterUni ( TComDataCU* pcCU, UInt uiPartAddr, Int iWid
   }
 #endif
 }
-#else
-Void TComPrediction::xPredInterUni ( TComDataCU* pcCU, UInt uiPartAddr, Int iWidth, Int iHeight, RefPicList eRefPicList, TComYuv*& rpcYuvPred, Int iPartIdx )
+
+/** Get the reference picture for a block, weighted virtual references are generated for the rows the block will read.
+    \param iMvVerMin  smallest vertical MV component that will be used (in MV units of the slice)
+    \param iMvVerMax  largest vertical MV component that will be used (in MV units of the slice)
+ */
+TComPicYuv* TComPrediction::xGetRefPicYuvRec( TComDataCU* pcCU, UInt uiPartAddr, Int iHeight, RefPicList eRefPicList, Int iRefIdx, Int iMvVerMin, Int iMvVerMax )
 {
-  Int         iRefIdx     = pcCU->getCUMvField( eRefPicList )->getRefIdx( uiPartAddr );           assert (iRefIdx >= 0);
-  TComMv      cMv         = pcCU->getCUMvField( eRefPicList )->getMv( uiPartAddr );
-  TComPicYuv* pcPicYuvRef = pcCU->getSlice()->getRefPic( eRefPicList, iRefIdx )->getPicYuvRec();
-#ifdef DCM_PBIC
-  TComIc      cIc         = pcCU->getCUIcField()->getIc( uiPartAddr );
-#endif
+  TComSlice* pcSlice = pcCU->getSlice();
 
-  pcCU->clipMv(cMv);
-#ifdef QC_SIFO
-  (eRefPicList == REF_PIC_LIST_0)?setCurrList(0):setCurrList(1);
-  setCurrRefFrame(iRefIdx);
-#endif
-#ifdef QC_AMVRES
-  if (pcCU->getSlice()->getSPS()->getUseAMVRes())
+  if ( pcSlice->getAddRefCnt( eRefPicList ) == 0 )
   {
-	  TComMv cMvc=cMv;
-      cMvc.scale_down();
-      xPredInterLumaBlkHMV( pcCU, pcPicYuvRef, uiPartAddr, &cMv, iWidth, iHeight, rpcYuvPred );
-	  xPredInterChromaBlk ( pcCU, pcPicYuvRef, uiPartAddr, &cMvc, iWidth, iHeight, rpcYuvPred );
-  }
-  else
-#endif
-  {
-    xPredInterLumaBlk   ( pcCU, pcPicYuvRef, uiPartAddr, &cMv, iWidth, iHeight, rpcYuvPred );
-    xPredInterChromaBlk ( pcCU, pcPicYuvRef, uiPartAddr, &cMv, iWidth, iHeight, rpcYuvPred );
-  }
-#ifdef DCM_PBIC
-  if (pcCU->getSlice()->getSPS()->getUseIC())
-  {
-    xPredICompLumaBlk  ( &cIc, iWidth   , iHeight   , rpcYuvPred->getStride() , 1, rpcYuvPred->getLumaAddr(uiPartAddr), rpcYuvPred->getStride() , 1, rpcYuvPred->getLumaAddr(uiPartAddr), eRefPicList );
-    xPredICompChromaBlk( &cIc, iWidth>>1, iHeight>>1, rpcYuvPred->getCStride(), 1, rpcYuvPred->getCbAddr(uiPartAddr)  , rpcYuvPred->getCStride(), 1, rpcYuvPred->getCbAddr(uiPartAddr)  , eRefPicList );
-    xPredICompChromaBlk( &cIc, iWidth>>1, iHeight>>1, rpcYuvPred->getCStride(), 1, rpcYuvPred->getCrAddr(uiPartAddr)  , rpcYuvPred->getCStride(), 1, rpcYuvPred->getCrAddr(uiPartAddr)  , eRefPicList );
+    return pcSlice->getRefPic( eRefPicList, iRefIdx )->getPicYuvRec();
   }
+
+#ifdef QC_AMVRES
+  Int  iMvShift = (pcSlice->getSPS()->getUseAMVRes())?3:2;
+#else
+  Int  iMvShift = 2;
 #endif
+  Int  iPelY    = pcCU->getPic()->getCU( pcCU->getAddr() )->getCUPelY() + g_auiRasterToPelY[ g_auiZscanToRaster[ pcCU->getZorderIdxInCU() + uiPartAddr ] ];
+
+  return pcSlice->getRefPicYuvRec( eRefPicList, iRefIdx,
+                                   iPelY               + ( iMvVerMin >> iMvShift )     - GRF_WP_ROW_MARGIN,
+                                   iPelY + iHeight - 1 + ( iMvVerMax >> iMvShift ) + 1 + GRF_WP_ROW_MARGIN );
 }
-#endif
 
 Void TComPrediction::xPredInterBi ( TComDataCU* pcCU, UInt uiPartAddr, Int iWidth, Int iHeight, TComYuv*& rpcYuvPred, Int iPartIdx )
 {
@@ -1177,6 +1376,19 @@ Void TComPrediction::xPredInterBi ( TComDataCU* pcCU, UInt uiPartAddr, Int iWidt
 }
 
 Void  TComPrediction::xPredInterLumaBlk( TComDataCU* pcCU, TComPicYuv* pcPicYuvRef, UInt uiPartAddr, TComMv* pcMv, Int iWidth, Int iHeight, TComYuv*& rpcYuv )
+{
+#ifdef QC_SIFO
+  if(pcCU->getSlice()->getUseSIFO())
+  {
+    xPredInterLumaBlkSIFO( pcCU, pcPicYuvRef, uiPartAddr, pcMv, iWidth, iHeight, rpcYuv );
+    return;
+  }
+#endif
+  xPredInterLumaBlkDIF( pcCU, pcPicYuvRef, uiPartAddr, pcMv, iWidth, iHeight, rpcYuv );
+}
+
+#ifdef QC_SIFO
+Void  TComPrediction::xPredInterLumaBlkSIFO( TComDataCU* pcCU, TComPicYuv* pcPicYuvRef, UInt uiPartAddr, TComMv* pcMv, Int iWidth, Int iHeight, TComYuv*& rpcYuv )
 {
   Int     iRefStride = pcPicYuvRef->getStride();
   Int     iDstStride = rpcYuv->getStride();
@@ -1189,15 +1401,23 @@ Void  TComPrediction::xPredInterLumaBlk( TComDataCU* pcCU, TComPicYuv* pcPicYuvR
 
   Pel* piDstY = rpcYuv->getLumaAddr( uiPartAddr );
 
-#ifdef QC_SIFO
-  if(pcCU->getSlice()->getUseSIFO())
-  {
-    xSIFOFilter  (piRefY, iRefStride, piDstY, iDstStride, iWidth, iHeight, iyFrac, ixFrac);
-  }
-  else
-  {
+  xSIFOFilter  (piRefY, iRefStride, piDstY, iDstStride, iWidth, iHeight, iyFrac, ixFrac);
+}
 #endif
 
+Void  TComPrediction::xPredInterLumaBlkDIF( TComDataCU* pcCU, TComPicYuv* pcPicYuvRef, UInt uiPartAddr, TComMv* pcMv, Int iWidth, Int iHeight, TComYuv*& rpcYuv )
+{
+  Int     iRefStride = pcPicYuvRef->getStride();
+  Int     iDstStride = rpcYuv->getStride();
+
+  Int     iRefOffset = ( pcMv->getHor() >> 2 ) + ( pcMv->getVer() >> 2 ) * iRefStride;
+  Pel*    piRefY     = pcPicYuvRef->getLumaAddr( pcCU->getAddr(), pcCU->getZorderIdxInCU() + uiPartAddr ) + iRefOffset;
+
+  Int     ixFrac  = pcMv->getHor() & 0x3;
+  Int     iyFrac  = pcMv->getVer() & 0x3;
+
+  Pel* piDstY = rpcYuv->getLumaAddr( uiPartAddr );
+
   //  Integer point
   if ( ixFrac == 0 && iyFrac == 0 )
   {
@@ -1327,10 +1547,26 @@ Void  TComPrediction::xPredInterLumaBlk( TComDataCU* pcCU, TComPicYuv* pcPicYuvR
       return;
     }
   }
-#ifdef QC_SIFO
 }
-#endif
+
+#if HHI_INTERP_FILTER
+Void TComPrediction::xPredInterLumaBlkMOMS( TComDataCU* pcCU, TComPicYuv* pcPicYuvRef, UInt uiPartAddr, TComMv* pcMv, Int iWidth, Int iHeight, TComYuv*& rpcYuv )
+{
+  predInterLumaBlkMOMS( pcCU, pcPicYuvRef, uiPartAddr, pcMv, iWidth, iHeight, rpcYuv, m_ePredInterFilt );
+}
+
+Void TComPrediction::xPredInterChromaBlkMOMS( TComDataCU* pcCU, TComPicYuv* pcPicYuvRef, UInt uiPartAddr, TComMv* pcMv, Int iWidth, Int iHeight, TComYuv*& rpcYuv )
+{
+  predInterChromaBlkMOMS( pcCU, pcPicYuvRef, uiPartAddr, pcMv, iWidth, iHeight, rpcYuv, m_ePredInterFilt );
+}
+
+#ifdef QC_AMVRES
+Void TComPrediction::xPredInterLumaBlkHAMMOMS( TComDataCU* pcCU, TComPicYuv* pcPicYuvRef, UInt uiPartAddr, TComMv* pcMv, Int iWidth, Int iHeight, TComYuv*& rpcYuv )
+{
+  predInterLumaBlkHAM_MOMS( pcCU, pcPicYuvRef, uiPartAddr, pcMv, iWidth, iHeight, rpcYuv, m_ePredInterFilt );
 }
+#endif
+#endif
 //--
 #ifdef QC_AMVRES
 Void  TComPrediction::xHAM_Filter(Pel*  piRefY, Int iRefStride,Pel*  piDstY,Int iDstStride,
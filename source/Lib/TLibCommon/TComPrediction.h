@@ -63,6 +63,20 @@ class TComPrediction : public TComPredFilter
 #endif
 {
 protected:
+  typedef Void (TComPrediction::*FpPredInterBlk)( TComDataCU* pcCU, TComPicYuv* pcPicYuvRef, UInt uiPartAddr, TComMv* pcMv, Int iWidth, Int iHeight, TComYuv*& rpcYuv );
+
+  // inter prediction tools of the current slice, selected by initInterTools()
+  FpPredInterBlk    m_fpPredInterLumaBlk;
+  FpPredInterBlk    m_fpPredInterChromaBlk;
+  Bool              m_bPredInterScaleMvC;                       ///< chroma uses the luma MV scaled down to 1/4 pel
+#if HHI_INTERP_FILTER
+  Bool              m_bPredInterRecFilt;                        ///< reference is the prefiltered reconstruction
+  InterpFilterType  m_ePredInterFilt;
+#endif
+#ifdef DCM_PBIC
+  Bool              m_bPredInterIC;
+#endif
+
   Int*      m_piYuvExt;
   Int       m_iYuvExtStride;
   Int       m_iYuvExtHeight;
@@ -98,10 +112,28 @@ protected:
   Void xPredIntraAng            ( Int* pSrc, Int iSrcStride, Pel*& rpDst, Int iDstStride, UInt iWidth, UInt iHeight, UInt uiDirMode, Bool bAbove, Bool bLeft );
 #endif
 
+  // Row and block kernels of the intra predictors, vectorized when ENABLE_SSE2 is set
+  static Void xFillBlk          ( Pel* pDst, Int iDstStride, Int iWidth, Int iHeight, Pel iVal );
+  static Void xPredIntraAngRow  ( Pel* pDst, Pel* pRef, Int iFract, Int iWidth );
+  static Void xPredIntraLinRow  ( Pel* pDst, Int* piAdd, Int iBase, Int iStep, Int iShift, Int iWidth );
+  static Void xTransposeBlk     ( Pel* pDst, Int iDstStride, Pel* pSrc, Int iSrcStride, Int iSize );
+
   // motion compensation functions
   Void xPredInterUni            ( TComDataCU* pcCU,                          UInt uiPartAddr,               Int iWidth, Int iHeight, RefPicList eRefPicList, TComYuv*& rpcYuvPred, Int iPartIdx          );
   Void xPredInterBi             ( TComDataCU* pcCU,                          UInt uiPartAddr,               Int iWidth, Int iHeight,                         TComYuv*& rpcYuvPred, Int iPartIdx          );
+  TComPicYuv* xGetRefPicYuvRec  ( TComDataCU* pcCU,                          UInt uiPartAddr,                           Int iHeight, RefPicList eRefPicList, Int iRefIdx, Int iMvVerMin, Int iMvVerMax );
   Void xPredInterLumaBlk        ( TComDataCU* pcCU, TComPicYuv* pcPicYuvRef, UInt uiPartAddr, TComMv* pcMv, Int iWidth, Int iHeight,                         TComYuv*& rpcYuv );
+  Void xPredInterLumaBlkDIF     ( TComDataCU* pcCU, TComPicYuv* pcPicYuvRef, UInt uiPartAddr, TComMv* pcMv, Int iWidth, Int iHeight,                         TComYuv*& rpcYuv );
+#ifdef QC_SIFO
+  Void xPredInterLumaBlkSIFO    ( TComDataCU* pcCU, TComPicYuv* pcPicYuvRef, UInt uiPartAddr, TComMv* pcMv, Int iWidth, Int iHeight,                         TComYuv*& rpcYuv );
+#endif
+#if HHI_INTERP_FILTER
+  Void xPredInterLumaBlkMOMS    ( TComDataCU* pcCU, TComPicYuv* pcPicYuvRef, UInt uiPartAddr, TComMv* pcMv, Int iWidth, Int iHeight,                         TComYuv*& rpcYuv );
+  Void xPredInterChromaBlkMOMS  ( TComDataCU* pcCU, TComPicYuv* pcPicYuvRef, UInt uiPartAddr, TComMv* pcMv, Int iWidth, Int iHeight,                         TComYuv*& rpcYuv );
+#ifdef QC_AMVRES
+  Void xPredInterLumaBlkHAMMOMS ( TComDataCU* pcCU, TComPicYuv* pcPicYuvRef, UInt uiPartAddr, TComMv* pcMv, Int iWidth, Int iHeight,                         TComYuv*& rpcYuv );
+#endif
+#endif
   Void xPredInterChromaBlk      ( TComDataCU* pcCU, TComPicYuv* pcPicYuvRef, UInt uiPartAddr, TComMv* pcMv, Int iWidth, Int iHeight,                         TComYuv*& rpcYuv                            );
 #if TEN_DIRECTIONAL_INTERP
   Void xPredInterLumaBlk_TEN    ( TComDataCU* pcCU, TComPicYuv* pcPicYuvRef, UInt uiPartAddr, TComMv* pcMv, Int iWidth, Int iHeight,                         TComYuv*& rpcYuv );
@@ -136,6 +168,7 @@ public:
   virtual ~TComPrediction();
 
   Void    initTempBuff();
+  Void    initInterTools( TComSlice* pcSlice );
 
   // inter
   Void motionCompensation         ( TComDataCU*  pcCU, TComYuv* pcYuvPred, RefPicList eRefPicList = REF_PIC_LIST_X, Int iPartIdx = -1 );
@@ -150,27 +150,27 @@ Void TComRdCost::init()
   m_afpDistortFunc[0]  = NULL;                  // for DF_DEFAULT
 
   m_afpDistortFunc[1]  = TComRdCost::xGetSSE;
-  m_afpDistortFunc[2]  = TComRdCost::xGetSSE4;
-  m_afpDistortFunc[3]  = TComRdCost::xGetSSE8;
-  m_afpDistortFunc[4]  = TComRdCost::xGetSSE16;
-  m_afpDistortFunc[5]  = TComRdCost::xGetSSE32;
-  m_afpDistortFunc[6]  = TComRdCost::xGetSSE64;
+  m_afpDistortFunc[2]  = TComRdCost::xGetSSEw<4>;
+  m_afpDistortFunc[3]  = TComRdCost::xGetSSEw<8>;
+  m_afpDistortFunc[4]  = TComRdCost::xGetSSEw<16>;
+  m_afpDistortFunc[5]  = TComRdCost::xGetSSEw<32>;
+  m_afpDistortFunc[6]  = TComRdCost::xGetSSEw<64>;
   m_afpDistortFunc[7]  = TComRdCost::xGetSSE16N;
 
   m_afpDistortFunc[8]  = TComRdCost::xGetSAD;
-  m_afpDistortFunc[9]  = TComRdCost::xGetSAD4;
-  m_afpDistortFunc[10] = TComRdCost::xGetSAD8;
-  m_afpDistortFunc[11] = TComRdCost::xGetSAD16;
-  m_afpDistortFunc[12] = TComRdCost::xGetSAD32;
-  m_afpDistortFunc[13] = TComRdCost::xGetSAD64;
+  m_afpDistortFunc[9]  = TComRdCost::xGetSADw<4>;
+  m_afpDistortFunc[10] = TComRdCost::xGetSADw<8>;
+  m_afpDistortFunc[11] = TComRdCost::xGetSADw<16>;
+  m_afpDistortFunc[12] = TComRdCost::xGetSADw<32>;
+  m_afpDistortFunc[13] = TComRdCost::xGetSADw<64>;
   m_afpDistortFunc[14] = TComRdCost::xGetSAD16N;
 
   m_afpDistortFunc[15] = TComRdCost::xGetSADs;
-  m_afpDistortFunc[16] = TComRdCost::xGetSADs4;
-  m_afpDistortFunc[17] = TComRdCost::xGetSADs8;
-  m_afpDistortFunc[18] = TComRdCost::xGetSADs16;
-  m_afpDistortFunc[19] = TComRdCost::xGetSADs32;
-  m_afpDistortFunc[20] = TComRdCost::xGetSADs64;
+  m_afpDistortFunc[16] = TComRdCost::xGetSADsw<4>;
+  m_afpDistortFunc[17] = TComRdCost::xGetSADsw<8>;
+  m_afpDistortFunc[18] = TComRdCost::xGetSADsw<16>;
+  m_afpDistortFunc[19] = TComRdCost::xGetSADsw<32>;
+  m_afpDistortFunc[20] = TComRdCost::xGetSADsw<64>;
   m_afpDistortFunc[21] = TComRdCost::xGetSADs16N;
 
   m_afpDistortFunc[22] = TComRdCost::xGetHADs;
@@ -197,19 +197,19 @@ Void TComRdCost::init()
   m_afpDistortFuncRnd[7]  = TComRdCost::xGetSSE16N;
 
   m_afpDistortFuncRnd[8]  = TComRdCost::xGetSAD;
-  m_afpDistortFuncRnd[9]  = TComRdCost::xGetSAD4;
-  m_afpDistortFuncRnd[10] = TComRdCost::xGetSAD8;
-  m_afpDistortFuncRnd[11] = TComRdCost::xGetSAD16;
-  m_afpDistortFuncRnd[12] = TComRdCost::xGetSAD32;
-  m_afpDistortFuncRnd[13] = TComRdCost::xGetSAD64;
+  m_afpDistortFuncRnd[9]  = TComRdCost::xGetSADw<4>;
+  m_afpDistortFuncRnd[10] = TComRdCost::xGetSADw<8>;
+  m_afpDistortFuncRnd[11] = TComRdCost::xGetSADw<16>;
+  m_afpDistortFuncRnd[12] = TComRdCost::xGetSADw<32>;
+  m_afpDistortFuncRnd[13] = TComRdCost::xGetSADw<64>;
   m_afpDistortFuncRnd[14] = TComRdCost::xGetSAD16N;
 
   m_afpDistortFuncRnd[15] = TComRdCost::xGetSADs;
-  m_afpDistortFuncRnd[16] = TComRdCost::xGetSADs4;
-  m_afpDistortFuncRnd[17] = TComRdCost::xGetSADs8;
-  m_afpDistortFuncRnd[18] = TComRdCost::xGetSADs16;
-  m_afpDistortFuncRnd[19] = TComRdCost::xGetSADs32;
-  m_afpDistortFuncRnd[20] = TComRdCost::xGetSADs64;
+  m_afpDistortFuncRnd[16] = TComRdCost::xGetSADsw<4>;
+  m_afpDistortFuncRnd[17] = TComRdCost::xGetSADsw<8>;
+  m_afpDistortFuncRnd[18] = TComRdCost::xGetSADsw<16>;
+  m_afpDistortFuncRnd[19] = TComRdCost::xGetSADsw<32>;
+  m_afpDistortFuncRnd[20] = TComRdCost::xGetSADsw<64>;
   m_afpDistortFuncRnd[21] = TComRdCost::xGetSADs16N;
 
   m_afpDistortFuncRnd[22] = TComRdCost::xGetHADs;
@@ -493,7 +493,13 @@ UInt TComRdCost::xGetSAD( DistParam* pcDtParam, Pel* pRefY, Bool bRound )
   return ( uiSum >> g_uiBitIncrement );
 }
 
-UInt TComRdCost::xGetSAD4( DistParam* pcDtParam, Pel* pRefY, Bool bRound )
+/** SAD of a block whose width is known at compile time, averaging the two references with rounding control
+    \param pcDtParam  distortion parameters, iCols must be equal to iWidth
+    \param pRefY      second prediction, stored with a stride of iCols
+    \param bRound     rounding offset added before averaging
+ */
+template<Int iWidth>
+UInt TComRdCost::xGetSADw( DistParam* pcDtParam, Pel* pRefY, Bool bRound )
 {
   Pel* piOrg   = pcDtParam->pOrg;
   Pel* piCur   = pcDtParam->pCur;
@@ -503,95 +509,26 @@ UInt TComRdCost::xGetSAD4( DistParam* pcDtParam, Pel* pRefY, Bool bRound )
   Int  iSubStep   = ( 1 << iSubShift );
   Int  iStrideCur = pcDtParam->iStrideCur*iSubStep;
   Int  iStrideOrg = pcDtParam->iStrideOrg*iSubStep;
+  Int  iStrideRef = iWidth*iSubStep;
   Pel  pred;
-  Int  i;
-
-  UInt uiSum = 0;
-
-  for( ; iRows != 0; iRows-=iSubStep )
-  {
-	  for(i = 0; i < 4; i++)
-	  {
-#ifdef ROUNDING_CONTROL_BIPRED_FIX
-		pred = (piCur[i] + piRef[i] + bRound) >> 1 ;
-#else
-		pred = xClip( (piCur[i] + piRef[i] + bRound) >> 1 );
-#endif
-		uiSum += abs( piOrg[i] - pred );
-	  }
-      piOrg += iStrideOrg;
-      piCur += iStrideCur;
-	  piRef += pcDtParam->iCols*iSubStep;
-  }
-
-  uiSum <<= iSubShift;
-  return ( uiSum >> g_uiBitIncrement );
-}
-
-UInt TComRdCost::xGetSAD8( DistParam* pcDtParam, Pel* pRefY, Bool bRound )
-{
-  Pel* piOrg      = pcDtParam->pOrg;
-  Pel* piCur      = pcDtParam->pCur;
-  Pel* piRef	  = pRefY;
-  Int  iRows      = pcDtParam->iRows;
-  Int  iSubShift  = pcDtParam->iSubShift;
-  Int  iSubStep   = ( 1 << iSubShift );
-  Int  iStrideCur = pcDtParam->iStrideCur*iSubStep;
-  Int  iStrideOrg = pcDtParam->iStrideOrg*iSubStep;
-  Pel  pred;
-  Int  i;
 
   UInt uiSum = 0;
 
   for( ; iRows != 0; iRows-=iSubStep )
   {
-	  for( i = 0; i < 8; i++)
-	  {
+    for ( Int n = 0; n < iWidth; n++ )
+    {
 #ifdef ROUNDING_CONTROL_BIPRED_FIX
-		pred = (piCur[i] + piRef[i] + bRound) >> 1 ;
+      pred = (piCur[n] + piRef[n] + bRound) >> 1 ;
 #else
-		pred = xClip( (piCur[i] + piRef[i] + bRound) >> 1 );
+      pred = xClip( (piCur[n] + piRef[n] + bRound) >> 1 );
 #endif
-		uiSum += abs( piOrg[i] - pred );
-	  }
-      piOrg += iStrideOrg;
-	  piCur += iStrideCur;
-	  piRef += pcDtParam->iCols*iSubStep;
-  }
-
-  uiSum <<= iSubShift;
-  return ( uiSum >> g_uiBitIncrement );
-}
-
-UInt TComRdCost::xGetSAD16( DistParam* pcDtParam, Pel* pRefY, Bool bRound )
-{
-  Pel* piOrg   = pcDtParam->pOrg;
-  Pel* piCur   = pcDtParam->pCur;
-  Pel* piRef   = pRefY;
-  Int  iRows   = pcDtParam->iRows;
-  Int  iSubShift  = pcDtParam->iSubShift;
-  Int  iSubStep   = ( 1 << iSubShift );
-  Int  iStrideCur = pcDtParam->iStrideCur*iSubStep;
-  Int  iStrideOrg = pcDtParam->iStrideOrg*iSubStep;
-  Pel  pred;
-  Int  i;
-
-  UInt uiSum = 0;
+      uiSum += abs( piOrg[n] - pred );
+    }
 
-  for( ; iRows != 0; iRows-=iSubStep )
-  {
-	  for( i = 0; i < 16; i++)
-	  {
-#ifdef ROUNDING_CONTROL_BIPRED_FIX
-		pred = (piCur[i] + piRef[i] + bRound) >> 1 ;
-#else
-		pred = xClip( (piCur[i] + piRef[i] + bRound) >> 1 );
-#endif
-		uiSum += abs( piOrg[i] - pred );
-	  }
-      piOrg += iStrideOrg;
-      piCur += iStrideCur;
-	  piRef += pcDtParam->iCols*iSubStep;
+    piOrg += iStrideOrg;
+    piCur += iStrideCur;
+    piRef += iStrideRef;
   }
 
   uiSum <<= iSubShift;
@@ -637,76 +574,6 @@ UInt TComRdCost::xGetSAD16N( DistParam* pcDtParam, Pel* pRefY, Bool bRound )
   return ( uiSum >> g_uiBitIncrement );
 }
 
-UInt TComRdCost::xGetSAD32( DistParam* pcDtParam, Pel* pRefY, Bool bRound )
-{
-  Pel* piOrg   = pcDtParam->pOrg;
-  Pel* piCur   = pcDtParam->pCur;
-  Pel* piRef   = pRefY;
-  Int  iRows   = pcDtParam->iRows;
-  Int  iSubShift  = pcDtParam->iSubShift;
-  Int  iSubStep   = ( 1 << iSubShift );
-  Int  iStrideCur = pcDtParam->iStrideCur*iSubStep;
-  Int  iStrideOrg = pcDtParam->iStrideOrg*iSubStep;
-  Pel  pred;
-  Int  i;
-
-  UInt uiSum = 0;
-
-  for( ; iRows != 0; iRows-=iSubStep )
-  {
-	  for(i = 0; i < 32; i++)
-	  {
-#ifdef ROUNDING_CONTROL_BIPRED_FIX
-		  pred = (piCur[i] + piRef[i] + bRound) >> 1 ;
-#else
-		  pred = xClip( (piCur[i] + piRef[i] + bRound) >> 1 );
-#endif
-		  uiSum += abs( piOrg[i] - pred );
-	  }
-      piOrg += iStrideOrg;
-      piCur += iStrideCur;
-	  piRef += pcDtParam->iCols*iSubStep;
-  }
-
-  uiSum <<= iSubShift;
-  return ( uiSum >> g_uiBitIncrement );
-}
-
-UInt TComRdCost::xGetSAD64( DistParam* pcDtParam, Pel* pRefY, Bool bRound )
-{
-  Pel* piOrg   = pcDtParam->pOrg;
-  Pel* piCur   = pcDtParam->pCur;
-  Pel* piRef   = pRefY;
-  Int  iRows   = pcDtParam->iRows;
-  Int  iSubShift  = pcDtParam->iSubShift;
-  Int  iSubStep   = ( 1 << iSubShift );
-  Int  iStrideCur = pcDtParam->iStrideCur*iSubStep;
-  Int  iStrideOrg = pcDtParam->iStrideOrg*iSubStep;
-  Pel  pred;
-  Int  i;
-
-  UInt uiSum = 0;
-
-  for( ; iRows != 0; iRows-=iSubStep )
-  {
-	  for(i = 0; i < 64; i++)
-	  {
-#ifdef ROUNDING_CONTROL_BIPRED_FIX
-		  pred = (piCur[i] + piRef[i] + bRound) >> 1 ;
-#else
-		  pred = xClip( (piCur[i] + piRef[i] + bRound) >> 1 );
-#endif
-		  uiSum += abs( piOrg[i] - pred );
-	  }
-      piOrg += iStrideOrg;
-      piCur += iStrideCur;
-	  piRef += pcDtParam->iCols*iSubStep;
-  }
-
-  uiSum <<= iSubShift;
-  return ( uiSum >> g_uiBitIncrement );
-}
-
 #endif
 
 UInt TComRdCost::xGetSAD( DistParam* pcDtParam )
@@ -733,7 +600,11 @@ UInt TComRdCost::xGetSAD( DistParam* pcDtParam )
   return ( uiSum >> g_uiBitIncrement );
 }
 
-UInt TComRdCost::xGetSAD4( DistParam* pcDtParam )
+/** SAD of a block whose width is known at compile time, so the row loop is fully unrolled
+    \param pcDtParam  distortion parameters, iCols must be equal to iWidth
+ */
+template<Int iWidth>
+UInt TComRdCost::xGetSADw( DistParam* pcDtParam )
 {
   Pel* piOrg   = pcDtParam->pOrg;
   Pel* piCur   = pcDtParam->pCur;
@@ -747,80 +618,10 @@ UInt TComRdCost::xGetSAD4( DistParam* pcDtParam )
 
   for( ; iRows != 0; iRows-=iSubStep )
   {
-    uiSum += abs( piOrg[0] - piCur[0] );
-    uiSum += abs( piOrg[1] - piCur[1] );
-    uiSum += abs( piOrg[2] - piCur[2] );
-    uiSum += abs( piOrg[3] - piCur[3] );
-
-    piOrg += iStrideOrg;
-    piCur += iStrideCur;
-  }
-
-  uiSum <<= iSubShift;
-  return ( uiSum >> g_uiBitIncrement );
-}
-
-UInt TComRdCost::xGetSAD8( DistParam* pcDtParam )
-{
-  Pel* piOrg      = pcDtParam->pOrg;
-  Pel* piCur      = pcDtParam->pCur;
-  Int  iRows      = pcDtParam->iRows;
-  Int  iSubShift  = pcDtParam->iSubShift;
-  Int  iSubStep   = ( 1 << iSubShift );
-  Int  iStrideCur = pcDtParam->iStrideCur*iSubStep;
-  Int  iStrideOrg = pcDtParam->iStrideOrg*iSubStep;
-
-  UInt uiSum = 0;
-
-  for( ; iRows != 0; iRows-=iSubStep )
-  {
-    uiSum += abs( piOrg[0] - piCur[0] );
-    uiSum += abs( piOrg[1] - piCur[1] );
-    uiSum += abs( piOrg[2] - piCur[2] );
-    uiSum += abs( piOrg[3] - piCur[3] );
-    uiSum += abs( piOrg[4] - piCur[4] );
-    uiSum += abs( piOrg[5] - piCur[5] );
-    uiSum += abs( piOrg[6] - piCur[6] );
-    uiSum += abs( piOrg[7] - piCur[7] );
-
-    piOrg += iStrideOrg;
-    piCur += iStrideCur;
-  }
-
-  uiSum <<= iSubShift;
-  return ( uiSum >> g_uiBitIncrement );
-}
-
-UInt TComRdCost::xGetSAD16( DistParam* pcDtParam )
-{
-  Pel* piOrg   = pcDtParam->pOrg;
-  Pel* piCur   = pcDtParam->pCur;
-  Int  iRows   = pcDtParam->iRows;
-  Int  iSubShift  = pcDtParam->iSubShift;
-  Int  iSubStep   = ( 1 << iSubShift );
-  Int  iStrideCur = pcDtParam->iStrideCur*iSubStep;
-  Int  iStrideOrg = pcDtParam->iStrideOrg*iSubStep;
-
-  UInt uiSum = 0;
-
-  for( ; iRows != 0; iRows-=iSubStep )
-  {
-    uiSum += abs( piOrg[0] - piCur[0] );
-    uiSum += abs( piOrg[1] - piCur[1] );
-    uiSum += abs( piOrg[2] - piCur[2] );
-    uiSum += abs( piOrg[3] - piCur[3] );
-    uiSum += abs( piOrg[4] - piCur[4] );
-    uiSum += abs( piOrg[5] - piCur[5] );
-    uiSum += abs( piOrg[6] - piCur[6] );
-    uiSum += abs( piOrg[7] - piCur[7] );
-    uiSum += abs( piOrg[8] - piCur[8] );
-    uiSum += abs( piOrg[9] - piCur[9] );
-    uiSum += abs( piOrg[10] - piCur[10] );
-    uiSum += abs( piOrg[11] - piCur[11] );
-    uiSum += abs( piOrg[12] - piCur[12] );
-    uiSum += abs( piOrg[13] - piCur[13] );
-    uiSum += abs( piOrg[14] - piCur[14] );
-    uiSum += abs( piOrg[15] - piCur[15] );
+    for ( Int n = 0; n < iWidth; n++ )
+    {
+      uiSum += abs( piOrg[n] - piCur[n] );
+    }
 
     piOrg += iStrideOrg;
     piCur += iStrideCur;
@@ -872,148 +673,6 @@ UInt TComRdCost::xGetSAD16N( DistParam* pcDtParam )
   return ( uiSum >> g_uiBitIncrement );
 }
 
-UInt TComRdCost::xGetSAD32( DistParam* pcDtParam )
-{
-  Pel* piOrg   = pcDtParam->pOrg;
-  Pel* piCur   = pcDtParam->pCur;
-  Int  iRows   = pcDtParam->iRows;
-  Int  iSubShift  = pcDtParam->iSubShift;
-  Int  iSubStep   = ( 1 << iSubShift );
-  Int  iStrideCur = pcDtParam->iStrideCur*iSubStep;
-  Int  iStrideOrg = pcDtParam->iStrideOrg*iSubStep;
-
-  UInt uiSum = 0;
-
-  for( ; iRows != 0; iRows-=iSubStep )
-  {
-    uiSum += abs( piOrg[0] - piCur[0] );
-    uiSum += abs( piOrg[1] - piCur[1] );
-    uiSum += abs( piOrg[2] - piCur[2] );
-    uiSum += abs( piOrg[3] - piCur[3] );
-    uiSum += abs( piOrg[4] - piCur[4] );
-    uiSum += abs( piOrg[5] - piCur[5] );
-    uiSum += abs( piOrg[6] - piCur[6] );
-    uiSum += abs( piOrg[7] - piCur[7] );
-    uiSum += abs( piOrg[8] - piCur[8] );
-    uiSum += abs( piOrg[9] - piCur[9] );
-    uiSum += abs( piOrg[10] - piCur[10] );
-    uiSum += abs( piOrg[11] - piCur[11] );
-    uiSum += abs( piOrg[12] - piCur[12] );
-    uiSum += abs( piOrg[13] - piCur[13] );
-    uiSum += abs( piOrg[14] - piCur[14] );
-    uiSum += abs( piOrg[15] - piCur[15] );
-    uiSum += abs( piOrg[16] - piCur[16] );
-    uiSum += abs( piOrg[17] - piCur[17] );
-    uiSum += abs( piOrg[18] - piCur[18] );
-    uiSum += abs( piOrg[19] - piCur[19] );
-    uiSum += abs( piOrg[20] - piCur[20] );
-    uiSum += abs( piOrg[21] - piCur[21] );
-    uiSum += abs( piOrg[22] - piCur[22] );
-    uiSum += abs( piOrg[23] - piCur[23] );
-    uiSum += abs( piOrg[24] - piCur[24] );
-    uiSum += abs( piOrg[25] - piCur[25] );
-    uiSum += abs( piOrg[26] - piCur[26] );
-    uiSum += abs( piOrg[27] - piCur[27] );
-    uiSum += abs( piOrg[28] - piCur[28] );
-    uiSum += abs( piOrg[29] - piCur[29] );
-    uiSum += abs( piOrg[30] - piCur[30] );
-    uiSum += abs( piOrg[31] - piCur[31] );
-
-    piOrg += iStrideOrg;
-    piCur += iStrideCur;
-  }
-
-  uiSum <<= iSubShift;
-  return ( uiSum >> g_uiBitIncrement );
-}
-
-UInt TComRdCost::xGetSAD64( DistParam* pcDtParam )
-{
-  Pel* piOrg   = pcDtParam->pOrg;
-  Pel* piCur   = pcDtParam->pCur;
-  Int  iRows   = pcDtParam->iRows;
-  Int  iSubShift  = pcDtParam->iSubShift;
-  Int  iSubStep   = ( 1 << iSubShift );
-  Int  iStrideCur = pcDtParam->iStrideCur*iSubStep;
-  Int  iStrideOrg = pcDtParam->iStrideOrg*iSubStep;
-
-  UInt uiSum = 0;
-
-  for( ; iRows != 0; iRows-=iSubStep )
-  {
-    uiSum += abs( piOrg[0] - piCur[0] );
-    uiSum += abs( piOrg[1] - piCur[1] );
-    uiSum += abs( piOrg[2] - piCur[2] );
-    uiSum += abs( piOrg[3] - piCur[3] );
-    uiSum += abs( piOrg[4] - piCur[4] );
-    uiSum += abs( piOrg[5] - piCur[5] );
-    uiSum += abs( piOrg[6] - piCur[6] );
-    uiSum += abs( piOrg[7] - piCur[7] );
-    uiSum += abs( piOrg[8] - piCur[8] );
-    uiSum += abs( piOrg[9] - piCur[9] );
-    uiSum += abs( piOrg[10] - piCur[10] );
-    uiSum += abs( piOrg[11] - piCur[11] );
-    uiSum += abs( piOrg[12] - piCur[12] );
-    uiSum += abs( piOrg[13] - piCur[13] );
-    uiSum += abs( piOrg[14] - piCur[14] );
-    uiSum += abs( piOrg[15] - piCur[15] );
-    uiSum += abs( piOrg[16] - piCur[16] );
-    uiSum += abs( piOrg[17] - piCur[17] );
-    uiSum += abs( piOrg[18] - piCur[18] );
-    uiSum += abs( piOrg[19] - piCur[19] );
-    uiSum += abs( piOrg[20] - piCur[20] );
-    uiSum += abs( piOrg[21] - piCur[21] );
-    uiSum += abs( piOrg[22] - piCur[22] );
-    uiSum += abs( piOrg[23] - piCur[23] );
-    uiSum += abs( piOrg[24] - piCur[24] );
-    uiSum += abs( piOrg[25] - piCur[25] );
-    uiSum += abs( piOrg[26] - piCur[26] );
-    uiSum += abs( piOrg[27] - piCur[27] );
-    uiSum += abs( piOrg[28] - piCur[28] );
-    uiSum += abs( piOrg[29] - piCur[29] );
-    uiSum += abs( piOrg[30] - piCur[30] );
-    uiSum += abs( piOrg[31] - piCur[31] );
-    uiSum += abs( piOrg[32] - piCur[32] );
-    uiSum += abs( piOrg[33] - piCur[33] );
-    uiSum += abs( piOrg[34] - piCur[34] );
-    uiSum += abs( piOrg[35] - piCur[35] );
-    uiSum += abs( piOrg[36] - piCur[36] );
-    uiSum += abs( piOrg[37] - piCur[37] );
-    uiSum += abs( piOrg[38] - piCur[38] );
-    uiSum += abs( piOrg[39] - piCur[39] );
-    uiSum += abs( piOrg[40] - piCur[40] );
-    uiSum += abs( piOrg[41] - piCur[41] );
-    uiSum += abs( piOrg[42] - piCur[42] );
-    uiSum += abs( piOrg[43] - piCur[43] );
-    uiSum += abs( piOrg[44] - piCur[44] );
-    uiSum += abs( piOrg[45] - piCur[45] );
-    uiSum += abs( piOrg[46] - piCur[46] );
-    uiSum += abs( piOrg[47] - piCur[47] );
-    uiSum += abs( piOrg[48] - piCur[48] );
-    uiSum += abs( piOrg[49] - piCur[49] );
-    uiSum += abs( piOrg[50] - piCur[50] );
-    uiSum += abs( piOrg[51] - piCur[51] );
-    uiSum += abs( piOrg[52] - piCur[52] );
-    uiSum += abs( piOrg[53] - piCur[53] );
-    uiSum += abs( piOrg[54] - piCur[54] );
-    uiSum += abs( piOrg[55] - piCur[55] );
-    uiSum += abs( piOrg[56] - piCur[56] );
-    uiSum += abs( piOrg[57] - piCur[57] );
-    uiSum += abs( piOrg[58] - piCur[58] );
-    uiSum += abs( piOrg[59] - piCur[59] );
-    uiSum += abs( piOrg[60] - piCur[60] );
-    uiSum += abs( piOrg[61] - piCur[61] );
-    uiSum += abs( piOrg[62] - piCur[62] );
-    uiSum += abs( piOrg[63] - piCur[63] );
-
-    piOrg += iStrideOrg;
-    piCur += iStrideCur;
-  }
-
-  uiSum <<= iSubShift;
-  return ( uiSum >> g_uiBitIncrement );
-}
-
 // --------------------------------------------------------------------------------------------------------------------
 // SAD with step (used in fractional search)
 // --------------------------------------------------------------------------------------------------------------------
@@ -1053,7 +712,13 @@ UInt TComRdCost::xGetSADs( DistParam* pcDtParam, Pel* pRefY, Bool bRound )
   return ( uiSum >> g_uiBitIncrement );
 }
 
-UInt TComRdCost::xGetSADs4( DistParam* pcDtParam, Pel* pRefY, Bool bRound )
+/** SAD with step of a block whose width is known at compile time, averaging the two references with rounding control
+    \param pcDtParam  distortion parameters, iCols must be equal to iWidth
+    \param pRefY      second prediction, stored with a stride of iCols
+    \param bRound     rounding offset added before averaging
+ */
+template<Int iWidth>
+UInt TComRdCost::xGetSADsw( DistParam* pcDtParam, Pel* pRefY, Bool bRound )
 {
   Pel* piOrg   = pcDtParam->pOrg;
   Pel* piCur   = pcDtParam->pCur;
@@ -1063,90 +728,24 @@ UInt TComRdCost::xGetSADs4( DistParam* pcDtParam, Pel* pRefY, Bool bRound )
   Int  iStrideOrg = pcDtParam->iStrideOrg;
   Int  iStep  = pcDtParam->iStep;
   Pel  pred;
-  Int  i;
 
   UInt uiSum = 0;
 
   for( ; iRows != 0; iRows-- )
   {
-    for(i = 0; i < 4; i++)
-	{
+    for ( Int n = 0; n < iWidth; n++ )
+    {
 #ifdef ROUNDING_CONTROL_BIPRED_FIX
-		pred = (piCur[i*iStep] + piRef[i] + bRound) >> 1 ;
+      pred = (piCur[n*iStep] + piRef[n] + bRound) >> 1 ;
 #else
-		pred = xClip( (piCur[i*iStep] + piRef[i] + bRound) >> 1 );
+      pred = xClip( (piCur[n*iStep] + piRef[n] + bRound) >> 1 );
 #endif
-		uiSum += abs( piOrg[i] - pred );
-	}
+      uiSum += abs( piOrg[n] - pred );
+    }
+
     piOrg += iStrideOrg;
     piCur += iStrideCur;
-	piRef += pcDtParam->iCols;
-  }
-
-  return ( uiSum >> g_uiBitIncrement );
-}
-
-UInt TComRdCost::xGetSADs8( DistParam* pcDtParam, Pel* pRefY, Bool bRound )
-{
-  Pel* piOrg   = pcDtParam->pOrg;
-  Pel* piCur   = pcDtParam->pCur;
-  Pel* piRef   = pRefY;
-  Int  iRows   = pcDtParam->iRows;
-  Int  iStrideCur = pcDtParam->iStrideCur;
-  Int  iStrideOrg = pcDtParam->iStrideOrg;
-  Int  iStep  = pcDtParam->iStep;
-  Pel  pred;
-  Int  i;
-
-  UInt uiSum = 0;
-
-  for( ; iRows != 0; iRows-- )
-  {
-	  for(i = 0; i < 8; i++)
-	  {
-#ifdef ROUNDING_CONTROL_BIPRED_FIX
-		pred = (piCur[i*iStep] + piRef[i] + bRound) >> 1 ;
-#else
-		  pred = xClip( (piCur[i*iStep] + piRef[i] + bRound) >> 1 );
-#endif
-		  uiSum += abs( piOrg[i] - pred );
-	  }
-      piOrg += iStrideOrg;
-      piCur += iStrideCur;
-	  piRef += pcDtParam->iCols;
-  }
-
-  return ( uiSum >> g_uiBitIncrement );
-}
-
-UInt TComRdCost::xGetSADs16( DistParam* pcDtParam, Pel* pRefY, Bool bRound )
-{
-  Pel* piOrg   = pcDtParam->pOrg;
-  Pel* piCur   = pcDtParam->pCur;
-  Pel* piRef   = pRefY;
-  Int  iRows   = pcDtParam->iRows;
-  Int  iStrideCur = pcDtParam->iStrideCur;
-  Int  iStrideOrg = pcDtParam->iStrideOrg;
-  Int  iStep   = pcDtParam->iStep;
-  Pel  pred;
-  Int  i;
-
-  UInt uiSum = 0;
-
-  for( ; iRows != 0; iRows-- )
-  {
-	  for(i = 0; i < 16; i++)
-	  {
-#ifdef ROUNDING_CONTROL_BIPRED_FIX
-		pred = (piCur[i*iStep] + piRef[i] + bRound) >> 1 ;
-#else
-		pred = xClip( (piCur[i*iStep] + piRef[i] + bRound) >> 1 );
-#endif
-		uiSum += abs( piOrg[i] - pred );
-	  }
-	  piOrg += iStrideOrg;
-      piCur += iStrideCur;
-	  piRef += pcDtParam->iCols;
+    piRef += iWidth;
   }
 
   return ( uiSum >> g_uiBitIncrement );
@@ -1189,73 +788,6 @@ UInt TComRdCost::xGetSADs16N( DistParam* pcDtParam, Pel* pRefY, Bool bRound )
   return ( uiSum >> g_uiBitIncrement );
 }
 
-UInt TComRdCost::xGetSADs32( DistParam* pcDtParam, Pel* pRefY, Bool bRound )
-{
-  Pel* piOrg   = pcDtParam->pOrg;
-  Pel* piCur   = pcDtParam->pCur;
-  Pel* piRef   = pRefY;
-  Int  iRows   = pcDtParam->iRows;
-  Int  iStrideCur = pcDtParam->iStrideCur;
-  Int  iStrideOrg = pcDtParam->iStrideOrg;
-  Int  iStep  = pcDtParam->iStep;
-  Pel  pred;
-  Int  i;
-
-  UInt uiSum = 0;
-
-  for( ; iRows != 0; iRows-- )
-  {
-	  for(i = 0; i < 32; i++)
-	  {
-#ifdef ROUNDING_CONTROL_BIPRED_FIX
-		pred = (piCur[iStep*i] + piRef[i] + bRound) >> 1 ;
-#else
-		pred = xClip( (piCur[iStep*i] + piRef[i] + bRound) >> 1 );
-#endif
-
-		uiSum += abs( piOrg[i] - pred );
-	  }
-      piOrg += iStrideOrg;
-      piCur += iStrideCur;
-	  piRef += pcDtParam->iCols;
-  }
-
-  return ( uiSum >> g_uiBitIncrement );
-}
-
-UInt TComRdCost::xGetSADs64( DistParam* pcDtParam, Pel* pRefY, Bool bRound )
-{
-  Pel* piOrg   = pcDtParam->pOrg;
-  Pel* piCur   = pcDtParam->pCur;
-  Pel* piRef   = pRefY;
-  Int  iRows   = pcDtParam->iRows;
-  Int  iStrideCur = pcDtParam->iStrideCur;
-  Int  iStrideOrg = pcDtParam->iStrideOrg;
-  Int  iStep  = pcDtParam->iStep;
-  Pel  pred;
-  Int  i;
-
-  UInt uiSum = 0;
-
-  for( ; iRows != 0; iRows-- )
-  {
-	  for(i = 0; i < 64; i++)
-	  {
-#ifdef ROUNDING_CONTROL_BIPRED_FIX
-		pred = (piCur[iStep*i] + piRef[i] + bRound) >> 1 ;
-#else
-		pred = xClip( (piCur[iStep*i] + piRef[i] + bRound) >> 1 );
-#endif
-		uiSum += abs( piOrg[i] - pred );
-	  }
-      piOrg += iStrideOrg;
-      piCur += iStrideCur;
-	  piRef += pcDtParam->iCols;
-  }
-
-  return ( uiSum >> g_uiBitIncrement );
-}
-
 #endif
 
 UInt TComRdCost::xGetSADs( DistParam* pcDtParam )
@@ -1283,7 +815,11 @@ UInt TComRdCost::xGetSADs( DistParam* pcDtParam )
   return ( uiSum >> g_uiBitIncrement );
 }
 
-UInt TComRdCost::xGetSADs4( DistParam* pcDtParam )
+/** SAD with step of a block whose width is known at compile time
+    \param pcDtParam  distortion parameters, iCols must be equal to iWidth
+ */
+template<Int iWidth>
+UInt TComRdCost::xGetSADsw( DistParam* pcDtParam )
 {
   Pel* piOrg   = pcDtParam->pOrg;
   Pel* piCur   = pcDtParam->pCur;
@@ -1291,103 +827,15 @@ UInt TComRdCost::xGetSADs4( DistParam* pcDtParam )
   Int  iStrideCur = pcDtParam->iStrideCur;
   Int  iStrideOrg = pcDtParam->iStrideOrg;
   Int  iStep  = pcDtParam->iStep;
-  Int  iStep2 = iStep<<1;
-  Int  iStep3 = iStep2 + iStep;
 
   UInt uiSum = 0;
 
   for( ; iRows != 0; iRows-- )
   {
-    uiSum += abs( piOrg[0] - piCur[     0] );
-    uiSum += abs( piOrg[1] - piCur[iStep ] );
-    uiSum += abs( piOrg[2] - piCur[iStep2] );
-    uiSum += abs( piOrg[3] - piCur[iStep3] );
-
-    piOrg += iStrideOrg;
-    piCur += iStrideCur;
-  }
-
-  return ( uiSum >> g_uiBitIncrement );
-}
-
-UInt TComRdCost::xGetSADs8( DistParam* pcDtParam )
-{
-  Pel* piOrg   = pcDtParam->pOrg;
-  Pel* piCur   = pcDtParam->pCur;
-  Int  iRows   = pcDtParam->iRows;
-  Int  iStrideCur = pcDtParam->iStrideCur;
-  Int  iStrideOrg = pcDtParam->iStrideOrg;
-  Int  iStep  = pcDtParam->iStep;
-  Int  iStep2 = iStep<<1;
-  Int  iStep3 = iStep2 + iStep;
-  Int  iStep4 = iStep3 + iStep;
-  Int  iStep5 = iStep4 + iStep;
-  Int  iStep6 = iStep5 + iStep;
-  Int  iStep7 = iStep6 + iStep;
-
-  UInt uiSum = 0;
-
-  for( ; iRows != 0; iRows-- )
-  {
-    uiSum += abs( piOrg[0] - piCur[     0] );
-    uiSum += abs( piOrg[1] - piCur[iStep ] );
-    uiSum += abs( piOrg[2] - piCur[iStep2] );
-    uiSum += abs( piOrg[3] - piCur[iStep3] );
-    uiSum += abs( piOrg[4] - piCur[iStep4] );
-    uiSum += abs( piOrg[5] - piCur[iStep5] );
-    uiSum += abs( piOrg[6] - piCur[iStep6] );
-    uiSum += abs( piOrg[7] - piCur[iStep7] );
-
-    piOrg += iStrideOrg;
-    piCur += iStrideCur;
-  }
-
-  return ( uiSum >> g_uiBitIncrement );
-}
-
-UInt TComRdCost::xGetSADs16( DistParam* pcDtParam )
-{
-  Pel* piOrg   = pcDtParam->pOrg;
-  Pel* piCur   = pcDtParam->pCur;
-  Int  iRows   = pcDtParam->iRows;
-  Int  iStrideCur = pcDtParam->iStrideCur;
-  Int  iStrideOrg = pcDtParam->iStrideOrg;
-  Int  iStep   = pcDtParam->iStep;
-  Int  iStep2  = iStep<<1;
-  Int  iStep3  = iStep2  + iStep;
-  Int  iStep4  = iStep3  + iStep;
-  Int  iStep5  = iStep4  + iStep;
-  Int  iStep6  = iStep5  + iStep;
-  Int  iStep7  = iStep6  + iStep;
-  Int  iStep8  = iStep7  + iStep;
-  Int  iStep9  = iStep8  + iStep;
-  Int  iStep10 = iStep9  + iStep;
-  Int  iStep11 = iStep10 + iStep;
-  Int  iStep12 = iStep11 + iStep;
-  Int  iStep13 = iStep12 + iStep;
-  Int  iStep14 = iStep13 + iStep;
-  Int  iStep15 = iStep14 + iStep;
-
-  UInt uiSum = 0;
-
-  for( ; iRows != 0; iRows-- )
-  {
-    uiSum += abs( piOrg[ 0] - piCur[      0] );
-    uiSum += abs( piOrg[ 1] - piCur[iStep  ] );
-    uiSum += abs( piOrg[ 2] - piCur[iStep2 ] );
-    uiSum += abs( piOrg[ 3] - piCur[iStep3 ] );
-    uiSum += abs( piOrg[ 4] - piCur[iStep4 ] );
-    uiSum += abs( piOrg[ 5] - piCur[iStep5 ] );
-    uiSum += abs( piOrg[ 6] - piCur[iStep6 ] );
-    uiSum += abs( piOrg[ 7] - piCur[iStep7 ] );
-    uiSum += abs( piOrg[ 8] - piCur[iStep8 ] );
-    uiSum += abs( piOrg[ 9] - piCur[iStep9 ] );
-    uiSum += abs( piOrg[10] - piCur[iStep10] );
-    uiSum += abs( piOrg[11] - piCur[iStep11] );
-    uiSum += abs( piOrg[12] - piCur[iStep12] );
-    uiSum += abs( piOrg[13] - piCur[iStep13] );
-    uiSum += abs( piOrg[14] - piCur[iStep14] );
-    uiSum += abs( piOrg[15] - piCur[iStep15] );
+    for ( Int n = 0; n < iWidth; n++ )
+    {
+      uiSum += abs( piOrg[n] - piCur[n*iStep] );
+    }
 
     piOrg += iStrideOrg;
     piCur += iStrideCur;
@@ -1436,236 +884,6 @@ UInt TComRdCost::xGetSADs16N( DistParam* pcDtParam )
   return ( uiSum >> g_uiBitIncrement );
 }
 
-UInt TComRdCost::xGetSADs32( DistParam* pcDtParam )
-{
-  Pel* piOrg   = pcDtParam->pOrg;
-  Pel* piCur   = pcDtParam->pCur;
-  Int  iRows   = pcDtParam->iRows;
-  Int  iStrideCur = pcDtParam->iStrideCur;
-  Int  iStrideOrg = pcDtParam->iStrideOrg;
-  Int  iStep  = pcDtParam->iStep;
-  Int  iStep2  = iStep<<1;
-  Int  iStep3  = iStep2  + iStep;
-  Int  iStep4  = iStep3  + iStep;
-  Int  iStep5  = iStep4  + iStep;
-  Int  iStep6  = iStep5  + iStep;
-  Int  iStep7  = iStep6  + iStep;
-  Int  iStep8  = iStep7  + iStep;
-  Int  iStep9  = iStep8  + iStep;
-  Int  iStep10 = iStep9  + iStep;
-  Int  iStep11 = iStep10 + iStep;
-  Int  iStep12 = iStep11 + iStep;
-  Int  iStep13 = iStep12 + iStep;
-  Int  iStep14 = iStep13 + iStep;
-  Int  iStep15 = iStep14 + iStep;
-  Int  iStep16 = iStep15 + iStep;
-  Int  iStep17 = iStep16 + iStep;
-  Int  iStep18 = iStep17 + iStep;
-  Int  iStep19 = iStep18 + iStep;
-  Int  iStep20 = iStep19 + iStep;
-  Int  iStep21 = iStep20 + iStep;
-  Int  iStep22 = iStep21 + iStep;
-  Int  iStep23 = iStep22 + iStep;
-  Int  iStep24 = iStep23 + iStep;
-  Int  iStep25 = iStep24 + iStep;
-  Int  iStep26 = iStep25 + iStep;
-  Int  iStep27 = iStep26 + iStep;
-  Int  iStep28 = iStep27 + iStep;
-  Int  iStep29 = iStep28 + iStep;
-  Int  iStep30 = iStep29 + iStep;
-  Int  iStep31 = iStep30 + iStep;
-
-  UInt uiSum = 0;
-
-  for( ; iRows != 0; iRows-- )
-  {
-    uiSum += abs( piOrg[ 0] - piCur[      0] );
-    uiSum += abs( piOrg[ 1] - piCur[iStep  ] );
-    uiSum += abs( piOrg[ 2] - piCur[iStep2 ] );
-    uiSum += abs( piOrg[ 3] - piCur[iStep3 ] );
-    uiSum += abs( piOrg[ 4] - piCur[iStep4 ] );
-    uiSum += abs( piOrg[ 5] - piCur[iStep5 ] );
-    uiSum += abs( piOrg[ 6] - piCur[iStep6 ] );
-    uiSum += abs( piOrg[ 7] - piCur[iStep7 ] );
-    uiSum += abs( piOrg[ 8] - piCur[iStep8 ] );
-    uiSum += abs( piOrg[ 9] - piCur[iStep9 ] );
-    uiSum += abs( piOrg[10] - piCur[iStep10] );
-    uiSum += abs( piOrg[11] - piCur[iStep11] );
-    uiSum += abs( piOrg[12] - piCur[iStep12] );
-    uiSum += abs( piOrg[13] - piCur[iStep13] );
-    uiSum += abs( piOrg[14] - piCur[iStep14] );
-    uiSum += abs( piOrg[15] - piCur[iStep15] );
-    uiSum += abs( piOrg[16] - piCur[iStep16] );
-    uiSum += abs( piOrg[17] - piCur[iStep17] );
-    uiSum += abs( piOrg[18] - piCur[iStep18] );
-    uiSum += abs( piOrg[19] - piCur[iStep19] );
-    uiSum += abs( piOrg[20] - piCur[iStep20] );
-    uiSum += abs( piOrg[21] - piCur[iStep21] );
-    uiSum += abs( piOrg[22] - piCur[iStep22] );
-    uiSum += abs( piOrg[23] - piCur[iStep23] );
-    uiSum += abs( piOrg[24] - piCur[iStep24] );
-    uiSum += abs( piOrg[25] - piCur[iStep25] );
-    uiSum += abs( piOrg[26] - piCur[iStep26] );
-    uiSum += abs( piOrg[27] - piCur[iStep27] );
-    uiSum += abs( piOrg[28] - piCur[iStep28] );
-    uiSum += abs( piOrg[29] - piCur[iStep29] );
-    uiSum += abs( piOrg[30] - piCur[iStep30] );
-    uiSum += abs( piOrg[31] - piCur[iStep31] );
-
-    piOrg += iStrideOrg;
-    piCur += iStrideCur;
-  }
-
-  return ( uiSum >> g_uiBitIncrement );
-}
-
-UInt TComRdCost::xGetSADs64( DistParam* pcDtParam )
-{
-  Pel* piOrg   = pcDtParam->pOrg;
-  Pel* piCur   = pcDtParam->pCur;
-  Int  iRows   = pcDtParam->iRows;
-  Int  iStrideCur = pcDtParam->iStrideCur;
-  Int  iStrideOrg = pcDtParam->iStrideOrg;
-  Int  iStep  = pcDtParam->iStep;
-  Int  iStep2  = iStep<<1;
-  Int  iStep3  = iStep2  + iStep;
-  Int  iStep4  = iStep3  + iStep;
-  Int  iStep5  = iStep4  + iStep;
-  Int  iStep6  = iStep5  + iStep;
-  Int  iStep7  = iStep6  + iStep;
-  Int  iStep8  = iStep7  + iStep;
-  Int  iStep9  = iStep8  + iStep;
-  Int  iStep10 = iStep9  + iStep;
-  Int  iStep11 = iStep10 + iStep;
-  Int  iStep12 = iStep11 + iStep;
-  Int  iStep13 = iStep12 + iStep;
-  Int  iStep14 = iStep13 + iStep;
-  Int  iStep15 = iStep14 + iStep;
-  Int  iStep16 = iStep15 + iStep;
-  Int  iStep17 = iStep16 + iStep;
-  Int  iStep18 = iStep17 + iStep;
-  Int  iStep19 = iStep18 + iStep;
-  Int  iStep20 = iStep19 + iStep;
-  Int  iStep21 = iStep20 + iStep;
-  Int  iStep22 = iStep21 + iStep;
-  Int  iStep23 = iStep22 + iStep;
-  Int  iStep24 = iStep23 + iStep;
-  Int  iStep25 = iStep24 + iStep;
-  Int  iStep26 = iStep25 + iStep;
-  Int  iStep27 = iStep26 + iStep;
-  Int  iStep28 = iStep27 + iStep;
-  Int  iStep29 = iStep28 + iStep;
-  Int  iStep30 = iStep29 + iStep;
-  Int  iStep31 = iStep30 + iStep;
-  Int  iStep32 = iStep31 + iStep;
-  Int  iStep33 = iStep32 + iStep;
-  Int  iStep34 = iStep33 + iStep;
-  Int  iStep35 = iStep34 + iStep;
-  Int  iStep36 = iStep35 + iStep;
-  Int  iStep37 = iStep36 + iStep;
-  Int  iStep38 = iStep37 + iStep;
-  Int  iStep39 = iStep38 + iStep;
-  Int  iStep40 = iStep39 + iStep;
-  Int  iStep41 = iStep40 + iStep;
-  Int  iStep42 = iStep41 + iStep;
-  Int  iStep43 = iStep42 + iStep;
-  Int  iStep44 = iStep43 + iStep;
-  Int  iStep45 = iStep44 + iStep;
-  Int  iStep46 = iStep45 + iStep;
-  Int  iStep47 = iStep46 + iStep;
-  Int  iStep48 = iStep47 + iStep;
-  Int  iStep49 = iStep48 + iStep;
-  Int  iStep50 = iStep49 + iStep;
-  Int  iStep51 = iStep50 + iStep;
-  Int  iStep52 = iStep51 + iStep;
-  Int  iStep53 = iStep52 + iStep;
-  Int  iStep54 = iStep53 + iStep;
-  Int  iStep55 = iStep54 + iStep;
-  Int  iStep56 = iStep55 + iStep;
-  Int  iStep57 = iStep56 + iStep;
-  Int  iStep58 = iStep57 + iStep;
-  Int  iStep59 = iStep58 + iStep;
-  Int  iStep60 = iStep59 + iStep;
-  Int  iStep61 = iStep60 + iStep;
-  Int  iStep62 = iStep61 + iStep;
-  Int  iStep63 = iStep62 + iStep;
-
-  UInt uiSum = 0;
-
-  for( ; iRows != 0; iRows-- )
-  {
-    uiSum += abs( piOrg[ 0] - piCur[      0] );
-    uiSum += abs( piOrg[ 1] - piCur[iStep  ] );
-    uiSum += abs( piOrg[ 2] - piCur[iStep2 ] );
-    uiSum += abs( piOrg[ 3] - piCur[iStep3 ] );
-    uiSum += abs( piOrg[ 4] - piCur[iStep4 ] );
-    uiSum += abs( piOrg[ 5] - piCur[iStep5 ] );
-    uiSum += abs( piOrg[ 6] - piCur[iStep6 ] );
-    uiSum += abs( piOrg[ 7] - piCur[iStep7 ] );
-    uiSum += abs( piOrg[ 8] - piCur[iStep8 ] );
-    uiSum += abs( piOrg[ 9] - piCur[iStep9 ] );
-    uiSum += abs( piOrg[10] - piCur[iStep10] );
-    uiSum += abs( piOrg[11] - piCur[iStep11] );
-    uiSum += abs( piOrg[12] - piCur[iStep12] );
-    uiSum += abs( piOrg[13] - piCur[iStep13] );
-    uiSum += abs( piOrg[14] - piCur[iStep14] );
-    uiSum += abs( piOrg[15] - piCur[iStep15] );
-    uiSum += abs( piOrg[16] - piCur[iStep16] );
-    uiSum += abs( piOrg[17] - piCur[iStep17] );
-    uiSum += abs( piOrg[18] - piCur[iStep18] );
-    uiSum += abs( piOrg[19] - piCur[iStep19] );
-    uiSum += abs( piOrg[20] - piCur[iStep20] );
-    uiSum += abs( piOrg[21] - piCur[iStep21] );
-    uiSum += abs( piOrg[22] - piCur[iStep22] );
-    uiSum += abs( piOrg[23] - piCur[iStep23] );
-    uiSum += abs( piOrg[24] - piCur[iStep24] );
-    uiSum += abs( piOrg[25] - piCur[iStep25] );
-    uiSum += abs( piOrg[26] - piCur[iStep26] );
-    uiSum += abs( piOrg[27] - piCur[iStep27] );
-    uiSum += abs( piOrg[28] - piCur[iStep28] );
-    uiSum += abs( piOrg[29] - piCur[iStep29] );
-    uiSum += abs( piOrg[30] - piCur[iStep30] );
-    uiSum += abs( piOrg[31] - piCur[iStep31] );
-    uiSum += abs( piOrg[32] - piCur[iStep32] );
-    uiSum += abs( piOrg[33] - piCur[iStep33] );
-    uiSum += abs( piOrg[34] - piCur[iStep34] );
-    uiSum += abs( piOrg[35] - piCur[iStep35] );
-    uiSum += abs( piOrg[36] - piCur[iStep36] );
-    uiSum += abs( piOrg[37] - piCur[iStep37] );
-    uiSum += abs( piOrg[38] - piCur[iStep38] );
-    uiSum += abs( piOrg[39] - piCur[iStep39] );
-    uiSum += abs( piOrg[40] - piCur[iStep40] );
-    uiSum += abs( piOrg[41] - piCur[iStep41] );
-    uiSum += abs( piOrg[42] - piCur[iStep42] );
-    uiSum += abs( piOrg[43] - piCur[iStep43] );
-    uiSum += abs( piOrg[44] - piCur[iStep44] );
-    uiSum += abs( piOrg[45] - piCur[iStep45] );
-    uiSum += abs( piOrg[46] - piCur[iStep46] );
-    uiSum += abs( piOrg[47] - piCur[iStep47] );
-    uiSum += abs( piOrg[48] - piCur[iStep48] );
-    uiSum += abs( piOrg[49] - piCur[iStep49] );
-    uiSum += abs( piOrg[50] - piCur[iStep50] );
-    uiSum += abs( piOrg[51] - piCur[iStep51] );
-    uiSum += abs( piOrg[52] - piCur[iStep52] );
-    uiSum += abs( piOrg[53] - piCur[iStep53] );
-    uiSum += abs( piOrg[54] - piCur[iStep54] );
-    uiSum += abs( piOrg[55] - piCur[iStep55] );
-    uiSum += abs( piOrg[56] - piCur[iStep56] );
-    uiSum += abs( piOrg[57] - piCur[iStep57] );
-    uiSum += abs( piOrg[58] - piCur[iStep58] );
-    uiSum += abs( piOrg[59] - piCur[iStep59] );
-    uiSum += abs( piOrg[60] - piCur[iStep60] );
-    uiSum += abs( piOrg[61] - piCur[iStep61] );
-    uiSum += abs( piOrg[62] - piCur[iStep62] );
-    uiSum += abs( piOrg[63] - piCur[iStep63] );
-
-    piOrg += iStrideOrg;
-    piCur += iStrideCur;
-  }
-
-  return ( uiSum >> g_uiBitIncrement );
-}
-
 // --------------------------------------------------------------------------------------------------------------------
 // SSE
 // --------------------------------------------------------------------------------------------------------------------
@@ -1949,66 +1167,11 @@ UInt TComRdCost::xGetSSE( DistParam* pcDtParam )
   return ( uiSum );
 }
 
-UInt TComRdCost::xGetSSE4( DistParam* pcDtParam )
-{
-  Pel* piOrg   = pcDtParam->pOrg;
-  Pel* piCur   = pcDtParam->pCur;
-  Int  iRows   = pcDtParam->iRows;
-  Int  iStrideOrg = pcDtParam->iStrideOrg;
-  Int  iStrideCur = pcDtParam->iStrideCur;
-
-  UInt uiSum = 0;
-  UInt uiShift = g_uiBitIncrement<<1;
-
-  Int  iTemp;
-
-  for( ; iRows != 0; iRows-- )
-  {
-
-    iTemp = piOrg[0] - piCur[0]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[1] - piCur[1]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[2] - piCur[2]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[3] - piCur[3]; uiSum += ( iTemp * iTemp ) >> uiShift;
-
-    piOrg += iStrideOrg;
-    piCur += iStrideCur;
-  }
-
-  return ( uiSum );
-}
-
-UInt TComRdCost::xGetSSE8( DistParam* pcDtParam )
-{
-  Pel* piOrg   = pcDtParam->pOrg;
-  Pel* piCur   = pcDtParam->pCur;
-  Int  iRows   = pcDtParam->iRows;
-  Int  iStrideOrg = pcDtParam->iStrideOrg;
-  Int  iStrideCur = pcDtParam->iStrideCur;
-
-  UInt uiSum = 0;
-  UInt uiShift = g_uiBitIncrement<<1;
-
-  Int  iTemp;
-
-  for( ; iRows != 0; iRows-- )
-  {
-    iTemp = piOrg[0] - piCur[0]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[1] - piCur[1]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[2] - piCur[2]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[3] - piCur[3]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[4] - piCur[4]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[5] - piCur[5]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[6] - piCur[6]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[7] - piCur[7]; uiSum += ( iTemp * iTemp ) >> uiShift;
-
-    piOrg += iStrideOrg;
-    piCur += iStrideCur;
-  }
-
-  return ( uiSum );
-}
-
-UInt TComRdCost::xGetSSE16( DistParam* pcDtParam )
+/** SSE of a block whose width is known at compile time
+    \param pcDtParam  distortion parameters, iCols must be equal to iWidth
+ */
+template<Int iWidth>
+UInt TComRdCost::xGetSSEw( DistParam* pcDtParam )
 {
   Pel* piOrg   = pcDtParam->pOrg;
   Pel* piCur   = pcDtParam->pCur;
@@ -2023,23 +1186,10 @@ UInt TComRdCost::xGetSSE16( DistParam* pcDtParam )
 
   for( ; iRows != 0; iRows-- )
   {
-
-    iTemp = piOrg[ 0] - piCur[ 0]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[ 1] - piCur[ 1]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[ 2] - piCur[ 2]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[ 3] - piCur[ 3]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[ 4] - piCur[ 4]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[ 5] - piCur[ 5]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[ 6] - piCur[ 6]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[ 7] - piCur[ 7]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[ 8] - piCur[ 8]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[ 9] - piCur[ 9]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[10] - piCur[10]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[11] - piCur[11]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[12] - piCur[12]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[13] - piCur[13]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[14] - piCur[14]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[15] - piCur[15]; uiSum += ( iTemp * iTemp ) >> uiShift;
+    for ( Int n = 0; n < iWidth; n++ )
+    {
+      iTemp = piOrg[n] - piCur[n]; uiSum += ( iTemp * iTemp ) >> uiShift;
+    }
 
     piOrg += iStrideOrg;
     piCur += iStrideCur;
@@ -2091,147 +1241,6 @@ UInt TComRdCost::xGetSSE16N( DistParam* pcDtParam )
   return ( uiSum );
 }
 
-UInt TComRdCost::xGetSSE32( DistParam* pcDtParam )
-{
-  Pel* piOrg   = pcDtParam->pOrg;
-  Pel* piCur   = pcDtParam->pCur;
-  Int  iRows   = pcDtParam->iRows;
-  Int  iStrideOrg = pcDtParam->iStrideOrg;
-  Int  iStrideCur = pcDtParam->iStrideCur;
-
-  UInt uiSum = 0;
-  UInt uiShift = g_uiBitIncrement<<1;
-  Int  iTemp;
-
-  for( ; iRows != 0; iRows-- )
-  {
-
-    iTemp = piOrg[ 0] - piCur[ 0]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[ 1] - piCur[ 1]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[ 2] - piCur[ 2]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[ 3] - piCur[ 3]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[ 4] - piCur[ 4]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[ 5] - piCur[ 5]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[ 6] - piCur[ 6]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[ 7] - piCur[ 7]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[ 8] - piCur[ 8]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[ 9] - piCur[ 9]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[10] - piCur[10]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[11] - piCur[11]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[12] - piCur[12]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[13] - piCur[13]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[14] - piCur[14]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[15] - piCur[15]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[16] - piCur[16]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[17] - piCur[17]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[18] - piCur[18]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[19] - piCur[19]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[20] - piCur[20]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[21] - piCur[21]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[22] - piCur[22]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[23] - piCur[23]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[24] - piCur[24]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[25] - piCur[25]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[26] - piCur[26]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[27] - piCur[27]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[28] - piCur[28]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[29] - piCur[29]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[30] - piCur[30]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[31] - piCur[31]; uiSum += ( iTemp * iTemp ) >> uiShift;
-
-    piOrg += iStrideOrg;
-    piCur += iStrideCur;
-  }
-
-  return ( uiSum );
-}
-
-UInt TComRdCost::xGetSSE64( DistParam* pcDtParam )
-{
-  Pel* piOrg   = pcDtParam->pOrg;
-  Pel* piCur   = pcDtParam->pCur;
-  Int  iRows   = pcDtParam->iRows;
-  Int  iStrideOrg = pcDtParam->iStrideOrg;
-  Int  iStrideCur = pcDtParam->iStrideCur;
-
-  UInt uiSum = 0;
-  UInt uiShift = g_uiBitIncrement<<1;
-  Int  iTemp;
-
-  for( ; iRows != 0; iRows-- )
-  {
-    iTemp = piOrg[ 0] - piCur[ 0]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[ 1] - piCur[ 1]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[ 2] - piCur[ 2]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[ 3] - piCur[ 3]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[ 4] - piCur[ 4]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[ 5] - piCur[ 5]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[ 6] - piCur[ 6]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[ 7] - piCur[ 7]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[ 8] - piCur[ 8]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[ 9] - piCur[ 9]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[10] - piCur[10]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[11] - piCur[11]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[12] - piCur[12]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[13] - piCur[13]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[14] - piCur[14]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[15] - piCur[15]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[16] - piCur[16]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[17] - piCur[17]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[18] - piCur[18]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[19] - piCur[19]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[20] - piCur[20]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[21] - piCur[21]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[22] - piCur[22]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[23] - piCur[23]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[24] - piCur[24]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[25] - piCur[25]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[26] - piCur[26]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[27] - piCur[27]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[28] - piCur[28]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[29] - piCur[29]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[30] - piCur[30]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[31] - piCur[31]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[32] - piCur[32]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[33] - piCur[33]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[34] - piCur[34]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[35] - piCur[35]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[36] - piCur[36]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[37] - piCur[37]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[38] - piCur[38]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[39] - piCur[39]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[40] - piCur[40]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[41] - piCur[41]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[42] - piCur[42]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[43] - piCur[43]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[44] - piCur[44]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[45] - piCur[45]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[46] - piCur[46]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[47] - piCur[47]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[48] - piCur[48]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[49] - piCur[49]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[50] - piCur[50]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[51] - piCur[51]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[52] - piCur[52]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[53] - piCur[53]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[54] - piCur[54]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[55] - piCur[55]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[56] - piCur[56]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[57] - piCur[57]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[58] - piCur[58]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[59] - piCur[59]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[60] - piCur[60]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[61] - piCur[61]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[62] - piCur[62]; uiSum += ( iTemp * iTemp ) >> uiShift;
-    iTemp = piOrg[63] - piCur[63]; uiSum += ( iTemp * iTemp ) >> uiShift;
-
-    piOrg += iStrideOrg;
-    piCur += iStrideCur;
-  }
-
-  return ( uiSum );
-}
-
 // --------------------------------------------------------------------------------------------------------------------
 // HADAMARD with step (used in fractional search)
 // --------------------------------------------------------------------------------------------------------------------
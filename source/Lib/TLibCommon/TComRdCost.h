@@ -177,27 +177,18 @@ public:
 private:
 
   static UInt xGetSSE           ( DistParam* pcDtParam );
-  static UInt xGetSSE4          ( DistParam* pcDtParam );
-  static UInt xGetSSE8          ( DistParam* pcDtParam );
-  static UInt xGetSSE16         ( DistParam* pcDtParam );
-  static UInt xGetSSE32         ( DistParam* pcDtParam );
-  static UInt xGetSSE64         ( DistParam* pcDtParam );
+  template<Int iWidth>
+  static UInt xGetSSEw          ( DistParam* pcDtParam );
   static UInt xGetSSE16N        ( DistParam* pcDtParam );
 
   static UInt xGetSAD           ( DistParam* pcDtParam );
-  static UInt xGetSAD4          ( DistParam* pcDtParam );
-  static UInt xGetSAD8          ( DistParam* pcDtParam );
-  static UInt xGetSAD16         ( DistParam* pcDtParam );
-  static UInt xGetSAD32         ( DistParam* pcDtParam );
-  static UInt xGetSAD64         ( DistParam* pcDtParam );
+  template<Int iWidth>
+  static UInt xGetSADw          ( DistParam* pcDtParam );
   static UInt xGetSAD16N        ( DistParam* pcDtParam );
 
   static UInt xGetSADs          ( DistParam* pcDtParam );
-  static UInt xGetSADs4         ( DistParam* pcDtParam );
-  static UInt xGetSADs8         ( DistParam* pcDtParam );
-  static UInt xGetSADs16        ( DistParam* pcDtParam );
-  static UInt xGetSADs32        ( DistParam* pcDtParam );
-  static UInt xGetSADs64        ( DistParam* pcDtParam );
+  template<Int iWidth>
+  static UInt xGetSADsw         ( DistParam* pcDtParam );
   static UInt xGetSADs16N       ( DistParam* pcDtParam );
 
   static UInt xGetHADs4         ( DistParam* pcDtParam );
@@ -218,19 +209,13 @@ private:
   static UInt xGetSSE16N        ( DistParam* pcDtParam, Pel* pRefY, Bool bRound );
 
   static UInt xGetSAD           ( DistParam* pcDtParam, Pel* pRefY, Bool bRound );
-  static UInt xGetSAD4          ( DistParam* pcDtParam, Pel* pRefY, Bool bRound );
-  static UInt xGetSAD8          ( DistParam* pcDtParam, Pel* pRefY, Bool bRound );
-  static UInt xGetSAD16         ( DistParam* pcDtParam, Pel* pRefY, Bool bRound );
-  static UInt xGetSAD32         ( DistParam* pcDtParam, Pel* pRefY, Bool bRound );
-  static UInt xGetSAD64         ( DistParam* pcDtParam, Pel* pRefY, Bool bRound );
+  template<Int iWidth>
+  static UInt xGetSADw          ( DistParam* pcDtParam, Pel* pRefY, Bool bRound );
   static UInt xGetSAD16N        ( DistParam* pcDtParam, Pel* pRefY, Bool bRound );
 
   static UInt xGetSADs          ( DistParam* pcDtParam, Pel* pRefY, Bool bRound );
-  static UInt xGetSADs4         ( DistParam* pcDtParam, Pel* pRefY, Bool bRound );
-  static UInt xGetSADs8         ( DistParam* pcDtParam, Pel* pRefY, Bool bRound );
-  static UInt xGetSADs16        ( DistParam* pcDtParam, Pel* pRefY, Bool bRound );
-  static UInt xGetSADs32        ( DistParam* pcDtParam, Pel* pRefY, Bool bRound );
-  static UInt xGetSADs64        ( DistParam* pcDtParam, Pel* pRefY, Bool bRound );
+  template<Int iWidth>
+  static UInt xGetSADsw         ( DistParam* pcDtParam, Pel* pRefY, Bool bRound );
   static UInt xGetSADs16N       ( DistParam* pcDtParam, Pel* pRefY, Bool bRound );
 
   static UInt xGetHADs4         ( DistParam* pcDtParam, Pel* pRefY, Bool bRound );
@@ -34,6 +34,7 @@
 */
 
 #include "TComRom.h"
+#include "TComTrQuant.h"
 #include <memory.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -41,11 +42,19 @@
 // Initialize / destroy functions
 // ====================================================================================================================
 
-// initialize ROM variables
+/// number of encoder and decoder instances which use the ROM tables
+static Int s_iROMRefCount = 0;
+
+// initialize ROM variables, the tables are shared by all encoder and decoder instances
 Void initROM()
 {
   Int i, c;
 
+  if ( s_iROMRefCount++ > 0 )
+  {
+    return;
+  }
+
   // g_aucConvertToBit[ x ]: log2(x/4), if x=4 -> 0, x=8 -> 1, x=16 -> 2, ...
   ::memset( g_aucConvertToBit,   -1, sizeof( g_aucConvertToBit ) );
   c=0;
@@ -82,6 +91,17 @@ Void initROM()
     initSigLastScanPattern( g_auiSigLastScan[ i ][ 1 ], i, true  );
     initSigLastScanPattern( g_auiSigLastScan[ i ][ 0 ], i, false );
   }
+
+  // last flag context per block position, transform blocks are at least 4x4
+  for ( i = 0; i < MAX_CU_DEPTH+1; i++ )
+  {
+    g_auhLastCtxInc[ i ] = NULL;
+    if ( i >= 2 )
+    {
+      g_auhLastCtxInc[ i ] = new UChar[ 1 << ( i << 1 ) ];
+      initLastCtxInc( g_auhLastCtxInc[ i ], i );
+    }
+  }
 #endif
 
 #if QC_MDDT
@@ -135,6 +155,11 @@ Void destroyROM()
 {
   Int i;
 
+  if ( --s_iROMRefCount > 0 )
+  {
+    return;
+  }
+
   for ( i=0; i<MAX_CU_DEPTH; i++ )
   {
     delete[] g_auiFrameScanXY[i];
@@ -147,6 +172,7 @@ Void destroyROM()
   {
     delete[] g_auiSigLastScan[i][0];
     delete[] g_auiSigLastScan[i][1];
+    delete[] g_auhLastCtxInc[i];
   }
 #endif
 
@@ -210,6 +236,18 @@ UInt g_auiRasterToPelY  [ MAX_NUM_SPU_W*MAX_NUM_SPU_W ] = { 0, };
 UInt g_auiPUOffset[8] = { 0, 8, 4, 4, 2, 10, 1, 5 };
 #endif
 
+const UChar g_aaauhPURuns[8][4][1+2*MAX_PU_RUNS] =
+{
+  { { 1, 0, 16 },                   { 1, 0, 16 },                   { 1, 0, 16 },         { 1, 0, 16 }         }, // 2Nx2N
+  { { 1, 0,  8 },                   { 1, 0,  8 },                   { 1, 0,  8 },         { 1, 0,  8 }         }, // 2NxN
+  { { 2, 0,  4, 8,  4 },            { 2, 0,  4, 8,  4 },            { 2, 0, 4, 8, 4 },    { 2, 0, 4, 8, 4 }    }, // Nx2N
+  { { 1, 0,  4 },                   { 1, 0,  4 },                   { 1, 0,  4 },         { 1, 0,  4 }         }, // NxN
+  { { 2, 0,  2,  4, 2 },            { 2, 0,  2,  4, 10 },           { 0 },                { 0 }                }, // 2NxnU
+  { { 2, 0, 10, 12, 2 },            { 2, 0,  2,  4,  2 },           { 0 },                { 0 }                }, // 2NxnD
+  { { 4, 0,  1,  8, 1, 2, 1, 10, 1 }, { 4, 0, 1, 8, 1, 2, 5, 10, 5 }, { 0 },              { 0 }                }, // nLx2N
+  { { 4, 0,  5,  8, 5, 6, 1, 14, 1 }, { 4, 0, 1, 2, 1, 8, 1, 10, 1 }, { 0 },              { 0 }                }, // nRx2N
+};
+
 Void initZscanToRaster ( Int iMaxDepth, Int iDepth, UInt uiStartVal, UInt*& rpuiCurrIdx )
 {
   Int iStride = 1 << ( iMaxDepth - 1 );
@@ -2368,6 +2406,7 @@ UInt* g_auiFrameScanY [ MAX_CU_DEPTH  ];
 
 #if HHI_TRANSFORM_CODING
 UInt* g_auiSigLastScan[ MAX_CU_DEPTH+1  ][ 2 ];
+UChar* g_auhLastCtxInc [ MAX_CU_DEPTH+1  ];
 #endif
 
 // scanning order to 8x8 context model mapping table
@@ -2452,6 +2491,21 @@ Void initSigLastScanPattern( UInt* puiScanPattern, const UInt uiLog2BlockSize, c
   }
   return;
 }
+
+/** \param puhCtxInc        table of last flag context indices in raster order of the block positions
+    \param uiLog2BlockSize  log2 of the transform block size, at least 2
+ */
+Void initLastCtxInc( UChar* puhCtxInc, const UInt uiLog2BlockSize )
+{
+  const UInt uiBlockSize = 1 << uiLog2BlockSize;
+  for ( UInt uiPosY = 0; uiPosY < uiBlockSize; uiPosY++ )
+  {
+    for ( UInt uiPosX = 0; uiPosX < uiBlockSize; uiPosX++ )
+    {
+      puhCtxInc[ ( uiPosY << uiLog2BlockSize ) + uiPosX ] = UChar( TComTrQuant::getLastCtxInc( uiPosX, uiPosY, uiLog2BlockSize ) );
+    }
+  }
+}
 #endif
 
 #if QC_MDDT
@@ -37,6 +37,8 @@
 #define __TCOMROM__
 
 #include "CommonDef.h"
+#include <memory.h>
+#include <assert.h>
 
 #if HHI_RQT
 #include<stdio.h>
@@ -62,6 +64,7 @@ Void         initFrameScanXY( UInt* pBuff, UInt* pBuffX, UInt* pBuffY, Int iWidt
 
 #if HHI_TRANSFORM_CODING
 Void         initSigLastScanPattern( UInt* puiScanPattern, const UInt uiLog2BlockSize, const bool bDownLeft );
+Void         initLastCtxInc( UChar* puhCtxInc, const UInt uiLog2BlockSize );
 #endif
 
 // ====================================================================================================================
@@ -91,6 +94,43 @@ extern       UInt g_uiAddCUDepth;
 extern       UInt g_auiPUOffset[8];
 #endif
 
+// z-order runs covered by a PU, relative to its first partition: { number of runs, ( offset, length ) pairs }
+// in units of 1/16 of the CU partitions, indexed by [part size][PU index]
+#define     MAX_PU_RUNS             4
+extern const UChar g_aaauhPURuns[8][4][1+2*MAX_PU_RUNS];
+
+/// set all partitions of a PU to one value, uiNumPart is the number of partitions of the CU
+template <typename T>
+inline Void setPURuns( T* pBase, T tValue, PartSize ePartSize, UInt uiPUIdx, UInt uiNumPart )
+{
+  assert( ePartSize < 8 && uiPUIdx < 4 );
+  const UChar* puhRuns = g_aaauhPURuns[ ePartSize ][ uiPUIdx ];
+  for ( UInt uiRun = 0; uiRun < puhRuns[0]; uiRun++ )
+  {
+    T*   p   = pBase + ( ( puhRuns[ 2*uiRun+1 ] * uiNumPart ) >> 4 );
+    UInt uiN = ( puhRuns[ 2*uiRun+2 ] * uiNumPart ) >> 4;
+    for ( UInt ui = 0; ui < uiN; ui++ )
+    {
+      p[ ui ] = tValue;
+    }
+  }
+}
+
+inline Void setPURuns( UChar* puhBase, UChar uhValue, PartSize ePartSize, UInt uiPUIdx, UInt uiNumPart )
+{
+  assert( ePartSize < 8 && uiPUIdx < 4 );
+  const UChar* puhRuns = g_aaauhPURuns[ ePartSize ][ uiPUIdx ];
+  for ( UInt uiRun = 0; uiRun < puhRuns[0]; uiRun++ )
+  {
+    memset( puhBase + ( ( puhRuns[ 2*uiRun+1 ] * uiNumPart ) >> 4 ), uhValue, ( puhRuns[ 2*uiRun+2 ] * uiNumPart ) >> 4 );
+  }
+}
+
+inline Void setPURuns( Bool* pbBase, Bool bValue, PartSize ePartSize, UInt uiPUIdx, UInt uiNumPart )
+{
+  setPURuns( (UChar*)pbBase, (UChar)bValue, ePartSize, uiPUIdx, uiNumPart );
+}
+
 // ====================================================================================================================
 // Quantization & DeQuantization
 // ====================================================================================================================
@@ -178,6 +218,7 @@ extern const Short kltCol8x8[9][8][8];
 #endif
 #if HHI_TRANSFORM_CODING
 extern       UInt*  g_auiSigLastScan[ MAX_CU_DEPTH+1  ][ 2 ];
+extern       UChar* g_auhLastCtxInc [ MAX_CU_DEPTH+1  ];
 #endif
 
 // ====================================================================================================================
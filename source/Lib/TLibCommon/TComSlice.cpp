@@ -76,6 +76,13 @@ TComSlice::TComSlice()
   m_auiAddRefCnt[0]  = 0;
   m_auiAddRefCnt[1]  = 0;
 
+  ::memset( m_apcVirtPic,      0, sizeof( m_apcVirtPic      ) );
+  ::memset( m_apcVirtBase,     0, sizeof( m_apcVirtBase     ) );
+  ::memset( m_auiVirtBandMask, 0, sizeof( m_auiVirtBandMask ) );
+  ::memset( m_aiVirtBandsLeft, 0, sizeof( m_aiVirtBandsLeft ) );
+  m_iVirtBandHeight = 0;
+  m_iVirtNumBands   = 0;
+
 #ifdef EDGE_BASED_PREDICTION
     m_bEdgePredictionEnable = false;
 #endif //EDGE_BASED_PREDICTION
@@ -397,7 +404,7 @@ Void TComSlice::setRefPicList       ( TComList<TComPic*>& rcListPic )
 
 #if HHI_INTERP_FILTER
       pcRefPic->getPicYuvRec()    ->extendPicBorder( getInterpFilterType() );
-      pcRefPic->getPicYuvRecFilt()->extendPicBorder( getInterpFilterType() );
+      pcRefPic->prepareRecFilt( getInterpFilterType() );
 #else
       pcRefPic->getPicYuvRec()->extendPicBorder();
 #endif
@@ -442,7 +449,7 @@ Void TComSlice::setRefPicList       ( TComList<TComPic*>& rcListPic )
 
 #if HHI_INTERP_FILTER
       pcRefPic->getPicYuvRec()    ->extendPicBorder( getInterpFilterType() );
-      pcRefPic->getPicYuvRecFilt()->extendPicBorder( getInterpFilterType() );
+      pcRefPic->prepareRecFilt( getInterpFilterType() );
 #else
       pcRefPic->getPicYuvRec()->extendPicBorder();
 #endif
@@ -516,7 +523,7 @@ Void TComSlice::setRefPicList       ( TComList<TComPic*>& rcListPic )
 
 #if HHI_INTERP_FILTER
         pcRefPic->getPicYuvRec()    ->extendPicBorder( getInterpFilterType() );
-        pcRefPic->getPicYuvRecFilt()->extendPicBorder( getInterpFilterType() );
+        pcRefPic->prepareRecFilt( getInterpFilterType() );
 #else
         pcRefPic->getPicYuvRec()->extendPicBorder();
 #endif
@@ -545,6 +552,7 @@ Void TComSlice::setVirtRefBuffer(TComPic* pSrc[2][GRF_MAX_NUM_EFF])
   for (Int j=0; j<2; j++)
   {
     m_apcVirtPic[j][i] = pSrc[j][i];
+    m_aiVirtBandsLeft[j][i] = 0;
   }
 }
 
@@ -563,20 +571,34 @@ Void TComSlice::linkVirtRefPic()
     for ( i=0; i<numRefIdxN; i++ )
     {
       setRefPic(m_apcVirtPic[n][i], eRefPicList, numRefIdx+i);
-
-#if HHI_INTERP_FILTER
-      m_apcVirtPic[n][i]->getPicYuvRec()    ->extendPicBorder( getInterpFilterType() );
-      m_apcVirtPic[n][i]->getPicYuvRecFilt()->extendPicBorder( getInterpFilterType() );
-#else
-      m_apcVirtPic[n][i]->getPicYuvRec()->extendPicBorder();
-#endif
-
       setEqualRef(eRefPicList, 0, numRefIdx+i, true);
     }
     setNumRefIdx(eRefPicList, numRefIdx+numRefIdxN);
   }
 }
 
+/** Free the sample buffers of the virtual references once the slice has been coded.
+    A later read through getRefPicYuvRec() allocates and weights them again.
+ */
+Void TComSlice::releaseVirtRefPic()
+{
+  for (Int j=0; j<2; j++)
+  for (Int i=0; i<m_auiAddRefCnt[j]; i++)
+  {
+    if ( m_apcVirtPic[j][i] == NULL )
+    {
+      continue;
+    }
+    m_apcVirtPic[j][i]->destroyPicYuvRec();
+
+    if ( m_auiVirtBandMask[j][i] || m_aiVirtBandsLeft[j][i] )
+    {
+      m_auiVirtBandMask[j][i] = 0;
+      m_aiVirtBandsLeft[j][i] = m_iVirtNumBands;
+    }
+  }
+}
+
 Void TComSlice::removeEffectMode(RefPicList e, EFF_MODE eEffMode)
 {
   Int iPosIdx = 0, iTmpIdx;
@@ -598,6 +620,9 @@ Void TComSlice::removeEffectMode(RefPicList e, EFF_MODE eEffMode)
   {
     m_aeEffectMode[e][iTmpIdx] = m_aeEffectMode[e][iTmpIdx+1];
     m_apcVirtPic[e][iTmpIdx] = m_apcVirtPic[e][iTmpIdx+1];
+    m_apcVirtBase[e][iTmpIdx] = m_apcVirtBase[e][iTmpIdx+1];
+    m_auiVirtBandMask[e][iTmpIdx] = m_auiVirtBandMask[e][iTmpIdx+1];
+    m_aiVirtBandsLeft[e][iTmpIdx] = m_aiVirtBandsLeft[e][iTmpIdx+1];
   }
 }
 
@@ -679,31 +704,147 @@ Bool TComSlice::isEqualWPAllParam( RefPicList e, EFF_MODE eEffMode1, EFF_MODE eE
   return true;
 }
 
+/** Weighting of the virtual reference is deferred until motion compensation reads it.
+    Only the source picture is recorded here; getRefPicYuvRec() weights the row bands on demand.
+ */
 Void TComSlice::generateWPSlice( RefPicList e, EFF_MODE eEffMode, UInt uiInsertIdx)
 {
   assert( eEffMode >= EFF_WP_SO && eEffMode <= EFF_WP_O );
 
-  Int x, y, iWidth, iHeight, iStride, iWeight, iOffset;
-  TComPicYuv* pcPicYuvRef;
-  Pel *pDst, *pSrc;
+  TComPic* pcRefPic = getRefPic(e, 0);
+
+  m_apcVirtPic[e][uiInsertIdx]->getSlice()->setPOC( pcRefPic->getPOC() );
+
+  Int iHeight = pcRefPic->getPicYuvRec()->getHeight();
+
+  m_iVirtBandHeight = g_uiMaxCUHeight;
+  while ( ( iHeight + m_iVirtBandHeight - 1 ) / m_iVirtBandHeight > GRF_WP_MAX_BANDS )
+  {
+    m_iVirtBandHeight <<= 1;
+  }
+  m_iVirtNumBands = ( iHeight + m_iVirtBandHeight - 1 ) / m_iVirtBandHeight;
+
+  m_apcVirtBase    [e][uiInsertIdx] = pcRefPic;
+  m_auiVirtBandMask[e][uiInsertIdx] = 0;
+  m_aiVirtBandsLeft[e][uiInsertIdx] = m_iVirtNumBands;
+#if HHI_INTERP_FILTER
+  m_apcVirtPic[e][uiInsertIdx]->setRecFiltReady( false );
+#endif
+}
+
+/** Get the reconstruction of a reference picture for reading the rows iTopY..iBottomY.
+    Every sample read of a reference goes through here, so a virtual reference is only weighted where it is used.
+    \param e         reference picture list
+    \param iRefIdx   reference index
+    \param iTopY     first luma row that will be read (picture coordinates)
+    \param iBottomY  last luma row that will be read (picture coordinates)
+    \returns reconstructed picture buffer of the reference
+ */
+TComPicYuv* TComSlice::getRefPicYuvRec( RefPicList e, Int iRefIdx, Int iTopY, Int iBottomY )
+{
+  xPrepareWPRefRows( e, iRefIdx, iTopY, iBottomY );
+  return m_apcRefPicList[e][iRefIdx]->getPicYuvRec();
+}
+
+#if HHI_INTERP_FILTER
+/** Get the MOMS coefficients of a reference picture. They need the whole weighted picture when the reference is virtual.
+ */
+TComPicYuv* TComSlice::getRefPicYuvRecFilt( RefPicList e, Int iRefIdx )
+{
+  TComPic* pcRefPic = m_apcRefPicList[e][iRefIdx];
 
-  pcPicYuvRef = getRefPic(e, 0)->getPicYuvRec();
+  if ( iRefIdx >= getNumRefIdx(e) - (Int)getAddRefCnt(e) )
+  {
+    xPrepareWPRefRows( e, iRefIdx, 0, getSPS()->getHeight() - 1 );
+    pcRefPic->prepareRecFilt( getInterpFilterType() );
+  }
+
+  return pcRefPic->getPicYuvRecFilt();
+}
+#endif
+
+/** Make sure the rows iTopY..iBottomY (luma, picture coordinates) of a weighted virtual reference are available.
+    The sample buffer of the virtual reference is allocated on its first use.
+ */
+Void TComSlice::xPrepareWPRefRows( RefPicList e, Int iRefIdx, Int iTopY, Int iBottomY )
+{
+  Int iVirtIdx = iRefIdx - ( getNumRefIdx(e) - (Int)getAddRefCnt(e) );
+
+  if ( iVirtIdx < 0 || m_apcVirtPic[e][iVirtIdx] != m_apcRefPicList[e][iRefIdx] )
+  {
+    return;
+  }
+
+  TComPic* pcVirtPic = m_apcVirtPic[e][iVirtIdx];
+  if ( pcVirtPic->getPicYuvRec() == NULL )
+  {
+    pcVirtPic->createPicYuvRec( getSPS()->getWidth(), getSPS()->getHeight() );
+
+    // margins of the weighted picture are produced together with its rows
+    pcVirtPic->getPicYuvRec()->setBorderExtension( true );
+  }
+
+  if ( m_aiVirtBandsLeft[e][iVirtIdx] == 0 )
+  {
+    return;
+  }
 
-  m_apcVirtPic[e][uiInsertIdx]->getSlice()->setPOC( getRefPic(e, 0)->getPOC() );
+  Int iLastRow = m_apcVirtBase[e][iVirtIdx]->getPicYuvRec()->getHeight() - 1;
+  Int iFirst   = Min( Max( iTopY,    0 ), iLastRow ) / m_iVirtBandHeight;
+  Int iLast    = Min( Max( iBottomY, 0 ), iLastRow ) / m_iVirtBandHeight;
+
+  for ( Int iBand = iFirst; iBand <= iLast; iBand++ )
+  {
+    UInt64 uiBit = (UInt64)1 << iBand;
+    if ( ( m_auiVirtBandMask[e][iVirtIdx] & uiBit ) == 0 )
+    {
+      xWeightWPBand( e, iVirtIdx, iBand );
+      m_auiVirtBandMask[e][iVirtIdx] |= uiBit;
+      m_aiVirtBandsLeft[e][iVirtIdx]--;
+    }
+  }
+}
+
+/** Weight one row band of a virtual reference. The first and the last band also cover the top and bottom margins,
+    the source picture is already border-extended so the margins come out identical to an extension of the weighted picture.
+ */
+Void TComSlice::xWeightWPBand( RefPicList e, Int iVirtIdx, Int iBand )
+{
+  EFF_MODE    eEffMode    = getEffectMode(e, iVirtIdx);
+  TComPicYuv* pcPicYuvRef = m_apcVirtBase[e][iVirtIdx]->getPicYuvRec();
+  TComPicYuv* pcPicYuvDst = m_apcVirtPic [e][iVirtIdx]->getPicYuvRec();
+
+  Int x, y, iWeight, iOffset;
+  Pel *pDst, *pSrc;
 
   // Luma
-  iWidth  = pcPicYuvRef->getWidth();
-  iHeight = pcPicYuvRef->getHeight();
-  iStride = pcPicYuvRef->getStride();
-  pSrc    = pcPicYuvRef->getLumaAddr();
-  pDst    = m_apcVirtPic[e][uiInsertIdx]->getPicYuvRec()->getLumaAddr();
+  Int iStride = pcPicYuvRef->getStride();
+  Int iMargin = pcPicYuvRef->getLumaMargin();
+  Int iHeight = pcPicYuvRef->getHeight();
+  Int iTop    = iBand * m_iVirtBandHeight;
+  Int iBottom = Min( iTop + m_iVirtBandHeight, iHeight );
+  Int iTopC   = iTop    >> 1;
+  Int iBottomC= iBottom >> 1;
+
+  if ( iBand == 0 )
+  {
+    iTop  = -iMargin;
+    iTopC = -pcPicYuvRef->getChromaMargin();
+  }
+  if ( iBand == m_iVirtNumBands - 1 )
+  {
+    iBottom  = iHeight + iMargin;
+    iBottomC = ( iHeight >> 1 ) + pcPicYuvRef->getChromaMargin();
+  }
 
   iWeight = getWPWeight(e, eEffMode, 0);
   iOffset = getWPOffset(e, eEffMode, 0);
 
+  pSrc    = pcPicYuvRef->getLumaAddr() + iTop * iStride - iMargin;
+  pDst    = pcPicYuvDst->getLumaAddr() + iTop * iStride - iMargin;
 
-  for (y=0; y<iHeight; y++) {
-    for (x=0; x<iWidth; x++) {
+  for (y=iTop; y<iBottom; y++) {
+    for (x=0; x<iStride; x++) {
       pDst[x] = Clip( ((iWeight*pSrc[x] + m_iWPLumaRound) >> m_iLumaLogWeightDenom) + iOffset );
     }
     pDst += iStride;
@@ -711,20 +852,18 @@ Void TComSlice::generateWPSlice( RefPicList e, EFF_MODE eEffMode, UInt uiInsertI
   }
 
   // Chroma
-  iWidth  >>= 1;
-  iHeight >>= 1;
-  iStride >>= 1;
+  iStride = pcPicYuvRef->getCStride();
+  iMargin = pcPicYuvRef->getChromaMargin();
 
   iWeight = getWPWeight(e, eEffMode, 1);
   iOffset = getWPOffset(e, eEffMode, 1);
 
-  pSrc    = pcPicYuvRef->getCbAddr();
-  pDst    = m_apcVirtPic[e][uiInsertIdx]->getPicYuvRec()->getCbAddr();
+  pSrc    = pcPicYuvRef->getCbAddr() + iTopC * iStride - iMargin;
+  pDst    = pcPicYuvDst->getCbAddr() + iTopC * iStride - iMargin;
 
-  for (y=0; y<iHeight; y++) {
-    for (x=0; x<iWidth; x++) {
+  for (y=iTopC; y<iBottomC; y++) {
+    for (x=0; x<iStride; x++) {
       pDst[x] = Clip( ((iWeight*pSrc[x] + m_iWPChromaRound) >> m_iChromaLogWeightDenom) + iOffset );
-
     }
     pDst += iStride;
     pSrc += iStride;
@@ -733,11 +872,11 @@ Void TComSlice::generateWPSlice( RefPicList e, EFF_MODE eEffMode, UInt uiInsertI
   iWeight = getWPWeight(e, eEffMode, 2);
   iOffset = getWPOffset(e, eEffMode, 2);
 
-  pSrc    = pcPicYuvRef->getCrAddr();
-  pDst    = m_apcVirtPic[e][uiInsertIdx]->getPicYuvRec()->getCrAddr();
+  pSrc    = pcPicYuvRef->getCrAddr() + iTopC * iStride - iMargin;
+  pDst    = pcPicYuvDst->getCrAddr() + iTopC * iStride - iMargin;
 
-  for (y=0; y<iHeight; y++) {
-    for (x=0; x<iWidth; x++) {
+  for (y=iTopC; y<iBottomC; y++) {
+    for (x=0; x<iStride; x++) {
       pDst[x] = Clip( ((iWeight*pSrc[x] + m_iWPChromaRound) >> m_iChromaLogWeightDenom) + iOffset );
     }
     pDst += iStride;
@@ -44,6 +44,7 @@
 #endif
 
 class TComPic;
+class TComPicYuv;
 
 // ====================================================================================================================
 // Class definition
@@ -336,6 +337,11 @@ private:
   EFF_MODE    m_aeEffectMode[2][GRF_MAX_NUM_EFF];
   UInt        m_auiAddRefCnt[2];
   TComPic*    m_apcVirtPic  [2][GRF_MAX_NUM_EFF];
+  TComPic*    m_apcVirtBase [2][GRF_MAX_NUM_EFF];     // source picture of each virtual reference
+  UInt64      m_auiVirtBandMask[2][GRF_MAX_NUM_EFF];   // row bands already weighted
+  Int         m_aiVirtBandsLeft[2][GRF_MAX_NUM_EFF];   // row bands still to be weighted
+  Int         m_iVirtBandHeight;
+  Int         m_iVirtNumBands;
   Bool        m_abEqualRef  [2][MAX_NUM_REF+GRF_MAX_NUM_EFF][MAX_NUM_REF+GRF_MAX_NUM_EFF];
 
   Int         m_iWPWeight   [2][GRF_MAX_NUM_WEFF][3];
@@ -467,6 +473,12 @@ public:
 
   Void setVirtRefBuffer(TComPic* pSrc[2][GRF_MAX_NUM_EFF]);
   Void linkVirtRefPic();
+  Void releaseVirtRefPic();
+
+  TComPicYuv* getRefPicYuvRec    ( RefPicList e, Int iRefIdx, Int iTopY, Int iBottomY );
+#if HHI_INTERP_FILTER
+  TComPicYuv* getRefPicYuvRecFilt( RefPicList e, Int iRefIdx );
+#endif
 
   Void initEqualRef();
   Bool      isEqualRef  ( RefPicList e, Int iRefIdx1, Int iRefIdx2 )
@@ -500,6 +512,15 @@ protected:
                          RefPicList          eRefPicList,
                          UInt                uiNthRefPic );
 
+  Void      xPrepareWPRefRows (RefPicList      e,
+                               Int             iRefIdx,
+                               Int             iTopY,
+                               Int             iBottomY );
+
+  Void      xWeightWPBand (RefPicList          e,
+                           Int                 iVirtIdx,
+                           Int                 iBand );
+
 };// END CLASS DEFINITION TComSlice
 
 
@@ -48,6 +48,7 @@
 
 #define RDOQ_CHROMA                 1           ///< use of RDOQ in chroma
 #define RDOQ_ROT_IDX0_ONLY          0           ///< use of RDOQ with ROT
+#define FAST_RDOQ_ZERO_THRES        3           ///< fast RDOQ: block is zeroed if no level reaches THRES/4 of a quantization step
 
 #define DQ_BITS                     6
 #define Q_BITS_8                    16
@@ -241,6 +242,7 @@ Void QpParam::initOffsetParam( Int iStartQP, Int iEndQP )
 TComTrQuant::TComTrQuant()
 {
   m_cQP.clear();
+  m_bUseFastRDOQ = false;
 
   // allocate temporary buffers
   m_plTempCoeff  = new Long[ MAX_CU_SIZE*MAX_CU_SIZE ];
@@ -2729,6 +2731,43 @@ Void TComTrQuant::xRateDistOptQuant_LCEC             ( TComDataCU*
 #endif
 #endif
 
+/** quantize a block of a large transform size
+ * \param piQuantCoef scaling matrix of the block, or the single scaling factor of the 64x64 transform
+ * \param bROT        the top-left 8x8 coefficients are already scaled by the rotational transform
+ * \param bZeroHF     coefficients outside the top-left 8x8 are discarded
+ */
+template<Int iWidth>
+Void TComTrQuant::xQuantLTRw( Long* piCoef, TCoeff* piQCoef, Int iHeight, UInt* piQuantCoef, Int iAdd, Int iNewBits, Bool bROT, Bool bZeroHF, UInt& ruiAcSum )
+{
+  for( Int y = 0; y < iHeight; y++ )
+  {
+    for( Int x = 0; x < iWidth; x++ )
+    {
+      Int  n        = y*iWidth + x;
+      Bool bLowFreq = ( y < 8 && x < 8 );
+      Long iLevel   = (Long) piCoef[n];
+      Int  iSign    = (iLevel < 0 ? -1: 1);
+
+      if ( bROT && bLowFreq ) iLevel = abs( iLevel );
+      else                    iLevel = abs( iLevel ) * piQuantCoef[ iWidth == 64 ? 0 : n ];
+
+      if ( bZeroHF && !bLowFreq ) iLevel = 0;
+      else                        iLevel = ( iLevel + iAdd ) >> iNewBits;
+
+      if( 0 != iLevel )
+      {
+        ruiAcSum  += iLevel;
+        iLevel    *= iSign;
+        piQCoef[n] = iLevel;
+      }
+      else
+      {
+        piQCoef[n] = 0;
+      }
+    }
+  }
+}
+
 Void TComTrQuant::xQuantLTR  (TComDataCU* pcCU, Long* pSrc, TCoeff*& pDes, Int iWidth, Int iHeight, UInt& uiAcSum, TextType eTType, UInt uiAbsPartIdx, UChar indexROT )
 {
   Long*   piCoef    = pSrc;
@@ -2737,6 +2776,7 @@ Void TComTrQuant::xQuantLTR  (TComDataCU* pcCU, Long* pSrc, TCoeff*& pDes, Int i
   Int   iNewBits    = 0;
   Int   iAdd = 0;
   Bool  bLogical    = false;
+  FpQuantLTR pfQuant = NULL;
 
   if ( iWidth > (Int)m_uiMaxTrSize )
   {
@@ -2770,6 +2810,7 @@ Void TComTrQuant::xQuantLTR  (TComDataCU* pcCU, Long* pSrc, TCoeff*& pDes, Int i
       piQuantCoef = ( g_aiQuantCoef256[m_cQP.rem()] );
       iNewBits = ECore16Shift + m_cQP.per();
       iAdd = m_cQP.m_iAdd16x16;
+      pfQuant  = TComTrQuant::xQuantLTRw<16>;
       break;
     }
   case 32:
@@ -2777,6 +2818,7 @@ Void TComTrQuant::xQuantLTR  (TComDataCU* pcCU, Long* pSrc, TCoeff*& pDes, Int i
       piQuantCoef = ( g_aiQuantCoef1024[m_cQP.rem()] );
       iNewBits = ECore32Shift + m_cQP.per();
       iAdd = m_cQP.m_iAdd32x32;
+      pfQuant  = TComTrQuant::xQuantLTRw<32>;
       break;
     }
   case 64:
@@ -2784,6 +2826,7 @@ Void TComTrQuant::xQuantLTR  (TComDataCU* pcCU, Long* pSrc, TCoeff*& pDes, Int i
       piQuantCoef = g_aiQuantCoef4096;   // To save the memory for g_aiQuantCoef4096
       iNewBits = ECore64Shift + m_cQP.per();
       iAdd = bLogical ? m_cQP.m_iAddNxN : m_cQP.m_iAdd64x64;
+      pfQuant  = TComTrQuant::xQuantLTRw<64>;
       break;
     }
   }
@@ -2824,51 +2867,12 @@ Void TComTrQuant::xQuantLTR  (TComDataCU* pcCU, Long* pSrc, TCoeff*& pDes, Int i
 #if QC_MDDT || LCEC_PHASE1_ADAPT_ENABLE
     UInt uiAcSum_init = uiAcSum;
 #endif
-    for( Int n = 0; n < iWidth*iHeight; n++ )
-    {
-      Long iLevel;
-      Int  iSign;
-      if ( m_bUseROT && indexROT )
-      {
-        iLevel  = (Long) piCoef[n];
-        iSign   = (iLevel < 0 ? -1: 1);
-
-        if ( ( n/iWidth ) < 8 && ( n%iWidth ) < 8 )
-        {
-          iLevel = abs( iLevel );
-        }
-        else
-        {
-          if ( iWidth == 64 ) iLevel = abs( iLevel ) * piQuantCoef[m_cQP.rem()];
-          else                iLevel = abs( iLevel ) * piQuantCoef[n];
-        }
-      }
-      else
-      {
-        iLevel  = (Long) piCoef[n];
-        iSign   = (iLevel < 0 ? -1: 1);
-        if ( iWidth == 64 ) iLevel = abs( iLevel ) * piQuantCoef[m_cQP.rem()];
-        else                iLevel = abs( iLevel ) * piQuantCoef[n];
-      }
-
 #if LCEC_PHASE1
-	    if (!pcCU->isIntra( uiAbsPartIdx ) && (m_iSymbolMode == 0) && ((n%iWidth)>=8 || (n/iWidth)>=8))
-		    iLevel = 0;
-      else
+    Bool bZeroHF = !pcCU->isIntra( uiAbsPartIdx ) && m_iSymbolMode == 0;
+#else
+    Bool bZeroHF = false;
 #endif
-      iLevel = ( iLevel + iAdd ) >> iNewBits;
-
-      if( 0 != iLevel )
-      {
-        uiAcSum += iLevel;
-        iLevel    *= iSign;
-        piQCoef[n] = iLevel;
-      }
-      else
-      {
-        piQCoef[n] = 0;
-      }
-    }
+    pfQuant( piCoef, piQCoef, iHeight, iWidth == 64 ? piQuantCoef + m_cQP.rem() : piQuantCoef, iAdd, iNewBits, m_bUseROT && indexROT, bZeroHF, uiAcSum );
 #if LCEC_PHASE1_ADAPT_ENABLE
   const UInt*  pucScan;
   if(pcCU->isIntra( uiAbsPartIdx ) && m_iSymbolMode == 0 && iWidth >= 16)
@@ -2938,6 +2942,20 @@ Void TComTrQuant::xQuantLTR  (TComDataCU* pcCU, Long* pSrc, TCoeff*& pDes, Int i
 
   }
 }
+/** dequantize a block of a large transform size
+ * \param piDeQuantCoef scaling matrix of the block, or the single scaling factor of the 64x64 transform
+ */
+template<Int iWidth>
+Void TComTrQuant::xDeQuantLTRw( TCoeff* piQCoef, Long* piCoef, Int iHeight, UInt* piDeQuantCoef, Int iShift )
+{
+  for( Int n = 0; n < iWidth*iHeight; n++ )
+  {
+    Int iLevel   = piQCoef[n];
+    Int iDeScale = piDeQuantCoef[ iWidth == 64 ? 0 : n ];
+    piCoef[n] = (Long) (iLevel*iDeScale) << iShift;
+  }
+}
+
 #if QC_MDDT
 Void TComTrQuant::xDeQuantLTR( TextType eText, UInt uiMode, TCoeff* pSrc, Long*& pDes, Int iWidth, Int iHeight, UChar indexROT )
 #else
@@ -2945,6 +2963,7 @@ Void TComTrQuant::xDeQuantLTR( TCoeff* pSrc, Long*& pDes, Int iWidth, Int iHeigh
 #endif
 {
   UInt* piDeQuantCoef = NULL;
+  FpDeQuantLTR pfDeQuant = NULL;
 
   TCoeff* piQCoef   = pSrc;
   Long*   piCoef    = pDes;
@@ -2985,38 +3004,24 @@ Void TComTrQuant::xDeQuantLTR( TCoeff* pSrc, Long*& pDes, Int iWidth, Int iHeigh
   case 16:
     {
       piDeQuantCoef = ( g_aiDeQuantCoef256[m_cQP.rem()] );
+      pfDeQuant     = TComTrQuant::xDeQuantLTRw<16>;
       break;
     }
   case 32:
     {
       piDeQuantCoef = ( g_aiDeQuantCoef1024[m_cQP.rem()] );
+      pfDeQuant     = TComTrQuant::xDeQuantLTRw<32>;
       break;
     }
   case 64:
     {
       piDeQuantCoef = ( g_aiDeQuantCoef4096 ); // To save the memory for g_aiDeQuantCoef4096
+      pfDeQuant     = TComTrQuant::xDeQuantLTRw<64>;
       break;
     }
   }
 
-  Int iLevel;
-  Int iDeScale;
-
-  for( Int n = 0; n < iWidth*iHeight; n++ )
-  {
-    iLevel  = piQCoef[n];
-
-    if( 0 != iLevel )
-    {
-      if ( iWidth == 64 ) iDeScale = piDeQuantCoef[m_cQP.rem()];
-      else                iDeScale = piDeQuantCoef[n];
-      piCoef[n] = (Long) (iLevel*iDeScale) << m_cQP.per();
-    }
-    else
-    {
-      piCoef [n] = 0;
-    }
-  }
+  pfDeQuant( piQCoef, piCoef, iHeight, iWidth == 64 ? piDeQuantCoef + m_cQP.rem() : piDeQuantCoef, m_cQP.per() );
 
   if ( m_bUseROT && indexROT )
   {
@@ -5168,6 +5173,7 @@ Void TComTrQuant::init( UInt uiMaxWidth, UInt uiMaxHeight, UInt uiMaxTrSize, Boo
   m_uiMaxTrSize  = uiMaxTrSize;
   m_bEnc         = bEnc;
   m_bUseRDOQ     = bUseRDOQ;
+  m_bUseFastRDOQ = false;
   m_bUseROT			 = bUseROT;
 #if LCEC_PHASE1
 #if LCEC_PHASE2
@@ -6748,6 +6754,12 @@ Void TComTrQuant::xRateDistOptQuant                 ( TComDataCU*
   UInt    uiMaxLineNum        = 0;
   Bool    bSubBlockCoding     = ( uiLog2BlkSize > 2 );
   Double  d64BlockUncodedCost = 0;
+  Bool    bZeroBlock          = true;
+#if QC_MDDT
+  Int64   lZeroThres          = Int64( m_bUseFastRDOQ ? FAST_RDOQ_ZERO_THRES : 2 ) << ( iQBits - 2 );
+#else
+  Long    lZeroThres          = Long ( m_bUseFastRDOQ ? FAST_RDOQ_ZERO_THRES : 2 ) << ( iQBits - 2 );
+#endif
 
   // Allocation on stack to avoid recurring memory allocation/deallocation on heap
   Int piCoeff[MAX_CU_SIZE * MAX_CU_SIZE];
@@ -6836,6 +6848,10 @@ Void TComTrQuant::xRateDistOptQuant                 ( TComDataCU*
 #endif
 
     plLevelDouble[ uiBlkPos ] = lLevelDouble;
+    if ( lLevelDouble >= lZeroThres )
+    {
+      bZeroBlock = false;
+    }
 #if QC_MDDT
     //assert(iQBits < 32);
     UInt uiMaxAbsLevel = (UInt)(lLevelDouble >> iQBits);
@@ -6891,6 +6907,24 @@ Void TComTrQuant::xRateDistOptQuant                 ( TComDataCU*
 #endif
   }
 
+  //===== skip blocks without any level worth coding =====
+  if ( bZeroBlock )
+  {
+    return;
+  }
+
+  //===== rate tables for the last flag, indexed by the context of each block position =====
+  const UChar* puhCtxLast = g_auhLastCtxInc[ uiLog2BlkSize ];
+  Double  ad64CostLast[ 16 ][ 2 ];
+  if ( m_bUseFastRDOQ )
+  {
+    for ( UInt uiCtx = 0; uiCtx < 16; uiCtx++ )
+    {
+      ad64CostLast[ uiCtx ][ 0 ] = xGetICost( m_pcEstBitsSbac->lastBits[ uiCtx ][ 0 ] );
+      ad64CostLast[ uiCtx ][ 1 ] = xGetICost( m_pcEstBitsSbac->lastBits[ uiCtx ][ 1 ] );
+    }
+  }
+
   //===== estimate context models =====
   if ( bSubBlockCoding )
   {
@@ -7134,9 +7168,9 @@ Void TComTrQuant::xRateDistOptQuant                 ( TComDataCU*
     if( uiLevel )
     {
       //----- check for last flag -----
-      UShort  uiCtxLast             = getLastCtxInc( uiPosX, uiPosY, uiLog2BlkSize );
-      Double  d64CostLastZero       = xGetICost( m_pcEstBitsSbac->lastBits[ uiCtxLast ][ 0 ] );
-      Double  d64CostLastOne        = xGetICost( m_pcEstBitsSbac->lastBits[ uiCtxLast ][ 1 ] );
+      UShort  uiCtxLast             = puhCtxLast[ uiBlkPos ];
+      Double  d64CostLastZero       = m_bUseFastRDOQ ? ad64CostLast[ uiCtxLast ][ 0 ] : xGetICost( m_pcEstBitsSbac->lastBits[ uiCtxLast ][ 0 ] );
+      Double  d64CostLastOne        = m_bUseFastRDOQ ? ad64CostLast[ uiCtxLast ][ 1 ] : xGetICost( m_pcEstBitsSbac->lastBits[ uiCtxLast ][ 1 ] );
       Double  d64CurrIsLastCost     = d64BaseCost + d64CostLastOne;
       d64BaseCost                  += d64CostLastZero;
 
@@ -67,6 +67,10 @@
 // Type definition
 // ====================================================================================================================
 
+// quantizer and dequantizer kernels of the large transform sizes, one instantiation per width
+typedef Void (*FpQuantLTR)   ( Long* piCoef, TCoeff* piQCoef, Int iHeight, UInt* piQuantCoef, Int iAdd, Int iNewBits, Bool bROT, Bool bZeroHF, UInt& ruiAcSum );
+typedef Void (*FpDeQuantLTR) ( TCoeff* piQCoef, Long* piCoef, Int iHeight, UInt* piDeQuantCoef, Int iShift );
+
 #if HHI_TRANSFORM_CODING
 typedef struct
 {
@@ -227,6 +231,8 @@ public:
   // Misc functions
   Void setQPforQuant( Int iQP, Bool bLowpass, SliceType eSliceType, TextType eTxtType);
   Void setLambda(Double dLambda) { m_dLambda = dLambda;}
+  Void setUseFastRDOQ( Bool b )   { m_bUseFastRDOQ = b;   }
+  Bool getUseFastRDOQ()           { return m_bUseFastRDOQ; }
 
   estBitsSbacStruct* m_pcEstBitsSbac;
 
@@ -260,6 +266,7 @@ protected:
   Bool	   m_bUseROT;
   Bool     m_bEnc;
   Bool     m_bUseRDOQ;
+  Bool     m_bUseFastRDOQ;
 
 #if LCEC_PHASE1
 #if LCEC_PHASE2
@@ -299,6 +306,8 @@ private:
   // quantization
   Void xQuant     ( TComDataCU* pcCU, Long* pSrc, TCoeff*& pDes, Int iWidth, Int iHeight, UInt& uiAcSum, TextType eTType, UInt uiAbsPartIdx, UChar indexROT );
   Void xQuantLTR  ( TComDataCU* pcCU, Long* pSrc, TCoeff*& pDes, Int iWidth, Int iHeight, UInt& uiAcSum, TextType eTType, UInt uiAbsPartIdx, UChar indexROT );
+  template<Int iWidth>
+  static Void xQuantLTRw ( Long* piCoef, TCoeff* piQCoef, Int iHeight, UInt* piQuantCoef, Int iAdd, Int iNewBits, Bool bROT, Bool bZeroHF, UInt& ruiAcSum );
   Void xQuant2x2  ( Long* plSrcCoef, TCoeff*& pDstCoef, UInt& uiAbsSum, UChar indexROT );
   Void xQuant4x4  ( TComDataCU* pcCU, Long* plSrcCoef, TCoeff*& pDstCoef, UInt& uiAbsSum, TextType eTType, UInt uiAbsPartIdx, UChar indexROT );
   Void xQuant8x8  ( TComDataCU* pcCU, Long* plSrcCoef, TCoeff*& pDstCoef, UInt& uiAbsSum, TextType eTType, UInt uiAbsPartIdx, UChar indexROT );
@@ -376,6 +385,8 @@ private:
   Void xDeQuant         ( TCoeff* pSrc,     Long*& pDes,       Int iWidth, Int iHeight, UChar indexROT );
   Void xDeQuantLTR      ( TCoeff* pSrc,     Long*&  pDes,      Int iWidth, Int iHeight, UChar indexROT );
 #endif
+  template<Int iWidth>
+  static Void xDeQuantLTRw ( TCoeff* piQCoef, Long* piCoef, Int iHeight, UInt* piDeQuantCoef, Int iShift );
   Void xDeQuant2x2      ( TCoeff* pSrcCoef, Long*& rplDstCoef, UChar indexROT );
   Void xDeQuant4x4      ( TCoeff* pSrcCoef, Long*& rplDstCoef, UChar indexROT );
   Void xDeQuant8x8      ( TCoeff* pSrcCoef, Long*& rplDstCoef, UChar indexROT );
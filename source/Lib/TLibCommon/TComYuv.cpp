@@ -42,6 +42,10 @@
 #include "CommonDef.h"
 #include "TComYuv.h"
 
+#if ENABLE_SSE2
+#include <emmintrin.h>
+#endif
+
 TComYuv::TComYuv()
 {
   m_apiBufY = NULL;
@@ -391,31 +395,15 @@ Void TComYuv::addClip( TComYuv* pcYuvSrc0, TComYuv* pcYuvSrc1, UInt uiTrUnitIdx,
 
 Void TComYuv::addClipLuma( TComYuv* pcYuvSrc0, TComYuv* pcYuvSrc1, UInt uiTrUnitIdx, UInt uiPartSize )
 {
-  Int x, y;
-
   Pel* pSrc0 = pcYuvSrc0->getLumaAddr( uiTrUnitIdx, uiPartSize );
   Pel* pSrc1 = pcYuvSrc1->getLumaAddr( uiTrUnitIdx, uiPartSize );
   Pel* pDst  = getLumaAddr( uiTrUnitIdx, uiPartSize );
 
-  UInt iSrc0Stride = pcYuvSrc0->getStride();
-  UInt iSrc1Stride = pcYuvSrc1->getStride();
-  UInt iDstStride  = getStride();
-  for ( y = uiPartSize-1; y >= 0; y-- )
-  {
-    for ( x = uiPartSize-1; x >= 0; x-- )
-    {
-      pDst[x] = xClip( pSrc0[x] + pSrc1[x] );
-    }
-    pSrc0 += iSrc0Stride;
-    pSrc1 += iSrc1Stride;
-    pDst  += iDstStride;
-  }
+  xAddClipBlk( pDst, getStride(), pSrc0, pcYuvSrc0->getStride(), pSrc1, pcYuvSrc1->getStride(), uiPartSize, uiPartSize );
 }
 
 Void TComYuv::addClipChroma( TComYuv* pcYuvSrc0, TComYuv* pcYuvSrc1, UInt uiTrUnitIdx, UInt uiPartSize )
 {
-  Int x, y;
-
   Pel* pSrcU0 = pcYuvSrc0->getCbAddr( uiTrUnitIdx, uiPartSize );
   Pel* pSrcU1 = pcYuvSrc1->getCbAddr( uiTrUnitIdx, uiPartSize );
   Pel* pSrcV0 = pcYuvSrc0->getCrAddr( uiTrUnitIdx, uiPartSize );
@@ -423,24 +411,12 @@ Void TComYuv::addClipChroma( TComYuv* pcYuvSrc0, TComYuv* pcYuvSrc1, UInt uiTrUn
   Pel* pDstU = getCbAddr( uiTrUnitIdx, uiPartSize );
   Pel* pDstV = getCrAddr( uiTrUnitIdx, uiPartSize );
 
-  UInt  iSrc0Stride = pcYuvSrc0->getCStride();
-  UInt  iSrc1Stride = pcYuvSrc1->getCStride();
-  UInt  iDstStride  = getCStride();
-  for ( y = uiPartSize-1; y >= 0; y-- )
-  {
-    for ( x = uiPartSize-1; x >= 0; x-- )
-    {
-      pDstU[x] = xClip( pSrcU0[x] + pSrcU1[x] );
-      pDstV[x] = xClip( pSrcV0[x] + pSrcV1[x] );
-    }
+  Int  iSrc0Stride = pcYuvSrc0->getCStride();
+  Int  iSrc1Stride = pcYuvSrc1->getCStride();
+  Int  iDstStride  = getCStride();
 
-    pSrcU0 += iSrc0Stride;
-    pSrcU1 += iSrc1Stride;
-    pSrcV0 += iSrc0Stride;
-    pSrcV1 += iSrc1Stride;
-    pDstU  += iDstStride;
-    pDstV  += iDstStride;
-  }
+  xAddClipBlk( pDstU, iDstStride, pSrcU0, iSrc0Stride, pSrcU1, iSrc1Stride, uiPartSize, uiPartSize );
+  xAddClipBlk( pDstV, iDstStride, pSrcV0, iSrc0Stride, pSrcV1, iSrc1Stride, uiPartSize, uiPartSize );
 }
 
 Void TComYuv::subtract( TComYuv* pcYuvSrc0, TComYuv* pcYuvSrc1, UInt uiTrUnitIdx, UInt uiPartSize )
@@ -451,31 +427,15 @@ Void TComYuv::subtract( TComYuv* pcYuvSrc0, TComYuv* pcYuvSrc1, UInt uiTrUnitIdx
 
 Void TComYuv::subtractLuma( TComYuv* pcYuvSrc0, TComYuv* pcYuvSrc1, UInt uiTrUnitIdx, UInt uiPartSize )
 {
-  Int x, y;
-
   Pel* pSrc0 = pcYuvSrc0->getLumaAddr( uiTrUnitIdx, uiPartSize );
   Pel* pSrc1 = pcYuvSrc1->getLumaAddr( uiTrUnitIdx, uiPartSize );
   Pel* pDst  = getLumaAddr( uiTrUnitIdx, uiPartSize );
 
-  Int  iSrc0Stride = pcYuvSrc0->getStride();
-  Int  iSrc1Stride = pcYuvSrc1->getStride();
-  Int  iDstStride  = getStride();
-  for ( y = uiPartSize-1; y >= 0; y-- )
-  {
-    for ( x = uiPartSize-1; x >= 0; x-- )
-    {
-      pDst[x] = pSrc0[x] - pSrc1[x];
-    }
-    pSrc0 += iSrc0Stride;
-    pSrc1 += iSrc1Stride;
-    pDst  += iDstStride;
-  }
+  xSubtractBlk( pDst, getStride(), pSrc0, pcYuvSrc0->getStride(), pSrc1, pcYuvSrc1->getStride(), uiPartSize, uiPartSize );
 }
 
 Void TComYuv::subtractChroma( TComYuv* pcYuvSrc0, TComYuv* pcYuvSrc1, UInt uiTrUnitIdx, UInt uiPartSize )
 {
-  Int x, y;
-
   Pel* pSrcU0 = pcYuvSrc0->getCbAddr( uiTrUnitIdx, uiPartSize );
   Pel* pSrcU1 = pcYuvSrc1->getCbAddr( uiTrUnitIdx, uiPartSize );
   Pel* pSrcV0 = pcYuvSrc0->getCrAddr( uiTrUnitIdx, uiPartSize );
@@ -486,58 +446,20 @@ Void TComYuv::subtractChroma( TComYuv* pcYuvSrc0, TComYuv* pcYuvSrc1, UInt uiTrU
   Int  iSrc0Stride = pcYuvSrc0->getCStride();
   Int  iSrc1Stride = pcYuvSrc1->getCStride();
   Int  iDstStride  = getCStride();
-  for ( y = uiPartSize-1; y >= 0; y-- )
-  {
-    for ( x = uiPartSize-1; x >= 0; x-- )
-    {
-      pDstU[x] = pSrcU0[x] - pSrcU1[x];
-      pDstV[x] = pSrcV0[x] - pSrcV1[x];
-    }
-    pSrcU0 += iSrc0Stride;
-    pSrcU1 += iSrc1Stride;
-    pSrcV0 += iSrc0Stride;
-    pSrcV1 += iSrc1Stride;
-    pDstU  += iDstStride;
-    pDstV  += iDstStride;
-  }
+
+  xSubtractBlk( pDstU, iDstStride, pSrcU0, iSrc0Stride, pSrcU1, iSrc1Stride, uiPartSize, uiPartSize );
+  xSubtractBlk( pDstV, iDstStride, pSrcV0, iSrc0Stride, pSrcV1, iSrc1Stride, uiPartSize, uiPartSize );
 }
 
 #ifdef ROUNDING_CONTROL_BIPRED
 
 Void TComYuv::addAvg( TComYuv* pcYuvSrc0, TComYuv* pcYuvSrc1, UInt iPartUnitIdx, UInt iWidth, UInt iHeight, Bool bRound )
 {
-  Int x, y;
-
-  Pel* pSrcY0  = pcYuvSrc0->getLumaAddr( iPartUnitIdx );
-  Pel* pSrcU0  = pcYuvSrc0->getCbAddr  ( iPartUnitIdx );
-  Pel* pSrcV0  = pcYuvSrc0->getCrAddr  ( iPartUnitIdx );
-
-  Pel* pSrcY1  = pcYuvSrc1->getLumaAddr( iPartUnitIdx );
-  Pel* pSrcU1  = pcYuvSrc1->getCbAddr  ( iPartUnitIdx );
-  Pel* pSrcV1  = pcYuvSrc1->getCrAddr  ( iPartUnitIdx );
-
-  Pel* pDstY   = getLumaAddr( iPartUnitIdx );
-  Pel* pDstU   = getCbAddr  ( iPartUnitIdx );
-  Pel* pDstV   = getCrAddr  ( iPartUnitIdx );
-
-  UInt  iSrc0Stride = pcYuvSrc0->getStride();
-  UInt  iSrc1Stride = pcYuvSrc1->getStride();
-  UInt  iDstStride  = getStride();
+  Int  iSrc0Stride = pcYuvSrc0->getStride();
+  Int  iSrc1Stride = pcYuvSrc1->getStride();
+  Int  iDstStride  = getStride();
 
-  for ( y = iHeight-1; y >= 0; y-- )
-  {
-    for ( x = iWidth-1; x >= 0; )
-    {
-      // note: luma min width is 4
-      pDstY[x] = (pSrcY0[x] + pSrcY1[x] + bRound) >> 1; x--;
-      pDstY[x] = (pSrcY0[x] + pSrcY1[x] + bRound) >> 1; x--;
-      pDstY[x] = (pSrcY0[x] + pSrcY1[x] + bRound) >> 1; x--;
-      pDstY[x] = (pSrcY0[x] + pSrcY1[x] + bRound) >> 1; x--;
-    }
-    pSrcY0 += iSrc0Stride;
-    pSrcY1 += iSrc1Stride;
-    pDstY  += iDstStride;
-  }
+  xAddAvgBlk( getLumaAddr( iPartUnitIdx ), iDstStride, pcYuvSrc0->getLumaAddr( iPartUnitIdx ), iSrc0Stride, pcYuvSrc1->getLumaAddr( iPartUnitIdx ), iSrc1Stride, iWidth, iHeight, bRound );
 
   iSrc0Stride = pcYuvSrc0->getCStride();
   iSrc1Stride = pcYuvSrc1->getCStride();
@@ -546,62 +468,19 @@ Void TComYuv::addAvg( TComYuv* pcYuvSrc0, TComYuv* pcYuvSrc1, UInt iPartUnitIdx,
   iWidth  >>=1;
   iHeight >>=1;
 
-  for ( y = iHeight-1; y >= 0; y-- )
-  {
-    for ( x = iWidth-1; x >= 0; )
-    {
-      // note: chroma min width is 2
-      pDstU[x] = (pSrcU0[x] + pSrcU1[x] + bRound) >> 1;
-      pDstV[x] = (pSrcV0[x] + pSrcV1[x] + bRound) >> 1; x--;
-      pDstU[x] = (pSrcU0[x] + pSrcU1[x] + bRound) >> 1;
-      pDstV[x] = (pSrcV0[x] + pSrcV1[x] + bRound) >> 1; x--;
-    }
-
-    pSrcU0 += iSrc0Stride;
-    pSrcU1 += iSrc1Stride;
-    pSrcV0 += iSrc0Stride;
-    pSrcV1 += iSrc1Stride;
-    pDstU  += iDstStride;
-    pDstV  += iDstStride;
-  }
+  xAddAvgBlk( getCbAddr( iPartUnitIdx ), iDstStride, pcYuvSrc0->getCbAddr( iPartUnitIdx ), iSrc0Stride, pcYuvSrc1->getCbAddr( iPartUnitIdx ), iSrc1Stride, iWidth, iHeight, bRound );
+  xAddAvgBlk( getCrAddr( iPartUnitIdx ), iDstStride, pcYuvSrc0->getCrAddr( iPartUnitIdx ), iSrc0Stride, pcYuvSrc1->getCrAddr( iPartUnitIdx ), iSrc1Stride, iWidth, iHeight, bRound );
 }
 
 #endif
 
 Void TComYuv::addAvg( TComYuv* pcYuvSrc0, TComYuv* pcYuvSrc1, UInt iPartUnitIdx, UInt iWidth, UInt iHeight )
 {
-  Int x, y;
-
-  Pel* pSrcY0  = pcYuvSrc0->getLumaAddr( iPartUnitIdx );
-  Pel* pSrcU0  = pcYuvSrc0->getCbAddr  ( iPartUnitIdx );
-  Pel* pSrcV0  = pcYuvSrc0->getCrAddr  ( iPartUnitIdx );
-
-  Pel* pSrcY1  = pcYuvSrc1->getLumaAddr( iPartUnitIdx );
-  Pel* pSrcU1  = pcYuvSrc1->getCbAddr  ( iPartUnitIdx );
-  Pel* pSrcV1  = pcYuvSrc1->getCrAddr  ( iPartUnitIdx );
-
-  Pel* pDstY   = getLumaAddr( iPartUnitIdx );
-  Pel* pDstU   = getCbAddr  ( iPartUnitIdx );
-  Pel* pDstV   = getCrAddr  ( iPartUnitIdx );
-
-  UInt  iSrc0Stride = pcYuvSrc0->getStride();
-  UInt  iSrc1Stride = pcYuvSrc1->getStride();
-  UInt  iDstStride  = getStride();
+  Int  iSrc0Stride = pcYuvSrc0->getStride();
+  Int  iSrc1Stride = pcYuvSrc1->getStride();
+  Int  iDstStride  = getStride();
 
-  for ( y = iHeight-1; y >= 0; y-- )
-  {
-    for ( x = iWidth-1; x >= 0; )
-    {
-      // note: luma min width is 4
-      pDstY[x] = (pSrcY0[x] + pSrcY1[x] + 1) >> 1; x--;
-      pDstY[x] = (pSrcY0[x] + pSrcY1[x] + 1) >> 1; x--;
-      pDstY[x] = (pSrcY0[x] + pSrcY1[x] + 1) >> 1; x--;
-      pDstY[x] = (pSrcY0[x] + pSrcY1[x] + 1) >> 1; x--;
-    }
-    pSrcY0 += iSrc0Stride;
-    pSrcY1 += iSrc1Stride;
-    pDstY  += iDstStride;
-  }
+  xAddAvgBlk( getLumaAddr( iPartUnitIdx ), iDstStride, pcYuvSrc0->getLumaAddr( iPartUnitIdx ), iSrc0Stride, pcYuvSrc1->getLumaAddr( iPartUnitIdx ), iSrc1Stride, iWidth, iHeight, 1 );
 
   iSrc0Stride = pcYuvSrc0->getCStride();
   iSrc1Stride = pcYuvSrc1->getCStride();
@@ -610,113 +489,176 @@ Void TComYuv::addAvg( TComYuv* pcYuvSrc0, TComYuv* pcYuvSrc1, UInt iPartUnitIdx,
   iWidth  >>=1;
   iHeight >>=1;
 
-  for ( y = iHeight-1; y >= 0; y-- )
-  {
-    for ( x = iWidth-1; x >= 0; )
-    {
-      // note: chroma min width is 2
-      pDstU[x] = (pSrcU0[x] + pSrcU1[x] + 1) >> 1;
-      pDstV[x] = (pSrcV0[x] + pSrcV1[x] + 1) >> 1; x--;
-      pDstU[x] = (pSrcU0[x] + pSrcU1[x] + 1) >> 1;
-      pDstV[x] = (pSrcV0[x] + pSrcV1[x] + 1) >> 1; x--;
-    }
-
-    pSrcU0 += iSrc0Stride;
-    pSrcU1 += iSrc1Stride;
-    pSrcV0 += iSrc0Stride;
-    pSrcV1 += iSrc1Stride;
-    pDstU  += iDstStride;
-    pDstV  += iDstStride;
-  }
+  xAddAvgBlk( getCbAddr( iPartUnitIdx ), iDstStride, pcYuvSrc0->getCbAddr( iPartUnitIdx ), iSrc0Stride, pcYuvSrc1->getCbAddr( iPartUnitIdx ), iSrc1Stride, iWidth, iHeight, 1 );
+  xAddAvgBlk( getCrAddr( iPartUnitIdx ), iDstStride, pcYuvSrc0->getCrAddr( iPartUnitIdx ), iSrc0Stride, pcYuvSrc1->getCrAddr( iPartUnitIdx ), iSrc1Stride, iWidth, iHeight, 1 );
 }
 
 Void TComYuv::removeHighFreq( TComYuv* pcYuvSrc, UInt uiWidht, UInt uiHeight )
 {
-  Int x, y;
+  xRemoveHighFreqBlk( m_apiBufY, getStride(),  pcYuvSrc->getLumaAddr(), pcYuvSrc->getStride(),  uiWidht,    uiHeight    );
+  xRemoveHighFreqBlk( m_apiBufU, getCStride(), pcYuvSrc->getCbAddr(),   pcYuvSrc->getCStride(), uiWidht>>1, uiHeight>>1 );
+  xRemoveHighFreqBlk( m_apiBufV, getCStride(), pcYuvSrc->getCrAddr(),   pcYuvSrc->getCStride(), uiWidht>>1, uiHeight>>1 );
+}
 
-  Pel* pSrc  = pcYuvSrc->getLumaAddr();
-  Pel* pSrcU = pcYuvSrc->getCbAddr();
-  Pel* pSrcV = pcYuvSrc->getCrAddr();
+Void TComYuv::removeHighFreq( TComYuv* pcYuvSrc, UInt uiPartIdx, UInt uiWidht, UInt uiHeight )
+{
+  xRemoveHighFreqBlk( getLumaAddr(uiPartIdx), getStride(),  pcYuvSrc->getLumaAddr(uiPartIdx), pcYuvSrc->getStride(),  uiWidht,    uiHeight    );
+  xRemoveHighFreqBlk( getCbAddr(uiPartIdx),   getCStride(), pcYuvSrc->getCbAddr(uiPartIdx),   pcYuvSrc->getCStride(), uiWidht>>1, uiHeight>>1 );
+  xRemoveHighFreqBlk( getCrAddr(uiPartIdx),   getCStride(), pcYuvSrc->getCrAddr(uiPartIdx),   pcYuvSrc->getCStride(), uiWidht>>1, uiHeight>>1 );
+}
 
-  Pel* pDst  = m_apiBufY;
-  Pel* pDstU = m_apiBufU;
-  Pel* pDstV = m_apiBufV;
+// ------------------------------------------------------------------------------------------------------------------
+//  Block kernels
+//  Each row is processed 8 samples at a time, a remaining group of 4 with a 64-bit load and the rest
+//  (chroma of 4x4 blocks) in scalar code. All kernels wrap to 16 bits exactly like the Pel arithmetic they replace.
+// ------------------------------------------------------------------------------------------------------------------
 
-  Int  iSrcStride = pcYuvSrc->getStride();
-  Int  iDstStride = getStride();
+Void TComYuv::xSubtractBlk( Pel* pDst, Int iDstStride, Pel* pSrc0, Int iSrc0Stride, Pel* pSrc1, Int iSrc1Stride, Int iWidth, Int iHeight )
+{
+  Int x, y;
 
-  for ( y = uiHeight-1; y >= 0; y-- )
+  for ( y = 0; y < iHeight; y++ )
   {
-    for ( x = uiWidht-1; x >= 0; x-- )
+    x = 0;
+#if ENABLE_SSE2
+    for ( ; x + 8 <= iWidth; x += 8 )
     {
-      pDst[x ] = xClip( (pDst[x ]<<1) - pSrc[x ] );
+      __m128i vSrc0 = _mm_loadu_si128( (const __m128i*)( pSrc0 + x ) );
+      __m128i vSrc1 = _mm_loadu_si128( (const __m128i*)( pSrc1 + x ) );
+      _mm_storeu_si128( (__m128i*)( pDst + x ), _mm_sub_epi16( vSrc0, vSrc1 ) );
     }
-    pSrc += iSrcStride;
-    pDst += iDstStride;
+    if ( x + 4 <= iWidth )
+    {
+      __m128i vSrc0 = _mm_loadl_epi64( (const __m128i*)( pSrc0 + x ) );
+      __m128i vSrc1 = _mm_loadl_epi64( (const __m128i*)( pSrc1 + x ) );
+      _mm_storel_epi64( (__m128i*)( pDst + x ), _mm_sub_epi16( vSrc0, vSrc1 ) );
+      x += 4;
+    }
+#endif
+    for ( ; x < iWidth; x++ )
+    {
+      pDst[x] = pSrc0[x] - pSrc1[x];
+    }
+    pSrc0 += iSrc0Stride;
+    pSrc1 += iSrc1Stride;
+    pDst  += iDstStride;
   }
+}
 
-  iSrcStride = pcYuvSrc->getCStride();
-  iDstStride = getCStride();
-
-  uiHeight >>= 1;
-  uiWidht  >>= 1;
+Void TComYuv::xAddClipBlk( Pel* pDst, Int iDstStride, Pel* pSrc0, Int iSrc0Stride, Pel* pSrc1, Int iSrc1Stride, Int iWidth, Int iHeight )
+{
+  Int x, y;
+  Pel iMax = (Pel)g_uiIBDI_MAX;
+#if ENABLE_SSE2
+  __m128i vMax  = _mm_set1_epi16( iMax );
+  __m128i vZero = _mm_setzero_si128();
+#endif
 
-  for ( y = uiHeight-1; y >= 0; y-- )
+  for ( y = 0; y < iHeight; y++ )
   {
-    for ( x = uiWidht-1; x >= 0; x-- )
+    x = 0;
+#if ENABLE_SSE2
+    for ( ; x + 8 <= iWidth; x += 8 )
     {
-      pDstU[x ] = xClip( (pDstU[x ]<<1) - pSrcU[x ] );
-      pDstV[x ] = xClip( (pDstV[x ]<<1) - pSrcV[x ] );
+      __m128i vSum = _mm_add_epi16( _mm_loadu_si128( (const __m128i*)( pSrc0 + x ) ), _mm_loadu_si128( (const __m128i*)( pSrc1 + x ) ) );
+      _mm_storeu_si128( (__m128i*)( pDst + x ), _mm_min_epi16( _mm_max_epi16( vSum, vZero ), vMax ) );
     }
-    pSrcU += iSrcStride;
-    pSrcV += iSrcStride;
-    pDstU += iDstStride;
-    pDstV += iDstStride;
+    if ( x + 4 <= iWidth )
+    {
+      __m128i vSum = _mm_add_epi16( _mm_loadl_epi64( (const __m128i*)( pSrc0 + x ) ), _mm_loadl_epi64( (const __m128i*)( pSrc1 + x ) ) );
+      _mm_storel_epi64( (__m128i*)( pDst + x ), _mm_min_epi16( _mm_max_epi16( vSum, vZero ), vMax ) );
+      x += 4;
+    }
+#endif
+    for ( ; x < iWidth; x++ )
+    {
+      Pel iSum = pSrc0[x] + pSrc1[x];
+      pDst[x]  = ( iSum < 0 ) ? 0 : ( iSum > iMax ) ? iMax : iSum;
+    }
+    pSrc0 += iSrc0Stride;
+    pSrc1 += iSrc1Stride;
+    pDst  += iDstStride;
   }
 }
 
-Void TComYuv::removeHighFreq( TComYuv* pcYuvSrc, UInt uiPartIdx, UInt uiWidht, UInt uiHeight )
+/** (pSrc0 + pSrc1 + iRound) >> 1 with iRound 0 or 1.
+    The SIMD path biases the samples to unsigned, uses the rounding average and removes the rounding bit again
+    where iRound is 0 and the sum is odd, which gives the same result as the 32-bit scalar expression.
+ */
+Void TComYuv::xAddAvgBlk( Pel* pDst, Int iDstStride, Pel* pSrc0, Int iSrc0Stride, Pel* pSrc1, Int iSrc1Stride, Int iWidth, Int iHeight, Int iRound )
 {
   Int x, y;
+#if ENABLE_SSE2
+  __m128i vBias = _mm_set1_epi16( (Short)0x8000 );
+  __m128i vOne  = _mm_set1_epi16( iRound ? 0 : 1 );
+#endif
 
-  Pel* pSrc  = pcYuvSrc->getLumaAddr(uiPartIdx);
-  Pel* pSrcU = pcYuvSrc->getCbAddr(uiPartIdx);
-  Pel* pSrcV = pcYuvSrc->getCrAddr(uiPartIdx);
-
-  Pel* pDst  = getLumaAddr(uiPartIdx);
-  Pel* pDstU = getCbAddr(uiPartIdx);
-  Pel* pDstV = getCrAddr(uiPartIdx);
-
-  Int  iSrcStride = pcYuvSrc->getStride();
-  Int  iDstStride = getStride();
-
-  for ( y = uiHeight-1; y >= 0; y-- )
+  for ( y = 0; y < iHeight; y++ )
   {
-    for ( x = uiWidht-1; x >= 0; x-- )
+    x = 0;
+#if ENABLE_SSE2
+    for ( ; x + 8 <= iWidth; x += 8 )
     {
-      pDst[x ] = xClip( (pDst[x ]<<1) - pSrc[x ] );
+      __m128i vSrc0 = _mm_loadu_si128( (const __m128i*)( pSrc0 + x ) );
+      __m128i vSrc1 = _mm_loadu_si128( (const __m128i*)( pSrc1 + x ) );
+      __m128i vAvg  = _mm_xor_si128( _mm_avg_epu16( _mm_xor_si128( vSrc0, vBias ), _mm_xor_si128( vSrc1, vBias ) ), vBias );
+      vAvg          = _mm_sub_epi16( vAvg, _mm_and_si128( _mm_xor_si128( vSrc0, vSrc1 ), vOne ) );
+      _mm_storeu_si128( (__m128i*)( pDst + x ), vAvg );
     }
-    pSrc += iSrcStride;
-    pDst += iDstStride;
+    if ( x + 4 <= iWidth )
+    {
+      __m128i vSrc0 = _mm_loadl_epi64( (const __m128i*)( pSrc0 + x ) );
+      __m128i vSrc1 = _mm_loadl_epi64( (const __m128i*)( pSrc1 + x ) );
+      __m128i vAvg  = _mm_xor_si128( _mm_avg_epu16( _mm_xor_si128( vSrc0, vBias ), _mm_xor_si128( vSrc1, vBias ) ), vBias );
+      vAvg          = _mm_sub_epi16( vAvg, _mm_and_si128( _mm_xor_si128( vSrc0, vSrc1 ), vOne ) );
+      _mm_storel_epi64( (__m128i*)( pDst + x ), vAvg );
+      x += 4;
+    }
+#endif
+    for ( ; x < iWidth; x++ )
+    {
+      pDst[x] = ( pSrc0[x] + pSrc1[x] + iRound ) >> 1;
+    }
+    pSrc0 += iSrc0Stride;
+    pSrc1 += iSrc1Stride;
+    pDst  += iDstStride;
   }
+}
 
-  iSrcStride = pcYuvSrc->getCStride();
-  iDstStride = getCStride();
-
-  uiHeight >>= 1;
-  uiWidht  >>= 1;
+Void TComYuv::xRemoveHighFreqBlk( Pel* pDst, Int iDstStride, Pel* pSrc, Int iSrcStride, Int iWidth, Int iHeight )
+{
+  Int x, y;
+  Pel iMax = (Pel)g_uiIBDI_MAX;
+#if ENABLE_SSE2
+  __m128i vMax  = _mm_set1_epi16( iMax );
+  __m128i vZero = _mm_setzero_si128();
+#endif
 
-  for ( y = uiHeight-1; y >= 0; y-- )
+  for ( y = 0; y < iHeight; y++ )
   {
-    for ( x = uiWidht-1; x >= 0; x-- )
+    x = 0;
+#if ENABLE_SSE2
+    for ( ; x + 8 <= iWidth; x += 8 )
     {
-      pDstU[x ] = xClip( (pDstU[x ]<<1) - pSrcU[x ] );
-      pDstV[x ] = xClip( (pDstV[x ]<<1) - pSrcV[x ] );
+      __m128i vDst = _mm_loadu_si128( (const __m128i*)( pDst + x ) );
+      vDst         = _mm_sub_epi16( _mm_slli_epi16( vDst, 1 ), _mm_loadu_si128( (const __m128i*)( pSrc + x ) ) );
+      _mm_storeu_si128( (__m128i*)( pDst + x ), _mm_min_epi16( _mm_max_epi16( vDst, vZero ), vMax ) );
     }
-    pSrcU += iSrcStride;
-    pSrcV += iSrcStride;
-    pDstU += iDstStride;
-    pDstV += iDstStride;
+    if ( x + 4 <= iWidth )
+    {
+      __m128i vDst = _mm_loadl_epi64( (const __m128i*)( pDst + x ) );
+      vDst         = _mm_sub_epi16( _mm_slli_epi16( vDst, 1 ), _mm_loadl_epi64( (const __m128i*)( pSrc + x ) ) );
+      _mm_storel_epi64( (__m128i*)( pDst + x ), _mm_min_epi16( _mm_max_epi16( vDst, vZero ), vMax ) );
+      x += 4;
+    }
+#endif
+    for ( ; x < iWidth; x++ )
+    {
+      Pel iVal = ( pDst[x] << 1 ) - pSrc[x];
+      pDst[x]  = ( iVal < 0 ) ? 0 : ( iVal > iMax ) ? iMax : iVal;
+    }
+    pSrc += iSrcStride;
+    pDst += iDstStride;
   }
 }
 
@@ -177,6 +177,12 @@ public:
 
   __inline Pel  xClip  (Pel x )      { return ( (x < 0) ? 0 : (x > (Pel)g_uiIBDI_MAX) ? (Pel)g_uiIBDI_MAX : x ); }
 
+  //  Block kernels shared by luma and chroma, vectorized when ENABLE_SSE2 is set
+  static Void xSubtractBlk      ( Pel* pDst, Int iDstStride, Pel* pSrc0, Int iSrc0Stride, Pel* pSrc1, Int iSrc1Stride, Int iWidth, Int iHeight );
+  static Void xAddClipBlk       ( Pel* pDst, Int iDstStride, Pel* pSrc0, Int iSrc0Stride, Pel* pSrc1, Int iSrc1Stride, Int iWidth, Int iHeight );
+  static Void xAddAvgBlk        ( Pel* pDst, Int iDstStride, Pel* pSrc0, Int iSrc0Stride, Pel* pSrc1, Int iSrc1Stride, Int iWidth, Int iHeight, Int iRound );
+  static Void xRemoveHighFreqBlk( Pel* pDst, Int iDstStride, Pel* pSrc,  Int iSrcStride,                                Int iWidth, Int iHeight );
+
 };// END CLASS DEFINITION TComYuv
 
 
@@ -269,6 +269,12 @@ void normalizeScanStats();
 
 #define BUGFIX85TMP 1 // Ignore cost of CBF (affects RQT off setting)
 
+#if defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 )
+#define ENABLE_SSE2                       1           ///< SSE2 kernels for sample-wise block operations (target supports SSE2)
+#else
+#define ENABLE_SSE2                       0
+#endif
+
 // ====================================================================================================================
 // Basic type redefinition
 // ====================================================================================================================
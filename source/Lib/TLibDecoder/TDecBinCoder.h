@@ -54,5 +54,30 @@ public:
   virtual Void  decodeBinTrm      ( UInt& ruiBin                           )  = 0;
 };
 
+/// bin decoder which counts the bins decoded by another bin decoder
+class TDecBinCounter : public TDecBinIf
+{
+private:
+  TDecBinIf*  m_pcTDecBinIf;
+  UInt64      m_uiNumBins;
+
+public:
+  TDecBinCounter()                        { m_pcTDecBinIf = 0; m_uiNumBins = 0; }
+  virtual ~TDecBinCounter()               {}
+
+  Void    setBinIf          ( TDecBinIf* p )                              { m_pcTDecBinIf = p; }
+  UInt64  getNumBins        ()                                            { return m_uiNumBins; }
+
+  Void    init              ( TComBitstream* pcTComBitstream )            { m_pcTDecBinIf->init( pcTComBitstream ); }
+  Void    uninit            ()                                            { m_pcTDecBinIf->uninit(); }
+
+  Void    start             ()                                            { m_pcTDecBinIf->start(); }
+  Void    finish            ()                                            { m_pcTDecBinIf->finish(); }
+
+  Void    decodeBin         ( UInt& ruiBin, ContextModel& rcCtxModel )    { m_pcTDecBinIf->decodeBin( ruiBin, rcCtxModel ); m_uiNumBins++; }
+  Void    decodeBinEP       ( UInt& ruiBin                           )    { m_pcTDecBinIf->decodeBinEP( ruiBin );           m_uiNumBins++; }
+  Void    decodeBinTrm      ( UInt& ruiBin                           )    { m_pcTDecBinIf->decodeBinTrm( ruiBin );          m_uiNumBins++; }
+};
+
 #endif
 
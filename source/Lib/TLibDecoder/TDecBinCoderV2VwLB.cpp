@@ -63,7 +63,7 @@ void TDecClearBuffer::init() {
     for (k = 1; k < StateCount; ++k)
         tempTable[k] = tempTable[k - 1] + int(lastStateOfGroup[k - 1]);
     for (k = 0; k < 64; ++k)
-        mergedStatesMapping[k] = tempTable[QStatesMapping[k]];
+        mergedStatesMapping[k] = tempTable[QDecStatesMapping[k]];
 
     for (k = 0; k < mergedStateCount; ++k)
         seq_coded_len[k] = get_pref_code();
@@ -51,7 +51,12 @@
 
 TDecGop::TDecGop()
 {
-  m_iGopSize = 0;
+  m_iGopSize        = 0;
+  m_bQuiet          = false;
+  m_bBenchmark      = false;
+  m_dSliceTime      = 0;
+  m_dLoopFilterTime = 0;
+  m_dALFTime        = 0;
 }
 
 TDecGop::~TDecGop()
@@ -126,6 +131,11 @@ Void TDecGop::decompressGop (Bool bEos, TComBitstream* pcBitstream, TComPic*& rp
       m_pcSbacDecoder->init( (TDecBinIf*)m_pcBinPIPE );
       m_pcBinPIPE->initDelay( pcSlice->getMaxPIPEDelay() );
     }
+    if ( m_bBenchmark )
+    {
+      m_cBinCounter.setBinIf( m_pcSbacDecoder->getBinIf() );
+      m_pcSbacDecoder->init( &m_cBinCounter );
+    }
     m_pcEntropyDecoder->setEntropyDecoder (m_pcSbacDecoder);
   }
   else
@@ -153,11 +163,16 @@ Void TDecGop::decompressGop (Bool bEos, TComBitstream* pcBitstream, TComPic*& rp
   }
 
   m_pcSliceDecoder->decompressSlice(pcBitstream, rpcPic);
+  pcSlice->releaseVirtRefPic();
+
+  long iSliceTime = clock();
 
   // deblocking filter
   m_pcLoopFilter->setCfg(pcSlice->getLoopFilterDisable(), 0, 0);
   m_pcLoopFilter->loopFilterPic( rpcPic );
 
+  long iLoopFilterTime = clock();
+
   // adaptive loop filter
   if( rpcPic->getSlice()->getSPS()->getUseALF() )
   {
@@ -171,14 +186,22 @@ Void TDecGop::decompressGop (Bool bEos, TComBitstream* pcBitstream, TComPic*& rp
     m_pcAdaptiveLoopFilter->freeALFParam(&cAlfParam);
   }
 
-#if HHI_INTERP_FILTER
-  // MOMS prefilter reconstructed pic
-  if( rpcPic->getSlice()->isReferenced() && rpcPic->getSlice()->getUseMOMS() )
+  if ( m_bBenchmark )
   {
-    TComCoeffCalcMOMS cCoeffCalc;
-    cCoeffCalc.calcCoeffs( rpcPic->getPicYuvRec(), rpcPic->getPicYuvRecFilt(), rpcPic->getSlice()->getInterpFilterType() );
+    long iALFTime = clock();
+    m_dSliceTime      += (Double)( iSliceTime      - iBeforeTime     ) / CLOCKS_PER_SEC;
+    m_dLoopFilterTime += (Double)( iLoopFilterTime - iSliceTime      ) / CLOCKS_PER_SEC;
+    m_dALFTime        += (Double)( iALFTime        - iLoopFilterTime ) / CLOCKS_PER_SEC;
+
+    rpcPic->setReconMark(true);
+    return;
+  }
+
+  if ( m_bQuiet )
+  {
+    rpcPic->setReconMark(true);
+    return;
   }
-#endif
 
   //-- For time output for each slice
   printf("\nPOC %4d ( %c-SLICE, QP%3d ) ",
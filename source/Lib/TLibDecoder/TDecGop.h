@@ -89,6 +89,15 @@ private:
   // Adaptive Loop filter
   TComAdaptiveLoopFilter*       m_pcAdaptiveLoopFilter;
 
+  Bool                  m_bQuiet;           ///< no per-picture messages
+
+  // benchmark mode: no per-picture messages, bins and stage times are accumulated
+  Bool                  m_bBenchmark;
+  TDecBinCounter        m_cBinCounter;
+  Double                m_dSliceTime;       ///< entropy decoding and reconstruction
+  Double                m_dLoopFilterTime;  ///< deblocking filter
+  Double                m_dALFTime;         ///< adaptive loop filter
+
 public:
   TDecGop();
   virtual ~TDecGop();
@@ -112,6 +121,13 @@ public:
 
   UInt  getBalancedCPUs()  { return m_uiBalancedCPUs; }
   Void  setBalancedCPUs( UInt ui ) { m_uiBalancedCPUs = ui; }
+
+  Void    setQuiet          ( Bool b )  { m_bQuiet = b; }
+  Void    setBenchmark      ( Bool b )  { m_bBenchmark = b; }
+  UInt64  getNumBins        ()          { return m_cBinCounter.getNumBins(); }
+  Double  getSliceTime      ()          { return m_dSliceTime; }
+  Double  getLoopFilterTime ()          { return m_dLoopFilterTime; }
+  Double  getALFTime        ()          { return m_dALFTime; }
 };
 
 #endif // !defined(AFX_TDECGOP_H__29440B7A_7CC0_48C7_8DD5_1A531D3CED45__INCLUDED_)
@@ -61,6 +61,7 @@ public:
 
   Void  init                      ( TDecBinIf* p )    { m_pcTDecBinIf = p; }
   Void  uninit                    ()                  { m_pcTDecBinIf = 0; }
+  TDecBinIf* getBinIf             ()                  { return m_pcTDecBinIf; }
 
   Void  resetEntropy              (TComSlice* pcSlice);
   Void  setBitstream              (TComBitstream* p)        { m_pcBitstream = p; m_pcTDecBinIf->init( p ); }
@@ -46,6 +46,7 @@ TDecSlice::TDecSlice()
   {
     m_apcVirtPic[j][i] = NULL;
   }
+  m_bSIFOInit = false;
 }
 
 TDecSlice::~TDecSlice()
@@ -54,14 +55,14 @@ TDecSlice::~TDecSlice()
 
 Void TDecSlice::create( TComSlice* pcSlice, Int iWidth, Int iHeight, UInt uiMaxWidth, UInt uiMaxHeight, UInt uiMaxDepth )
 {
-  // allocate required memory for generated reference frame
+  // allocate required memory for generated reference frame, the sample buffers are only allocated while a slice reads them
   for (Int j=0; j<2; j++)
   for (Int i=0; i<pcSlice->getAddRefCnt( (RefPicList)j ) ; i++ )
   {
     if(m_apcVirtPic[j][i] == NULL)
     {
       m_apcVirtPic[j][i] = new TComPic;
-      m_apcVirtPic[j][i]->create( iWidth, iHeight, uiMaxWidth, uiMaxHeight, uiMaxDepth, true );
+      m_apcVirtPic[j][i]->create( iWidth, iHeight, uiMaxWidth, uiMaxHeight, uiMaxDepth, true, false );
     }
   }
 }
@@ -166,13 +167,11 @@ Void TDecSlice::generateRefPicNew ( TComSlice* rpcSlice )
 #ifdef QC_SIFO
 Void TDecSlice::initSIFOFilters(Int Tap, TComPrediction *m_cPrediction )
 {
-  static Int first = 1;
-  
-  if(first == 1)
+  if(!m_bSIFOInit)
   {  
     Int i;
 
-    first = 0;
+    m_bSIFOInit = true;
     for (i=0; i<16; i++)
 	  {
       m_cPrediction->setSIFOFilter(0,i);
@@ -61,6 +61,8 @@ private:
   // additional buffers for generated reference frames
   TComPic*        m_apcVirtPic[2][GRF_MAX_NUM_EFF];
 
+  Bool            m_bSIFOInit;        ///< SIFO filters have been initialized
+
 public:
   TDecSlice();
   virtual ~TDecSlice();
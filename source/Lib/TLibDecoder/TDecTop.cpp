@@ -41,6 +41,10 @@ TDecTop::TDecTop()
   m_bGopSizeSet   = false;
   m_iMaxRefPicNum = 0;
   m_uiValidPS = 0;
+  m_iFirstPOC = 0;
+  m_uiCuDecoderWidth  = 0;
+  m_uiCuDecoderHeight = 0;
+  m_uiCuDecoderDepth  = 0;
 #if HHI_RQT
 #if ENC_DEC_TRACE
   g_hTrace = fopen( "TraceDec.txt", "wb" );
@@ -73,6 +77,12 @@ Void TDecTop::destroy()
   m_apcSlicePilot = NULL;
 
   m_cSliceDecoder.destroy();
+
+  if ( m_uiCuDecoderWidth )
+  {
+    m_cCuDecoder.destroy();
+    m_uiCuDecoderWidth = 0;
+  }
 }
 
 Void TDecTop::init()
@@ -160,7 +170,7 @@ Void TDecTop::xGetNewPicBuffer ( TComSlice* pcSlice, TComPic*& rpcPic )
     rpcPic->getPicYuvRec()->setBorderExtension(false);
 
 #if HHI_INTERP_FILTER
-    rpcPic->getPicYuvRecFilt()->setBorderExtension(false);
+    rpcPic->setRecFiltReady(false);
 #endif
   }
 }
@@ -249,8 +259,15 @@ Void TDecTop::decode (Bool bEos, TComBitstream* pcBitstream, UInt& ruiPOC, TComL
   }
 #endif
 
+  // leading pictures of a random access point reference pictures which have not been decoded
+  if ( m_apcSlicePilot->getPOC() < m_iFirstPOC )
+  {
+    return;
+  }
+
   // Buffer initialize for prediction.
   m_cPrediction.initTempBuff();
+  m_cPrediction.initInterTools( m_apcSlicePilot );
 #ifdef EDGE_BASED_PREDICTION
   //Initialise edge based prediction for the current slice
   m_cPrediction.getEdgeBasedPred()->setEdgePredictionEnable(m_apcSlicePilot->getEdgePredictionEnable());
@@ -259,8 +276,18 @@ Void TDecTop::decode (Bool bEos, TComBitstream* pcBitstream, UInt& ruiPOC, TComL
   //  Get a new picture buffer
   xGetNewPicBuffer (m_apcSlicePilot, pcPic);
 
-  // Recursive structure
-  m_cCuDecoder.create ( g_uiMaxCUDepth, g_uiMaxCUWidth, g_uiMaxCUHeight );
+  // Recursive structure, the working CUs of all depths are kept until the CU geometry changes
+  if ( m_uiCuDecoderWidth != g_uiMaxCUWidth || m_uiCuDecoderHeight != g_uiMaxCUHeight || m_uiCuDecoderDepth != g_uiMaxCUDepth )
+  {
+    if ( m_uiCuDecoderWidth )
+    {
+      m_cCuDecoder.destroy();
+    }
+    m_cCuDecoder.create ( g_uiMaxCUDepth, g_uiMaxCUWidth, g_uiMaxCUHeight );
+    m_uiCuDecoderWidth  = g_uiMaxCUWidth;
+    m_uiCuDecoderHeight = g_uiMaxCUHeight;
+    m_uiCuDecoderDepth  = g_uiMaxCUDepth;
+  }
   m_cCuDecoder.init   ( &m_cEntropyDecoder, &m_cTrQuant, &m_cPrediction );
   m_cTrQuant.init     ( g_uiMaxCUWidth, g_uiMaxCUHeight, m_apcSlicePilot->getSPS()->getMaxTrSize(), m_apcSlicePilot->getSPS()->getUseROT() );
 
@@ -368,8 +395,6 @@ Void TDecTop::decode (Bool bEos, TComBitstream* pcBitstream, UInt& ruiPOC, TComL
 
   rpcListPic = &m_cListPic;
 
-  m_cCuDecoder.destroy();
-
   return;
 }
 
@@ -61,11 +61,16 @@ private:
   UInt                    m_uiBalancedCPUs;
 
   UInt                    m_uiValidPS;
+  Int                     m_iFirstPOC;        //  pictures with lower POC are skipped
   TComList<TComPic*>      m_cListPic;         //  Dynamic buffer
   TComSPS                 m_cSPS;
   TComPPS                 m_cPPS;
   TComSlice*              m_apcSlicePilot;
 
+  UInt                    m_uiCuDecoderWidth;   //  CU geometry of the working CUs, 0 before the first slice
+  UInt                    m_uiCuDecoderHeight;
+  UInt                    m_uiCuDecoderDepth;
+
   // functional classes
   TComPrediction          m_cPrediction;
   TComTrQuant             m_cTrQuant;
@@ -95,6 +100,11 @@ public:
 
   Void  deletePicBuffer();
 
+  TDecGop*  getGopDecoder() { return &m_cGopDecoder; }
+
+  /// skip the leading pictures when decoding starts at a random access point
+  Void  setFirstPOC( Int iPOC ) { m_iFirstPOC = iPOC; }
+
   Void  setBalancedCPUs( UInt ui ) { m_uiBalancedCPUs = ui; }
   UInt  getBalancedCPUs() { return m_cSPS.getBalancedCPUs(); }
 
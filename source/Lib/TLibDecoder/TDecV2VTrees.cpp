@@ -461,7 +461,7 @@ const UInt *QDecodingTree[TreeCount] = {
     dec_tree005
 };
 
-const UInt QStatesMapping[] = {
+const UInt QDecStatesMapping[] = {
    0,   0,   1,   2,       3,   3,   4,   4,
    4,   5,   5,   5,       6,   6,   6,   7,
    7,   7,   7,   8,       8,   8,   8,   9,
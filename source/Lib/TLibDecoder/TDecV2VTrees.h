@@ -46,6 +46,6 @@ extern const UInt *QDecodingTree[];
 const UInt TreeCount = 24;
 const UInt StateCount = 16;
 
-extern const UInt QStatesMapping[];
+extern const UInt QDecStatesMapping[];
 
 #endif
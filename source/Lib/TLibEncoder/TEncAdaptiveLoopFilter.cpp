@@ -1952,6 +1952,14 @@ TEncAdaptiveLoopFilter::TEncAdaptiveLoopFilter()
 // Public member functions
 // ====================================================================================================================
 
+Void TEncAdaptiveLoopFilter::destroy()
+{
+  TComAdaptiveLoopFilter::destroy();
+#if QC_ALF
+  m_cEncArena.destroy();
+#endif
+}
+
 /** \param	pcPic						picture (TComPic) pointer
 		\param	pcEntropyCoder	entropy coder class
  */
@@ -1994,32 +2002,70 @@ Void TEncAdaptiveLoopFilter::startALFEnc( TComPic* pcPic, TEncEntropy* pcEntropy
   get_mem2Dpel (&(imgY_temp), im_height, im_width);
 #endif
 
+  // the correlation and mask arrays are carved from one arena, allocated for the first picture and reused afterwards
+  if ( !m_cEncArena.isCreated() )
+  {
+    size_t uiArenaSize = TComAlfArena::getMatrix4DSize<double>( NO_TEST_FILT, NO_VAR_BINS, MAX_SQR_FILT_LENGTH, MAX_SQR_FILT_LENGTH )
+                       + TComAlfArena::getMatrix3DSize<double>( NO_TEST_FILT, NO_VAR_BINS, MAX_SQR_FILT_LENGTH )
+                       + TComAlfArena::getMatrixSize<Int>( NO_VAR_BINS, MAX_SQR_FILT_LENGTH )
+                       + TComAlfArena::getArraySize<double>( NO_VAR_BINS )
+                       + 2 * TComAlfArena::getMatrixSize<imgpel>( im_height, im_width );
+#if !ALF_MEM_PATCH
+    uiArenaSize += 2 * TComAlfArena::getMatrixSize<Int>( NO_VAR_BINS, MAX_SQR_FILT_LENGTH );
+#else
+    uiArenaSize += TComAlfArena::getMatrix4DSize<double>( NO_TEST_FILT, NO_VAR_BINS, MAX_SQR_FILT_LENGTH, MAX_SQR_FILT_LENGTH )
+                 + TComAlfArena::getMatrix3DSize<double>( NO_TEST_FILT, NO_VAR_BINS, MAX_SQR_FILT_LENGTH )
+                 + TComAlfArena::getMatrixSize<double>( NO_TEST_FILT, NO_VAR_BINS )
+                 + TComAlfArena::getMatrixSize<double>( MAX_SQR_FILT_LENGTH, MAX_SQR_FILT_LENGTH )
+                 + TComAlfArena::getMatrix3DSize<double>( NO_VAR_BINS, MAX_SQR_FILT_LENGTH, MAX_SQR_FILT_LENGTH )
+                 + TComAlfArena::getMatrixSize<double>( NO_VAR_BINS, MAX_SQR_FILT_LENGTH )
+                 + TComAlfArena::getArraySize<double>( NO_VAR_BINS )
+                 + 2 * TComAlfArena::getArraySize<double>( MAX_SQR_FILT_LENGTH )
+                 + 2 * TComAlfArena::getArraySize<Int>( MAX_SQR_FILT_LENGTH )
+                 + 2 * TComAlfArena::getMatrixSize<Int>( NO_VAR_BINS, MAX_SQR_FILT_LENGTH );
+#endif
+    m_cEncArena.create( uiArenaSize );
+  }
+  else
+  {
+    m_cEncArena.reset();
+  }
+
   // init qc_filter
-  initMatrix4D_double(&EGlobalSym, NO_TEST_FILT,  NO_VAR_BINS, MAX_SQR_FILT_LENGTH, MAX_SQR_FILT_LENGTH);
-  initMatrix3D_double(&yGlobalSym, NO_TEST_FILT, NO_VAR_BINS, MAX_SQR_FILT_LENGTH); 
+  m_cEncArena.initMatrix4D(&EGlobalSym, NO_TEST_FILT,  NO_VAR_BINS, MAX_SQR_FILT_LENGTH, MAX_SQR_FILT_LENGTH);
+  m_cEncArena.initMatrix3D(&yGlobalSym, NO_TEST_FILT, NO_VAR_BINS, MAX_SQR_FILT_LENGTH); 
 #if !ALF_MEM_PATCH
-  initMatrix_int(&g_filterCoeffSym, NO_VAR_BINS, MAX_SQR_FILT_LENGTH); 
-  initMatrix_int(&g_filterCoeffPrevSelected, NO_VAR_BINS, MAX_SQR_FILT_LENGTH); 
+  m_cEncArena.initMatrix(&g_filterCoeffSym, NO_VAR_BINS, MAX_SQR_FILT_LENGTH); 
+  m_cEncArena.initMatrix(&g_filterCoeffPrevSelected, NO_VAR_BINS, MAX_SQR_FILT_LENGTH); 
 #endif
-  initMatrix_int(&g_filterCoeffSymQuant, NO_VAR_BINS, MAX_SQR_FILT_LENGTH); 
+  m_cEncArena.initMatrix(&g_filterCoeffSymQuant, NO_VAR_BINS, MAX_SQR_FILT_LENGTH); 
 
-  pixAcc = (double *) calloc(NO_VAR_BINS, sizeof(double));
-  get_mem2Dpel(&varImg, im_height, im_width);
-  get_mem2Dpel(&maskImg, im_height, im_width);
+  m_cEncArena.initArray(&pixAcc, NO_VAR_BINS);
+#if ALF_MEM_PATCH
+  m_cEncArena.initMatrix4D(&EFullSym, NO_TEST_FILT,  NO_VAR_BINS, MAX_SQR_FILT_LENGTH, MAX_SQR_FILT_LENGTH);
+  m_cEncArena.initMatrix3D(&yFullSym, NO_TEST_FILT, NO_VAR_BINS, MAX_SQR_FILT_LENGTH); 
+  m_cEncArena.initMatrix(&pixAccFull, NO_TEST_FILT, NO_VAR_BINS);
+  for (Int i=0; i<NO_TEST_FILT; i++)
+  {
+    m_abFullSymValid[i] = false;
+  }
+#endif
+  m_cEncArena.initMatrix(&varImg, im_height, im_width);
+  m_cEncArena.initMatrix(&maskImg, im_height, im_width);
   
 
 #if ALF_MEM_PATCH
-	initMatrix_double(&E_temp, MAX_SQR_FILT_LENGTH, MAX_SQR_FILT_LENGTH);//
-    y_temp = (double *) calloc(MAX_SQR_FILT_LENGTH, sizeof(double));//
-    initMatrix3D_double(&E_merged, NO_VAR_BINS, MAX_SQR_FILT_LENGTH, MAX_SQR_FILT_LENGTH);//
-    initMatrix_double(&y_merged, NO_VAR_BINS, MAX_SQR_FILT_LENGTH); //
-    pixAcc_merged = (double *) calloc(NO_VAR_BINS, sizeof(double));//
-
-	filterCoeffQuantMod = (int *) calloc(MAX_SQR_FILT_LENGTH, sizeof(int));//
-    filterCoeff = (double *) calloc(MAX_SQR_FILT_LENGTH, sizeof(double));//
-    filterCoeffQuant = (int *) calloc(MAX_SQR_FILT_LENGTH, sizeof(int));//
-    initMatrix_int(&diffFilterCoeffQuant, NO_VAR_BINS, MAX_SQR_FILT_LENGTH);//
-    initMatrix_int(&FilterCoeffQuantTemp, NO_VAR_BINS, MAX_SQR_FILT_LENGTH);//
+	m_cEncArena.initMatrix(&E_temp, MAX_SQR_FILT_LENGTH, MAX_SQR_FILT_LENGTH);//
+    m_cEncArena.initArray(&y_temp, MAX_SQR_FILT_LENGTH);//
+    m_cEncArena.initMatrix3D(&E_merged, NO_VAR_BINS, MAX_SQR_FILT_LENGTH, MAX_SQR_FILT_LENGTH);//
+    m_cEncArena.initMatrix(&y_merged, NO_VAR_BINS, MAX_SQR_FILT_LENGTH); //
+    m_cEncArena.initArray(&pixAcc_merged, NO_VAR_BINS);//
+
+	m_cEncArena.initArray(&filterCoeffQuantMod, MAX_SQR_FILT_LENGTH);//
+    m_cEncArena.initArray(&filterCoeff, MAX_SQR_FILT_LENGTH);//
+    m_cEncArena.initArray(&filterCoeffQuant, MAX_SQR_FILT_LENGTH);//
+    m_cEncArena.initMatrix(&diffFilterCoeffQuant, NO_VAR_BINS, MAX_SQR_FILT_LENGTH);//
+    m_cEncArena.initMatrix(&FilterCoeffQuantTemp, NO_VAR_BINS, MAX_SQR_FILT_LENGTH);//
 
 #endif
 
@@ -2055,34 +2101,7 @@ Void TEncAdaptiveLoopFilter::endALFEnc()
   free_mem2Dpel (imgY_ext);
   free_mem2Dpel (imgY_temp);
 #endif
-// delete qc filters
-  destroyMatrix4D_double(EGlobalSym, NO_TEST_FILT,  NO_VAR_BINS);
-  destroyMatrix3D_double(yGlobalSym, NO_TEST_FILT);
-  destroyMatrix_int(g_filterCoeffSymQuant);
-#if !ALF_MEM_PATCH
-  destroyMatrix_int(g_filterCoeffSym);
-  destroyMatrix_int(g_filterCoeffPrevSelected);
-#endif
-
-  free(pixAcc);
-  free_mem2Dpel(varImg);
-  free_mem2Dpel(maskImg);
-
-#if ALF_MEM_PATCH
-    destroyMatrix3D_double(E_merged, NO_VAR_BINS);
-	destroyMatrix_double(y_merged);
-	destroyMatrix_double(E_temp);
-	free(pixAcc_merged);
-
-	free(filterCoeffQuantMod);
-	free(y_temp);
-
-	free(filterCoeff);
-	free(filterCoeffQuant);
-	destroyMatrix_int(diffFilterCoeffQuant);
-	destroyMatrix_int(FilterCoeffQuantTemp);
-
-#endif
+  // the arrays of startALFEnc() stay in m_cEncArena until destroy()
   freeALFParam(ALFp);
   freeALFParam(tempALFp);
   delete ALFp;
@@ -4135,59 +4154,125 @@ Void   TEncAdaptiveLoopFilter::xFirstFilteringFrameLuma(imgpel* ImgOrg, imgpel*
   xstoreInBlockMatrix(ImgOrg, ImgDec, tap, Stride);
   xFilteringFrameLuma_qc(ImgOrg, ImgDec, ImgRest, ALFp, tap, Stride);
 }
+/** correlation of the masked picture; the unmasked correlation is computed once per picture and filter shape.
+    All products are integers, so the sums are exact and the masked-off part can be subtracted
+ */
 Void   TEncAdaptiveLoopFilter::xstoreInBlockMatrix(imgpel* ImgOrg, imgpel* ImgDec, Int tap, Int Stride)
 {
-  Int i,j,k,l,varInd,ii,jj;
-  Int x, y;
-  Int fl =tap/2;
+  Int i,j,k,l,varInd;
   Int sqrFiltLength=(((tap*tap)/4 + 1) + 1);
-  Int fl2=9/2; //extended size at each side of the frame
-  Int ELocal[MAX_SQR_FILT_LENGTH];
-  Int yLocal;
-  Int *p_pattern;
   Int filtNo =2; 
-  double **E,*yy;
   Int count_valid=0;
   if (tap==9)
 		filtNo =0;
   else if (tap==7)
 		filtNo =1;
 
-  p_pattern= patternTab[filtNo];
+  double ***EFull = EFullSym[filtNo];
+  double **yFull = yFullSym[filtNo];
+  double ***E = EGlobalSym[filtNo];
+  double **yy = yGlobalSym[filtNo];
+
+  if (!m_abFullSymValid[filtNo])
+  {
+    memset( pixAccFull[filtNo], 0,sizeof(double)*NO_VAR_BINS);
+    for (varInd=0; varInd<NO_VAR_BINS; varInd++)
+    {
+      memset(yFull[varInd],0,sizeof(double)*MAX_SQR_FILT_LENGTH);
+      for (k=0; k<sqrFiltLength; k++)
+      {
+        memset(EFull[varInd][k],0,sizeof(double)*MAX_SQR_FILT_LENGTH);
+      }
+    }
+    xaccumulateBlockMatrix(ImgOrg, ImgDec, tap, Stride, -1, EFull, yFull, pixAccFull[filtNo]);
+    m_abFullSymValid[filtNo] = true;
+  }
 
   memset( pixAcc, 0,sizeof(double)*NO_VAR_BINS);
   for (varInd=0; varInd<NO_VAR_BINS; varInd++)
   {
-	memset(yGlobalSym[filtNo][varInd],0,sizeof(double)*MAX_SQR_FILT_LENGTH);
+	memset(yy[varInd],0,sizeof(double)*MAX_SQR_FILT_LENGTH);
     for (k=0; k<sqrFiltLength; k++)
 	{
-	  memset(EGlobalSym[filtNo][varInd][k],0,sizeof(double)*MAX_SQR_FILT_LENGTH);
+	  memset(E[varInd][k],0,sizeof(double)*MAX_SQR_FILT_LENGTH);
     }
   }
-  for (i = fl2; i < im_height+fl2; i++)
+  for (i = 0; i < im_height; i++)
   {
-	for (j = fl2; j < im_width+fl2; j++)
+	for (j = 0; j < im_width; j++)
 	{	  
-	  if (maskImg[i-fl2][j-fl2] == 1)
+	  if (maskImg[i][j] == 1)
 	  {
 		count_valid++;
 	  }
 	}
   }
 
-  if (1)
+  if (count_valid > 0 && count_valid < im_height*im_width - count_valid)
   {
-    Int j;
-	for (i=0,y=fl2; i<im_height; i++,y++)
+    // few pixels are on: accumulate them directly
+    xaccumulateBlockMatrix(ImgOrg, ImgDec, tap, Stride, 1, E, yy, pixAcc);
+  }
+  else
+  {
+    // no pixel is on (all are used) or most pixels are on: subtract the masked-off part from the full correlation
+    if (count_valid > 0)
+    {
+      xaccumulateBlockMatrix(ImgOrg, ImgDec, tap, Stride, 0, E, yy, pixAcc);
+    }
+    for (varInd=0; varInd<NO_VAR_BINS; varInd++)
+    {
+      pixAcc[varInd] = pixAccFull[filtNo][varInd] - pixAcc[varInd];
+      for (k=0; k<sqrFiltLength; k++)
+      {
+        for (l=k; l<sqrFiltLength; l++)
+          E[varInd][k][l] = EFull[varInd][k][l] - E[varInd][k][l];
+        yy[varInd][k] = yFull[varInd][k] - yy[varInd][k];
+      }
+    }
+  }
+
+  // Matrix EGlobalSeq is symmetric, only part of it is calculated
+  for (varInd=0; varInd<NO_VAR_BINS; varInd++)
+  {
+	double **pE = E[varInd];
+    for (k=1; k<sqrFiltLength; k++)
 	{
-	  for (j=0,x=fl2; j<im_width; j++,x++)
+      for (l=0; l<k; l++)
 	  {
-		if (maskImg[i][j] == 0 && count_valid > 0)
-		{
+        pE[k][l]=pE[l][k];
+      }
+    }
+  }
+}
 
-		}
-		else
+/** adds the upper-triangle correlation of all pixels whose mask equals iMask (all pixels if iMask < 0)
+ */
+Void   TEncAdaptiveLoopFilter::xaccumulateBlockMatrix(imgpel* ImgOrg, imgpel* ImgDec, Int tap, Int Stride, Int iMask, double ***E, double **yy, double *pixAccTab)
+{
+  Int i,j,k,l,varInd,ii,jj;
+  Int fl =tap/2;
+  Int sqrFiltLength=(((tap*tap)/4 + 1) + 1);
+  Int ELocal[MAX_SQR_FILT_LENGTH];
+  Int yLocal;
+  Int *p_pattern;
+  Int filtNo =2; 
+  double **pE,*py;
+  if (tap==9)
+		filtNo =0;
+  else if (tap==7)
+		filtNo =1;
+
+  p_pattern= patternTab[filtNo];
+
+	for (i=0; i<im_height; i++)
+	{
+	  for (j=0; j<im_width; j++)
+	  {
+		if (iMask >= 0 && maskImg[i][j] != iMask)
 		{
+		  continue;
+		}
 		  varInd=min(varImg[i][j], NO_VAR_BINS-1);
 		  k=0; 
 		  memset(ELocal, 0, sqrFiltLength*sizeof(int));
@@ -4204,32 +4289,18 @@ Void   TEncAdaptiveLoopFilter::xstoreInBlockMatrix(imgpel* ImgOrg, imgpel* ImgDe
 			ELocal[sqrFiltLength-1]=1;
 		  yLocal=ImgOrg[(i)*Stride + (j)];
 
-		  pixAcc[varInd]+=(yLocal*yLocal);
-			E= EGlobalSym[filtNo][varInd];
-			yy= yGlobalSym[filtNo][varInd];
+		  pixAccTab[varInd]+=(yLocal*yLocal);
+			pE= E[varInd];
+			py= yy[varInd];
 
 		  for (k=0; k<sqrFiltLength; k++)
 		  {
 			  for (l=k; l<sqrFiltLength; l++)
-				E[k][l]+=(double)(ELocal[k]*ELocal[l]);
-			  yy[k]+=(double)(ELocal[k]*yLocal);
+				pE[k][l]+=(double)(ELocal[k]*ELocal[l]);
+			  py[k]+=(double)(ELocal[k]*yLocal);
 		  }
-		}
 	  }
 	}
-  }
-  // Matrix EGlobalSeq is symmetric, only part of it is calculated
-  for (varInd=0; varInd<NO_VAR_BINS; varInd++)
-  {
-	double **pE = EGlobalSym[filtNo][varInd];
-    for (k=1; k<sqrFiltLength; k++)
-	{
-      for (l=0; l<k; l++)
-	  {
-        pE[k][l]=pE[l][k];
-      }
-    }
-  }
 }
 
 Void   TEncAdaptiveLoopFilter::xFilteringFrameLuma_qc(imgpel* ImgOrg, imgpel* imgY_pad, imgpel* ImgFilt, ALFParam* ALFp, Int tap, Int Stride)
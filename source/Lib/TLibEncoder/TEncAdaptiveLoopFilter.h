@@ -226,6 +226,12 @@ private:
   double					***yGlobalSym;
   double					****EGlobalSym;
   double				    *pixAcc;
+#if ALF_MEM_PATCH
+  double					***yFullSym;          ///< unmasked correlation of the current picture, per filter shape
+  double					****EFullSym;
+  double					**pixAccFull;
+  Bool						m_abFullSymValid[NO_TEST_FILT];
+#endif
   Int						**g_filterCoeffSymQuant;
   imgpel                    **varImg;
   imgpel					**maskImg;
@@ -253,6 +259,8 @@ private:
   Int **FilterCoeffQuantTemp;
 #endif
 
+  TComAlfArena      m_cEncArena;                                      ///< storage of the arrays allocated in startALFEnc()
+
 #endif
 
 private:
@@ -317,6 +325,9 @@ public:
   TEncAdaptiveLoopFilter					();
 	virtual ~TEncAdaptiveLoopFilter	() {}
 
+  /// destroy ALF buffers, including the encoder arena
+  Void destroy();
+
 	/// allocate temporal memory
   Void startALFEnc(TComPic* pcPic, TEncEntropy* pcEntropyCoder);
 
@@ -349,6 +360,7 @@ public:
 #if ALF_MEM_PATCH
   Void xFirstFilteringFrameLuma         (imgpel* ImgOrg, imgpel* ImgDec, imgpel* ImgRest, ALFParam* ALFp, Int tap,  Int Stride);
   Void xstoreInBlockMatrix(imgpel* ImgOrg, imgpel* ImgDec, Int tap, Int Stride);
+  Void xaccumulateBlockMatrix(imgpel* ImgOrg, imgpel* ImgDec, Int tap, Int Stride, Int iMask, double ***E, double **yy, double *pixAccTab);
   Void xFilteringFrameLuma_qc(imgpel* ImgOrg, imgpel* imgY_pad, imgpel* ImgFilt, ALFParam* ALFp, Int tap, Int Stride);
   Void xfilterFrame_en(imgpel* ImgDec, imgpel* ImgRest,int filtNo, int Stride);
 #endif
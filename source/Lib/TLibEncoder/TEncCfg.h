@@ -57,6 +57,7 @@ protected:
   Int       m_iSourceWidth;
   Int       m_iSourceHeight;
   Int       m_iFrameToBeEncoded;
+  Bool      m_bQuiet;                           //  no per-picture and summary messages
 
   //====== Coding Structure ========
   UInt      m_uiIntraPeriod;
@@ -66,6 +67,10 @@ protected:
   Int       m_iNumOfReferenceB_L0;
   Int       m_iNumOfReferenceB_L1;
 
+  Bool      m_bUseLookahead;                    //  scene-cut and motion analysis of the input pictures
+  Int       m_iSceneCutThreshold;               //  min. saving in % of prediction from the previous picture
+  Int       m_iMotionGOPThreshold;              //  mean motion in samples which halves the GOP (0: off)
+
   Int       m_iQP;                              //  if (AdaptiveQP == OFF)
 
   Int       m_aiTLayerQPOffset[MAX_TLAYER];
@@ -108,6 +113,14 @@ protected:
   Int       m_iSearchRange;                     //  0:Full frame
   Int       m_iMaxDeltaQP;                      //  Max. absolute delta QP (1:default)
 
+  //====== Rate control ========
+  Bool      m_bUseRateCtrl;
+  Int       m_iTargetBitrate;                   //  bits per second
+  Int       m_iVBVBufferSize;                   //  bits, 0: unconstrained
+  Bool      m_bUseLCURateCtrl;                  //  LCU level lambda and QP adaptation
+  Int       m_iTwoPass;                         //  0: single pass, 1: first pass, 2: second pass
+  char*     m_pchStatsFile;                     //  two-pass statistics file
+
   //====== Generated Reference Frame Mode ========
   char*     m_pchGRefMode;
 
@@ -119,6 +132,8 @@ protected:
   Bool      m_bUseHADME;
   Bool      m_bUseGPB;
   Bool      m_bUseRDOQ;
+  Bool      m_bUseFastRDOQ;
+  Bool      m_bUseFastRDOQFinal;
   Bool      m_bUseLDC;
   Bool      m_bUsePAD;
   Bool      m_bUseQBO;
@@ -177,6 +192,7 @@ public:
   Void      setSourceWidth                  ( Int   i )      { m_iSourceWidth = i; }
   Void      setSourceHeight                 ( Int   i )      { m_iSourceHeight = i; }
   Void      setFrameToBeEncoded             ( Int   i )      { m_iFrameToBeEncoded = i; }
+  Void      setQuiet                        ( Bool  b )      { m_bQuiet = b; }
 
   //====== Coding Structure ========
   Void      setIntraPeriod                  ( Int   i )      { m_uiIntraPeriod = (UInt)i; }
@@ -186,6 +202,10 @@ public:
   Void      setNumOfReferenceB_L0           ( Int   i )      { m_iNumOfReferenceB_L0 = i; }
   Void      setNumOfReferenceB_L1           ( Int   i )      { m_iNumOfReferenceB_L1 = i; }
 
+  Void      setUseLookahead                 ( Bool  b )      { m_bUseLookahead = b; }
+  Void      setSceneCutThreshold            ( Int   i )      { m_iSceneCutThreshold = i; }
+  Void      setMotionGOPThreshold           ( Int   i )      { m_iMotionGOPThreshold = i; }
+
   Void      setQP                           ( Int   i )      { m_iQP = i; }
 
   Void      setTemporalLayerQPOffset        ( Int*  piTemporalLayerQPOffset )      { for ( Int i = 0; i < MAX_TLAYER; i++ ) m_aiTLayerQPOffset[i] = piTemporalLayerQPOffset[i]; }
@@ -229,6 +249,14 @@ public:
   Void      setSearchRange                  ( Int   i )      { m_iSearchRange = i; }
   Void      setMaxDeltaQP                   ( Int   i )      { m_iMaxDeltaQP = i; }
 
+  //====== Rate control ========
+  Void      setUseRateCtrl                  ( Bool  b )      { m_bUseRateCtrl = b; }
+  Void      setTargetBitrate                ( Int   i )      { m_iTargetBitrate = i; }
+  Void      setVBVBufferSize                ( Int   i )      { m_iVBVBufferSize = i; }
+  Void      setUseLCURateCtrl               ( Bool  b )      { m_bUseLCURateCtrl = b; }
+  Void      setTwoPass                      ( Int   i )      { m_iTwoPass = i; }
+  Void      setStatsFile                    ( char* c )      { m_pchStatsFile = c; }
+
    //====== Generated Reference Frame Mode ========
   Void      setGRefMode       (char*  c)       {m_pchGRefMode=c; }
 
@@ -238,6 +266,7 @@ public:
   Int       getSourceWidth                  ()      { return  m_iSourceWidth; }
   Int       getSourceHeight                 ()      { return  m_iSourceHeight; }
   Int       getFrameToBeEncoded             ()      { return  m_iFrameToBeEncoded; }
+  Bool      getQuiet                        ()      { return  m_bQuiet; }
 
   //==== Coding Structure ========
   UInt      getIntraPeriod                  ()      { return  m_uiIntraPeriod; }
@@ -247,6 +276,10 @@ public:
   Int       getNumOfReferenceB_L0           ()      { return  m_iNumOfReferenceB_L0; }
   Int       getNumOfReferenceB_L1           ()      { return  m_iNumOfReferenceB_L1; }
 
+  Bool      getUseLookahead                 ()      { return  m_bUseLookahead; }
+  Int       getSceneCutThreshold            ()      { return  m_iSceneCutThreshold; }
+  Int       getMotionGOPThreshold           ()      { return  m_iMotionGOPThreshold; }
+
   Int       getQP                           ()      { return  m_iQP; }
 
   Int       getTemporalLayerQPOffset        ( Int i )      { assert (i < MAX_TLAYER ); return  m_aiTLayerQPOffset[i]; }
@@ -291,6 +324,14 @@ public:
   Int       getSearchRange                  ()      { return  m_iSearchRange; }
   Int       getMaxDeltaQP                   ()      { return  m_iMaxDeltaQP; }
 
+  //==== Rate control ========
+  Bool      getUseRateCtrl                  ()      { return  m_bUseRateCtrl; }
+  Int       getTargetBitrate                ()      { return  m_iTargetBitrate; }
+  Int       getVBVBufferSize                ()      { return  m_iVBVBufferSize; }
+  Bool      getUseLCURateCtrl               ()      { return  m_bUseLCURateCtrl; }
+  Int       getTwoPass                      ()      { return  m_iTwoPass; }
+  char*     getStatsFile                    ()      { return  m_pchStatsFile; }
+
    //====== Generated Reference Frame Mode ========
   char*      getGRefMode       ()       { return m_pchGRefMode; }
 
@@ -301,6 +342,8 @@ public:
   Void      setUseALF                       ( Bool  b )     { m_bUseALF   = b; }
   Void      setUseGPB                       ( Bool  b )     { m_bUseGPB     = b; }
   Void      setUseRDOQ                      ( Bool  b )     { m_bUseRDOQ    = b; }
+  Void      setUseFastRDOQ                  ( Bool  b )     { m_bUseFastRDOQ      = b; }
+  Void      setUseFastRDOQFinal             ( Bool  b )     { m_bUseFastRDOQFinal = b; }
   Void      setUseLDC                       ( Bool  b )     { m_bUseLDC     = b; }
   Void      setUsePAD                       ( Bool  b )     { m_bUsePAD     = b; }
   Void      setUseQBO                       ( Bool  b )     { m_bUseQBO     = b; }
@@ -346,6 +389,8 @@ public:
   Bool      getUseALF                       ()      { return m_bUseALF;     }
   Bool      getUseGPB                       ()      { return m_bUseGPB;     }
   Bool      getUseRDOQ                      ()      { return m_bUseRDOQ;    }
+  Bool      getUseFastRDOQ                  ()      { return m_bUseFastRDOQ;      }
+  Bool      getUseFastRDOQFinal             ()      { return m_bUseFastRDOQFinal; }
   Bool      getUseLDC                       ()      { return m_bUseLDC;     }
   Bool      getUsePAD                       ()      { return m_bUsePAD;     }
   Bool      getUseQBO                       ()      { return m_bUseQBO;     }
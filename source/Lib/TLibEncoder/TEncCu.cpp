@@ -230,7 +230,8 @@ Void TEncCu::compressCU( TComDataCU*& rpcCU )
   // multiple-QP coding mode
   else
   {
-    Int iQP  = rpcCU->getSlice()->getSliceQp();
+    Int iSliceQP = rpcCU->getSlice()->getSliceQp();
+    Int iQP  = m_iQp;     // LCU QP, differs from the slice QP with LCU level rate control
     Int idQP = m_pcEncCfg->getMaxDeltaQP();
     Int i;
     Int iBestQP = iQP;
@@ -244,9 +245,15 @@ Void TEncCu::compressCU( TComDataCU*& rpcCU )
 
     // first try
     xCompressCU( m_ppcBestCU[0], m_ppcTempCU[0], 0 );
+    rpcCU->getSlice()->setSliceQp( iSliceQP );
 
+    // a skipped LCU has no dQP, it is decoded with the slice QP
+    if ( m_ppcBestCU[0]->isSkipped( 0 ) && m_ppcBestCU[0]->getDepth( 0 ) == 0 )
+    {
+      rpcCU->setQPSubParts( iSliceQP, 0, 0 );
+    }
     // for non-zero residual case
-    if ( !( m_ppcBestCU[0]->isSkipped( 0 ) && m_ppcBestCU[0]->getDepth( 0 ) == 0 ) )
+    else
     {
       // add dQP bits
       m_pcEntropyCoder->resetBits();
@@ -256,48 +263,51 @@ Void TEncCu::compressCU( TComDataCU*& rpcCU )
 
       fBestCost = m_ppcBestCU[0]->getTotalCost();
 
-      // try every case
-      for ( i=iQP-idQP; i<=iQP+idQP; i++ )
+      // try every case, the rate control sets the LCU QP without a search
+      if ( idQP > 0 )
       {
-        if ( i == iQP ) continue;
+        for ( i=iQP-idQP; i<=iQP+idQP; i++ )
+        {
+          if ( i == iQP ) continue;
+
+          rpcCU->getSlice()->setSliceQp( i );
+          m_ppcBestCU[0]->initCU( rpcCU->getPic(), rpcCU->getAddr() );
+          m_ppcTempCU[0]->initCU( rpcCU->getPic(), rpcCU->getAddr() );
+          m_ppcBestCU[0]->setQPSubParts( i, 0, 0 );
+          m_ppcTempCU[0]->setQPSubParts( i, 0, 0 );
+
+          xCompressCU( m_ppcBestCU[0], m_ppcTempCU[0], 0 );
+
+          // add dQP bits
+          rpcCU->getSlice()->setSliceQp( iSliceQP );
+          m_pcEntropyCoder->resetBits();
+          m_pcEntropyCoder->encodeQP( m_ppcBestCU[0], 0, false );
+          m_ppcBestCU[0]->getTotalBits() += m_pcEntropyCoder->getNumberOfWrittenBits(); // dQP bits
+          m_ppcBestCU[0]->getTotalCost()  = m_pcRdCost->calcRdCost( m_ppcBestCU[0]->getTotalBits(), m_ppcBestCU[0]->getTotalDistortion() );
+
+          if ( fBestCost > m_ppcBestCU[0]->getTotalCost() )
+          {
+            fBestCost = m_ppcBestCU[0]->getTotalCost();
+            iBestQP   = i;
+          }
+        }
 
-        rpcCU->getSlice()->setSliceQp( i );
+        // perform best case
+        rpcCU->getSlice()->setSliceQp( iBestQP );
         m_ppcBestCU[0]->initCU( rpcCU->getPic(), rpcCU->getAddr() );
         m_ppcTempCU[0]->initCU( rpcCU->getPic(), rpcCU->getAddr() );
-        m_ppcBestCU[0]->setQPSubParts( i, 0, 0 );
-        m_ppcTempCU[0]->setQPSubParts( i, 0, 0 );
+        m_ppcBestCU[0]->setQPSubParts( iBestQP, 0, 0 );
+        m_ppcTempCU[0]->setQPSubParts( iBestQP, 0, 0 );
 
         xCompressCU( m_ppcBestCU[0], m_ppcTempCU[0], 0 );
 
         // add dQP bits
-        rpcCU->getSlice()->setSliceQp( iQP );
+        rpcCU->getSlice()->setSliceQp( iSliceQP );
         m_pcEntropyCoder->resetBits();
         m_pcEntropyCoder->encodeQP( m_ppcBestCU[0], 0, false );
         m_ppcBestCU[0]->getTotalBits() += m_pcEntropyCoder->getNumberOfWrittenBits(); // dQP bits
         m_ppcBestCU[0]->getTotalCost()  = m_pcRdCost->calcRdCost( m_ppcBestCU[0]->getTotalBits(), m_ppcBestCU[0]->getTotalDistortion() );
-
-        if ( fBestCost > m_ppcBestCU[0]->getTotalCost() )
-        {
-          fBestCost = m_ppcBestCU[0]->getTotalCost();
-          iBestQP   = i;
-        }
       }
-
-      // perform best case
-      rpcCU->getSlice()->setSliceQp( iBestQP );
-      m_ppcBestCU[0]->initCU( rpcCU->getPic(), rpcCU->getAddr() );
-      m_ppcTempCU[0]->initCU( rpcCU->getPic(), rpcCU->getAddr() );
-      m_ppcBestCU[0]->setQPSubParts( iBestQP, 0, 0 );
-      m_ppcTempCU[0]->setQPSubParts( iBestQP, 0, 0 );
-
-      xCompressCU( m_ppcBestCU[0], m_ppcTempCU[0], 0 );
-
-      // add dQP bits
-      rpcCU->getSlice()->setSliceQp( iQP );
-      m_pcEntropyCoder->resetBits();
-      m_pcEntropyCoder->encodeQP( m_ppcBestCU[0], 0, false );
-      m_ppcBestCU[0]->getTotalBits() += m_pcEntropyCoder->getNumberOfWrittenBits(); // dQP bits
-      m_ppcBestCU[0]->getTotalCost()  = m_pcRdCost->calcRdCost( m_ppcBestCU[0]->getTotalBits(), m_ppcBestCU[0]->getTotalDistortion() );
     }
   }
 }
@@ -546,6 +556,12 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, UInt u
       }
     }
 
+    // re-code residual of selected inter mode when the final RDOQ setting differs from mode decision
+    if ( m_pcEncCfg->getUseRDOQ() && m_pcEncCfg->getUseFastRDOQ() != m_pcEncCfg->getUseFastRDOQFinal() )
+    {
+      xRecodeBestInter( rpcBestCU );
+    }
+
     m_pcEntropyCoder->resetBits();
     m_pcEntropyCoder->encodeSplitFlag( rpcBestCU, 0, uiDepth, true );
     rpcBestCU->getTotalBits() += m_pcEntropyCoder->getNumberOfWrittenBits(); // split bits
@@ -1041,6 +1057,32 @@ Void TEncCu::xCheckBestMode( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU )
   }
 }
 
+/** re-codes the residual of the best inter CU with the RDOQ setting for final coding
+ * \param rpcBestCU best CU of the current depth
+ */
+Void TEncCu::xRecodeBestInter( TComDataCU*& rpcBestCU )
+{
+  if ( rpcBestCU->getPredictionMode(0) != MODE_INTER )
+  {
+    return;
+  }
+
+  UChar uhDepth = rpcBestCU->getDepth( 0 );
+
+  m_pcTrQuant->setUseFastRDOQ( m_pcEncCfg->getUseFastRDOQFinal() );
+#if HHI_RQT
+  m_pcPredSearch->encodeResAndCalcRdInterCU( rpcBestCU, m_ppcOrigYuv[uhDepth], m_ppcPredYuvBest[uhDepth], m_ppcResiYuvTemp[uhDepth], m_ppcResiYuvBest[uhDepth], m_ppcRecoYuvBest[uhDepth], false );
+#else
+  m_pcPredSearch->encodeResAndCalcRdInterCU( rpcBestCU, m_ppcOrigYuv[uhDepth], m_ppcPredYuvBest[uhDepth], m_ppcResiYuvBest[uhDepth], m_ppcRecoYuvBest[uhDepth], false );
+#endif
+  m_pcTrQuant->setUseFastRDOQ( m_pcEncCfg->getUseFastRDOQ() );
+
+  rpcBestCU->getTotalCost()  = m_pcRdCost->calcRdCost( rpcBestCU->getTotalBits(), rpcBestCU->getTotalDistortion() );
+
+  if( m_bUseSBACRD )
+    m_pppcRDSbacCoder[uhDepth][CI_TEMP_BEST]->store(m_pppcRDSbacCoder[uhDepth][CI_NEXT_BEST]);
+}
+
 Void TEncCu::xCheckRDCostAMVPSkip           ( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU )
 {
   UChar uhDepth = rpcTempCU->getDepth(0);
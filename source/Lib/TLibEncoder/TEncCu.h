@@ -136,6 +136,7 @@ protected:
   Void  xCheckRDCostInter   ( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, PartSize ePartSize  );
   Void  xCheckRDCostIntra   ( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, PartSize ePartSize  );
   Void  xCheckBestMode      ( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU                      );
+  Void  xRecodeBestInter    ( TComDataCU*& rpcBestCU                                              );
 #if PLANAR_INTRA
   Void  xCheckPlanarIntra   ( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU                      );
 #endif
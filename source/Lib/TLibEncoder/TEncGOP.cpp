@@ -39,6 +39,10 @@
 
 #include <time.h>
 
+#if ENABLE_SSE2
+#include <emmintrin.h>
+#endif
+
 // ====================================================================================================================
 // Constructor / destructor / initialization / destroy
 // ====================================================================================================================
@@ -52,6 +56,8 @@ TEncGOP::TEncGOP()
 
   m_pcCfg               = NULL;
   m_pcSliceEncoder      = NULL;
+  m_pcRateCtrl          = NULL;
+  m_pcTwoPass           = NULL;
 #ifdef QC_SIFO
   m_pcSIFOEncoder       = NULL;
 #endif
@@ -88,6 +94,8 @@ Void TEncGOP::init ( TEncTop* pcTEncTop )
   m_pcEncTop     = pcTEncTop;
   m_pcCfg                = pcTEncTop;
   m_pcSliceEncoder       = pcTEncTop->getSliceEncoder();
+  m_pcRateCtrl           = pcTEncTop->getRateCtrl();
+  m_pcTwoPass            = pcTEncTop->getTwoPass();
 #ifdef QC_SIFO
   m_pcSIFOEncoder        = pcTEncTop->getSIFOEncoder();
 #endif
@@ -115,7 +123,7 @@ Void TEncGOP::init ( TEncTop* pcTEncTop )
 // Public member functions
 // ====================================================================================================================
 
-Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rcListPic, TComList<TComPicYuv*>& rcListPicYuvRecOut, TComList<TComBitstream*> rcListBitstreamOut )
+Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, Int iGOPSize, TComList<TComPic*>& rcListPic, TComList<TComPicYuv*>& rcListPicYuvRecOut, TComList<TComBitstream*> rcListBitstreamOut )
 {
   TComPic*        pcPic;
   TComPicYuv*     pcPicYuvRecOut;
@@ -126,7 +134,12 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
   TComBitstream*  pcOut = new TComBitstream;
   pcOut->create( 500000 );
 
-  xInitGOP( iPOCLast, iNumPicRcvd, rcListPic, rcListPicYuvRecOut );
+  xInitGOP( iPOCLast, iNumPicRcvd, iGOPSize, rcListPic, rcListPicYuvRecOut );
+
+  if ( m_pcCfg->getUseRateCtrl() )
+  {
+    m_pcRateCtrl->initGOP( iNumPicRcvd, m_iGopSize, m_pcCfg->getHierarchicalCoding() );
+  }
 
   m_iNumPicCoded = 0;
   for ( Int iDepth = 0; iDepth < m_iHrchDepth; iDepth++ )
@@ -173,6 +186,12 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
       pcBitstreamOut->resetBits();
       pcBitstreamOut->rewindStreamPacket();
 
+      //  QP allocation of the second pass from the first pass statistics
+      if ( m_pcCfg->getTwoPass() == 2 )
+      {
+        m_pcTwoPass->initPicture( uiPOCCurr );
+      }
+
       //  Slice data initialization
       TComSlice*      pcSlice;
       m_pcSliceEncoder->initEncSlice ( pcPic, iPOCLast, uiPOCCurr, iNumPicRcvd, iTimeOffset, iDepth, pcSlice );
@@ -303,6 +322,9 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
         }
       }
 
+      // samples of the weighted virtual references are not read after this point
+      pcSlice->releaseVirtRefPic();
+
       //-- Loop filter
       m_pcLoopFilter->setCfg(pcSlice->getLoopFilterDisable(), m_pcCfg->getLoopFilterAlphaC0Offget(), m_pcCfg->getLoopFilterBetaOffget());
       m_pcLoopFilter->loopFilterPic( pcPic );
@@ -528,15 +550,6 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
         getSliceEncoder()->getCUEncoder()->getCABAC4V2V()->setCntFlag(1);
       }
 
-#if HHI_INTERP_FILTER      
-      // MOMS prefilter reconstructed pic
-      if ( pcPic->getSlice()->isReferenced() && pcSlice->getUseMOMS() )
-      {
-        TComCoeffCalcMOMS cCoeffCalc;
-        cCoeffCalc.calcCoeffs( pcPic->getPicYuvRec(), pcPic->getPicYuvRecFilt(), pcPic->getSlice()->getInterpFilterType() );
-      }
-#endif
-
       // File writing
       m_pcSliceEncoder->encodeSlice( pcPic, pcBitstreamOut );
 #ifdef QC_SIFO
@@ -567,6 +580,15 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
       //-- For time output for each slice
       Double dEncTime = (double)(clock()-iBeforeTime) / CLOCKS_PER_SEC;
 
+      if ( m_pcCfg->getUseRateCtrl() )
+      {
+        m_pcRateCtrl->updatePicture( pcBitstreamOut->getNumberOfWrittenBits() );
+      }
+      if ( m_pcCfg->getTwoPass() == 2 )
+      {
+        m_pcTwoPass->updatePicture( pcBitstreamOut->getNumberOfWrittenBits() );
+      }
+
       xCalculateAddPSNR( pcPic, &pcPicD, pcBitstreamOut->getNumberOfWrittenBits(), dEncTime );
 
       // free original picture
@@ -579,6 +601,18 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
 
       pcPic->setReconMark   ( true );
 
+      // a later intra picture is a random access point only if no picture after it references across it
+      Int iMinRefPOC = pcSlice->getPOC();
+      for ( Int iList = 0; iList < 2; iList++ )
+      {
+        for ( Int iRefIdx = 0; iRefIdx < pcSlice->getNumRefIdx( (RefPicList)iList ); iRefIdx++ )
+        {
+          iMinRefPOC = Min( iMinRefPOC, pcSlice->getRefPic( (RefPicList)iList, iRefIdx )->getPOC() );
+        }
+      }
+      m_aiCodedPOC      [m_iNumPicCoded] = pcSlice->getPOC();
+      m_aiCodedMinRefPOC[m_iNumPicCoded] = iMinRefPOC;
+
       m_bFirst = false;
       m_iNumPicCoded++;
     }
@@ -612,6 +646,10 @@ Void TEncGOP::printOutSummary(UInt uiNumAllPicCoded)
   //-- all
   printf( "\n\nSUMMARY --------------------------------------------------------\n" );
   m_gcAnalyzeAll.printOut('a');
+  if ( m_pcCfg->getUseRateCtrl() && m_pcCfg->getVBVBufferSize() > 0 )
+  {
+    printf( "\tVBV buffer overflows: %d\n", m_pcRateCtrl->getVBVOverflows() );
+  }
 
   printf( "\n\nI Slices--------------------------------------------------------\n" );
   m_gcAnalyzeI.printOut('i');
@@ -676,13 +714,13 @@ Void TEncGOP::preLoopFilterPicAll( TComPic* pcPic, UInt64& ruiDist, UInt64& ruiB
 // Protected member functions
 // ====================================================================================================================
 
-Void TEncGOP::xInitGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rcListPic, TComList<TComPicYuv*>& rcListPicYuvRecOut )
+Void TEncGOP::xInitGOP( Int iPOCLast, Int iNumPicRcvd, Int iGOPSize, TComList<TComPic*>& rcListPic, TComList<TComPicYuv*>& rcListPicYuvRecOut )
 {
   assert( iNumPicRcvd > 0 );
   Int i;
 
   //  Set hierarchical B info.
-  m_iGopSize    = m_pcCfg->getGOPSize();
+  m_iGopSize    = iGOPSize;
   for( i=1 ; ; i++)
   {
     m_iHrchDepth = i;
@@ -861,128 +899,119 @@ Void TEncGOP::xDeScalePic( TComPic* pcPic, TComPicYuv* pcPicD )
   }
 }
 
-UInt64 TEncGOP::xFindDistortionFrame (TComPicYuv* pcPic0, TComPicYuv* pcPic1)
+/** sum of squared differences of a block, each squared difference is shifted right by uiShift before accumulation
+ */
+UInt64 TEncGOP::xGetSSE( Pel* pSrc0, Int iStride0, Pel* pSrc1, Int iStride1, Int iWidth, Int iHeight, UInt uiShift )
 {
   Int     x, y;
-  Pel*  pSrc0   = pcPic0 ->getLumaAddr();
-  Pel*  pSrc1   = pcPic1 ->getLumaAddr();
-  UInt  uiShift = g_uiBitIncrement<<1;
-  Int   iTemp;
-
-  Int   iStride = pcPic0->getStride();
-  Int   iWidth  = pcPic0->getWidth();
-  Int   iHeight = pcPic0->getHeight();
-
-  UInt64  uiTotalDiff = 0;
+  UInt64  uiSSE = 0;
+#if ENABLE_SSE2
+  __m128i vSum   = _mm_setzero_si128();
+  __m128i vZero  = _mm_setzero_si128();
+  __m128i vShift = _mm_cvtsi32_si128( uiShift );
+#endif
 
   for( y = 0; y < iHeight; y++ )
   {
-    for( x = 0; x < iWidth; x++ )
+    x = 0;
+#if ENABLE_SSE2
+    for( ; x + 8 <= iWidth; x += 8 )
+    {
+      __m128i vDiff = _mm_sub_epi16( _mm_loadu_si128( (const __m128i*)( pSrc0 + x ) ), _mm_loadu_si128( (const __m128i*)( pSrc1 + x ) ) );
+      __m128i vSq;
+      if ( uiShift == 0 )
+      {
+        vSq = _mm_madd_epi16( vDiff, vDiff );
+      }
+      else
+      {
+        __m128i vLo = _mm_mullo_epi16( vDiff, vDiff );
+        __m128i vHi = _mm_mulhi_epi16( vDiff, vDiff );
+        vSq = _mm_add_epi32( _mm_srl_epi32( _mm_unpacklo_epi16( vLo, vHi ), vShift ), _mm_srl_epi32( _mm_unpackhi_epi16( vLo, vHi ), vShift ) );
+      }
+      // widen to 64 bits before accumulating so that large pictures cannot overflow
+      vSum = _mm_add_epi64( vSum, _mm_unpacklo_epi32( vSq, vZero ) );
+      vSum = _mm_add_epi64( vSum, _mm_unpackhi_epi32( vSq, vZero ) );
+    }
+#endif
+    for( ; x < iWidth; x++ )
     {
-      iTemp = pSrc0[x] - pSrc1[x]; uiTotalDiff += (iTemp*iTemp) >> uiShift;
+      Int iTemp = pSrc0[x] - pSrc1[x];
+      uiSSE += (iTemp*iTemp) >> uiShift;
     }
-    pSrc0 += iStride;
-    pSrc1 += iStride;
+    pSrc0 += iStride0;
+    pSrc1 += iStride1;
   }
 
-  iHeight >>= 1;
-  iWidth  >>= 1;
-  iStride >>= 1;
+#if ENABLE_SSE2
+  UInt64 auiSum[2];
+  _mm_storeu_si128( (__m128i*)auiSum, vSum );
+  uiSSE += auiSum[0] + auiSum[1];
+#endif
 
-  pSrc0  = pcPic0->getCbAddr();
-  pSrc1  = pcPic1->getCbAddr();
+  return uiSSE;
+}
 
-  for( y = 0; y < iHeight; y++ )
-  {
-    for( x = 0; x < iWidth; x++ )
-    {
-      iTemp = pSrc0[x] - pSrc1[x]; uiTotalDiff += (iTemp*iTemp) >> uiShift;
-    }
-    pSrc0 += iStride;
-    pSrc1 += iStride;
-  }
+/** add the luma and chroma SSE of one LCU row to ruiSSE[0..2]
+    \param uiRow    LCU row index
+    \param iWidth   luma width of the compared area
+    \param iHeight  luma height of the compared area
+    \param uiShift  right shift applied to every squared difference
+ */
+Void TEncGOP::xAddSSELCURow( TComPicYuv* pcPic0, TComPicYuv* pcPic1, UInt uiRow, Int iWidth, Int iHeight, UInt uiShift, UInt64* puiSSE )
+{
+  Int iY0 = uiRow * g_uiMaxCUHeight;
+  Int iY1 = Min( iY0 + (Int)g_uiMaxCUHeight, iHeight );
+
+  Int iStride0 = pcPic0->getStride();
+  Int iStride1 = pcPic1->getStride();
+  puiSSE[0] += xGetSSE( pcPic0->getLumaAddr() + iY0*iStride0, iStride0, pcPic1->getLumaAddr() + iY0*iStride1, iStride1, iWidth, iY1 - iY0, uiShift );
+
+  iY0 >>= 1;
+  iY1   = Min( iY1 >> 1, iHeight >> 1 );
+  iStride0 = pcPic0->getCStride();
+  iStride1 = pcPic1->getCStride();
+  puiSSE[1] += xGetSSE( pcPic0->getCbAddr() + iY0*iStride0, iStride0, pcPic1->getCbAddr() + iY0*iStride1, iStride1, iWidth >> 1, iY1 - iY0, uiShift );
+  puiSSE[2] += xGetSSE( pcPic0->getCrAddr() + iY0*iStride0, iStride0, pcPic1->getCrAddr() + iY0*iStride1, iStride1, iWidth >> 1, iY1 - iY0, uiShift );
+}
 
-  pSrc0  = pcPic0->getCrAddr();
-  pSrc1  = pcPic1->getCrAddr();
+UInt64 TEncGOP::xFindDistortionFrame (TComPicYuv* pcPic0, TComPicYuv* pcPic1)
+{
+  Int     iWidth  = pcPic0->getWidth();
+  Int     iHeight = pcPic0->getHeight();
+  UInt    uiRows  = ( iHeight + g_uiMaxCUHeight - 1 ) / g_uiMaxCUHeight;
+  UInt64  auiSSE[3] = { 0, 0, 0 };
 
-  for( y = 0; y < iHeight; y++ )
+  for( UInt uiRow = 0; uiRow < uiRows; uiRow++ )
   {
-    for( x = 0; x < iWidth; x++ )
-    {
-      iTemp = pSrc0[x] - pSrc1[x]; uiTotalDiff += (iTemp*iTemp) >> uiShift;
-    }
-    pSrc0 += iStride;
-    pSrc1 += iStride;
+    xAddSSELCURow( pcPic0, pcPic1, uiRow, iWidth, iHeight, g_uiBitIncrement<<1, auiSSE );
   }
 
-  return uiTotalDiff;
+  return auiSSE[0] + auiSSE[1] + auiSSE[2];
 }
 
 Void TEncGOP::xCalculateAddPSNR( TComPic* pcPic, TComPicYuv* pcPicD, UInt uibits, Double dEncTime )
 {
-  Int     x, y;
-  UInt    uiSSDY  = 0;
-  UInt    uiSSDU  = 0;
-  UInt    uiSSDV  = 0;
+  UInt64  auiSSE[3] = { 0, 0, 0 };
 
   Double  dYPSNR  = 0.0;
   Double  dUPSNR  = 0.0;
   Double  dVPSNR  = 0.0;
 
   //===== calculate PSNR =====
-  Pel*  pOrg    = pcPic ->getPicYuvOrg()->getLumaAddr();
-  Pel*  pRec    = pcPicD->getLumaAddr();
-  Int   iStride = pcPicD->getStride();
-
-  Int   iWidth;
-  Int   iHeight;
-
-  iWidth  = pcPicD->getWidth () - m_pcEncTop->getPad(0);
-  iHeight = pcPicD->getHeight() - m_pcEncTop->getPad(1);
-
+  Int   iWidth  = pcPicD->getWidth () - m_pcEncTop->getPad(0);
+  Int   iHeight = pcPicD->getHeight() - m_pcEncTop->getPad(1);
   Int   iSize   = iWidth*iHeight;
+  UInt  uiRows  = ( iHeight + g_uiMaxCUHeight - 1 ) / g_uiMaxCUHeight;
 
-  for( y = 0; y < iHeight; y++ )
-  {
-    for( x = 0; x < iWidth; x++ )
-    {
-      Int iDiff = (Int)( pOrg[x] - pRec[x] );
-      uiSSDY   += iDiff * iDiff;
-    }
-    pOrg += iStride;
-    pRec += iStride;
-  }
-
-  iHeight >>= 1;
-  iWidth  >>= 1;
-  iStride >>= 1;
-  pOrg  = pcPic ->getPicYuvOrg()->getCbAddr();
-  pRec  = pcPicD->getCbAddr();
-
-  for( y = 0; y < iHeight; y++ )
+  for( UInt uiRow = 0; uiRow < uiRows; uiRow++ )
   {
-    for( x = 0; x < iWidth; x++ )
-    {
-      Int iDiff = (Int)( pOrg[x] - pRec[x] );
-      uiSSDU   += iDiff * iDiff;
-    }
-    pOrg += iStride;
-    pRec += iStride;
+    xAddSSELCURow( pcPic->getPicYuvOrg(), pcPicD, uiRow, iWidth, iHeight, 0, auiSSE );
   }
 
-  pOrg  = pcPic ->getPicYuvOrg()->getCrAddr();
-  pRec  = pcPicD->getCrAddr();
-
-  for( y = 0; y < iHeight; y++ )
-  {
-    for( x = 0; x < iWidth; x++ )
-    {
-      Int iDiff = (Int)( pOrg[x] - pRec[x] );
-      uiSSDV   += iDiff * iDiff;
-    }
-    pOrg += iStride;
-    pRec += iStride;
-  }
+  UInt64  uiSSDY  = auiSSE[0];
+  UInt64  uiSSDU  = auiSSE[1];
+  UInt64  uiSSDV  = auiSSE[2];
 
   Double fRefValueY = 255.0 * 255.0 * (Double)iSize;
   Double fRefValueC = fRefValueY / 4.0;
@@ -990,6 +1019,14 @@ Void TEncGOP::xCalculateAddPSNR( TComPic* pcPic, TComPicYuv* pcPicD, UInt uibits
   dUPSNR            = ( uiSSDU ? 10.0 * log10( fRefValueC / (Double)uiSSDU ) : 99.99 );
   dVPSNR            = ( uiSSDV ? 10.0 * log10( fRefValueC / (Double)uiSSDV ) : 99.99 );
 
+  // first pass statistics
+  if ( m_pcCfg->getTwoPass() == 1 )
+  {
+    TComSlice* pcSlice = pcPic->getSlice();
+    m_pcTwoPass->writePicture( pcSlice->getPOC(), pcSlice->isIntra() ? 'I' : pcSlice->isInterP() ? 'P' : 'B', pcSlice->getSliceQp(),
+                               uibits, uiSSDY, uiSSDU, uiSSDV );
+  }
+
   // fix: total bits should consider slice size bits (32bit)
   uibits += 32;
 
@@ -1009,6 +1046,10 @@ Void TEncGOP::xCalculateAddPSNR( TComPic* pcPic, TComPicYuv* pcPicD, UInt uibits
   }
 
   //===== output =====
+  if ( m_pcCfg->getQuiet() )
+  {
+    return;
+  }
   TComSlice*  pcSlice = pcPic->getSlice();
   printf("\nPOC %4d ( %c-SLICE, QP %d ) %10d bits ",
     pcSlice->getPOC(),
@@ -1017,6 +1058,20 @@ Void TEncGOP::xCalculateAddPSNR( TComPic* pcPic, TComPicYuv* pcPicD, UInt uibits
     uibits );
   printf( "[Y %6.4lf dB    U %6.4lf dB    V %6.4lf dB]  ", dYPSNR, dUPSNR, dVPSNR );
   printf ("[ET %5.0f ] ", dEncTime );
+  if ( m_pcCfg->getUseLookahead() )
+  {
+    TEncLookahead* pcLookahead = m_pcEncTop->getLookahead();
+    printf ("[LA %6.2f %6.2f%s] ", pcLookahead->getComplexity( pcSlice->getPOC() ), pcLookahead->getIntraComplexity( pcSlice->getPOC() ),
+                                    pcLookahead->isSceneCut( pcSlice->getPOC() ) ? " SC" : "" );
+  }
+  if ( m_pcCfg->getUseRateCtrl() )
+  {
+    printf ("[RC %8.0f %8lld] ", m_pcRateCtrl->getPicTarget(), m_pcRateCtrl->getVBVFullness() );
+  }
+  if ( m_pcCfg->getTwoPass() == 2 )
+  {
+    printf ("[2P %+3d] ", m_pcTwoPass->getQPOffset() );
+  }
 
   for (Int iRefList = 0; iRefList < 2; iRefList++)
   {
@@ -76,6 +76,8 @@ private:
   TEncTop*                m_pcEncTop;
   TEncCfg*                m_pcCfg;
   TEncSlice*              m_pcSliceEncoder;
+  TEncRateCtrl*           m_pcRateCtrl;
+  TEncTwoPass*            m_pcTwoPass;
 #ifdef QC_SIFO
   TEncSIFO*               m_pcSIFOEncoder;
 #endif
@@ -101,6 +103,10 @@ private:
   // indicate sequence first
   Bool                    m_bSeqFirst;
 
+  // coded pictures of the last GOP in coding order, for random access point detection
+  Int                     m_aiCodedPOC      [MAX_GOP];    ///< POC
+  Int                     m_aiCodedMinRefPOC[MAX_GOP];    ///< lowest referenced POC, the POC itself for intra pictures
+
 public:
   TEncGOP();
   virtual ~TEncGOP();
@@ -112,13 +118,16 @@ public:
   UInt getBalancedCPUs()         { return m_uiBalancedCPUs; }
 
   Void  init        ( TEncTop* pcTEncTop );
-  Void  compressGOP ( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rcListPic, TComList<TComPicYuv*>& rcListPicYuvRec, TComList<TComBitstream*> rcListBitstream );
+  Void  compressGOP ( Int iPOCLast, Int iNumPicRcvd, Int iGOPSize, TComList<TComPic*>& rcListPic, TComList<TComPicYuv*>& rcListPicYuvRec, TComList<TComBitstream*> rcListBitstream );
 
   Int   getGOPSize()          { return  m_iGopSize;  }
   Int   getRateGOPSize()      { return  m_iRateGopSize;  }
   Int   isHierarchicalB()     { return  m_pcCfg->getHierarchicalCoding();  }
   Int   getHrchDepth()        { return  m_iHrchDepth; }
 
+  Int   getCodedPOC       ( Int iIdx ) { return  m_aiCodedPOC      [iIdx]; }
+  Int   getCodedMinRefPOC ( Int iIdx ) { return  m_aiCodedMinRefPOC[iIdx]; }
+
   TComList<TComPic*>*   getListPic()      { return m_pcListPic; }
 
   Void  printOutSummary      ( UInt uiNumAllPicCoded );
@@ -129,7 +138,7 @@ public:
   Void setCABAC4V2V (TEncBinCABAC4V2V* p) { m_pcBinCABAC4V2V = p; }
 
 protected:
-  Void  xInitGOP          ( Int iPOC, Int iNumPicRcvd, TComList<TComPic*>& rcListPic, TComList<TComPicYuv*>& rcListPicYuvRecOut );
+  Void  xInitGOP          ( Int iPOC, Int iNumPicRcvd, Int iGOPSize, TComList<TComPic*>& rcListPic, TComList<TComPicYuv*>& rcListPicYuvRecOut );
   Void  xGetBuffer        ( TComList<TComPic*>& rcListPic, TComList<TComPicYuv*>& rcListPicYuvRecOut, TComList<TComBitstream*>& rcListBitstream, Int iNumPicRcvd, Int iTimeOffset, TComPic*& rpcPic, TComPicYuv*& rpcPicYuvRecOut, TComBitstream*& rpcBitstreamOut, UInt uiPOCCurr );
 
   // for scaling & descaing of picture
@@ -141,6 +150,10 @@ protected:
   Void  xCalculateAddPSNR ( TComPic* pcPic, TComPicYuv* pcPicD, UInt uiBits, Double dEncTime );
 
   UInt64 xFindDistortionFrame (TComPicYuv* pcPic0, TComPicYuv* pcPic1);
+
+  // SSE kernel and its per LCU row use, vectorized when ENABLE_SSE2 is set
+  static UInt64 xGetSSE   ( Pel* pSrc0, Int iStride0, Pel* pSrc1, Int iStride1, Int iWidth, Int iHeight, UInt uiShift );
+  Void  xAddSSELCURow     ( TComPicYuv* pcPic0, TComPicYuv* pcPic1, UInt uiRow, Int iWidth, Int iHeight, UInt uiShift, UInt64* puiSSE );
 };// END CLASS DEFINITION TEncGOP
 
 
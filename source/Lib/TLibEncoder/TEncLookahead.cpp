@@ -0,0 +1,351 @@
+/* ====================================================================================================================
+
+  The copyright in this software is being made available under the License included below.
+  This software may be subject to other third party and   contributor rights, including patent rights, and no such
+  rights are granted under this license.
+
+  Copyright (c) 2010, SAMSUNG ELECTRONICS CO., LTD. and BRITISH BROADCASTING CORPORATION
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, are permitted only for
+  the purpose of developing standards within the Joint Collaborative Team on Video Coding and for testing and
+  promoting such standards. The following conditions are required to be met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+      the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+      the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of SAMSUNG ELECTRONICS CO., LTD. nor the name of the BRITISH BROADCASTING CORPORATION
+      may be used to endorse or promote products derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ * ====================================================================================================================
+*/
+
+/** \file     TEncLookahead.cpp
+    \brief    encoder lookahead class
+*/
+
+#include <stdlib.h>
+#include "TEncLookahead.h"
+
+// ====================================================================================================================
+// Constructor / destructor / create / destroy
+// ====================================================================================================================
+
+TEncLookahead::TEncLookahead()
+{
+  m_pCurr = NULL;
+  m_pPrev = NULL;
+  m_piMvX = NULL;
+  m_piMvY = NULL;
+}
+
+TEncLookahead::~TEncLookahead()
+{
+}
+
+/**
+   \param iSourceWidth         width of the input pictures
+   \param iSourceHeight        height of the input pictures
+   \param iSceneCutThreshold   percentage, a picture is a scene cut if prediction from the previous picture saves less
+   \param iMotionGOPThreshold  mean motion vector length in samples which halves the GOP, 0 disables it
+ */
+Void TEncLookahead::create( Int iSourceWidth, Int iSourceHeight, Int iSceneCutThreshold, Int iMotionGOPThreshold )
+{
+  m_iWidth  = iSourceWidth  >> 1;
+  m_iHeight = iSourceHeight >> 1;
+
+  Int iNumBlk = ( ( m_iWidth + LOOKAHEAD_BLK_SIZE - 1 ) / LOOKAHEAD_BLK_SIZE ) * ( ( m_iHeight + LOOKAHEAD_BLK_SIZE - 1 ) / LOOKAHEAD_BLK_SIZE );
+
+  m_pCurr = (Pel*)xMalloc( Pel, m_iWidth * m_iHeight );
+  m_pPrev = (Pel*)xMalloc( Pel, m_iWidth * m_iHeight );
+  m_piMvX = (Int*)xMalloc( Int, iNumBlk );
+  m_piMvY = (Int*)xMalloc( Int, iNumBlk );
+
+  m_bHasPrev            = false;
+  m_iSceneCutThreshold  = iSceneCutThreshold;
+  m_iMotionGOPThreshold = iMotionGOPThreshold;
+
+  for ( Int i = 0; i < LOOKAHEAD_HISTORY; i++ )
+  {
+    m_acEntry[i].iPOC = -1;
+  }
+}
+
+Void TEncLookahead::destroy()
+{
+  if ( m_pCurr ) { xFree( m_pCurr ); m_pCurr = NULL; }
+  if ( m_pPrev ) { xFree( m_pPrev ); m_pPrev = NULL; }
+  if ( m_piMvX ) { xFree( m_piMvX ); m_piMvX = NULL; }
+  if ( m_piMvY ) { xFree( m_piMvY ); m_piMvY = NULL; }
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+/** The picture is compared with the picture of the previous call, pictures must be added in display order.
+    \param pcPicYuv   original picture
+    \param iPOC       POC of the picture
+ */
+Void TEncLookahead::addPicture( TComPicYuv* pcPicYuv, Int iPOC )
+{
+  Pel* pTmp = m_pPrev;
+  m_pPrev   = m_pCurr;
+  m_pCurr   = pTmp;
+
+  xDownsample( pcPicYuv );
+
+  Int     iNumBlkX     = ( m_iWidth  + LOOKAHEAD_BLK_SIZE - 1 ) / LOOKAHEAD_BLK_SIZE;
+  Int     iNumBlkY     = ( m_iHeight + LOOKAHEAD_BLK_SIZE - 1 ) / LOOKAHEAD_BLK_SIZE;
+  UInt64  uiIntraCost  = 0;
+  UInt64  uiInterCost  = 0;
+  UInt64  uiMotion     = 0;
+
+  for ( Int iBlkY = 0; iBlkY < iNumBlkY; iBlkY++ )
+  {
+    for ( Int iBlkX = 0; iBlkX < iNumBlkX; iBlkX++ )
+    {
+      Int  iIdx   = iBlkY * iNumBlkX + iBlkX;
+      UInt uiCost = xIntraCost( iBlkX, iBlkY );
+
+      uiIntraCost += uiCost;
+
+      if ( m_bHasPrev )
+      {
+        UInt uiInter = xInterCost( iBlkX, iBlkY, m_piMvX[iIdx], m_piMvY[iIdx] );
+        uiCost       = Min( uiCost, uiInter );
+        uiMotion    += abs( m_piMvX[iIdx] ) + abs( m_piMvY[iIdx] );
+      }
+      else
+      {
+        m_piMvX[iIdx] = m_piMvY[iIdx] = 0;
+      }
+      uiInterCost += uiCost;
+    }
+  }
+
+  Entry* pcEntry       = &m_acEntry[ iPOC % LOOKAHEAD_HISTORY ];
+  pcEntry->iPOC        = iPOC;
+  pcEntry->uiIntraCost = uiIntraCost;
+  pcEntry->uiInterCost = uiInterCost;
+  pcEntry->dMotion     = 2.0 * (Double)uiMotion / (Double)( iNumBlkX * iNumBlkY );
+  pcEntry->bSceneCut   = m_bHasPrev && m_iSceneCutThreshold > 0 && uiInterCost * 100 >= uiIntraCost * ( 100 - m_iSceneCutThreshold );
+
+  m_bHasPrev = true;
+}
+
+Bool TEncLookahead::isSceneCut( Int iPOC )
+{
+  Entry* pcEntry = xGetEntry( iPOC );
+  return pcEntry && pcEntry->bSceneCut;
+}
+
+/** The GOP is halved when the mean motion of its first half exceeds the threshold.
+    \param iPOCLast     POC of the last received picture
+    \param iNumPicRcvd  number of received pictures of the GOP
+    \param iGOPSize     configured GOP size
+    \returns GOP size to be used for the received pictures
+ */
+Int TEncLookahead::getGOPSize( Int iPOCLast, Int iNumPicRcvd, Int iGOPSize )
+{
+  if ( m_iMotionGOPThreshold <= 0 || iGOPSize < 2 || iNumPicRcvd != ( iGOPSize >> 1 ) )
+  {
+    return iGOPSize;
+  }
+
+  Double dMotion = 0;
+  for ( Int iPOC = iPOCLast - iNumPicRcvd + 1; iPOC <= iPOCLast; iPOC++ )
+  {
+    Entry* pcEntry = xGetEntry( iPOC );
+    dMotion += pcEntry ? pcEntry->dMotion : 0;
+  }
+
+  return dMotion >= (Double)( m_iMotionGOPThreshold * iNumPicRcvd ) ? ( iGOPSize >> 1 ) : iGOPSize;
+}
+
+Double TEncLookahead::getIntraComplexity( Int iPOC )
+{
+  Entry* pcEntry = xGetEntry( iPOC );
+  return pcEntry ? (Double)pcEntry->uiIntraCost / (Double)( 4 * m_iWidth * m_iHeight ) : 0;
+}
+
+Double TEncLookahead::getComplexity( Int iPOC )
+{
+  Entry* pcEntry = xGetEntry( iPOC );
+  return pcEntry ? (Double)pcEntry->uiInterCost / (Double)( 4 * m_iWidth * m_iHeight ) : 0;
+}
+
+// ====================================================================================================================
+// Protected member functions
+// ====================================================================================================================
+
+TEncLookahead::Entry* TEncLookahead::xGetEntry( Int iPOC )
+{
+  Entry* pcEntry = &m_acEntry[ iPOC % LOOKAHEAD_HISTORY ];
+  return pcEntry->iPOC == iPOC ? pcEntry : NULL;
+}
+
+/// 2x2 average of the luma samples
+Void TEncLookahead::xDownsample( TComPicYuv* pcPicYuv )
+{
+  Pel* pSrc    = pcPicYuv->getLumaAddr();
+  Int  iStride = pcPicYuv->getStride();
+  Pel* pDst    = m_pCurr;
+
+  for ( Int y = 0; y < m_iHeight; y++ )
+  {
+    for ( Int x = 0; x < m_iWidth; x++ )
+    {
+      pDst[x] = ( pSrc[2*x] + pSrc[2*x+1] + pSrc[2*x+iStride] + pSrc[2*x+1+iStride] + 2 ) >> 2;
+    }
+    pSrc += 2 * iStride;
+    pDst += m_iWidth;
+  }
+}
+
+/// minimum SAD of DC, horizontal and vertical prediction from the neighbouring samples of the block
+UInt TEncLookahead::xIntraCost( Int iBlkX, Int iBlkY )
+{
+  Int  iX      = iBlkX * LOOKAHEAD_BLK_SIZE;
+  Int  iY      = iBlkY * LOOKAHEAD_BLK_SIZE;
+  Int  iBlkW   = Min( LOOKAHEAD_BLK_SIZE, m_iWidth  - iX );
+  Int  iBlkH   = Min( LOOKAHEAD_BLK_SIZE, m_iHeight - iY );
+  Pel* pBlk    = m_pCurr + iY * m_iWidth + iX;
+  Pel* pAbove  = pBlk - m_iWidth;
+  Pel* pLeft   = pBlk - 1;
+  Bool bAbove  = iY > 0;
+  Bool bLeft   = iX > 0;
+  Int  x, y;
+
+  // DC from the available neighbours, the block mean if there are none
+  Int iSum = 0;
+  Int iNum = 0;
+  if ( bAbove ) { for ( x = 0; x < iBlkW; x++ ) iSum += pAbove[x];           iNum += iBlkW; }
+  if ( bLeft  ) { for ( y = 0; y < iBlkH; y++ ) iSum += pLeft[y * m_iWidth]; iNum += iBlkH; }
+  if ( iNum == 0 )
+  {
+    for ( y = 0; y < iBlkH; y++ )
+    {
+      for ( x = 0; x < iBlkW; x++ )
+      {
+        iSum += pBlk[y * m_iWidth + x];
+      }
+    }
+    iNum = iBlkW * iBlkH;
+  }
+  Int iDC = ( iSum + ( iNum >> 1 ) ) / iNum;
+
+  UInt uiDC  = 0;
+  UInt uiHor = 0;
+  UInt uiVer = 0;
+  for ( y = 0; y < iBlkH; y++ )
+  {
+    Pel* pRow = pBlk + y * m_iWidth;
+    for ( x = 0; x < iBlkW; x++ )
+    {
+      uiDC += abs( pRow[x] - iDC );
+      if ( bLeft  ) uiHor += abs( pRow[x] - pLeft[y * m_iWidth] );
+      if ( bAbove ) uiVer += abs( pRow[x] - pAbove[x] );
+    }
+  }
+
+  UInt uiCost = uiDC;
+  if ( bLeft  ) uiCost = Min( uiCost, uiHor );
+  if ( bAbove ) uiCost = Min( uiCost, uiVer );
+  return uiCost;
+}
+
+/** Block matching in the previous picture, starting from the best of the zero vector and the vectors of the left and
+    above blocks, refined by a small full search around the best position until it does not move.
+    \retval riMvX, riMvY  motion vector in half resolution samples
+ */
+UInt TEncLookahead::xInterCost( Int iBlkX, Int iBlkY, Int& riMvX, Int& riMvY )
+{
+  Int  iX       = iBlkX * LOOKAHEAD_BLK_SIZE;
+  Int  iY       = iBlkY * LOOKAHEAD_BLK_SIZE;
+  Int  iNumBlkX = ( m_iWidth + LOOKAHEAD_BLK_SIZE - 1 ) / LOOKAHEAD_BLK_SIZE;
+  Int  iIdx     = iBlkY * iNumBlkX + iBlkX;
+
+  Int  aiCandX[3] = { 0, 0, 0 };
+  Int  aiCandY[3] = { 0, 0, 0 };
+  Int  iNumCand   = 1;
+  if ( iBlkX > 0 ) { aiCandX[iNumCand] = m_piMvX[iIdx - 1];        aiCandY[iNumCand] = m_piMvY[iIdx - 1];        iNumCand++; }
+  if ( iBlkY > 0 ) { aiCandX[iNumCand] = m_piMvX[iIdx - iNumBlkX]; aiCandY[iNumCand] = m_piMvY[iIdx - iNumBlkX]; iNumCand++; }
+
+  Int  iBestX  = 0;
+  Int  iBestY  = 0;
+  UInt uiBest  = xBlockSAD( m_pPrev, iX, iY, 0, 0 );
+  for ( Int i = 1; i < iNumCand; i++ )
+  {
+    UInt uiSAD = xBlockSAD( m_pPrev, iX, iY, aiCandX[i], aiCandY[i] );
+    if ( uiSAD < uiBest )
+    {
+      uiBest = uiSAD;
+      iBestX = aiCandX[i];
+      iBestY = aiCandY[i];
+    }
+  }
+
+  for ( Int iIter = 0; iIter < LOOKAHEAD_SEARCH_ITER; iIter++ )
+  {
+    Int iCentX = iBestX;
+    Int iCentY = iBestY;
+    for ( Int iDY = -LOOKAHEAD_SEARCH_RANGE; iDY <= LOOKAHEAD_SEARCH_RANGE; iDY++ )
+    {
+      for ( Int iDX = -LOOKAHEAD_SEARCH_RANGE; iDX <= LOOKAHEAD_SEARCH_RANGE; iDX++ )
+      {
+        UInt uiSAD = xBlockSAD( m_pPrev, iX, iY, iCentX + iDX, iCentY + iDY );
+        if ( uiSAD < uiBest )
+        {
+          uiBest = uiSAD;
+          iBestX = iCentX + iDX;
+          iBestY = iCentY + iDY;
+        }
+      }
+    }
+    if ( iBestX == iCentX && iBestY == iCentY )
+    {
+      break;
+    }
+  }
+
+  riMvX = iBestX;
+  riMvY = iBestY;
+  return uiBest;
+}
+
+/// SAD of the block at (iX, iY) of the current picture, MAX_UINT if the displaced block leaves the reference picture
+UInt TEncLookahead::xBlockSAD( Pel* pRef, Int iX, Int iY, Int iMvX, Int iMvY )
+{
+  Int iBlkW = Min( LOOKAHEAD_BLK_SIZE, m_iWidth  - iX );
+  Int iBlkH = Min( LOOKAHEAD_BLK_SIZE, m_iHeight - iY );
+
+  if ( iX + iMvX < 0 || iY + iMvY < 0 || iX + iMvX + iBlkW > m_iWidth || iY + iMvY + iBlkH > m_iHeight )
+  {
+    return MAX_UINT;
+  }
+
+  Pel* pCur = m_pCurr + iY * m_iWidth + iX;
+  pRef     += ( iY + iMvY ) * m_iWidth + iX + iMvX;
+
+  UInt uiSAD = 0;
+  for ( Int y = 0; y < iBlkH; y++ )
+  {
+    for ( Int x = 0; x < iBlkW; x++ )
+    {
+      uiSAD += abs( pCur[x] - pRef[x] );
+    }
+    pCur += m_iWidth;
+    pRef += m_iWidth;
+  }
+  return uiSAD;
+}
@@ -0,0 +1,115 @@
+/* ====================================================================================================================
+
+  The copyright in this software is being made available under the License included below.
+  This software may be subject to other third party and   contributor rights, including patent rights, and no such
+  rights are granted under this license.
+
+  Copyright (c) 2010, SAMSUNG ELECTRONICS CO., LTD. and BRITISH BROADCASTING CORPORATION
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, are permitted only for
+  the purpose of developing standards within the Joint Collaborative Team on Video Coding and for testing and
+  promoting such standards. The following conditions are required to be met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+      the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+      the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of SAMSUNG ELECTRONICS CO., LTD. nor the name of the BRITISH BROADCASTING CORPORATION
+      may be used to endorse or promote products derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ * ====================================================================================================================
+*/
+
+/** \file     TEncLookahead.h
+    \brief    encoder lookahead class (header)
+*/
+
+#ifndef __TENCLOOKAHEAD__
+#define __TENCLOOKAHEAD__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include "../TLibCommon/CommonDef.h"
+#include "../TLibCommon/TComPicYuv.h"
+
+// ====================================================================================================================
+// Constants
+// ====================================================================================================================
+
+#define LOOKAHEAD_BLK_SIZE          8           ///< block size of the cost analysis in the half resolution picture
+#define LOOKAHEAD_SEARCH_RANGE      2           ///< refinement range around the best predictor, half resolution samples
+#define LOOKAHEAD_SEARCH_ITER       4           ///< max. number of refinement steps
+#define LOOKAHEAD_HISTORY           ( 2 * MAX_GOP ) ///< number of analysed pictures kept, must cover one GOP
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// encoder lookahead class, cheap half resolution intra/inter cost analysis of the input pictures
+/** Every input picture is analysed when it is received by the encoder, i.e. over the pictures of the GOP which is
+    buffered before coding. The intra cost is the SAD of a DC/horizontal/vertical prediction from the neighbouring
+    original samples, the inter cost the SAD of a small block matching search in the previous input picture.
+ */
+class TEncLookahead
+{
+private:
+  /// analysis result of one picture
+  struct Entry
+  {
+    Int     iPOC;
+    UInt64  uiIntraCost;                      ///< sum of block intra costs
+    UInt64  uiInterCost;                      ///< sum of block costs, minimum of intra and inter cost
+    Double  dMotion;                          ///< mean motion vector length in full resolution samples
+    Bool    bSceneCut;
+  };
+
+  Int       m_iWidth;                         ///< half resolution picture width
+  Int       m_iHeight;                        ///< half resolution picture height
+  Pel*      m_pCurr;                          ///< half resolution luma of the current picture
+  Pel*      m_pPrev;                          ///< half resolution luma of the previous picture
+  Int*      m_piMvX;                          ///< block motion vectors of the current picture, used as predictors
+  Int*      m_piMvY;
+  Bool      m_bHasPrev;
+
+  Int       m_iSceneCutThreshold;             ///< percentage by which the inter cost must fall below the intra cost
+  Int       m_iMotionGOPThreshold;            ///< mean motion, in full resolution samples, which halves the GOP
+
+  Entry     m_acEntry[LOOKAHEAD_HISTORY];
+
+  Void    xDownsample   ( TComPicYuv* pcPicYuv );
+  UInt    xIntraCost    ( Int iBlkX, Int iBlkY );
+  UInt    xInterCost    ( Int iBlkX, Int iBlkY, Int& riMvX, Int& riMvY );
+  UInt    xBlockSAD     ( Pel* pRef, Int iX, Int iY, Int iMvX, Int iMvY );
+
+  Entry*  xGetEntry     ( Int iPOC );
+
+public:
+  TEncLookahead();
+  virtual ~TEncLookahead();
+
+  Void    create        ( Int iSourceWidth, Int iSourceHeight, Int iSceneCutThreshold, Int iMotionGOPThreshold );
+  Void    destroy       ();
+
+  Void    addPicture    ( TComPicYuv* pcPicYuv, Int iPOC );                 ///< analyse an input picture
+
+  Bool    isSceneCut    ( Int iPOC );
+  Int     getGOPSize    ( Int iPOCLast, Int iNumPicRcvd, Int iGOPSize );    ///< GOP size for the received pictures
+
+  /// intra cost per full resolution sample
+  Double  getIntraComplexity  ( Int iPOC );
+  /// cost per full resolution sample of the best prediction, equal to the intra complexity for the first picture
+  Double  getComplexity       ( Int iPOC );
+};
+
+#endif // __TENCLOOKAHEAD__
@@ -0,0 +1,337 @@
+/* ====================================================================================================================
+
+  The copyright in this software is being made available under the License included below.
+  This software may be subject to other third party and   contributor rights, including patent rights, and no such
+  rights are granted under this license.
+
+  Copyright (c) 2010, SAMSUNG ELECTRONICS CO., LTD. and BRITISH BROADCASTING CORPORATION
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, are permitted only for
+  the purpose of developing standards within the Joint Collaborative Team on Video Coding and for testing and
+  promoting such standards. The following conditions are required to be met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+      the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+      the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of SAMSUNG ELECTRONICS CO., LTD. nor the name of the BRITISH BROADCASTING CORPORATION
+      may be used to endorse or promote products derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ * ====================================================================================================================
+*/
+
+/** \file     TEncRateCtrl.cpp
+    \brief    rate control class
+*/
+
+#include <math.h>
+#include "TEncRateCtrl.h"
+
+// ====================================================================================================================
+// Tables
+// ====================================================================================================================
+
+/// bit allocation weight per level, intra pictures first, then the temporal layers
+static const Double s_adLevelWeight[RC_NUM_LEVEL] = { 24.0, 8.0, 4.0, 2.0, 1.0 };
+
+// ====================================================================================================================
+// Constructor / destructor / create / destroy
+// ====================================================================================================================
+
+TEncRateCtrl::TEncRateCtrl()
+{
+  m_pdLCUAlpha  = NULL;
+  m_pdLCUBeta   = NULL;
+  m_pdLCUWeight = NULL;
+}
+
+TEncRateCtrl::~TEncRateCtrl()
+{
+}
+
+/**
+   \param iTargetBitrate   target bitrate in bits per second
+   \param iFrameRate       frame rate
+   \param iVBVBufferSize   VBV buffer size in bits, 0 if unconstrained
+   \param bLCULevel        LCU level lambda and QP adaptation
+   \param iWidth           picture width
+   \param iHeight          picture height
+   \param iLCUWidth        LCU width
+   \param iLCUHeight       LCU height
+ */
+Void TEncRateCtrl::create( Int iTargetBitrate, Int iFrameRate, Int iVBVBufferSize, Bool bLCULevel, Int iWidth, Int iHeight, Int iLCUWidth, Int iLCUHeight )
+{
+  m_iPicWidth   = iWidth;
+  m_iPicHeight  = iHeight;
+  m_iLCUWidth   = iLCUWidth;
+  m_iLCUHeight  = iLCUHeight;
+  m_iNumPixels  = iWidth * iHeight;
+  m_iNumLCU     = ( ( iWidth + iLCUWidth - 1 ) / iLCUWidth ) * ( ( iHeight + iLCUHeight - 1 ) / iLCUHeight );
+  m_dBitsPerPic = (Double)iTargetBitrate / (Double)iFrameRate;
+  m_iBitsCoded  = 0;
+  m_iPicsCoded  = 0;
+
+  m_iVBVSize      = iVBVBufferSize;
+  m_iVBVFullness  = 0;
+  m_iVBVOverflows = 0;
+
+  m_dGOPBitsLeft = 0;
+  for ( Int i = 0; i < RC_NUM_LEVEL; i++ )
+  {
+    m_aiGOPPicsLeft[i] = 0;
+    m_adAlpha      [i] = RC_ALPHA_INIT;
+    m_adBeta       [i] = RC_BETA_INIT;
+    m_adLastLambda [i] = 0;
+    m_adComplexity [i] = 0;
+  }
+
+  m_bLCULevel = bLCULevel;
+  if ( m_bLCULevel )
+  {
+    m_pdLCUAlpha  = new Double[ RC_NUM_LEVEL * m_iNumLCU ];
+    m_pdLCUBeta   = new Double[ RC_NUM_LEVEL * m_iNumLCU ];
+    m_pdLCUWeight = new Double[ m_iNumLCU ];
+
+    for ( Int i = 0; i < RC_NUM_LEVEL * m_iNumLCU; i++ )
+    {
+      m_pdLCUAlpha[i] = RC_ALPHA_INIT;
+      m_pdLCUBeta [i] = RC_BETA_INIT;
+    }
+  }
+}
+
+Void TEncRateCtrl::destroy()
+{
+  delete [] m_pdLCUAlpha;   m_pdLCUAlpha  = NULL;
+  delete [] m_pdLCUBeta;    m_pdLCUBeta   = NULL;
+  delete [] m_pdLCUWeight;  m_pdLCUWeight = NULL;
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+/** The pictures per temporal layer are counted with the loop structure of TEncGOP::compressGOP().
+    \param iNumPic        number of pictures of the GOP
+    \param iGOPSize       GOP size of the hierarchical structure
+    \param bHierarchical  hierarchical coding
+ */
+Void TEncRateCtrl::initGOP( Int iNumPic, Int iGOPSize, Bool bHierarchical )
+{
+  Int iHrchDepth = 1;
+  while ( ( iGOPSize >> iHrchDepth ) != 0 )
+  {
+    iHrchDepth++;
+  }
+
+  for ( Int i = 0; i < RC_NUM_LEVEL; i++ )
+  {
+    m_aiGOPPicsLeft[i] = 0;
+  }
+
+  for ( Int iDepth = 0; iDepth < iHrchDepth; iDepth++ )
+  {
+    Int iTimeOffset = ( 1 << ( iHrchDepth - 1 - iDepth ) );
+    Int iStep       = iTimeOffset << 1;
+
+    if ( !bHierarchical && iDepth != 0 )
+    {
+      iTimeOffset = 1;
+      iStep       = 1;
+    }
+
+    for ( ; iTimeOffset <= iNumPic; iTimeOffset += iStep )
+    {
+      if ( !bHierarchical && iDepth != 0 && iTimeOffset == iGOPSize )
+      {
+        continue;
+      }
+      m_aiGOPPicsLeft[ 1 + Min( iDepth, MAX_TLAYER - 1 ) ]++;
+    }
+
+    if ( !bHierarchical && iDepth != 0 )
+    {
+      break;
+    }
+  }
+
+  // a deviation from the target is compensated over the smoothing window
+  Double dDeviation = (Double)m_iBitsCoded - m_dBitsPerPic * (Double)m_iPicsCoded;
+  m_dGOPBitsLeft    = (Double)iNumPic * ( m_dBitsPerPic - dDeviation / RC_SMOOTH_WINDOW );
+  m_dGOPBitsLeft    = Max( m_dGOPBitsLeft, 0.1 * m_dBitsPerPic * iNumPic );
+}
+
+/**
+   \param iDepth       temporal layer of the picture
+   \param bIntra       intra picture
+   \param dComplexity  lookahead complexity of the picture, 0 if not available
+ */
+Void TEncRateCtrl::initPicture( Int iDepth, Bool bIntra, Double dComplexity )
+{
+  Int iLayerLevel = 1 + Min( iDepth, MAX_TLAYER - 1 );
+  m_iPicLevel     = bIntra ? 0 : iLayerLevel;
+
+  // share of the remaining GOP bits
+  Double dWeightLeft = 0;
+  for ( Int i = 1; i < RC_NUM_LEVEL; i++ )
+  {
+    dWeightLeft += m_aiGOPPicsLeft[i] * s_adLevelWeight[i];
+  }
+  if ( m_aiGOPPicsLeft[iLayerLevel] > 0 )
+  {
+    dWeightLeft -= s_adLevelWeight[iLayerLevel];
+    m_aiGOPPicsLeft[iLayerLevel]--;
+  }
+  dWeightLeft += s_adLevelWeight[m_iPicLevel];
+
+  m_dPicTargetBits = m_dGOPBitsLeft * s_adLevelWeight[m_iPicLevel] / dWeightLeft;
+  if ( bIntra )
+  {
+    m_dPicTargetBits = Max( m_dPicTargetBits, m_dBitsPerPic * s_adLevelWeight[0] / s_adLevelWeight[1] );
+  }
+
+  // pictures which are more complex than the previous ones of their level get more bits
+  if ( dComplexity > 0 )
+  {
+    if ( m_adComplexity[m_iPicLevel] > 0 )
+    {
+      m_dPicTargetBits           *= Clip3( 0.67, 1.5, dComplexity / m_adComplexity[m_iPicLevel] );
+      m_adComplexity[m_iPicLevel] = 0.75 * m_adComplexity[m_iPicLevel] + 0.25 * dComplexity;
+    }
+    else
+    {
+      m_adComplexity[m_iPicLevel] = dComplexity;
+    }
+  }
+
+  // the buffer must not overflow with the picture
+  if ( m_iVBVSize > 0 )
+  {
+    m_dPicTargetBits = Min( m_dPicTargetBits, 0.9 * m_iVBVSize - m_iVBVFullness + m_dBitsPerPic );
+  }
+
+  Double dBpp = Max( m_dPicTargetBits / m_iNumPixels, RC_MIN_BPP );
+  m_dPicLambda = m_adAlpha[m_iPicLevel] * pow( dBpp, m_adBeta[m_iPicLevel] );
+
+  Double dLastLambda = m_adLastLambda[m_iPicLevel];
+  if ( dLastLambda > 0 )
+  {
+    m_dPicLambda = Clip3( dLastLambda / RC_PIC_LAMBDA_RANGE, dLastLambda * RC_PIC_LAMBDA_RANGE, m_dPicLambda );
+  }
+  m_iPicQP = xLambdaToQP( m_dPicLambda );
+
+  if ( m_bLCULevel )
+  {
+    Double* pdAlpha = m_pdLCUAlpha + m_iPicLevel * m_iNumLCU;
+    Double* pdBeta  = m_pdLCUBeta  + m_iPicLevel * m_iNumLCU;
+
+    m_dLCUWeightLeft = 0;
+    for ( Int i = 0; i < m_iNumLCU; i++ )
+    {
+      m_pdLCUWeight[i]  = xGetLCUPixels( i ) * pow( m_dPicLambda / pdAlpha[i], 1.0 / pdBeta[i] );
+      m_dLCUWeightLeft += m_pdLCUWeight[i];
+    }
+    m_dLCUBitsLeft   = m_dPicTargetBits;
+    m_dLastLCULambda = m_dPicLambda;
+    m_iLastLCUQP     = m_iPicQP;
+  }
+}
+
+/** \param iBits  coded bits of the picture
+ */
+Void TEncRateCtrl::updatePicture( Int iBits )
+{
+  m_iBitsCoded   += iBits;
+  m_iPicsCoded   ++;
+  m_dGOPBitsLeft -= iBits;
+
+  xUpdateModel( m_adAlpha[m_iPicLevel], m_adBeta[m_iPicLevel], m_dPicLambda, iBits, m_iNumPixels );
+  m_adLastLambda[m_iPicLevel] = m_dPicLambda;
+
+  m_iVBVFullness = Max( (Int64)0, m_iVBVFullness + iBits - (Int64)m_dBitsPerPic );
+  if ( m_iVBVSize > 0 && m_iVBVFullness > m_iVBVSize )
+  {
+    m_iVBVOverflows++;
+  }
+}
+
+/** \param iLCUAddr  LCU address in raster order
+ */
+Void TEncRateCtrl::initLCU( Int iLCUAddr )
+{
+  Int    iIdx    = m_iPicLevel * m_iNumLCU + iLCUAddr;
+  Double dTarget = m_dLCUWeightLeft > 0 ? m_dLCUBitsLeft * m_pdLCUWeight[iLCUAddr] / m_dLCUWeightLeft : 0;
+  Double dBpp    = Max( dTarget / xGetLCUPixels( iLCUAddr ), RC_MIN_BPP );
+
+  m_iLCUAddr   = iLCUAddr;
+  m_dLCULambda = m_pdLCUAlpha[iIdx] * pow( dBpp, m_pdLCUBeta[iIdx] );
+  m_dLCULambda = Clip3( m_dPicLambda     / RC_LCU_LAMBDA_RANGE, m_dPicLambda     * RC_LCU_LAMBDA_RANGE, m_dLCULambda );
+  m_dLCULambda = Clip3( m_dLastLCULambda / RC_LCU_LAMBDA_STEP,  m_dLastLCULambda * RC_LCU_LAMBDA_STEP,  m_dLCULambda );
+
+  m_iLCUQP = xLambdaToQP( m_dLCULambda );
+  m_iLCUQP = Clip3( m_iPicQP - RC_LCU_MAX_DQP, m_iPicQP + RC_LCU_MAX_DQP, m_iLCUQP );
+  m_iLCUQP = Clip3( m_iLastLCUQP - 1, m_iLastLCUQP + 1, m_iLCUQP );
+  m_iLCUQP = Clip3( MIN_QP, MAX_QP, m_iLCUQP );
+}
+
+/** \param iBits  estimated bits of the LCU from the mode decision
+ */
+Void TEncRateCtrl::updateLCU( Int iBits )
+{
+  Int iIdx = m_iPicLevel * m_iNumLCU + m_iLCUAddr;
+
+  m_dLCUBitsLeft   -= iBits;
+  m_dLCUWeightLeft -= m_pdLCUWeight[m_iLCUAddr];
+
+  xUpdateModel( m_pdLCUAlpha[iIdx], m_pdLCUBeta[iIdx], m_dLCULambda, iBits, xGetLCUPixels( m_iLCUAddr ) );
+
+  m_dLastLCULambda = m_dLCULambda;
+  m_iLastLCUQP     = m_iLCUQP;
+}
+
+// ====================================================================================================================
+// Protected member functions
+// ====================================================================================================================
+
+Int TEncRateCtrl::xGetLCUPixels( Int iLCUAddr )
+{
+  Int iNumLCUX = ( m_iPicWidth + m_iLCUWidth - 1 ) / m_iLCUWidth;
+  Int iX       = ( iLCUAddr % iNumLCUX ) * m_iLCUWidth;
+  Int iY       = ( iLCUAddr / iNumLCUX ) * m_iLCUHeight;
+
+  return Min( m_iLCUWidth, m_iPicWidth - iX ) * Min( m_iLCUHeight, m_iPicHeight - iY );
+}
+
+Int TEncRateCtrl::xLambdaToQP( Double dLambda )
+{
+  Int iQP = (Int)floor( 4.2005 * log( dLambda ) + 13.7122 + 0.5 );
+  return Clip3( MIN_QP, MAX_QP, iQP );
+}
+
+/** The model is moved towards the lambda it would have needed for the coded bits.
+    \param rdAlpha, rdBeta  R-lambda model
+    \param dLambda          lambda used for coding
+    \param dBits            coded bits
+    \param iNumPixels       number of coded pixels
+ */
+Void TEncRateCtrl::xUpdateModel( Double& rdAlpha, Double& rdBeta, Double dLambda, Double dBits, Int iNumPixels )
+{
+  Double dBpp        = Max( dBits / iNumPixels, RC_MIN_BPP );
+  Double dLambdaComp = rdAlpha * pow( dBpp, rdBeta );
+  Double dDiff       = log( dLambda ) - log( dLambdaComp );
+
+  rdAlpha += RC_ALPHA_RATE * dDiff * rdAlpha;
+  rdBeta  += RC_BETA_RATE  * dDiff * Clip3( -5.0, -0.1, log( dBpp ) );
+
+  rdAlpha  = Clip3( 0.05, 20.0, rdAlpha );
+  rdBeta   = Clip3( -3.0, -0.1, rdBeta  );
+}
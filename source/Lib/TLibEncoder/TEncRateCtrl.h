@@ -0,0 +1,150 @@
+/* ====================================================================================================================
+
+  The copyright in this software is being made available under the License included below.
+  This software may be subject to other third party and   contributor rights, including patent rights, and no such
+  rights are granted under this license.
+
+  Copyright (c) 2010, SAMSUNG ELECTRONICS CO., LTD. and BRITISH BROADCASTING CORPORATION
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, are permitted only for
+  the purpose of developing standards within the Joint Collaborative Team on Video Coding and for testing and
+  promoting such standards. The following conditions are required to be met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+      the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+      the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of SAMSUNG ELECTRONICS CO., LTD. nor the name of the BRITISH BROADCASTING CORPORATION
+      may be used to endorse or promote products derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ * ====================================================================================================================
+*/
+
+/** \file     TEncRateCtrl.h
+    \brief    rate control class (header)
+*/
+
+#ifndef __TENCRATECTRL__
+#define __TENCRATECTRL__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include "../TLibCommon/CommonDef.h"
+
+// ====================================================================================================================
+// Constants
+// ====================================================================================================================
+
+#define RC_NUM_LEVEL                ( MAX_TLAYER + 1 )  ///< number of R-lambda models, intra and one per temporal layer
+#define RC_SMOOTH_WINDOW            40          ///< number of pictures over which a bit deviation is compensated
+#define RC_MIN_BPP                  0.0001      ///< lower bound of the target bits per pixel
+#define RC_ALPHA_INIT               3.2003      ///< initial R-lambda model, lambda = alpha * bpp^beta
+#define RC_BETA_INIT                -1.367
+#define RC_ALPHA_RATE               0.1         ///< model update step sizes
+#define RC_BETA_RATE                0.05
+#define RC_PIC_LAMBDA_RANGE         2.5198      ///< 2^(4/3), max. lambda change to the previous picture of the same level
+#define RC_LCU_LAMBDA_RANGE         1.5874      ///< 2^(2/3), max. LCU lambda change to the picture lambda
+#define RC_LCU_LAMBDA_STEP          1.2599      ///< 2^(1/3), max. lambda change to the previous LCU
+#define RC_LCU_MAX_DQP              2           ///< max. LCU QP change to the picture QP
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// rate control class, GOP, picture and LCU bit allocation with R-lambda models
+/** The GOP target follows the target bitrate, a deviation of the coded bits is compensated over RC_SMOOTH_WINDOW
+    pictures. Pictures get a share of the remaining GOP bits by the weight of their temporal layer, clipped by the
+    VBV buffer. Lambda is derived from the target bits per pixel with one model per temporal layer, LCUs get a share
+    of the remaining picture bits by the bits their own models predict at the picture lambda.
+ */
+class TEncRateCtrl
+{
+private:
+  // sequence
+  Int       m_iNumPixels;
+  Int       m_iNumLCU;
+  Double    m_dBitsPerPic;                    ///< average target bits per picture
+  Int64     m_iBitsCoded;                     ///< bits of the coded pictures
+  Int64     m_iPicsCoded;                     ///< number of coded pictures
+
+  // VBV buffer
+  Int64     m_iVBVSize;                       ///< buffer size in bits, 0 if unconstrained
+  Int64     m_iVBVFullness;                   ///< buffer fullness after the last picture
+  Int       m_iVBVOverflows;                  ///< number of pictures which exceeded the buffer
+
+  // GOP
+  Double    m_dGOPBitsLeft;
+  Int       m_aiGOPPicsLeft[RC_NUM_LEVEL];    ///< remaining pictures of the GOP per level
+
+  // picture
+  Double    m_adAlpha     [RC_NUM_LEVEL];
+  Double    m_adBeta      [RC_NUM_LEVEL];
+  Double    m_adLastLambda[RC_NUM_LEVEL];     ///< lambda of the last picture per level, 0 if none
+  Double    m_adComplexity[RC_NUM_LEVEL];     ///< running mean of the lookahead complexity per level
+  Int       m_iPicLevel;
+  Double    m_dPicTargetBits;
+  Double    m_dPicLambda;
+  Int       m_iPicQP;
+
+  // LCU
+  Bool      m_bLCULevel;
+  Int       m_iPicWidth;
+  Int       m_iPicHeight;
+  Int       m_iLCUWidth;
+  Int       m_iLCUHeight;
+  Double*   m_pdLCUAlpha;                     ///< LCU models, RC_NUM_LEVEL * m_iNumLCU
+  Double*   m_pdLCUBeta;
+  Double*   m_pdLCUWeight;                    ///< bits of the LCUs predicted at the picture lambda
+  Double    m_dLCUBitsLeft;
+  Double    m_dLCUWeightLeft;
+  Double    m_dLCULambda;
+  Double    m_dLastLCULambda;
+  Int       m_iLCUQP;
+  Int       m_iLastLCUQP;
+  Int       m_iLCUAddr;
+
+  Int       xGetLCUPixels ( Int iLCUAddr );
+  Double    xGetLevelWeight ( Int iLevel );
+
+  static Int  xLambdaToQP   ( Double dLambda );
+  static Void xUpdateModel  ( Double& rdAlpha, Double& rdBeta, Double dLambda, Double dBits, Int iNumPixels );
+
+public:
+  TEncRateCtrl();
+  virtual ~TEncRateCtrl();
+
+  Void    create        ( Int iTargetBitrate, Int iFrameRate, Int iVBVBufferSize, Bool bLCULevel,
+                          Int iWidth, Int iHeight, Int iLCUWidth, Int iLCUHeight );
+  Void    destroy       ();
+
+  /// GOP of iNumPic pictures with the hierarchical structure of iGOPSize
+  Void    initGOP       ( Int iNumPic, Int iGOPSize, Bool bHierarchical );
+  /// picture target, lambda and QP, dComplexity is the lookahead complexity or 0
+  Void    initPicture   ( Int iDepth, Bool bIntra, Double dComplexity );
+  Void    updatePicture ( Int iBits );
+
+  Void    initLCU       ( Int iLCUAddr );
+  Void    updateLCU     ( Int iBits );
+
+  Double  getPicLambda  ()    { return m_dPicLambda;      }
+  Int     getPicQP      ()    { return m_iPicQP;          }
+  Double  getPicTarget  ()    { return m_dPicTargetBits;  }
+  Double  getLCULambda  ()    { return m_dLCULambda;      }
+  Int     getLCUQP      ()    { return m_iLCUQP;          }
+  Bool    getLCULevel   ()    { return m_bLCULevel;       }
+  Int64   getVBVFullness()    { return m_iVBVFullness;    }
+  Int     getVBVOverflows()   { return m_iVBVOverflows;   }
+};
+
+#endif // __TENCRATECTRL__
@@ -59,9 +59,18 @@ TEncSIFO::TEncSIFO()
 {
   SIFO_FILTER           = NULL;
   AccErrorP             = NULL;                    // [Filter][Sppos]
+  AccErrorB             = NULL;                    // [FilterF][FilterB][SpposF][SpposB]
   SequenceAccErrorP     = NULL;                    // [Filter][Sppos]
   SequenceAccErrorB     = NULL;                    // [FilterF][FilterB][SpposF][SpposB]
   SIFO_FILTER           = NULL;                    // [num_SIFO][16 subpels][SQR_FILTER]
+  m_bFirstInit          = true;
+  m_bFirstP             = true;
+  m_bFirstB             = true;
+  m_piTapPos2D          = NULL;
+  m_piTapCoef2D         = NULL;
+  m_piSumH              = NULL;
+  m_apiIntBlk[0]        = NULL;
+  m_apiIntBlk[1]        = NULL;
 #if FIX_TICKET67==1
   m_pcPredSearch        = NULL;
 #if USE_DIAGONAL_FILT==1
@@ -81,9 +90,15 @@ Void TEncSIFO::destroy()
   {
     UInt num_SIFO = m_pcPredSearch->getNum_SIFOFilters();
     if(AccErrorP)         { xFree_mem2Ddouble(AccErrorP);                             AccErrorP         = NULL; }
+    if(AccErrorB)         { xFree_mem4Ddouble(AccErrorB, num_SIFO, num_SIFO);         AccErrorB         = NULL; }
     if(SequenceAccErrorP) { xFree_mem2Ddouble(SequenceAccErrorP);                     SequenceAccErrorP = NULL; }
     if(SequenceAccErrorB) { xFree_mem4Ddouble(SequenceAccErrorB, num_SIFO, num_SIFO); SequenceAccErrorB = NULL; }
     if (SIFO_FILTER)      { xFree_mem3Ddouble(SIFO_FILTER, num_SIFO);                 SIFO_FILTER       = NULL; }
+    if (m_piTapPos2D)     { delete [] m_piTapPos2D;                                   m_piTapPos2D      = NULL; }
+    if (m_piTapCoef2D)    { delete [] m_piTapCoef2D;                                  m_piTapCoef2D     = NULL; }
+    if (m_piSumH)         { delete [] m_piSumH;                                       m_piSumH          = NULL; }
+    if (m_apiIntBlk[0])   { delete [] m_apiIntBlk[0];                                 m_apiIntBlk[0]    = NULL; }
+    if (m_apiIntBlk[1])   { delete [] m_apiIntBlk[1];                                 m_apiIntBlk[1]    = NULL; }
 #if USE_DIAGONAL_FILT==1
 #if SIFO_DIF_COMPATIBILITY==1
     UInt numFilters = m_pcPredSearch->getNum_AvailableFilters();
@@ -146,16 +161,15 @@ Void TEncSIFO::initEncSIFO(TComSlice*& rpcSlice )
 
 Void TEncSIFO::initSIFOFilters(Int Tap)
 {
-  static Int first = 1;
   UInt num_SIFO = m_pcPredSearch->getNum_SIFOFilters();
 
-  if(first == 1)
+  if(m_bFirstInit)
   {  
     Int i;
     Int filterLength =  Tap;  
     Int sqrFiltLength = filterLength*filterLength;
 
-    first = 0;
+    m_bFirstInit = false;
     xGet_mem3Ddouble(&SIFO_FILTER, num_SIFO, 16, sqrFiltLength);
     for (i=0; i<16; i++)
     {
@@ -165,10 +179,97 @@ Void TEncSIFO::initSIFOFilters(Int Tap)
     initSeparableFilter(Tap);
 #if USE_DIAGONAL_FILT==1
     xInitDiagonalFilter(Tap);
+#endif
+#if !BUGFIX50TMP
+    xInitFilterTaps(Tap);
 #endif
   }
 }
 
+#if !BUGFIX50TMP
+/** splits each SIFO filter into integer taps for the block interpolation of the statistics;
+ *  a separable filter is stored as a vertical and a horizontal factor, the horizontal factors are shared
+ *  between the filters of a sub-pel position, any other filter is stored as a list of its non-zero taps
+ */
+Void TEncSIFO::xInitFilterTaps(Int Tap)
+{
+  UInt num_SIFO = m_pcPredSearch->getNum_SIFOFilters();
+  Int  sqrFiltLength = Tap*Tap;
+  Double coeffQP = (Double)COEFF_QP;
+  Int  aiTapV[SIFO_MAX_TAP], aiTapH[SIFO_MAX_TAP];
+  Int  sub_pos, filterNo, k, l, i;
+
+  assert( num_SIFO <= SIFO_MAX_FILTERS && Tap <= SIFO_MAX_TAP );
+
+  m_piTapPos2D  = new Int[ num_SIFO * 16 * sqrFiltLength ];
+  m_piTapCoef2D = new Int[ num_SIFO * 16 * sqrFiltLength ];
+
+  for (sub_pos=0; sub_pos<16; sub_pos++)
+  {
+    m_aiNumFiltH[sub_pos] = 0;
+    for (filterNo=0; filterNo<num_SIFO; filterNo++)
+    {
+      Double* pdFilter = SIFO_FILTER[filterNo][sub_pos];
+      Bool    bSeparable = true;
+
+      // both factors of a separable filter sum to one, so they are the row and the column sums
+      for (k=0; k<Tap; k++)
+      {
+        Double dSumV = 0, dSumH = 0;
+        for (l=0; l<Tap; l++)
+        {
+          dSumV += pdFilter[k*Tap+l];
+          dSumH += pdFilter[l*Tap+k];
+        }
+        aiTapV[k] = (Int)floor( dSumV*coeffQP + 0.5 );
+        aiTapH[k] = (Int)floor( dSumH*coeffQP + 0.5 );
+        bSeparable = bSeparable && aiTapV[k] == dSumV*coeffQP && aiTapH[k] == dSumH*coeffQP;
+      }
+      for (k=0; k<Tap && bSeparable; k++)
+      {
+        for (l=0; l<Tap; l++)
+        {
+          bSeparable = bSeparable && (Double)(aiTapV[k]*aiTapH[l]) == pdFilter[k*Tap+l]*coeffQP*coeffQP;
+        }
+      }
+
+      m_aiFiltIdxH  [filterNo][sub_pos] = -1;
+      m_aiNumTap2D  [filterNo][sub_pos] = 0;
+      if (bSeparable)
+      {
+        for (i=0; i<m_aiNumFiltH[sub_pos]; i++)
+        {
+          if (memcmp(m_aiFiltTapH[sub_pos][i], aiTapH, Tap*sizeof(Int)) == 0)
+            break;
+        }
+        if (i == m_aiNumFiltH[sub_pos])
+        {
+          memcpy(m_aiFiltTapH[sub_pos][i], aiTapH, Tap*sizeof(Int));
+          m_aiNumFiltH[sub_pos]++;
+        }
+        m_aiFiltIdxH[filterNo][sub_pos] = i;
+        memcpy(m_aiFiltTapV[filterNo][sub_pos], aiTapV, Tap*sizeof(Int));
+      }
+      else
+      {
+        Int* piPos  = m_piTapPos2D  + (filterNo*16 + sub_pos)*sqrFiltLength;
+        Int* piCoef = m_piTapCoef2D + (filterNo*16 + sub_pos)*sqrFiltLength;
+        for (i=0; i<sqrFiltLength; i++)
+        {
+          if (pdFilter[i] != 0)
+          {
+            piPos [m_aiNumTap2D[filterNo][sub_pos]] = i;
+            piCoef[m_aiNumTap2D[filterNo][sub_pos]] = (Int)floor( pdFilter[i]*coeffQP*coeffQP + 0.5 );
+            assert( piCoef[m_aiNumTap2D[filterNo][sub_pos]] == pdFilter[i]*coeffQP*coeffQP );
+            m_aiNumTap2D[filterNo][sub_pos]++;
+          }
+        }
+      }
+    }
+  }
+}
+#endif
+
 Void TEncSIFO::initSeparableFilter(Int Tap)
 {
   Int filterLength = Tap;
@@ -341,9 +442,9 @@ Void TEncSIFO::ComputeFiltersAndOffsets( TComPic*& rpcPic)
   xResetAll(pcSlice);
   xResetOffsets(pcSlice);
 
+  // squared errors of the current frame were accumulated CU by CU during compressSlice
   if(pcSlice->getSliceType() == P_SLICE)
   {
-    xAccumulateError_P(rpcPic);       // Accumulate squared error for filter decision
 #ifdef QC_SIFO_PRED
     if (m_pcPredSearch->getPredictFilterP() > 0 && pcSlice->getSPS()->getUseSIFO_Pred()) 
 #else
@@ -361,7 +462,34 @@ Void TEncSIFO::ComputeFiltersAndOffsets( TComPic*& rpcPic)
   }
   else if(pcSlice->getSliceType() == B_SLICE)
   {
-    xAccumulateError_B(rpcPic);       // Accumulate squared error for frame and sequence
+    UInt num_SIFO = m_pcPredSearch->getNum_SIFOFilters();
+    for(Int a = 0; a < num_SIFO; ++a)
+      for(Int b = 0; b < num_SIFO; ++b)
+        for(Int c = 0; c < 16; ++c)
+          for(Int d = 0; d < 16; ++d)
+            SequenceAccErrorB[a][b][c][d] += AccErrorB[a][b][c][d];
+#if SIFO_DIF_COMPATIBILITY==1
+    if(pcSlice->getSPS()->getDIFTap()==6)
+    {
+      UInt num_AVALABLE_FILTERS = m_pcPredSearch->getNum_AvailableFilters();
+      UInt uiMax, uiSubPosIndx1, uiSubPosIndx2, uiHFPic;
+      uiMax = -1;
+      uiHFPic = xCheckHFPic(rpcPic);
+      if(uiHFPic == 1)
+      {
+        for(Int f = 0; f < num_AVALABLE_FILTERS; ++f)
+        {
+          for(uiSubPosIndx1=1; uiSubPosIndx1<16;uiSubPosIndx1++)
+          {
+            for(uiSubPosIndx2=1; uiSubPosIndx2<16;uiSubPosIndx2++)
+            {
+              SequenceAccErrorB[num_AVALABLE_FILTERS+f][num_AVALABLE_FILTERS+f][uiSubPosIndx1][uiSubPosIndx2] = uiMax;
+            }
+          }
+        }
+      }
+    }
+#endif
     xComputeFilterCombination_B_gd(SequenceAccErrorB, SequenceBestCombFilterB);
     // Compute best single sequence filter
 #ifdef QC_SIFO_PRED
@@ -704,6 +832,61 @@ Void TEncSIFO::xFree_mem4Ddouble(Double ****array4D, Int idx, Int frames)
 }
 #endif
 
+/** clears the frame statistics; called before each compressSlice pass, so that only the last pass is kept
+ * \param pcSlice current slice
+ */
+Void TEncSIFO::initFrameError(TComSlice* pcSlice)
+{
+  Int a, b, c;
+  UInt num_SIFO = m_pcPredSearch->getNum_SIFOFilters();
+
+#if !BUGFIX50TMP
+  if(m_piSumH == NULL)
+  {
+    TComPic* pcPic = pcSlice->getPic();
+    Int iWidth  = g_uiMaxCUWidth  / pcPic->getNumPartInWidth();
+    Int iHeight = g_uiMaxCUHeight / pcPic->getNumPartInHeight();
+    m_piSumH       = new Int[ num_SIFO * (iHeight + m_pcCfg->getDIFTap() - 1) * iWidth ];
+    m_apiIntBlk[0] = new Int[ num_SIFO * iHeight * iWidth ];
+    m_apiIntBlk[1] = new Int[ num_SIFO * iHeight * iWidth ];
+  }
+#endif
+
+  if(pcSlice->getSliceType() == P_SLICE)
+  {
+    if(AccErrorP == NULL)
+      xGet_mem2Ddouble(&AccErrorP, num_SIFO, 16);
+
+    for(a = 0; a < num_SIFO; ++a)
+      memset(AccErrorP[a], 0, 16 * sizeof(Double));
+  }
+  else if(pcSlice->getSliceType() == B_SLICE)
+  {
+    if(AccErrorB == NULL)
+      xGet_mem4Ddouble(&AccErrorB, num_SIFO, num_SIFO, 16, 16);
+
+    for(a = 0; a < num_SIFO; ++a)
+      for(b = 0; b < num_SIFO; ++b)
+        for(c = 0; c < 16; ++c)
+          memset(AccErrorB[a][b][c], 0, 16 * sizeof(Double));
+  }
+}
+
+/** accumulates the interpolation error of all filters for the motion of a compressed CU
+ * \param pcCU CU after mode decision
+ */
+Void TEncSIFO::accumulateCUError(TComDataCU* pcCU)
+{
+  if(pcCU->getSlice()->getSliceType() == P_SLICE)
+  {
+    xAccumulateError_P(pcCU);
+  }
+  else if(pcCU->getSlice()->getSliceType() == B_SLICE)
+  {
+    xAccumulateError_B(pcCU);
+  }
+}
+
 Void TEncSIFO::xResetSequenceFilters()
 {
   Int i; 
@@ -722,24 +905,18 @@ Void TEncSIFO::xResetSequenceFilters()
 Void TEncSIFO::xResetAll(TComSlice* pcSlice)
 {
   Int a, b, c, d;
-  static Int firstP = 1;
-  static Int firstB = 1;
   UInt num_SIFO = m_pcPredSearch->getNum_SIFOFilters();
 
   if(pcSlice->getSliceType() == P_SLICE)
   {
-    if(firstP == 1)
+    if(m_bFirstP)
     {
-      xGet_mem2Ddouble(&AccErrorP, num_SIFO, 16);
       xGet_mem2Ddouble(&SequenceAccErrorP, 16, num_SIFO);
     }
 
-    for(a = 0; a < num_SIFO; ++a)
-      memset(AccErrorP[a], 0, 16 * sizeof(Double));
-
-    if(firstP == 1)
+    if(m_bFirstP)
     {
-      firstP = 0;
+      m_bFirstP = false;
 
       for(a = 0; a < 16; ++a)
         for(b = 0; b < num_SIFO; ++b)
@@ -754,14 +931,14 @@ Void TEncSIFO::xResetAll(TComSlice* pcSlice)
   }
   else if(pcSlice->getSliceType() == B_SLICE)
   {
-    if(firstB == 1)
+    if(m_bFirstB)
     {  
       xGet_mem4Ddouble(&SequenceAccErrorB, num_SIFO, num_SIFO, 16, 16);
     }
 
-    if(firstB == 1)
+    if(m_bFirstB)
     {    
-      firstB = 0;
+      m_bFirstB = false;
       memset(SequenceBestCombFilterB, 0, 16 * sizeof(Int));
 
       for(a = 0; a < num_SIFO; ++a)
@@ -781,124 +958,133 @@ Void TEncSIFO::xResetAll(TComSlice* pcSlice)
   }  
 }
 
-Void TEncSIFO::xAccumulateError_P(TComPic*& rpcPic)
+Void TEncSIFO::xAccumulateError_P(TComDataCU* pcCU)
 {
-  UInt uiCUAddr;
+  TComPic* rpcPic = pcCU->getPic();
+  UInt uiCUAddr = pcCU->getAddr();
   TComPicYuv* pcPicOrg = rpcPic->getPicYuvOrg();
   TComPicYuv* pcPicRef;
-  UInt64 uiSSD = 0;
-  Int x, y,f;
+  Int f;
+  Int	iOrgStride = pcPicOrg->getStride();
+#if BUGFIX50TMP
+  UInt64 uiSSD;
+  Int x, y;
   UInt uiShift = g_uiBitIncrement<<1;	
   Int iTemp;
-  Int	iOrgStride = pcPicOrg->getStride();
 #if SIFO_DIF_COMPATIBILITY==1
   Int intPixelTab[20];
 #else
   Int intPixelTab[16];
+#endif
 #endif
   UInt NUM_SIFO_TAB[16];
 
   for(UInt i=0;i<16;i++)
     NUM_SIFO_TAB[i] = m_pcPredSearch->getNum_SIFOTab(i);
 
-  for( uiCUAddr = 0; uiCUAddr < rpcPic->getPicSym()->getNumberOfCUsInFrame() ; uiCUAddr++ )
-  {	
-    TComDataCU*& pcCU = rpcPic->getCU( uiCUAddr );	
-
-    UInt number_of_BasicUnit_perCU = rpcPic->getNumPartInCU();
-    UInt BasicUnit_Width  = g_uiMaxCUWidth  / rpcPic->getNumPartInWidth();
-    UInt BasicUnit_Height = g_uiMaxCUHeight / rpcPic->getNumPartInHeight();
+  UInt number_of_BasicUnit_perCU = rpcPic->getNumPartInCU();
+  UInt BasicUnit_Width  = g_uiMaxCUWidth  / rpcPic->getNumPartInWidth();
+  UInt BasicUnit_Height = g_uiMaxCUHeight / rpcPic->getNumPartInHeight();
+  UInt uiBlockSize      = BasicUnit_Width * BasicUnit_Height;
 
-    for(UInt uiIdx=0; uiIdx<number_of_BasicUnit_perCU; uiIdx++)
+  for(UInt uiIdx=0; uiIdx<number_of_BasicUnit_perCU; uiIdx++)
+  {
+    Int iRefIdx = pcCU->getCUMvField( REF_PIC_LIST_0 )->getRefIdx(uiIdx);
+    if(iRefIdx!=-1)
     {
-      Int iRefIdx = pcCU->getCUMvField( REF_PIC_LIST_0 )->getRefIdx(uiIdx);
-      if(iRefIdx!=-1)
-      {
-        pcPicRef = pcCU->getSlice()->getRefPic( REF_PIC_LIST_0, iRefIdx )->getPicYuvRec();
-        //TComMv mv = pcCU->getCUMvField( REF_PIC_LIST_0 )->getMv(uiIdx);
+      //TComMv mv = pcCU->getCUMvField( REF_PIC_LIST_0 )->getMv(uiIdx);
 
-        //for(UInt H=0;H<4;H++)
-        //{
-        //	for(UInt V=0;V<4;V++)
-        //	{
-        //		m_pcPredSearch->LumaPrediction ( pcCU, pcPicRef, uiIdx, &mv, BasicUnit_Width, BasicUnit_Height, pcYuv_filter, H, V);
-        //	}
-        //}
-        //  m_pcCuEncoder->PredInterLumaBlk ( pcCU, pcPicRef, uiIdx, &mv, BasicUnit_Width, BasicUnit_Height, pcPicYuvFilt);
+      //for(UInt H=0;H<4;H++)
+      //{
+      //	for(UInt V=0;V<4;V++)
+      //	{
+      //		m_pcPredSearch->LumaPrediction ( pcCU, pcPicRef, uiIdx, &mv, BasicUnit_Width, BasicUnit_Height, pcYuv_filter, H, V);
+      //	}
+      //}
+      //  m_pcCuEncoder->PredInterLumaBlk ( pcCU, pcPicRef, uiIdx, &mv, BasicUnit_Width, BasicUnit_Height, pcPicYuvFilt);
 
-        uiSSD = 0;
-        TComMv mv = pcCU->getCUMvField( REF_PIC_LIST_0 )->getMv(uiIdx);
-        Int mv_x;
-        Int mv_y;
+      TComMv mv = pcCU->getCUMvField( REF_PIC_LIST_0 )->getMv(uiIdx);
+      Int mv_x;
+      Int mv_y;
 
-        pcCU->clipMv(mv);
+      pcCU->clipMv(mv);
 
 #ifdef QC_AMVRES
-        if (pcCU->getSlice()->getSPS()->getUseAMVRes())
-        {
-          if (mv.isHAM())
-            continue;
-          else
-            mv.scale_down();
-        }
+      if (pcCU->getSlice()->getSPS()->getUseAMVRes())
+      {
+        if (mv.isHAM())
+          continue;
+        else
+          mv.scale_down();
+      }
+#endif
+      mv_x = mv.getHor();
+      mv_y = mv.getVer();
+      UInt     uixFrac  = mv_x & 0x3;
+      UInt     uiyFrac  = mv_y & 0x3;
+      UInt     uiSubPos = uixFrac+ 4*uiyFrac;
+
+#if BUGFIX50TMP
+      UInt uiLPelX   = pcCU->getCUPelX() + g_auiRasterToPelX[ g_auiZscanToRaster[uiIdx] ]; 
 #endif
-        mv_x = mv.getHor();
-        mv_y = mv.getVer();
-        UInt     uixFrac  = mv_x & 0x3;
-        UInt     uiyFrac  = mv_y & 0x3;
-        UInt     uiSubPos = uixFrac+ 4*uiyFrac;
+      UInt uiTPelY   = pcCU->getCUPelY() + g_auiRasterToPelY[ g_auiZscanToRaster[uiIdx] ];
 
-        Int     iRefStride = pcPicRef->getStride();
+      pcPicRef = xGetRefPicYuvRec( pcCU, REF_PIC_LIST_0, iRefIdx, uiTPelY, BasicUnit_Height, mv_y );
 
-        Int     iRefOffset = ( mv_x >> 2 ) + ( mv_y >> 2 ) * iRefStride;
+      Int     iRefStride = pcPicRef->getStride();
 
-        UInt uiLPelX   = pcCU->getCUPelX() + g_auiRasterToPelX[ g_auiZscanToRaster[uiIdx] ]; 
-        UInt uiTPelY   = pcCU->getCUPelY() + g_auiRasterToPelY[ g_auiZscanToRaster[uiIdx] ];
-        //if (uiLPelX >= pcPicOrg->getWidth() || uiTPelY >= pcPicOrg->getHeight())
-        //{
-        //	continue;
-        //}
+      Int     iRefOffset = ( mv_x >> 2 ) + ( mv_y >> 2 ) * iRefStride;
+      //if (uiLPelX >= pcPicOrg->getWidth() || uiTPelY >= pcPicOrg->getHeight())
+      //{
+      //	continue;
+      //}
 
-        Pel* pOrgY = pcPicOrg->getLumaAddr(uiCUAddr, uiIdx);
-        Pel* pRefY = pcPicRef->getLumaAddr(uiCUAddr, uiIdx) + iRefOffset;    
+      Pel* pOrgY = pcPicOrg->getLumaAddr(uiCUAddr, uiIdx);
+      Pel* pRefY = pcPicRef->getLumaAddr(uiCUAddr, uiIdx) + iRefOffset;    
 
-        for( y = 0; y < BasicUnit_Height; y++ )
-        {
-          for( x = 0; x < BasicUnit_Width; x++ )
-          {	
 #if BUGFIX50TMP
-            xGetInterpolatedPixelArray(intPixelTab, (pRefY+x), uiLPelX, uiTPelY, iRefStride, pcPicRef->getWidth(), pcPicRef->getMaxAddr(), uiSubPos);
-#else
-            xGetInterpolatedPixelArray(intPixelTab, (pRefY+x), uiLPelX, uiTPelY, iRefStride, pcPicRef->getWidth(), pcPicRef->getHeight(), uiSubPos);
-#endif
-            for(f = 0; f < NUM_SIFO_TAB[uiSubPos]; ++f)
-            {
-              iTemp = *(pOrgY+x) - intPixelTab[f];
-              uiSSD = ( iTemp * iTemp ) >> uiShift;
-              AccErrorP[f][uiSubPos] += uiSSD;
-            }
+      for( y = 0; y < BasicUnit_Height; y++ )
+      {
+        for( x = 0; x < BasicUnit_Width; x++ )
+        {	
+          xGetInterpolatedPixelArray(intPixelTab, (pRefY+x), uiLPelX, uiTPelY, iRefStride, pcPicRef->getWidth(), pcPicRef->getMaxAddr(), uiSubPos);
+          for(f = 0; f < NUM_SIFO_TAB[uiSubPos]; ++f)
+          {
+            iTemp = *(pOrgY+x) - intPixelTab[f];
+            uiSSD = ( iTemp * iTemp ) >> uiShift;
+            AccErrorP[f][uiSubPos] += uiSSD;
           }
-          pOrgY += iOrgStride;
-          pRefY += iRefStride;			
-        }  	
+        }
+        pOrgY += iOrgStride;
+        pRefY += iRefStride;			
+      }  	
+#else
+      xGetInterpolatedBlock(m_apiIntBlk[0], pRefY, iRefStride, BasicUnit_Width, BasicUnit_Height, uiSubPos, 0, NUM_SIFO_TAB[uiSubPos]);
+      for(f = 0; f < NUM_SIFO_TAB[uiSubPos]; ++f)
+      {
+        AccErrorP[f][uiSubPos] += xGetBlockError(pOrgY, iOrgStride, m_apiIntBlk[0] + f*uiBlockSize, NULL, BasicUnit_Width, BasicUnit_Height);
       }
+#endif
     }
   }
 }
 
+/** Get the reference picture for a basic unit, a weighted virtual reference is generated for the rows the filter taps read.
+    \param iMvVer  vertical MV component in quarter-pel units
+ */
+TComPicYuv* TEncSIFO::xGetRefPicYuvRec(TComDataCU* pcCU, RefPicList eRefPicList, Int iRefIdx, UInt uiTPelY, UInt uiHeight, Int iMvVer)
+{
+  Int iTopY = (Int)uiTPelY + ( iMvVer >> 2 );
+
+  return pcCU->getSlice()->getRefPicYuvRec( eRefPicList, iRefIdx, iTopY - GRF_WP_ROW_MARGIN, iTopY + (Int)uiHeight + GRF_WP_ROW_MARGIN );
+}
+
 #if BUGFIX50TMP
 #if SIFO_DIF_COMPATIBILITY==1
 Void TEncSIFO:: xGetInterpolatedPixelArray(int out[20], Pel *imgY, int x, int y, int Stride, int img_width, Pel *maxAddr, UInt sub_pos)
 #else
 Void TEncSIFO:: xGetInterpolatedPixelArray(int out[16], Pel *imgY, int x, int y, int Stride, int img_width, Pel *maxAddr, UInt sub_pos)
 #endif
-#else
-#if SIFO_DIF_COMPATIBILITY==1
-Void TEncSIFO:: xGetInterpolatedPixelArray(int out[20], Pel *imgY, int x, int y, int Stride, int img_width, int img_height, UInt sub_pos)
-#else
-Void TEncSIFO:: xGetInterpolatedPixelArray(int out[16], Pel *imgY, int x, int y, int Stride, int img_width, int img_height, UInt sub_pos)
-#endif
-#endif
 {
 #if SIFO_DIF_COMPATIBILITY==1
   Double ipVal[20];     //[num_SIFO]
@@ -911,10 +1097,7 @@ Void TEncSIFO:: xGetInterpolatedPixelArray(int out[16], Pel *imgY, int x, int y,
   Int filter_length = m_pcCfg->getDIFTap();
   Int filter_offset = (filter_length/2 - 1);
   UInt num_SIFO = m_pcPredSearch->getNum_SIFOFilters();
-  UInt NUM_SIFO_TAB[16];
-
-  for(UInt i=0;i<16;i++)
-    NUM_SIFO_TAB[i] = m_pcPredSearch->getNum_SIFOTab(i);
+  UInt num_SIFO_sub_pos = m_pcPredSearch->getNum_SIFOTab(sub_pos);   // only the table of the current sub-pel position is used
 
   for (filterNo=0; filterNo < num_SIFO; filterNo++)
   {
@@ -934,11 +1117,9 @@ Void TEncSIFO:: xGetInterpolatedPixelArray(int out[16], Pel *imgY, int x, int y,
       imgY_tmp1 = imgY_tmp;
       for(jj = 0; jj < filter_length; ++jj)
       {
-#if BUGFIX50TMP
         if (imgY_tmp1 >= maxAddr)
           break;
-#endif
-        for (filterNo=0; filterNo < NUM_SIFO_TAB[sub_pos]; filterNo++)
+        for (filterNo=0; filterNo < num_SIFO_sub_pos; filterNo++)
         {
           ipVal[filterNo] += (SIFO_FILTER[filterNo][sub_pos][filter_length * ii + jj] * (*imgY_tmp1));
         }
@@ -946,13 +1127,125 @@ Void TEncSIFO:: xGetInterpolatedPixelArray(int out[16], Pel *imgY, int x, int y,
       }
       imgY_tmp += Stride;
     }
-    for (filterNo=0; filterNo < NUM_SIFO_TAB[sub_pos]; filterNo++)
+    for (filterNo=0; filterNo < num_SIFO_sub_pos; filterNo++)
     {
       //out[filterNo] = Clip3(0, (1<<(g_uiBitDepth + g_uiBitIncrement))-1, (int)(ipVal[filterNo] + 0.5));
       out[filterNo] = Clip((Int)(ipVal[filterNo] + 0.5));
     }
   }
 }
+#else
+/** interpolates a basic unit with the SIFO filters [uiFirstFilter, uiFirstFilter+uiNumFilters) of a sub-pel position;
+ *  the taps are integers in COEFF_QP^2 units, so the sums are exact and round like the Double filters of SIFO_FILTER
+ * \param piOut  interpolated samples, iWidth*iHeight per filter, indexed by the filter number
+ */
+Void TEncSIFO::xGetInterpolatedBlock(Int* piOut, Pel* piRef, Int iRefStride, Int iWidth, Int iHeight, UInt uiSubPos, UInt uiFirstFilter, UInt uiNumFilters)
+{
+  Int  iTap      = m_pcCfg->getDIFTap();
+  Int  iOffset   = iTap/2 - 1;
+  Int  iSize     = iWidth*iHeight;
+  Int  iRows     = iHeight + iTap - 1;
+  UInt uiNumTab  = m_pcPredSearch->getNum_SIFOTab(uiSubPos);
+  UInt uiEnd     = uiFirstFilter + uiNumFilters;
+  Bool abSumH[SIFO_MAX_FILTERS];
+  Int  aiOffset[SIFO_MAX_TAP*SIFO_MAX_TAP];
+  Int  x, y, k, iSum;
+  UInt f;
+
+  // the full-pel position and the filters beyond the table of the position give zero samples
+  for (f = uiFirstFilter; f < uiEnd; f++)
+  {
+    if (uiSubPos == 0 || f >= uiNumTab)
+      memset(piOut + f*iSize, 0, iSize*sizeof(Int));
+  }
+  if (uiSubPos == 0)
+    return;
+
+  uiEnd = Min(uiEnd, uiNumTab);
+  memset(abSumH, 0, sizeof(abSumH));
+  piRef -= iOffset*iRefStride + iOffset;
+
+  // rows of the horizontal pass read by the non-zero vertical taps
+  Int iFirstRow = iTap, iLastRow = -1;
+  for (f = uiFirstFilter; f < uiEnd; f++)
+  {
+    if (m_aiFiltIdxH[f][uiSubPos] >= 0)
+    {
+      for (k = 0; k < iTap; k++)
+      {
+        if (m_aiFiltTapV[f][uiSubPos][k])
+        {
+          iFirstRow = Min(iFirstRow, k);
+          iLastRow  = Max(iLastRow,  k);
+        }
+      }
+    }
+  }
+  iLastRow += iHeight - 1;
+
+  for (f = uiFirstFilter; f < uiEnd; f++)
+  {
+    Int* piDst  = piOut + f*iSize;
+    Int  iIdxH  = m_aiFiltIdxH[f][uiSubPos];
+
+    if (iIdxH >= 0)
+    {
+      Int* piTapV = m_aiFiltTapV[f][uiSubPos];
+      Int* piSumH = m_piSumH + iIdxH*iRows*iWidth;
+
+      // horizontal pass, once per factor
+      if (!abSumH[iIdxH])
+      {
+        Int* piTapH = m_aiFiltTapH[uiSubPos][iIdxH];
+        Pel* piSrc  = piRef + iFirstRow*iRefStride;
+        abSumH[iIdxH] = true;
+        for (y = iFirstRow; y <= iLastRow; y++, piSrc += iRefStride)
+        {
+          for (x = 0; x < iWidth; x++)
+          {
+            for (iSum = 0, k = 0; k < iTap; k++)
+              iSum += piTapH[k]*piSrc[x+k];
+            piSumH[y*iWidth+x] = iSum;
+          }
+        }
+      }
+
+      for (y = 0; y < iHeight; y++)
+      {
+        for (x = 0; x < iWidth; x++)
+        {
+          for (iSum = 0, k = 0; k < iTap; k++)
+          {
+            if (piTapV[k])
+              iSum += piTapV[k]*piSumH[(y+k)*iWidth+x];
+          }
+          piDst[y*iWidth+x] = Clip( (Int)( (Double)iSum/(COEFF_QP*COEFF_QP) + 0.5 ) );
+        }
+      }
+    }
+    else
+    {
+      Int  iNumTap = m_aiNumTap2D[f][uiSubPos];
+      Int* piPos   = m_piTapPos2D  + (f*16 + uiSubPos)*iTap*iTap;
+      Int* piCoef  = m_piTapCoef2D + (f*16 + uiSubPos)*iTap*iTap;
+
+      for (k = 0; k < iNumTap; k++)
+        aiOffset[k] = (piPos[k]/iTap)*iRefStride + piPos[k]%iTap;
+
+      for (y = 0; y < iHeight; y++)
+      {
+        Pel* piSrc = piRef + y*iRefStride;
+        for (x = 0; x < iWidth; x++)
+        {
+          for (iSum = 0, k = 0; k < iNumTap; k++)
+            iSum += piCoef[k]*piSrc[x+aiOffset[k]];
+          piDst[y*iWidth+x] = Clip( (Int)( (Double)iSum/(COEFF_QP*COEFF_QP) + 0.5 ) );
+        }
+      }
+    }
+  }
+}
+#endif
 
 Void TEncSIFO::xUpdateSequenceFilters_P(TComSlice* pcSlice)
 {
@@ -1514,235 +1807,279 @@ UInt TEncSIFO::xCheckHFPic(TComPic*& rpcPic)
 }
 #endif
 
-Void TEncSIFO::xAccumulateError_B(TComPic*& rpcPic)
+Void TEncSIFO::xAccumulateError_B(TComDataCU* pcCU)
 {
-  UInt uiCUAddr;
+  TComPic* rpcPic = pcCU->getPic();
+  UInt uiCUAddr = pcCU->getAddr();
   TComPicYuv* pcPicOrg = rpcPic->getPicYuvOrg();
   TComPicYuv* pcPicRef;
   TComPicYuv* pcPicRefBi[2];
-  UInt64 uiSSD = 0;
-  Int x, y,f,f0,f1;
+  Int f,f0,f1;
+  Int	iOrgStride = pcPicOrg->getStride();
+#if SIFO_DIF_COMPATIBILITY==1
+  Int tapsize = rpcPic->getPicSym()->getSlice()->getSPS()->getDIFTap();
+#endif
+#if BUGFIX50TMP
+  UInt64 uiSSD;
+  Int x, y;
   UInt uiShift = g_uiBitIncrement<<1;	
   Int iTemp;
-  Int	iOrgStride = pcPicOrg->getStride();
 #if SIFO_DIF_COMPATIBILITY==1
   Int intPixelTab[20],intPixelTabF[20],intPixelTabB[20];
-  Int tapsize = rpcPic->getPicSym()->getSlice()->getSPS()->getDIFTap();
 #else
   Int intPixelTab[16],intPixelTabF[16],intPixelTabB[16];
+#endif
 #endif
   Int iaRefIdx[2];
   UInt num_AVALABLE_FILTERS = m_pcPredSearch->getNum_AvailableFilters();
   UInt num_SIFO = m_pcPredSearch->getNum_SIFOFilters();
 
-  for( uiCUAddr = 0; uiCUAddr < rpcPic->getPicSym()->getNumberOfCUsInFrame() ; uiCUAddr++ )
-  {	
-    TComDataCU*& pcCU = rpcPic->getCU( uiCUAddr );	
+  UInt number_of_BasicUnit_perCU = rpcPic->getNumPartInCU();
+  UInt BasicUnit_Width  = g_uiMaxCUWidth  / rpcPic->getNumPartInWidth();
+  UInt BasicUnit_Height = g_uiMaxCUHeight / rpcPic->getNumPartInHeight();
+  UInt uiBlockSize      = BasicUnit_Width * BasicUnit_Height;
 
-    UInt number_of_BasicUnit_perCU = rpcPic->getNumPartInCU();
-    UInt BasicUnit_Width  = g_uiMaxCUWidth  / rpcPic->getNumPartInWidth();
-    UInt BasicUnit_Height = g_uiMaxCUHeight / rpcPic->getNumPartInHeight();
-
-    for(UInt uiIdx=0; uiIdx<number_of_BasicUnit_perCU; uiIdx++)
-    {
-      iaRefIdx[0] = pcCU->getCUMvField( REF_PIC_LIST_0 )->getRefIdx(uiIdx);
-      iaRefIdx[1] = pcCU->getCUMvField( REF_PIC_LIST_1 )->getRefIdx(uiIdx);
+  for(UInt uiIdx=0; uiIdx<number_of_BasicUnit_perCU; uiIdx++)
+  {
+    iaRefIdx[0] = pcCU->getCUMvField( REF_PIC_LIST_0 )->getRefIdx(uiIdx);
+    iaRefIdx[1] = pcCU->getCUMvField( REF_PIC_LIST_1 )->getRefIdx(uiIdx);
 
-      if(iaRefIdx[0] == -1 && iaRefIdx[1] == -1)
-        continue;
+    if(iaRefIdx[0] == -1 && iaRefIdx[1] == -1)
+      continue;
 
-      if(iaRefIdx[0] != -1 && iaRefIdx[1] != -1)
-      {
-        uiSSD = 0;
+    if(iaRefIdx[0] != -1 && iaRefIdx[1] != -1)
+    {
 
-        pcPicRefBi[0] = pcCU->getSlice()->getRefPic(REF_PIC_LIST_0, iaRefIdx[0] )->getPicYuvRec();
-        pcPicRefBi[1] = pcCU->getSlice()->getRefPic(REF_PIC_LIST_1, iaRefIdx[1] )->getPicYuvRec();
-        TComMv mv0 = pcCU->getCUMvField( REF_PIC_LIST_0 )->getMv(uiIdx);
-        TComMv mv1 = pcCU->getCUMvField( REF_PIC_LIST_1 )->getMv(uiIdx);
+      TComMv mv0 = pcCU->getCUMvField( REF_PIC_LIST_0 )->getMv(uiIdx);
+      TComMv mv1 = pcCU->getCUMvField( REF_PIC_LIST_1 )->getMv(uiIdx);
 
-        Int mv_x0,mv_x1;
-        Int mv_y0,mv_y1;
-        pcCU->clipMv(mv0);                          pcCU->clipMv(mv1);
+      Int mv_x0,mv_x1;
+      Int mv_y0,mv_y1;
+      pcCU->clipMv(mv0);                          pcCU->clipMv(mv1);
 
 #ifdef QC_AMVRES
-        if (pcCU->getSlice()->getSPS()->getUseAMVRes())
+      if (pcCU->getSlice()->getSPS()->getUseAMVRes())
+      {
+        if (mv0.isHAM()||mv1.isHAM())
+          continue;
+        else
         {
-          if (mv0.isHAM()||mv1.isHAM())
-            continue;
-          else
-          {
-            mv0.scale_down();
-            mv1.scale_down();
-          }
+          mv0.scale_down();
+          mv1.scale_down();
         }
+      }
 #endif
-        mv_x0 = mv0.getHor();                       mv_x1 = mv1.getHor();
-        mv_y0 = mv0.getVer();                       mv_y1 = mv1.getVer();
-        UInt     uixFrac0  = mv_x0 & 0x3;           UInt     uixFrac1  = mv_x1 & 0x3;
-        UInt     uiyFrac0  = mv_y0 & 0x3;           UInt     uiyFrac1  = mv_y1 & 0x3;
-        UInt     uiSubPos0 = uixFrac0+ 4*uiyFrac0;  UInt     uiSubPos1 = uixFrac1+ 4*uiyFrac1;
+      mv_x0 = mv0.getHor();                       mv_x1 = mv1.getHor();
+      mv_y0 = mv0.getVer();                       mv_y1 = mv1.getVer();
+      UInt     uixFrac0  = mv_x0 & 0x3;           UInt     uixFrac1  = mv_x1 & 0x3;
+      UInt     uiyFrac0  = mv_y0 & 0x3;           UInt     uiyFrac1  = mv_y1 & 0x3;
+      UInt     uiSubPos0 = uixFrac0+ 4*uiyFrac0;  UInt     uiSubPos1 = uixFrac1+ 4*uiyFrac1;
 
-        Int     iRefStride0 = pcPicRefBi[0]->getStride();
-        Int     iRefOffset0 = ( mv_x0 >> 2 ) + ( mv_y0 >> 2 ) * iRefStride0;
-        Int     iRefStride1 = pcPicRefBi[1]->getStride();
-        Int     iRefOffset1 = ( mv_x1 >> 2 ) + ( mv_y1 >> 2 ) * iRefStride1;
+#if BUGFIX50TMP
+      UInt uiLPelX   = pcCU->getCUPelX() + g_auiRasterToPelX[ g_auiZscanToRaster[uiIdx] ]; 
+#endif
+      UInt uiTPelY   = pcCU->getCUPelY() + g_auiRasterToPelY[ g_auiZscanToRaster[uiIdx] ];
 
-        UInt uiLPelX   = pcCU->getCUPelX() + g_auiRasterToPelX[ g_auiZscanToRaster[uiIdx] ]; 
-        UInt uiTPelY   = pcCU->getCUPelY() + g_auiRasterToPelY[ g_auiZscanToRaster[uiIdx] ];
+      pcPicRefBi[0] = xGetRefPicYuvRec( pcCU, REF_PIC_LIST_0, iaRefIdx[0], uiTPelY, BasicUnit_Height, mv_y0 );
+      pcPicRefBi[1] = xGetRefPicYuvRec( pcCU, REF_PIC_LIST_1, iaRefIdx[1], uiTPelY, BasicUnit_Height, mv_y1 );
 
-        Pel* pOrgY = pcPicOrg->getLumaAddr(uiCUAddr, uiIdx);
-        Pel* pRefY0 = pcPicRefBi[0]->getLumaAddr(uiCUAddr, uiIdx) + iRefOffset0;    
-        Pel* pRefY1 = pcPicRefBi[1]->getLumaAddr(uiCUAddr, uiIdx) + iRefOffset1;    
+      Int     iRefStride0 = pcPicRefBi[0]->getStride();
+      Int     iRefOffset0 = ( mv_x0 >> 2 ) + ( mv_y0 >> 2 ) * iRefStride0;
+      Int     iRefStride1 = pcPicRefBi[1]->getStride();
+      Int     iRefOffset1 = ( mv_x1 >> 2 ) + ( mv_y1 >> 2 ) * iRefStride1;
+
+      Pel* pOrgY = pcPicOrg->getLumaAddr(uiCUAddr, uiIdx);
+      Pel* pRefY0 = pcPicRefBi[0]->getLumaAddr(uiCUAddr, uiIdx) + iRefOffset0;    
+      Pel* pRefY1 = pcPicRefBi[1]->getLumaAddr(uiCUAddr, uiIdx) + iRefOffset1;    
 
-        for( y = 0; y < BasicUnit_Height; y++ )
-        {
-          for( x = 0; x < BasicUnit_Width; x++ )
-          {	
 #if BUGFIX50TMP
-            xGetInterpolatedPixelArray(intPixelTabF, (pRefY0+x), uiLPelX, uiTPelY, iRefStride0, pcPicRefBi[0]->getWidth(), pcPicRefBi[0]->getMaxAddr(), uiSubPos0);
-            xGetInterpolatedPixelArray(intPixelTabB, (pRefY1+x), uiLPelX, uiTPelY, iRefStride1, pcPicRefBi[1]->getWidth(), pcPicRefBi[1]->getMaxAddr(), uiSubPos1);
-#else
-            xGetInterpolatedPixelArray(intPixelTabF, (pRefY0+x), uiLPelX, uiTPelY, iRefStride0, pcPicRefBi[0]->getWidth(), pcPicRefBi[0]->getHeight(), uiSubPos0);
-            xGetInterpolatedPixelArray(intPixelTabB, (pRefY1+x), uiLPelX, uiTPelY, iRefStride1, pcPicRefBi[1]->getWidth(), pcPicRefBi[1]->getHeight(), uiSubPos1);
-#endif
-            for(f0 = 0; f0 < num_AVALABLE_FILTERS; ++f0)
-            {
-              for(f1 = 0; f1 < num_AVALABLE_FILTERS; ++f1)
-              {						
-                iTemp = *(pOrgY+x) - ((intPixelTabF[f0]+intPixelTabB[f1]+1)>>1);
-                uiSSD = ( iTemp * iTemp ) >> uiShift;
-                SequenceAccErrorB[f0][f1][uiSubPos0][uiSubPos1] += uiSSD;
-              }
+      for( y = 0; y < BasicUnit_Height; y++ )
+      {
+        for( x = 0; x < BasicUnit_Width; x++ )
+        {	
+          xGetInterpolatedPixelArray(intPixelTabF, (pRefY0+x), uiLPelX, uiTPelY, iRefStride0, pcPicRefBi[0]->getWidth(), pcPicRefBi[0]->getMaxAddr(), uiSubPos0);
+          xGetInterpolatedPixelArray(intPixelTabB, (pRefY1+x), uiLPelX, uiTPelY, iRefStride1, pcPicRefBi[1]->getWidth(), pcPicRefBi[1]->getMaxAddr(), uiSubPos1);
+          for(f0 = 0; f0 < num_AVALABLE_FILTERS; ++f0)
+          {
+            for(f1 = 0; f1 < num_AVALABLE_FILTERS; ++f1)
+            {						
+              iTemp = *(pOrgY+x) - ((intPixelTabF[f0]+intPixelTabB[f1]+1)>>1);
+              uiSSD = ( iTemp * iTemp ) >> uiShift;
+              AccErrorB[f0][f1][uiSubPos0][uiSubPos1] += uiSSD;
             }
+          }
 
 #if SIFO_DIF_COMPATIBILITY==1
-            if(tapsize==6)
+          if(tapsize==6)
+          {
+            UInt pos = num_SIFO-num_AVALABLE_FILTERS;
+            for(f0 = 0; f0 < num_AVALABLE_FILTERS; ++f0)
             {
-              UInt pos = num_SIFO-num_AVALABLE_FILTERS;
-              for(f0 = 0; f0 < num_AVALABLE_FILTERS; ++f0)
+              for(f1 = 0; f1 < num_AVALABLE_FILTERS; ++f1)
               {
-                for(f1 = 0; f1 < num_AVALABLE_FILTERS; ++f1)
-                {
-                  iTemp = *(pOrgY+x) - ((intPixelTabF[pos+f0]+intPixelTabB[pos+f1]+1)>>1);
-                  uiSSD = ( iTemp * iTemp ) >> uiShift;
-                  SequenceAccErrorB[num_AVALABLE_FILTERS+f0][num_AVALABLE_FILTERS+f1][uiSubPos0][uiSubPos1] += uiSSD;
-                }
+                iTemp = *(pOrgY+x) - ((intPixelTabF[pos+f0]+intPixelTabB[pos+f1]+1)>>1);
+                uiSSD = ( iTemp * iTemp ) >> uiShift;
+                AccErrorB[num_AVALABLE_FILTERS+f0][num_AVALABLE_FILTERS+f1][uiSubPos0][uiSubPos1] += uiSSD;
               }
             }
+          }
 #endif
 
-#if !BUGFIX50
-            pOrgY  += iOrgStride;
-            pRefY0 += iRefStride0;			
-            pRefY1 += iRefStride1;
-#endif
-          }  	
-#if BUGFIX50
           pOrgY  += iOrgStride;
           pRefY0 += iRefStride0;			
           pRefY1 += iRefStride1;
-#endif
-        }
+        }  	
       }
-      else
+#else
+      // only the filters combined below are interpolated
+      xGetInterpolatedBlock(m_apiIntBlk[0], pRefY0, iRefStride0, BasicUnit_Width, BasicUnit_Height, uiSubPos0, 0, num_AVALABLE_FILTERS);
+      xGetInterpolatedBlock(m_apiIntBlk[1], pRefY1, iRefStride1, BasicUnit_Width, BasicUnit_Height, uiSubPos1, 0, num_AVALABLE_FILTERS);
+      for(f0 = 0; f0 < num_AVALABLE_FILTERS; ++f0)
       {
-        Int iRefIdx = (iaRefIdx[0]!= -1)? iaRefIdx[0] : iaRefIdx[1];
-        RefPicList list = (iaRefIdx[0]!= -1)? REF_PIC_LIST_0 : REF_PIC_LIST_1;
+        for(f1 = 0; f1 < num_AVALABLE_FILTERS; ++f1)
+        {
+          AccErrorB[f0][f1][uiSubPos0][uiSubPos1] += xGetBlockError(pOrgY, iOrgStride, m_apiIntBlk[0] + f0*uiBlockSize, m_apiIntBlk[1] + f1*uiBlockSize, BasicUnit_Width, BasicUnit_Height);
+        }
+      }
 
-        pcPicRef = pcCU->getSlice()->getRefPic( list, iRefIdx )->getPicYuvRec();
+#if SIFO_DIF_COMPATIBILITY==1
+      if(tapsize==6)
+      {
+        UInt pos = num_SIFO-num_AVALABLE_FILTERS;
+        xGetInterpolatedBlock(m_apiIntBlk[0], pRefY0, iRefStride0, BasicUnit_Width, BasicUnit_Height, uiSubPos0, pos, num_AVALABLE_FILTERS);
+        xGetInterpolatedBlock(m_apiIntBlk[1], pRefY1, iRefStride1, BasicUnit_Width, BasicUnit_Height, uiSubPos1, pos, num_AVALABLE_FILTERS);
+        for(f0 = 0; f0 < num_AVALABLE_FILTERS; ++f0)
+        {
+          for(f1 = 0; f1 < num_AVALABLE_FILTERS; ++f1)
+          {
+            AccErrorB[num_AVALABLE_FILTERS+f0][num_AVALABLE_FILTERS+f1][uiSubPos0][uiSubPos1] += xGetBlockError(pOrgY, iOrgStride, m_apiIntBlk[0] + (pos+f0)*uiBlockSize, m_apiIntBlk[1] + (pos+f1)*uiBlockSize, BasicUnit_Width, BasicUnit_Height);
+          }
+        }
+      }
+#endif
+#endif
+    }
+    else
+    {
+      Int iRefIdx = (iaRefIdx[0]!= -1)? iaRefIdx[0] : iaRefIdx[1];
+      RefPicList list = (iaRefIdx[0]!= -1)? REF_PIC_LIST_0 : REF_PIC_LIST_1;
 
-        uiSSD = 0;
-        TComMv mv = pcCU->getCUMvField( list )->getMv(uiIdx);
-        pcCU->clipMv(mv);
+      TComMv mv = pcCU->getCUMvField( list )->getMv(uiIdx);
+      pcCU->clipMv(mv);
 
-        Int mv_x ;
-        Int mv_y ;
+      Int mv_x ;
+      Int mv_y ;
 #ifdef QC_AMVRES
-        if (pcCU->getSlice()->getSPS()->getUseAMVRes())
-        {
-          if (mv.isHAM())
-            continue;
-          else
-            mv.scale_down();
-        }
+      if (pcCU->getSlice()->getSPS()->getUseAMVRes())
+      {
+        if (mv.isHAM())
+          continue;
+        else
+          mv.scale_down();
+      }
 #endif
 
-        mv_x = mv.getHor();
-        mv_y = mv.getVer();
-        UInt     uixFrac  = mv_x & 0x3;
-        UInt     uiyFrac  = mv_y & 0x3;
-        UInt     uiSubPos = uixFrac+ 4*uiyFrac;
+      mv_x = mv.getHor();
+      mv_y = mv.getVer();
+      UInt     uixFrac  = mv_x & 0x3;
+      UInt     uiyFrac  = mv_y & 0x3;
+      UInt     uiSubPos = uixFrac+ 4*uiyFrac;
 
-        Int     iRefStride = pcPicRef->getStride();
-        Int     iRefOffset = ( mv_x >> 2 ) + ( mv_y >> 2 ) * iRefStride;
+#if BUGFIX50TMP
+      UInt uiLPelX   = pcCU->getCUPelX() + g_auiRasterToPelX[ g_auiZscanToRaster[uiIdx] ]; 
+#endif
+      UInt uiTPelY   = pcCU->getCUPelY() + g_auiRasterToPelY[ g_auiZscanToRaster[uiIdx] ];
 
-        UInt uiLPelX   = pcCU->getCUPelX() + g_auiRasterToPelX[ g_auiZscanToRaster[uiIdx] ]; 
-        UInt uiTPelY   = pcCU->getCUPelY() + g_auiRasterToPelY[ g_auiZscanToRaster[uiIdx] ];
+      pcPicRef = xGetRefPicYuvRec( pcCU, list, iRefIdx, uiTPelY, BasicUnit_Height, mv_y );
 
-        Pel* pOrgY = pcPicOrg->getLumaAddr(uiCUAddr, uiIdx);
-        Pel* pRefY = pcPicRef->getLumaAddr(uiCUAddr, uiIdx) + iRefOffset;    
+      Int     iRefStride = pcPicRef->getStride();
+      Int     iRefOffset = ( mv_x >> 2 ) + ( mv_y >> 2 ) * iRefStride;
+
+      Pel* pOrgY = pcPicOrg->getLumaAddr(uiCUAddr, uiIdx);
+      Pel* pRefY = pcPicRef->getLumaAddr(uiCUAddr, uiIdx) + iRefOffset;    
 
-        for( y = 0; y < BasicUnit_Height; y++ )
-        {
-          for( x = 0; x < BasicUnit_Width; x++ )
-          {	
-            // Unidirectional error is accumulated along the diagonal
 #if BUGFIX50TMP
-            xGetInterpolatedPixelArray(intPixelTab, (pRefY+x), uiLPelX, uiTPelY, iRefStride, pcPicRef->getWidth(), pcPicRef->getMaxAddr(), uiSubPos);
-#else
-            xGetInterpolatedPixelArray(intPixelTab, (pRefY+x), uiLPelX, uiTPelY, iRefStride, pcPicRef->getWidth(), pcPicRef->getHeight(), uiSubPos);
-#endif
-            for(f = 0; f < num_AVALABLE_FILTERS; ++f)
-            {
-              iTemp = *(pOrgY+x) - intPixelTab[f];
-              uiSSD = ( iTemp * iTemp ) >> uiShift;
-              //AccErrorP[f][uiSubPos] += uiSSD;
-              SequenceAccErrorB[f][f][uiSubPos][uiSubPos] += uiSSD;
-            }
+      for( y = 0; y < BasicUnit_Height; y++ )
+      {
+        for( x = 0; x < BasicUnit_Width; x++ )
+        {	
+          // Unidirectional error is accumulated along the diagonal
+          xGetInterpolatedPixelArray(intPixelTab, (pRefY+x), uiLPelX, uiTPelY, iRefStride, pcPicRef->getWidth(), pcPicRef->getMaxAddr(), uiSubPos);
+          for(f = 0; f < num_AVALABLE_FILTERS; ++f)
+          {
+            iTemp = *(pOrgY+x) - intPixelTab[f];
+            uiSSD = ( iTemp * iTemp ) >> uiShift;
+            //AccErrorP[f][uiSubPos] += uiSSD;
+            AccErrorB[f][f][uiSubPos][uiSubPos] += uiSSD;
+          }
 
 #if SIFO_DIF_COMPATIBILITY==1
-            if(tapsize==6)
+          if(tapsize==6)
+          {
+            UInt pos = num_SIFO-num_AVALABLE_FILTERS;
+            for(f = 0; f < num_AVALABLE_FILTERS; ++f)
             {
-              UInt pos = num_SIFO-num_AVALABLE_FILTERS;
-              for(f = 0; f < num_AVALABLE_FILTERS; ++f)
-              {
-                iTemp = *(pOrgY+x) - intPixelTab[pos+f];
-                uiSSD = ( iTemp * iTemp ) >> uiShift;
-                SequenceAccErrorB[num_AVALABLE_FILTERS+f][num_AVALABLE_FILTERS+f][uiSubPos][uiSubPos] += uiSSD;
-              }
+              iTemp = *(pOrgY+x) - intPixelTab[pos+f];
+              uiSSD = ( iTemp * iTemp ) >> uiShift;
+              AccErrorB[num_AVALABLE_FILTERS+f][num_AVALABLE_FILTERS+f][uiSubPos][uiSubPos] += uiSSD;
             }
+          }
 #endif			
 
-          }
-          pOrgY += iOrgStride;
-          pRefY += iRefStride;			
-        }  	
+        }
+        pOrgY += iOrgStride;
+        pRefY += iRefStride;			
+      }  	
+#else
+      // Unidirectional error is accumulated along the diagonal
+      xGetInterpolatedBlock(m_apiIntBlk[0], pRefY, iRefStride, BasicUnit_Width, BasicUnit_Height, uiSubPos, 0, num_AVALABLE_FILTERS);
+      for(f = 0; f < num_AVALABLE_FILTERS; ++f)
+      {
+        AccErrorB[f][f][uiSubPos][uiSubPos] += xGetBlockError(pOrgY, iOrgStride, m_apiIntBlk[0] + f*uiBlockSize, NULL, BasicUnit_Width, BasicUnit_Height);
       }
-    }
-  }
+
 #if SIFO_DIF_COMPATIBILITY==1
-  if(tapsize==6)
-  {
-    UInt uiMax, uiSubPosIndx1, uiSubPosIndx2, uiHFPic;
-    uiMax = -1;
-    uiHFPic = xCheckHFPic(rpcPic);
-    if(uiHFPic == 1)
-    {
-      for(f = 0; f < num_AVALABLE_FILTERS; ++f)
+      if(tapsize==6)
       {
-        for(uiSubPosIndx1=1; uiSubPosIndx1<16;uiSubPosIndx1++)
+        UInt pos = num_SIFO-num_AVALABLE_FILTERS;
+        xGetInterpolatedBlock(m_apiIntBlk[0], pRefY, iRefStride, BasicUnit_Width, BasicUnit_Height, uiSubPos, pos, num_AVALABLE_FILTERS);
+        for(f = 0; f < num_AVALABLE_FILTERS; ++f)
         {
-          for(uiSubPosIndx2=1; uiSubPosIndx2<16;uiSubPosIndx2++)
-          {
-            SequenceAccErrorB[num_AVALABLE_FILTERS+f][num_AVALABLE_FILTERS+f][uiSubPosIndx1][uiSubPosIndx2] = uiMax;
-          }
+          AccErrorB[num_AVALABLE_FILTERS+f][num_AVALABLE_FILTERS+f][uiSubPos][uiSubPos] += xGetBlockError(pOrgY, iOrgStride, m_apiIntBlk[0] + (pos+f)*uiBlockSize, NULL, BasicUnit_Width, BasicUnit_Height);
         }
       }
+#endif
+#endif
     }
   }
-#endif
 }
 
+#if !BUGFIX50TMP
+/** sum of the squared errors of an interpolated basic unit, shifted per sample like the statistics
+ * \param piPredB  second prediction of a bi-predicted unit, averaged with piPredA, or NULL
+ */
+UInt64 TEncSIFO::xGetBlockError(Pel* piOrg, Int iOrgStride, Int* piPredA, Int* piPredB, Int iWidth, Int iHeight)
+{
+  UInt   uiShift = g_uiBitIncrement<<1;
+  UInt64 uiSSD   = 0;
+  Int    x, y, iTemp;
+
+  for( y = 0; y < iHeight; y++ )
+  {
+    for( x = 0; x < iWidth; x++ )
+    {
+      iTemp  = piOrg[x] - ( piPredB ? ( (piPredA[x] + piPredB[x] + 1) >> 1 ) : piPredA[x] );
+      uiSSD += ( iTemp * iTemp ) >> uiShift;
+    }
+    piOrg   += iOrgStride;
+    piPredA += iWidth;
+    if (piPredB)
+      piPredB += iWidth;
+  }
+  return uiSSD;
+}
+#endif
+
 
 
 
@@ -1753,11 +2090,12 @@ Double TEncSIFO::xGetDCdiff(TComSlice* rpcSlice, RefPicList list, Int ref)
   Double dDCRef		= 0.;
 
   TComPicYuv* pcPicYuvOrg = rpcSlice->getPic()->getPicYuvOrg();
-  TComPicYuv* pcPicYuvRef = rpcSlice->getRefPic(list, ref)->getPicYuvRec();
 
   Int iWidth  = pcPicYuvOrg->getWidth();
   Int iHeight = pcPicYuvOrg->getHeight();
 
+  TComPicYuv* pcPicYuvRef = rpcSlice->getRefPicYuvRec(list, ref, 0, iHeight - 1);
+
   dDCOrg = xComputeImgSum(pcPicYuvOrg->getLumaAddr(), iWidth, iHeight, pcPicYuvOrg->getStride());
   dDCRef = xComputeImgSum(pcPicYuvRef->getLumaAddr(), iWidth, iHeight, pcPicYuvRef->getStride());
 
@@ -1803,10 +2141,11 @@ Void TEncSIFO::xBlockDC(TComSlice* rpcSlice, RefPicList list, Int *DCmin, Int *D
   ref_frame = 0;
 
   TComPicYuv* pcPicYuvOrg = rpcSlice->getPic()->getPicYuvOrg();
-  TComPicYuv* pcPicYuvRef = rpcSlice->getRefPic(list, 0)->getPicYuvRec();
 
   Int img_width  = pcPicYuvOrg->getWidth();
   Int img_height = pcPicYuvOrg->getHeight();
+
+  TComPicYuv* pcPicYuvRef = rpcSlice->getRefPicYuvRec(list, 0, 0, img_height - 1);
   Int ioStride = pcPicYuvOrg->getStride();
   Int irStride = pcPicYuvRef->getStride();
 
@@ -45,6 +45,13 @@ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSI
 class TEncTop;
 class TEncGOP;
 
+#if SIFO_DIF_COMPATIBILITY==1
+#define SIFO_MAX_FILTERS            20          ///< maximum number of SIFO filters of a sub-pel position
+#else
+#define SIFO_MAX_FILTERS            16
+#endif
+#define SIFO_MAX_TAP                12          ///< maximum SIFO filter length
+
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
@@ -57,6 +64,7 @@ private:
   TEncSearch*							m_pcPredSearch;												///< encoder search class
 
   Double **AccErrorP;                              // [Filter][Sppos]
+  Double ****AccErrorB;                            // [FilterF][FilterB][SpposF][SpposB], current frame
   Double **SequenceAccErrorP;                      // [Filter][Sppos]
   Double ****SequenceAccErrorB;                    // [FilterF][FilterB][SpposF][SpposB]
   Double ***SIFO_FILTER;                           // [num_SIFO][16 subpels][SQR_FILTER]
@@ -68,6 +76,18 @@ private:
 #endif
 #endif
   Int SequenceBestCombFilterB[16];                 // [Sppos]
+  Int m_aiFiltIdxH[SIFO_MAX_FILTERS][16];          // [Filter][Sppos] horizontal factor of a separable filter, -1 if not separable
+  Int m_aiFiltTapV[SIFO_MAX_FILTERS][16][SIFO_MAX_TAP]; // [Filter][Sppos][Tap] vertical factor, in COEFF_QP units
+  Int m_aiNumFiltH[16];                            // [Sppos] number of distinct horizontal factors
+  Int m_aiFiltTapH[16][SIFO_MAX_FILTERS][SIFO_MAX_TAP]; // [Sppos][Factor][Tap] horizontal factors, in COEFF_QP units
+  Int m_aiNumTap2D[SIFO_MAX_FILTERS][16];          // [Filter][Sppos] number of non-zero taps of a non-separable filter
+  Int* m_piTapPos2D;                               // [Filter][Sppos][SQR_FILTER] tap positions of non-separable filters
+  Int* m_piTapCoef2D;                              // [Filter][Sppos][SQR_FILTER] taps, in COEFF_QP^2 units
+  Int* m_piSumH;                                   // [Factor][rows][width] horizontal pass of a basic unit
+  Int* m_apiIntBlk[2];                             // [Filter][height][width] interpolated basic unit per list
+  Bool m_bFirstInit;                              // filters have not been allocated
+  Bool m_bFirstP;                                  // no P slice has been coded, SequenceAccErrorP is not allocated
+  Bool m_bFirstB;                                  // no B slice has been coded, SequenceAccErrorB is not allocated
 
 protected:
   Int xGet_mem2Ddouble(Double ***array2D, Int rows, Int columns);
@@ -81,8 +101,9 @@ protected:
   Double  xComputeImgSum			( Pel* img,										Int width, Int height, Int stride		);	///< compute sum of pixel values
   Void xResetAll(TComSlice* pcSlice);
   Void xResetSequenceFilters();
-  Void xAccumulateError_P(TComPic*& rpcPic);
-  Void xAccumulateError_B(TComPic*& rpcPic);  
+  Void xAccumulateError_P(TComDataCU* pcCU);
+  Void xAccumulateError_B(TComDataCU* pcCU);
+  TComPicYuv* xGetRefPicYuvRec(TComDataCU* pcCU, RefPicList eRefPicList, Int iRefIdx, UInt uiTPelY, UInt uiHeight, Int iMvVer);
   Void xUpdateSequenceFilters_P(TComSlice* pcSlice);
   Void xUpdateSequenceFilters_P_pred(TComSlice* pcSlice);
   Void xComputeFilterCombination_B_gd(Double ****err, Int out[16]);
@@ -96,11 +117,9 @@ protected:
   Void xGetInterpolatedPixelArray(Int out[16], Pel* imgY, Int x, Int y, Int stride, Int img_width, Pel *maxAddr, UInt sub_pos);
 #endif
 #else
-#if SIFO_DIF_COMPATIBILITY==1
-  Void xGetInterpolatedPixelArray(Int out[20], Pel* imgY, Int x, Int y, Int stride, Int img_width, Int img_height, UInt sub_pos);
-#else
-  Void xGetInterpolatedPixelArray(Int out[16], Pel* imgY, Int x, Int y, Int stride, Int img_width, Int img_height, UInt sub_pos);
-#endif
+  Void xInitFilterTaps(Int Tap);
+  Void xGetInterpolatedBlock(Int* piOut, Pel* piRef, Int iRefStride, Int iWidth, Int iHeight, UInt uiSubPos, UInt uiFirstFilter, UInt uiNumFilters);
+  UInt64 xGetBlockError(Pel* piOrg, Int iOrgStride, Int* piPredA, Int* piPredB, Int iWidth, Int iHeight);
 #endif
 #if SIFO_DIF_COMPATIBILITY==1
   UInt xCheckHFPic(TComPic*& rpcPic);
@@ -134,6 +153,8 @@ public:
 
   Void initSIFOFilters(Int Tap);     
   Void initSeparableFilter(Int Tap);
+  Void initFrameError(TComSlice* pcSlice);          ///< clear frame statistics before slice compression
+  Void accumulateCUError(TComDataCU* pcCU);         ///< accumulate statistics of a compressed CU
   Void ComputeFiltersAndOffsets(TComPic*& rpcPic);
   Void    setFirstPassSubpelOffset(RefPicList iRefList, TComSlice* pcSlice);
 };
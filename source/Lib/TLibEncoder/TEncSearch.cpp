@@ -2612,6 +2612,43 @@ TEncSearch::estIntraPredQT( TComDataCU* pcCU,
     } // AIS enabled
 #endif
     
+    //===== re-code selected mode when the final RDOQ setting differs from mode decision =====
+    if( m_pcEncCfg->getUseRDOQ() && m_pcEncCfg->getUseFastRDOQ() != m_pcEncCfg->getUseFastRDOQFinal() )
+    {
+      pcCU->setLumaIntraDirSubParts ( uiBestPUMode, uiPartOffset, uiDepth + uiInitTrDepth );
+#if HHI_AIS
+      pcCU->setLumaIntraFiltFlagSubParts( bBestISMode, uiPartOffset, uiDepth + uiInitTrDepth );
+#endif
+      
+      if( m_bUseSBACRD )
+      {
+        if( uiPU )  m_pcRDGoOnSbacCoder->load( m_pppcRDSbacCoder[uiDepth+1][CI_NEXT_BEST] );
+        else        m_pcRDGoOnSbacCoder->load( m_pppcRDSbacCoder[uiDepth  ][CI_CURR_BEST] );
+      }
+      
+      UInt   uiPUDistY = 0;
+      UInt   uiPUDistC = 0;
+      Double dPUCost   = 0.0;
+      m_pcTrQuant->setUseFastRDOQ( m_pcEncCfg->getUseFastRDOQFinal() );
+      xRecurIntraCodingQT( pcCU, uiInitTrDepth, uiPartOffset, bLumaOnly, pcOrgYuv, pcPredYuv, pcResiYuv, uiPUDistY, uiPUDistC, dPUCost );
+      m_pcTrQuant->setUseFastRDOQ( m_pcEncCfg->getUseFastRDOQ() );
+      
+      uiBestPUDistY = uiPUDistY;
+      uiBestPUDistC = uiPUDistC;
+      
+      xSetIntraResultQT( pcCU, uiInitTrDepth, uiPartOffset, bLumaOnly, pcRecoYuv );
+      
+      UInt uiQPartNum = pcCU->getPic()->getNumPartInCU() >> ( ( pcCU->getDepth(0) + uiInitTrDepth ) << 1 );
+      ::memcpy( m_puhQTTempTrIdx,  pcCU->getTransformIdx()       + uiPartOffset, uiQPartNum * sizeof( UChar ) );
+      ::memcpy( m_puhQTTempCbf[0], pcCU->getCbf( TEXT_LUMA     ) + uiPartOffset, uiQPartNum * sizeof( UChar ) );
+      ::memcpy( m_puhQTTempCbf[1], pcCU->getCbf( TEXT_CHROMA_U ) + uiPartOffset, uiQPartNum * sizeof( UChar ) );
+      ::memcpy( m_puhQTTempCbf[2], pcCU->getCbf( TEXT_CHROMA_V ) + uiPartOffset, uiQPartNum * sizeof( UChar ) );
+      
+      if( m_bUseSBACRD )
+      {
+        m_pcRDGoOnSbacCoder->store( m_pppcRDSbacCoder[uiDepth+1][CI_NEXT_BEST] );
+      }
+    }
     
     //--- update overall distortion ---
     uiOverallDistY += uiBestPUDistY;
@@ -2782,6 +2819,27 @@ TEncSearch::estIntraPredChromaQT( TComDataCU* pcCU,
     }
   }
   
+  //----- re-code selected mode when the final RDOQ setting differs from mode decision -----
+  if( m_pcEncCfg->getUseRDOQ() && m_pcEncCfg->getUseFastRDOQ() != m_pcEncCfg->getUseFastRDOQFinal() )
+  {
+    if( m_bUseSBACRD )
+    {
+      m_pcRDGoOnSbacCoder->load( m_pppcRDSbacCoder[uiDepth][CI_CURR_BEST] );
+    }
+    
+    UInt    uiDist = 0;
+    pcCU->setChromIntraDirSubParts  ( uiBestMode, 0, uiDepth );
+    m_pcTrQuant->setUseFastRDOQ     ( m_pcEncCfg->getUseFastRDOQFinal() );
+    xRecurIntraChromaCodingQT       ( pcCU,   0, 0, pcOrgYuv, pcPredYuv, pcResiYuv, uiDist );
+    m_pcTrQuant->setUseFastRDOQ     ( m_pcEncCfg->getUseFastRDOQ() );
+    uiBestDist  = uiDist;
+    
+    UInt  uiQPN = pcCU->getPic()->getNumPartInCU() >> ( uiDepth << 1 );
+    xSetIntraResultChromaQT( pcCU, 0, 0, pcRecoYuv );
+    ::memcpy( m_puhQTTempCbf[1], pcCU->getCbf( TEXT_CHROMA_U ), uiQPN * sizeof( UChar ) );
+    ::memcpy( m_puhQTTempCbf[2], pcCU->getCbf( TEXT_CHROMA_V ), uiQPN * sizeof( UChar ) );
+  }
+  
   //----- set data -----
   UInt  uiQPN = pcCU->getPic()->getNumPartInCU() >> ( uiDepth << 1 );
   ::memcpy( pcCU->getCbf( TEXT_CHROMA_U ), m_puhQTTempCbf[1], uiQPN * sizeof( UChar ) );
@@ -4867,7 +4925,7 @@ UInt TEncSearch::xGetTemplateCost( TComDataCU* pcCU,
 {
   UInt uiCost  = MAX_INT;
   
-  TComPicYuv* pcPicYuvRef = pcCU->getSlice()->getRefPic( eRefPicList, iRefIdx )->getPicYuvRec();
+  TComPicYuv* pcPicYuvRef = xGetRefPicYuvRec( pcCU, uiPartAddr, iSizeY, eRefPicList, iRefIdx, cMvCand.getVer(), cMvCand.getVer() );
   
   // prediction pattern
 #ifdef QC_AMVRES
@@ -4998,9 +5056,6 @@ Void TEncSearch::xMotionEstimation( TComDataCU* pcCU, TComYuv* pcYuvOrg, Int iPa
                             pcYuv->getStride(),
                             0, 0, 0, 0 );
   
-  Pel*        piRefY      = pcCU->getSlice()->getRefPic( eRefPicList, iRefIdxPred )->getPicYuvRec()->getLumaAddr( pcCU->getAddr(), pcCU->getZorderIdxInCU() + uiPartAddr );
-  Int         iRefStride  = pcCU->getSlice()->getRefPic( eRefPicList, iRefIdxPred )->getPicYuvRec()->getStride();
-  
   TComMv      cMvPred = *pcMvPred;
   
 #ifdef QC_AMVRES
@@ -5010,6 +5065,10 @@ Void TEncSearch::xMotionEstimation( TComDataCU* pcCU, TComYuv* pcYuvOrg, Int iPa
   if ( bBi )  xSetSearchRange   ( pcCU, rcMv   , iSrchRng, cMvSrchRngLT, cMvSrchRngRB );
   else        xSetSearchRange   ( pcCU, cMvPred, iSrchRng, cMvSrchRngLT, cMvSrchRngRB );
   
+  TComPicYuv* pcPicYuvRef = xGetSearchRefPicYuv( pcCU, uiPartAddr, iRoiHeight, eRefPicList, iRefIdxPred, *pcMvPred, cMvSrchRngLT, cMvSrchRngRB );
+  Pel*        piRefY      = pcPicYuvRef->getLumaAddr( pcCU->getAddr(), pcCU->getZorderIdxInCU() + uiPartAddr );
+  Int         iRefStride  = pcPicYuvRef->getStride();
+  
   m_pcRdCost->getMotionCost ( 1, 0 );
   
 #ifdef QC_AMVRES
@@ -5133,7 +5192,7 @@ Void TEncSearch::xMotionEstimation( TComDataCU* pcCU, TComYuv* pcYuvOrg, Int iPa
 #endif
       case IPF_HHI_4TAP_MOMS:
       case IPF_HHI_6TAP_MOMS:
-        piRefY = pcCU->getSlice()->getRefPic( eRefPicList, iRefIdxPred )->getPicYuvRecFilt()->getLumaAddr( pcCU->getAddr(), pcCU->getZorderIdxInCU() + uiPartAddr );
+        piRefY = pcCU->getSlice()->getRefPicYuvRecFilt( eRefPicList, iRefIdxPred )->getLumaAddr( pcCU->getAddr(), pcCU->getZorderIdxInCU() + uiPartAddr );
         xPatternSearchFracMOMS_Bi( pcCU, pcPatternKey, piRefY, iRefStride, &rcMv, cMvHalf, cMvQter, ruiCost, ePFilt ,pcMvPred,iRefIdxPred, pRefBufY, bRound);
         break;
       default:
@@ -5151,7 +5210,7 @@ Void TEncSearch::xMotionEstimation( TComDataCU* pcCU, TComYuv* pcYuvOrg, Int iPa
 #endif
       case IPF_HHI_4TAP_MOMS:
       case IPF_HHI_6TAP_MOMS:
-        piRefY = pcCU->getSlice()->getRefPic( eRefPicList, iRefIdxPred )->getPicYuvRecFilt()->getLumaAddr( pcCU->getAddr(), pcCU->getZorderIdxInCU() + uiPartAddr );
+        piRefY = pcCU->getSlice()->getRefPicYuvRecFilt( eRefPicList, iRefIdxPred )->getLumaAddr( pcCU->getAddr(), pcCU->getZorderIdxInCU() + uiPartAddr );
         xPatternSearchFracMOMS_Bi( pcCU, pcPatternKey, piRefY, iRefStride, &rcMv, cMvHalf, cMvQter, ruiCost, ePFilt , pRefBufY, bRound);
         break;
       default:
@@ -5186,7 +5245,7 @@ Void TEncSearch::xMotionEstimation( TComDataCU* pcCU, TComYuv* pcYuvOrg, Int iPa
 #endif
       case IPF_HHI_4TAP_MOMS:
       case IPF_HHI_6TAP_MOMS:
-        piRefY = pcCU->getSlice()->getRefPic( eRefPicList, iRefIdxPred )->getPicYuvRecFilt()->getLumaAddr( pcCU->getAddr(), pcCU->getZorderIdxInCU() + uiPartAddr );
+        piRefY = pcCU->getSlice()->getRefPicYuvRecFilt( eRefPicList, iRefIdxPred )->getLumaAddr( pcCU->getAddr(), pcCU->getZorderIdxInCU() + uiPartAddr );
         xPatternSearchFracMOMS( pcCU, pcPatternKey, piRefY, iRefStride, &rcMv, cMvHalf, cMvQter, ruiCost, ePFilt ,pcMvPred,iRefIdxPred);
         break;
       default:
@@ -5204,7 +5263,7 @@ Void TEncSearch::xMotionEstimation( TComDataCU* pcCU, TComYuv* pcYuvOrg, Int iPa
 #endif
       case IPF_HHI_4TAP_MOMS:
       case IPF_HHI_6TAP_MOMS:
-        piRefY = pcCU->getSlice()->getRefPic( eRefPicList, iRefIdxPred )->getPicYuvRecFilt()->getLumaAddr( pcCU->getAddr(), pcCU->getZorderIdxInCU() + uiPartAddr );
+        piRefY = pcCU->getSlice()->getRefPicYuvRecFilt( eRefPicList, iRefIdxPred )->getLumaAddr( pcCU->getAddr(), pcCU->getZorderIdxInCU() + uiPartAddr );
         xPatternSearchFracMOMS( pcCU, pcPatternKey, piRefY, iRefStride, &rcMv, cMvHalf, cMvQter, ruiCost, ePFilt );
         break;
       default:
@@ -5269,6 +5328,39 @@ Void TEncSearch::xMotionEstimation( TComDataCU* pcCU, TComYuv* pcYuvOrg, Int iPa
 }
 
 
+/** Get the reference picture for the motion search. For a weighted virtual reference every row the search may visit is generated:
+    the search window, the start vector and the extra start candidates tested by the fast search.
+ */
+TComPicYuv* TEncSearch::xGetSearchRefPicYuv( TComDataCU* pcCU, UInt uiPartAddr, Int iRoiHeight, RefPicList eRefPicList, Int iRefIdx, TComMv cMvStart, TComMv& rcMvSrchRngLT, TComMv& rcMvSrchRngRB )
+{
+  if ( pcCU->getSlice()->getAddRefCnt( eRefPicList ) == 0 )
+  {
+    return pcCU->getSlice()->getRefPic( eRefPicList, iRefIdx )->getPicYuvRec();
+  }
+
+#ifdef QC_AMVRES
+  Int  iMvShift = (pcCU->getSlice()->getSPS()->getUseAMVRes())?3:2;
+#else
+  Int  iMvShift = 2;
+#endif
+  Int  iMvVerMin = Min( 0, rcMvSrchRngLT.getVer() << iMvShift );
+  Int  iMvVerMax = Max( 0, rcMvSrchRngRB.getVer() << iMvShift );
+
+  pcCU->clipMv( cMvStart );
+  iMvVerMin = Min( iMvVerMin, cMvStart.getVer() );
+  iMvVerMax = Max( iMvVerMax, cMvStart.getVer() );
+
+  for ( UInt uiIdx = 0; uiIdx < 3; uiIdx++ )
+  {
+    TComMv cMv = m_acMvPredictors[uiIdx];
+    pcCU->clipMv( cMv );
+    iMvVerMin = Min( iMvVerMin, cMv.getVer() );
+    iMvVerMax = Max( iMvVerMax, cMv.getVer() );
+  }
+
+  return xGetRefPicYuvRec( pcCU, uiPartAddr, iRoiHeight, eRefPicList, iRefIdx, iMvVerMin, iMvVerMax );
+}
+
 Void TEncSearch::xSetSearchRange ( TComDataCU* pcCU, TComMv& cMvPred, Int iSrchRng, TComMv& rcMvSrchRngLT, TComMv& rcMvSrchRngRB )
 {
 #ifdef QC_AMVRES
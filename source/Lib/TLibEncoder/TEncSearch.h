@@ -489,6 +489,15 @@ Void xMergeEstimation             ( TComDataCU*     pcCU,
                                     TComMv&       rcMv,
                                     UInt&         ruiSAD );
 
+  TComPicYuv* xGetSearchRefPicYuv( TComDataCU*   pcCU,
+                                    UInt          uiPartAddr,
+                                    Int           iRoiHeight,
+                                    RefPicList    eRefPicList,
+                                    Int           iRefIdx,
+                                    TComMv        cMvStart,
+                                    TComMv&       rcMvSrchRngLT,
+                                    TComMv&       rcMvSrchRngRB );
+
   Void xSetSearchRange            ( TComDataCU*   pcCU,
                                     TComMv&       cMvPred,
                                     Int           iSrchRng,
@@ -120,7 +120,13 @@ Void TEncSlice::init( TEncTop* pcEncTop )
   m_pcListPic         = pcEncTop->getListPic();
 
   m_pcGOPEncoder      = pcEncTop->getGOPEncoder();
+  m_pcLookahead       = pcEncTop->getLookahead();
+  m_pcRateCtrl        = pcEncTop->getRateCtrl();
+  m_pcTwoPass         = pcEncTop->getTwoPass();
   m_pcCuEncoder       = pcEncTop->getCuEncoder();
+#ifdef QC_SIFO
+  m_pcSIFOEncoder     = pcEncTop->getSIFOEncoder();
+#endif
   m_pcPredSearch      = pcEncTop->getPredSearch();
 
   m_pcEntropyCoder    = pcEncTop->getEntropyCoder();
@@ -144,7 +150,7 @@ Void TEncSlice::init( TEncTop* pcEncTop )
   m_pdRdPicQp         = (Double*)xMalloc( Double, m_pcCfg->getDeltaQpRD() * 2 + 1 );
   m_piRdPicQp         = (Int*   )xMalloc( Int,    m_pcCfg->getDeltaQpRD() * 2 + 1 );
 
-  // allocate additional reference frame here
+  // allocate additional reference frame here, the sample buffers are only allocated while a slice reads them
   if ( m_pcCfg->getGRefMode() != NULL )
   {
     UInt uiNumEffFrames = 0;
@@ -159,7 +165,7 @@ Void TEncSlice::init( TEncTop* pcEncTop )
       if ( m_apcVirtPic[j][i] == NULL)
       {
         m_apcVirtPic[j][i] = new TComPic;
-        m_apcVirtPic[j][i]->create( iWidth, iHeight, g_uiMaxCUWidth, g_uiMaxCUHeight, g_uiMaxCUDepth, true );
+        m_apcVirtPic[j][i]->create( iWidth, iHeight, g_uiMaxCUWidth, g_uiMaxCUHeight, g_uiMaxCUDepth, true, false );
       }
     }
   }
@@ -213,6 +219,13 @@ Void TEncSlice::initEncSlice( TComPic* pcPic, Int iPOCLast, UInt uiPOCCurr, Int
     }
   }
 
+  // scene cuts are coded as intra pictures with the QP of the lowest temporal layer
+  Bool bSceneCut = m_pcCfg->getUseLookahead() && m_pcLookahead->isSceneCut( uiPOCCurr );
+  if ( bSceneCut )
+  {
+    iDepth = 0;
+  }
+
   // slice type
   SliceType eSliceType;
 
@@ -226,7 +239,7 @@ Void TEncSlice::initEncSlice( TComPic* pcPic, Int iPOCLast, UInt uiPOCCurr, Int
   {
     eSliceType = iDepth > 0 ? B_SLICE : P_SLICE;
   }
-  eSliceType = (iPOCLast == 0 || uiPOCCurr % m_pcCfg->getIntraPeriod() == 0 || m_pcGOPEncoder->getGOPSize() == 0) ? I_SLICE : eSliceType;
+  eSliceType = (iPOCLast == 0 || uiPOCCurr % m_pcCfg->getIntraPeriod() == 0 || m_pcGOPEncoder->getGOPSize() == 0 || bSceneCut) ? I_SLICE : eSliceType;
 
   rpcSlice->setSliceType    ( eSliceType );
   rpcSlice->setPOC          ( iPOCLast - iNumPicRcvd + iTimeOffset );
@@ -262,7 +275,7 @@ Void TEncSlice::initEncSlice( TComPic* pcPic, Int iPOCLast, UInt uiPOCCurr, Int
   }
   else
   {
-    if ( ( iPOCLast != 0 ) && ( ( uiPOCCurr % m_pcCfg->getIntraPeriod() ) != 0 ) && ( m_pcGOPEncoder->getGOPSize() != 0 ) ) // P or B-slice
+    if ( ( iPOCLast != 0 ) && ( ( uiPOCCurr % m_pcCfg->getIntraPeriod() ) != 0 ) && ( m_pcGOPEncoder->getGOPSize() != 0 ) && !bSceneCut ) // P or B-slice
     {
       if ( m_pcCfg->getUseLDC() && !m_pcCfg->getUseBQP() )
       {
@@ -286,6 +299,12 @@ Void TEncSlice::initEncSlice( TComPic* pcPic, Int iPOCLast, UInt uiPOCCurr, Int
     dQP += pdQPs[ pcPic->getSlice()->getPOC() ];
   }
 
+  // second pass QP, first pass QP of the picture with the offset to meet the target bitrate
+  if ( m_pcCfg->getTwoPass() == 2 )
+  {
+    dQP = m_pcTwoPass->getPicQP( (Int)floor( dQP + 0.5 ) );
+  }
+
   // ------------------------------------------------------------------------------------------------------------------
   // Lambda computation
   // ------------------------------------------------------------------------------------------------------------------
@@ -364,6 +383,21 @@ Void TEncSlice::initEncSlice( TComPic* pcPic, Int iPOCLast, UInt uiPOCCurr, Int
     m_piRdPicQp    [iDQpIdx] = iQP;
   }
 
+  // rate control, lambda from the target bits instead of the QP
+  if ( m_pcCfg->getUseRateCtrl() )
+  {
+    Double dComplexity = 0;
+    if ( m_pcCfg->getUseLookahead() )
+    {
+      dComplexity = eSliceType == I_SLICE ? m_pcLookahead->getIntraComplexity( uiPOCCurr ) : m_pcLookahead->getComplexity( uiPOCCurr );
+    }
+    m_pcRateCtrl->initPicture( iDepth, eSliceType == I_SLICE, dComplexity );
+
+    m_pdRdPicLambda[0] = m_pcRateCtrl->getPicLambda();
+    m_pdRdPicQp    [0] = m_pcRateCtrl->getPicQP();
+    m_piRdPicQp    [0] = m_pcRateCtrl->getPicQP();
+  }
+
   // obtain dQP = 0 case
   dLambda = m_pdRdPicLambda[0];
   dQP     = m_pdRdPicQp    [0];
@@ -380,7 +414,7 @@ Void TEncSlice::initEncSlice( TComPic* pcPic, Int iPOCLast, UInt uiPOCCurr, Int
   {
     eSliceType = P_SLICE;
   }
-  eSliceType = (iPOCLast == 0 || uiPOCCurr % m_pcCfg->getIntraPeriod() == 0 || m_pcGOPEncoder->getGOPSize() == 0) ? I_SLICE : eSliceType;
+  eSliceType = (iPOCLast == 0 || uiPOCCurr % m_pcCfg->getIntraPeriod() == 0 || m_pcGOPEncoder->getGOPSize() == 0 || bSceneCut) ? I_SLICE : eSliceType;
 
   rpcSlice->setSliceType        ( eSliceType );
 #endif
@@ -534,6 +568,9 @@ Void TEncSlice::compressSlice( TComPic*& rpcPic )
     InitScanOrderForSlice(); 
 #endif
 
+  // bind the inter prediction tools of the slice
+  m_pcPredSearch->initInterTools( rpcPic->getSlice() );
+
   // set entropy coder
   if( m_pcCfg->getUseSBACRD() )
   {
@@ -558,12 +595,33 @@ Void TEncSlice::compressSlice( TComPic*& rpcPic )
   m_pcTrQuant->precalculateUnaryExpGolombLevel();
 #endif
 
+#ifdef QC_SIFO
+  // SIFO statistics are gathered CU by CU, only the last compression pass is kept
+  // the reference indices are resolved in the lists as coded, before TEncGOP restores the QBO reordering
+  Bool bSIFOStat = rpcPic->getSlice()->getUseSIFO() && !rpcPic->getSlice()->isIntra();
+  if ( bSIFOStat )
+  {
+    m_pcSIFOEncoder->initFrameError( rpcPic->getSlice() );
+  }
+#endif
+
+  Bool bLCURateCtrl = m_pcCfg->getUseRateCtrl() && m_pcRateCtrl->getLCULevel();
+
   // for every CU
   for( uiCUAddr = 0; uiCUAddr < rpcPic->getPicSym()->getNumberOfCUsInFrame() ; uiCUAddr++ )
   {
     // set QP
     m_pcCuEncoder->setQpLast( rpcPic->getSlice()->getSliceQp() );
 
+    // LCU level rate control
+    if ( bLCURateCtrl )
+    {
+      m_pcRateCtrl->initLCU( uiCUAddr );
+      m_pcCuEncoder->setQpLast( m_pcRateCtrl->getLCUQP() );
+      m_pcRdCost   ->setLambda( m_pcRateCtrl->getLCULambda() );
+      m_pcTrQuant  ->setLambda( m_pcRateCtrl->getLCULambda() );
+    }
+
     // initialize CU encoder
     TComDataCU*& pcCU = rpcPic->getCU( uiCUAddr );
     pcCU->initCU( rpcPic, uiCUAddr );
@@ -604,10 +662,29 @@ Void TEncSlice::compressSlice( TComPic*& rpcPic )
 #endif
     }
 
+#ifdef QC_SIFO
+    if ( bSIFOStat )
+    {
+      m_pcSIFOEncoder->accumulateCUError( pcCU );
+    }
+#endif
+
+    if ( bLCURateCtrl )
+    {
+      m_pcRateCtrl->updateLCU( pcCU->getTotalBits() );
+    }
+
     m_uiPicTotalBits += pcCU->getTotalBits();
     m_dPicRdCost     += pcCU->getTotalCost();
     m_uiPicDist      += pcCU->getTotalDistortion();
   }
+
+  // restore the picture lambda
+  if ( bLCURateCtrl )
+  {
+    m_pcRdCost ->setLambda( rpcPic->getSlice()->getLambda() );
+    m_pcTrQuant->setLambda( rpcPic->getSlice()->getLambda() );
+  }
 }
 
 /** \param  rpcPic        picture class
@@ -801,7 +878,7 @@ Bool TEncSlice::xEstimateWPSlice( TComSlice* rpcSlice, RefPicList eRefPicList, E
   Int iShift = g_uiBitDepth+g_uiBitIncrement-8;
 
   // Luma
-  pcPicYuvRef = rpcSlice->getRefPic(eRefPicList, 0)->getPicYuvRec();
+  pcPicYuvRef = rpcSlice->getRefPicYuvRec(eRefPicList, 0, 0, iHeight - 1);
   iWidth      = pcPicYuvRef->getWidth ();
   iHeight     = pcPicYuvRef->getHeight();
   iStride     = pcPicYuvRef->getStride();
@@ -42,9 +42,15 @@
 #include "../TLibCommon/TComPic.h"
 #include "../TLibCommon/TComPicYuv.h"
 #include "TEncCu.h"
+#ifdef QC_SIFO
+#include "TEncSIFO.h"
+#endif
 
 class TEncTop;
 class TEncGOP;
+class TEncLookahead;
+class TEncRateCtrl;
+class TEncTwoPass;
 
 // ====================================================================================================================
 // Class definition
@@ -65,7 +71,13 @@ private:
 
   // processing units
   TEncGOP*                m_pcGOPEncoder;                       ///< GOP encoder
+  TEncLookahead*          m_pcLookahead;                        ///< lookahead, scene-cut decision
+  TEncRateCtrl*           m_pcRateCtrl;                         ///< rate control
+  TEncTwoPass*            m_pcTwoPass;                          ///< two-pass encoding, second pass QP
   TEncCu*                 m_pcCuEncoder;                        ///< CU encoder
+#ifdef QC_SIFO
+  TEncSIFO*               m_pcSIFOEncoder;                      ///< SIFO encoder, collects filter statistics per CU
+#endif
 
   // encoder search
   TEncSearch*             m_pcPredSearch;                       ///< encoder search class
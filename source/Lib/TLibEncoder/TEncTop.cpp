@@ -66,8 +66,12 @@ TEncTop::~TEncTop()
 #endif
 }
 
-Void TEncTop::create ()
+/** \retval false if the two-pass statistics file cannot be written or read, the encoder has to be destroyed then
+ */
+Bool TEncTop::create ()
 {
+  Bool bOk = true;
+
   // initialize global variables
   initROM();
 
@@ -79,6 +83,23 @@ Void TEncTop::create ()
 #if HHI_DEBLOCKING_FILTER || TENTM_DEBLOCKING_FILTER
   m_cLoopFilter.        create( g_uiMaxCUDepth );
 #endif
+  if ( m_bUseLookahead )
+  {
+    m_cLookahead.       create( getSourceWidth(), getSourceHeight(), m_iSceneCutThreshold, m_iMotionGOPThreshold );
+  }
+  if ( m_bUseRateCtrl )
+  {
+    m_cRateCtrl.        create( m_iTargetBitrate, m_iFrameRate, m_iVBVBufferSize, m_bUseLCURateCtrl,
+                                getSourceWidth(), getSourceHeight(), g_uiMaxCUWidth, g_uiMaxCUHeight );
+  }
+  if ( m_iTwoPass )
+  {
+    bOk = m_cTwoPass.create( m_iTwoPass, m_pchStatsFile, m_iTargetBitrate, m_iFrameRate, m_iFrameToBeEncoded );
+    if ( bOk && m_iTwoPass == 2 && m_cTwoPass.getNumStats() < m_iFrameToBeEncoded && !m_bQuiet )
+    {
+      printf("\nwarning: two-pass statistics for %d of %d pictures\n", m_cTwoPass.getNumStats(), m_iFrameToBeEncoded );
+    }
+  }
 
   // if SBAC-based RD optimization is used
   if( m_bUseSBACRD )
@@ -99,6 +120,8 @@ Void TEncTop::create ()
       }
     }
   }
+
+  return bOk;
 }
 
 Void TEncTop::destroy ()
@@ -111,6 +134,9 @@ Void TEncTop::destroy ()
 #if HHI_DEBLOCKING_FILTER || TENTM_DEBLOCKING_FILTER
   m_cLoopFilter.        destroy();
 #endif
+  m_cLookahead.         destroy();
+  m_cRateCtrl.          destroy();
+  m_cTwoPass.           destroy();
 
   // SBAC RD
   if( m_bUseSBACRD )
@@ -173,6 +199,7 @@ Void TEncTop::init()
 #else
   m_cTrQuant.init( g_uiMaxCUWidth, g_uiMaxCUHeight, m_uiMaxTrSize, m_bUseROT, m_bUseRDOQ, true );
 #endif
+  m_cTrQuant.setUseFastRDOQ( m_bUseFastRDOQ );
 
   // initialize encoder search class
   m_cSearch.init( this, &m_cTrQuant, m_iSearchRange, m_iFastSearch, 0, &m_cEntropyCoder, &m_cRdCost, getRDSbacCoder(), getRDGoOnSbacCoder() );
@@ -221,20 +248,30 @@ Void TEncTop::encode( bool bEos, TComPicYuv* pcPicYuvOrg, TComList<TComPicYuv*>&
   xGetNewPicBuffer( pcPicCurr );
   pcPicYuvOrg->copyToPic( pcPicCurr->getPicYuvOrg() );
 
-  if ( m_iPOCLast != 0 && ( m_iNumPicRcvd != m_iGOPSize && m_iGOPSize ) && !bEos )
+  // lookahead: a scene cut ends the GOP, high motion halves it
+  Int  iGOPSize  = m_iGOPSize;
+  Bool bSceneCut = false;
+  if ( m_bUseLookahead )
+  {
+    m_cLookahead.addPicture( pcPicCurr->getPicYuvOrg(), m_iPOCLast );
+    bSceneCut = m_cLookahead.isSceneCut( m_iPOCLast );
+    iGOPSize  = m_cLookahead.getGOPSize( m_iPOCLast, m_iNumPicRcvd, m_iGOPSize );
+  }
+
+  if ( m_iPOCLast != 0 && ( m_iNumPicRcvd != iGOPSize && iGOPSize ) && !bEos && !bSceneCut )
   {
     iNumEncoded = 0;
     return;
   }
 
   // compress GOP
-  m_cGOPEncoder.compressGOP( m_iPOCLast, m_iNumPicRcvd, m_cListPic, rcListPicYuvRecOut, rcListBitstreamOut );
+  m_cGOPEncoder.compressGOP( m_iPOCLast, m_iNumPicRcvd, iGOPSize, m_cListPic, rcListPicYuvRecOut, rcListBitstreamOut );
 
   iNumEncoded         = m_iNumPicRcvd;
   m_iNumPicRcvd       = 0;
   m_uiNumAllPicCoded += iNumEncoded;
 
-  if (bEos)
+  if ( bEos && !m_bQuiet )
   {
     m_cGOPEncoder.printOutSummary (m_uiNumAllPicCoded);
   }
@@ -297,7 +334,7 @@ Void TEncTop::xGetNewPicBuffer ( TComPic*& rpcPic )
   rpcPic->getPicYuvRec()->setBorderExtension(false);
 
 #if HHI_INTERP_FILTER
-  rpcPic->getPicYuvRecFilt()->setBorderExtension(false);
+  rpcPic->setRecFiltReady(false);
 #endif
 }
 
@@ -330,7 +367,7 @@ Void TEncTop::xInitSPS()
   m_cSPS.setALFMaxLength  ( m_iALFMaxLength     );
 #endif
 
-  m_cSPS.setUseDQP        ( m_iMaxDeltaQP != 0  );
+  m_cSPS.setUseDQP        ( m_iMaxDeltaQP != 0 || ( m_bUseRateCtrl && m_bUseLCURateCtrl ) );
   m_cSPS.setUseLDC        ( m_bUseLDC           );
   m_cSPS.setUsePAD        ( m_bUsePAD           );
   m_cSPS.setUseQBO        ( m_bUseQBO           );
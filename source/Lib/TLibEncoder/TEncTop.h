@@ -53,6 +53,9 @@
 #include "TEncSbac.h"
 #include "TEncSearch.h"
 #include "TEncAdaptiveLoopFilter.h"
+#include "TEncLookahead.h"
+#include "TEncRateCtrl.h"
+#include "TEncTwoPass.h"
 
 #include "TEncBinCoderCABAC4V2V.h"
 
@@ -94,6 +97,9 @@ private:
   TEncGOP                 m_cGOPEncoder;                  ///< GOP encoder
   TEncSlice               m_cSliceEncoder;                ///< slice encoder
   TEncCu                  m_cCuEncoder;                   ///< CU encoder
+  TEncLookahead           m_cLookahead;                   ///< scene-cut and motion analysis of the input pictures
+  TEncRateCtrl            m_cRateCtrl;                    ///< rate control
+  TEncTwoPass             m_cTwoPass;                     ///< two-pass encoding statistics
 #ifdef QC_SIFO
   TEncSIFO                m_cSIFOEncoder;                 // SIFO encoder
 #endif
@@ -117,7 +123,7 @@ public:
   TEncTop();
   virtual ~TEncTop();
 
-  Void      create          ();
+  Bool      create          ();
   Void      destroy         ();
   Void      init            ();
   Void      deletePicBuffer ();
@@ -139,6 +145,9 @@ public:
   TEncSIFO*							  getSIFOEncoder				() { return  &m_cSIFOEncoder;	  			}
 #endif
   TEncCu*                 getCuEncoder          () { return  &m_cCuEncoder;           }
+  TEncLookahead*          getLookahead          () { return  &m_cLookahead;           }
+  TEncRateCtrl*           getRateCtrl           () { return  &m_cRateCtrl;            }
+  TEncTwoPass*            getTwoPass            () { return  &m_cTwoPass;             }
   TEncEntropy*            getEntropyCoder       () { return  &m_cEntropyCoder;        }
   TEncCavlc*              getCavlcCoder         () { return  &m_cCavlcCoder;          }
   TEncSbac*               getSbacCoder          () { return  &m_cSbacCoder;           }
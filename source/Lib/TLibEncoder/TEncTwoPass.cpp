@@ -0,0 +1,213 @@
+/* ====================================================================================================================
+
+  The copyright in this software is being made available under the License included below.
+  This software may be subject to other third party and   contributor rights, including patent rights, and no such
+  rights are granted under this license.
+
+  Copyright (c) 2010, SAMSUNG ELECTRONICS CO., LTD. and BRITISH BROADCASTING CORPORATION
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, are permitted only for
+  the purpose of developing standards within the Joint Collaborative Team on Video Coding and for testing and
+  promoting such standards. The following conditions are required to be met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+      the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+      the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of SAMSUNG ELECTRONICS CO., LTD. nor the name of the BRITISH BROADCASTING CORPORATION
+      may be used to endorse or promote products derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ * ====================================================================================================================
+*/
+
+/** \file     TEncTwoPass.cpp
+    \brief    two-pass encoding class
+*/
+
+#include <stdlib.h>
+#include <math.h>
+#include "TEncTwoPass.h"
+
+// ====================================================================================================================
+// Constructor / destructor / create / destroy
+// ====================================================================================================================
+
+TEncTwoPass::TEncTwoPass()
+{
+  m_iPass   = 0;
+  m_iNumPic = 0;
+  m_iNumStats = 0;
+  m_pFile   = NULL;
+  m_piQP    = NULL;
+  m_puiBits = NULL;
+}
+
+TEncTwoPass::~TEncTwoPass()
+{
+}
+
+/**
+   \param iPass            1: first pass, 2: second pass
+   \param pchStatsFile     statistics file, written by the first pass and read by the second pass
+   \param iTargetBitrate   target bitrate of the second pass in bits per second
+   \param iFrameRate       frame rate
+   \param iNumFrames       number of pictures to be encoded
+   \retval                 false if the statistics file cannot be written or read
+ */
+Bool TEncTwoPass::create( Int iPass, char* pchStatsFile, Int iTargetBitrate, Int iFrameRate, Int iNumFrames )
+{
+  m_iPass = iPass;
+
+  if ( m_iPass == 1 )
+  {
+    m_pFile = fopen( pchStatsFile, "w" );
+    if ( m_pFile == NULL )
+    {
+      return false;
+    }
+    fprintf( m_pFile, "# POC type QP bits SSE_Y SSE_U SSE_V\n" );
+    return true;
+  }
+
+  m_iNumPic = iNumFrames;
+  m_piQP    = new Int [ m_iNumPic ];
+  m_puiBits = new UInt[ m_iNumPic ];
+  for ( Int i = 0; i < m_iNumPic; i++ )
+  {
+    m_piQP   [i] = -1;
+    m_puiBits[i] = 0;
+  }
+
+  FILE* pFile = fopen( pchStatsFile, "r" );
+  if ( pFile == NULL )
+  {
+    return false;
+  }
+
+  Char  acLine[256];
+  Int   iNumStats = 0;
+  m_dPass1BitsLeft = 0;
+  while ( fgets( acLine, sizeof(acLine), pFile ) )
+  {
+    Int   iPOC, iQP;
+    Char  cSliceType;
+    UInt  uiBits;
+    if ( acLine[0] == '#' || sscanf( acLine, "%d %c %d %u", &iPOC, &cSliceType, &iQP, &uiBits ) != 4 )
+    {
+      continue;
+    }
+    if ( iPOC < 0 || iPOC >= m_iNumPic )
+    {
+      continue;
+    }
+    m_piQP   [iPOC]  = iQP;
+    m_puiBits[iPOC]  = uiBits;
+    m_dPass1BitsLeft += uiBits;
+    iNumStats++;
+  }
+  fclose( pFile );
+
+  m_iNumStats = iNumStats;
+
+  m_dBitsLeft     = (Double)iTargetBitrate * (Double)iNumFrames / (Double)iFrameRate;
+  m_dCodedBits    = 0;
+  m_dPredBits     = 0;
+  m_dMeanPicBits  = iNumStats ? m_dPass1BitsLeft / iNumStats : 0;
+  m_iPOC          = -1;
+  m_iQPOffset     = 0;
+  m_dPicPredBits  = 0;
+  return true;
+}
+
+Void TEncTwoPass::destroy()
+{
+  if ( m_pFile )
+  {
+    fclose( m_pFile );
+    m_pFile = NULL;
+  }
+  if ( m_piQP )
+  {
+    delete[] m_piQP;
+    m_piQP = NULL;
+  }
+  if ( m_puiBits )
+  {
+    delete[] m_puiBits;
+    m_puiBits = NULL;
+  }
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+Void TEncTwoPass::writePicture( Int iPOC, Char cSliceType, Int iQP, UInt uiBits, UInt64 uiSSEY, UInt64 uiSSEU, UInt64 uiSSEV )
+{
+  fprintf( m_pFile, "%d %c %d %u %llu %llu %llu\n", iPOC, cSliceType, iQP, uiBits,
+           (unsigned long long)uiSSEY, (unsigned long long)uiSSEU, (unsigned long long)uiSSEV );
+}
+
+/** The ratio of coded to predicted bits corrects the model for the difference between the fast first pass and the
+    second pass, it is damped by one mean picture so that the first pictures do not swing the offset.
+ */
+Void TEncTwoPass::initPicture( Int iPOC )
+{
+  m_iPOC         = iPOC;
+  m_dPicPredBits = 0;
+
+  if ( iPOC < 0 || iPOC >= m_iNumPic || m_piQP[iPOC] < 0 || m_dPass1BitsLeft <= 0 )
+  {
+    // keep the last offset
+    return;
+  }
+
+  Double dCorrection = ( m_dCodedBits + m_dMeanPicBits ) / ( m_dPredBits + m_dMeanPicBits );
+  dCorrection = Clip3( TP_MIN_CORRECTION, TP_MAX_CORRECTION, dCorrection );
+
+  Double dOffset = TP_MAX_QP_OFFSET;
+  if ( m_dBitsLeft > 0 )
+  {
+    dOffset = TP_QP_PER_OCTAVE * log( dCorrection * m_dPass1BitsLeft / m_dBitsLeft ) / log( 2.0 );
+  }
+  m_iQPOffset = Clip3( -TP_MAX_QP_OFFSET, TP_MAX_QP_OFFSET, (Int)floor( dOffset + 0.5 ) );
+
+  Int iQP = Clip3( MIN_QP, MAX_QP, m_piQP[iPOC] + m_iQPOffset );
+  m_dPicPredBits = m_puiBits[iPOC] * pow( 2.0, ( m_piQP[iPOC] - iQP ) / TP_QP_PER_OCTAVE );
+}
+
+Void TEncTwoPass::updatePicture( UInt uiBits )
+{
+  m_dBitsLeft -= uiBits;
+
+  if ( m_iPOC < 0 || m_iPOC >= m_iNumPic || m_piQP[m_iPOC] < 0 )
+  {
+    return;
+  }
+
+  m_dPass1BitsLeft -= m_puiBits[m_iPOC];
+  if ( m_dPicPredBits > 0 )
+  {
+    m_dCodedBits += uiBits;
+    m_dPredBits  += m_dPicPredBits;
+  }
+}
+
+Int TEncTwoPass::getPicQP( Int iDefaultQP )
+{
+  Int iQP = iDefaultQP;
+  if ( m_iPOC >= 0 && m_iPOC < m_iNumPic && m_piQP[m_iPOC] >= 0 )
+  {
+    iQP = m_piQP[m_iPOC];
+  }
+  return Clip3( MIN_QP, MAX_QP, iQP + m_iQPOffset );
+}
@@ -0,0 +1,106 @@
+/* ====================================================================================================================
+
+  The copyright in this software is being made available under the License included below.
+  This software may be subject to other third party and   contributor rights, including patent rights, and no such
+  rights are granted under this license.
+
+  Copyright (c) 2010, SAMSUNG ELECTRONICS CO., LTD. and BRITISH BROADCASTING CORPORATION
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, are permitted only for
+  the purpose of developing standards within the Joint Collaborative Team on Video Coding and for testing and
+  promoting such standards. The following conditions are required to be met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+      the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+      the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of SAMSUNG ELECTRONICS CO., LTD. nor the name of the BRITISH BROADCASTING CORPORATION
+      may be used to endorse or promote products derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ * ====================================================================================================================
+*/
+
+/** \file     TEncTwoPass.h
+    \brief    two-pass encoding class (header)
+*/
+
+#ifndef __TENCTWOPASS__
+#define __TENCTWOPASS__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <stdio.h>
+#include "../TLibCommon/CommonDef.h"
+
+// ====================================================================================================================
+// Constants
+// ====================================================================================================================
+
+#define TP_QP_PER_OCTAVE            6.0         ///< QP increase which halves the bits of a picture
+#define TP_MAX_QP_OFFSET            12          ///< max. QP offset to the first pass
+#define TP_MIN_CORRECTION           0.5         ///< range of the ratio of coded to predicted second pass bits
+#define TP_MAX_CORRECTION           2.0
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// two-pass encoding class, first pass statistics file and second pass QP allocation
+/** The first pass writes one line per coded picture with POC, slice type, QP, bits and the SSE of the three
+    components. The second pass keeps the QP structure of the first pass and adds one offset to all remaining
+    pictures, chosen so that the first pass bits of these pictures, scaled by TP_QP_PER_OCTAVE and by the ratio of
+    coded to predicted bits so far, meet the remaining budget of the target bitrate.
+ */
+class TEncTwoPass
+{
+private:
+  Int       m_iPass;                          ///< 1: first pass, 2: second pass
+  FILE*     m_pFile;                          ///< statistics file, first pass only
+
+  // first pass statistics per POC
+  Int       m_iNumPic;
+  Int       m_iNumStats;                      ///< number of pictures with statistics
+  Int*      m_piQP;                           ///< QP of the first pass, -1 if the picture has no statistics
+  UInt*     m_puiBits;
+
+  // second pass
+  Double    m_dBitsLeft;                      ///< remaining bits of the target
+  Double    m_dPass1BitsLeft;                 ///< first pass bits of the remaining pictures
+  Double    m_dCodedBits;                     ///< second pass bits of the pictures with statistics
+  Double    m_dPredBits;                      ///< predicted bits of these pictures
+  Double    m_dMeanPicBits;                   ///< mean first pass bits per picture
+  Int       m_iPOC;
+  Int       m_iQPOffset;
+  Double    m_dPicPredBits;
+
+public:
+  TEncTwoPass();
+  virtual ~TEncTwoPass();
+
+  Bool    create          ( Int iPass, char* pchStatsFile, Int iTargetBitrate, Int iFrameRate, Int iNumFrames );
+  Void    destroy         ();
+
+  /// first pass
+  Void    writePicture    ( Int iPOC, Char cSliceType, Int iQP, UInt uiBits, UInt64 uiSSEY, UInt64 uiSSEU, UInt64 uiSSEV );
+
+  /// second pass, QP offset of the picture
+  Void    initPicture     ( Int iPOC );
+  Void    updatePicture   ( UInt uiBits );
+  /// QP of the picture, iDefaultQP is used for pictures without statistics
+  Int     getPicQP        ( Int iDefaultQP );
+  Int     getQPOffset     ()    { return m_iQPOffset; }
+  Int     getNumStats     ()    { return m_iNumStats; }
+};
+
+#endif // __TENCTWOPASS__
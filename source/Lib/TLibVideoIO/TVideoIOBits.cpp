@@ -56,7 +56,7 @@ Void TVideoIOBits::openBits( char* pchFile, Bool bWriteMode )
 {
   if ( bWriteMode )
   {
-    m_cHandle.open( pchFile, ios::binary | ios::out );
+    m_cHandle.open( pchFile, true );
 
     if( m_cHandle.fail() )
     {
@@ -66,7 +66,7 @@ Void TVideoIOBits::openBits( char* pchFile, Bool bWriteMode )
   }
   else
   {
-    m_cHandle.open( pchFile, ios::binary | ios::in );
+    m_cHandle.open( pchFile, false );
 
     if( m_cHandle.fail() )
     {
@@ -126,6 +126,23 @@ Void TVideoIOBits::writeBits( TComBitstream* pcBitstream )
   m_cHandle.write( reinterpret_cast<char*>(plBuff   ), uiBytes      );
 }
 
+Int64 TVideoIOBits::getPosition()
+{
+  return m_cHandle.rdbuf()->pubseekoff( 0, ios::cur, ios::in | ios::out );
+}
+
+/** \param  iPosition     position returned by getPosition() while writing, the file must be seekable
+ */
+Void TVideoIOBits::seekBits( Int64 iPosition )
+{
+  m_cHandle.clear();
+  if ( m_cHandle.rdbuf()->pubseekpos( iPosition, ios::in ) != iPosition )
+  {
+    printf("\nfailed to seek in Bitstream file\n");
+    exit(0);
+  }
+}
+
 
 
 
@@ -141,7 +158,7 @@ Void TVideoIOBitsStartCode::openBits( char* pchFile, Bool bWriteMode )
 {
   if ( bWriteMode )
   {
-    m_cHandle.open( pchFile, ios::binary | ios::out );
+    m_cHandle.open( pchFile, true );
 
     if( m_cHandle.fail() )
     {
@@ -151,7 +168,7 @@ Void TVideoIOBitsStartCode::openBits( char* pchFile, Bool bWriteMode )
   }
   else
   {
-    m_cHandle.open( pchFile, ios::binary | ios::in );
+    m_cHandle.open( pchFile, false );
 
     if( m_cHandle.fail() )
     {
@@ -159,6 +176,7 @@ Void TVideoIOBitsStartCode::openBits( char* pchFile, Bool bWriteMode )
       exit(0);
     }
   }
+  m_bStartCodeRead = false;
 
   return;
 }
@@ -195,14 +213,19 @@ Bool TVideoIOBitsStartCode::readBits( TComBitstream*& rpcBitstream )
 
 int TVideoIOBitsStartCode::xFindNextStartCode(UInt& ruiPacketSize, UChar* pucBuffer)
 {
-  UInt uiDummy = 0;
-  m_cHandle.read( reinterpret_cast<char*>(&uiDummy), 3 );
-  if ( m_cHandle.eof() ) return -1;
-  assert( 0 == uiDummy );
-
-  m_cHandle.read( reinterpret_cast<char*>(&uiDummy), 1 );
-  if ( m_cHandle.eof() ) return -1;
-  assert( 1 == uiDummy );
+  // the start code has already been consumed at the end of the previous packet
+  if ( !m_bStartCodeRead )
+  {
+    UInt uiDummy = 0;
+    m_cHandle.read( reinterpret_cast<char*>(&uiDummy), 3 );
+    if ( m_cHandle.eof() ) return -1;
+    assert( 0 == uiDummy );
+
+    m_cHandle.read( reinterpret_cast<char*>(&uiDummy), 1 );
+    if ( m_cHandle.eof() ) return -1;
+    assert( 1 == uiDummy );
+  }
+  m_bStartCodeRead = false;
 
   Int iNextStartCodeBytes = 0;
   Int iBytesRead = 0;
@@ -238,7 +261,8 @@ int TVideoIOBitsStartCode::xFindNextStartCode(UInt& ruiPacketSize, UChar* pucBuf
 
   ruiPacketSize = iBytesRead - iNextStartCodeBytes;
 
-  m_cHandle.seekg( -iNextStartCodeBytes, ios::cur );
+  // no seek back, the stream may be a pipe
+  m_bStartCodeRead = ( iNextStartCodeBytes != 0 );
   return 0;
 }
 
@@ -261,4 +285,22 @@ Void TVideoIOBitsStartCode::writeBits( TComBitstream* pcBitstream )
   m_cHandle.write( reinterpret_cast<char*>(plBuff   ), uiBytes      );
 }
 
+/// the start code of the next packet may have been read already, the position is the one of the start code
+Int64 TVideoIOBitsStartCode::getPosition()
+{
+  Int64 iPosition = m_cHandle.rdbuf()->pubseekoff( 0, ios::cur, ios::in | ios::out );
+  return m_bStartCodeRead ? iPosition - 4 : iPosition;
+}
 
+/** \param  iPosition     position returned by getPosition() while writing, the file must be seekable
+ */
+Void TVideoIOBitsStartCode::seekBits( Int64 iPosition )
+{
+  m_cHandle.clear();
+  if ( m_cHandle.rdbuf()->pubseekpos( iPosition, ios::in ) != iPosition )
+  {
+    printf("\nfailed to seek in Bitstream file\n");
+    exit(0);
+  }
+  m_bStartCodeRead = false;
+}
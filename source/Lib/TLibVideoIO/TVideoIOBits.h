@@ -40,6 +40,7 @@
 #include <fstream>
 #include <iostream>
 #include "../TLibCommon/CommonDef.h"
+#include "TVideoIOStream.h"
 #include "../TLibCommon/TComBitStream.h"
 
 using namespace std;
@@ -52,7 +53,7 @@ using namespace std;
 class TVideoIOBits
 {
 private:
-  fstream   m_cHandle;                                      ///< file handle
+  TVideoIOStream m_cHandle;                                 ///< file handle, "-" selects stdin or stdout
 
 public:
   TVideoIOBits()            {}
@@ -64,16 +65,20 @@ public:
   Bool readBits   ( TComBitstream*& rpcBitstream    );      ///< read  one packet from file
   Void writeBits  ( TComBitstream*  pcBitstream     );      ///< write one packet to   file
 
+  Int64 getPosition();                                      ///< byte position of the next packet
+  Void  seekBits  ( Int64 iPosition );                      ///< continue reading at a packet position
+
 };
 
 /// bitstream file I/O class
 class TVideoIOBitsStartCode
 {
 private:
-  fstream   m_cHandle;                                      ///< file handle
+  TVideoIOStream m_cHandle;                                 ///< file handle, "-" selects stdin or stdout
+  Bool      m_bStartCodeRead;                               ///< start code of the next packet has been read with the last packet
 
 public:
-  TVideoIOBitsStartCode()            {}
+  TVideoIOBitsStartCode()            { m_bStartCodeRead = false; }
   virtual ~TVideoIOBitsStartCode()   {}
 
   Void openBits   ( char* pchFile,  Bool bWriteMode );      ///< open or create file
@@ -82,8 +87,11 @@ public:
   Bool readBits   ( TComBitstream*& rpcBitstream    );      ///< read  one packet from file
   Void writeBits  ( TComBitstream*  pcBitstream     );      ///< write one packet to   file
 
+  Int64 getPosition();                                      ///< byte position of the next packet
+  Void  seekBits  ( Int64 iPosition );                      ///< continue reading at a packet position
+
 private:
-  int xFindNextStartCode(UInt& ruiPacketSize, UChar* pucBuffer); ///< get packet size and number of startcode bytes and seeks to the packet's start position
+  int xFindNextStartCode(UInt& ruiPacketSize, UChar* pucBuffer); ///< read one packet and the start code of the next one, without seeking
 
 };
 
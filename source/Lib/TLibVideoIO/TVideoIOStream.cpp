@@ -0,0 +1,284 @@
+/* ====================================================================================================================
+
+  The copyright in this software is being made available under the License included below.
+  This software may be subject to other third party and   contributor rights, including patent rights, and no such
+  rights are granted under this license.
+
+  Copyright (c) 2010, SAMSUNG ELECTRONICS CO., LTD. and BRITISH BROADCASTING CORPORATION
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, are permitted only for
+  the purpose of developing standards within the Joint Collaborative Team on Video Coding and for testing and
+  promoting such standards. The following conditions are required to be met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+      the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+      the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of SAMSUNG ELECTRONICS CO., LTD. nor the name of the BRITISH BROADCASTING CORPORATION
+      may be used to endorse or promote products derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ * ====================================================================================================================
+*/
+
+
+/** \file     TVideoIOStream.cpp
+    \brief    buffered file and standard stream I/O class
+*/
+
+#include <string.h>
+#include <fcntl.h>
+#ifdef _WIN32
+#include <io.h>
+#define dup     _dup
+#define dup2    _dup2
+#define fdopen  _fdopen
+#define fileno  _fileno
+#define fseeko  _fseeki64
+#else
+#include <unistd.h>
+#endif
+
+#include "TVideoIOStream.h"
+
+static Int  s_iStdoutFd     = -1;     ///< duplicate of the original stdout descriptor, -1 if not reserved
+static Bool s_bStdoutTaken  = false;  ///< set once stdout has been taken by an output stream
+
+// ====================================================================================================================
+// TVideoIOStreamBuf: public member functions
+// ====================================================================================================================
+
+/** \param pchFile    file name string, "-" for the standard input or output
+    \param bWriteMode file open mode
+    \retval           true if the file has been opened
+ */
+Bool TVideoIOStreamBuf::open( const char* pchFile, Bool bWriteMode )
+{
+  close();
+
+  Bool bStd = ( strcmp( pchFile, "-" ) == 0 );
+
+  if ( !bStd )
+  {
+    m_pFile = fopen( pchFile, bWriteMode ? "wb" : "rb" );
+  }
+  else if ( bWriteMode )
+  {
+    TVideoIOStream::reserveStdout();
+    if ( s_iStdoutFd < 0 || s_bStdoutTaken )
+    {
+      return false;
+    }
+    s_bStdoutTaken = true;
+
+    Int iFd = s_iStdoutFd;
+#ifdef _WIN32
+    _setmode( iFd, _O_BINARY );
+#endif
+    m_pFile = fdopen( iFd, "wb" );
+  }
+  else
+  {
+#ifdef _WIN32
+    _setmode( fileno( stdin ), _O_BINARY );
+#endif
+    m_pFile = stdin;
+  }
+
+  if ( m_pFile == NULL )
+  {
+    return false;
+  }
+
+  // the stdio buffer is bypassed, all transfers are done in blocks of the stream buffer size
+  setvbuf( m_pFile, NULL, _IONBF, 0 );
+
+  m_pcBuffer   = new Char[ VIDEO_IO_BUF_SIZE ];
+  m_iBufferPos = 0;
+  if ( bWriteMode )
+  {
+    setp( m_pcBuffer, m_pcBuffer + VIDEO_IO_BUF_SIZE );
+    setg( NULL, NULL, NULL );
+  }
+  else
+  {
+    setp( NULL, NULL );
+    setg( m_pcBuffer, m_pcBuffer, m_pcBuffer );
+  }
+  return true;
+}
+
+Void TVideoIOStreamBuf::close()
+{
+  if ( m_pFile == NULL )
+  {
+    return;
+  }
+
+  sync();
+  if ( m_pFile != stdin )
+  {
+    fclose( m_pFile );
+  }
+  m_pFile = NULL;
+
+  delete [] m_pcBuffer;
+  m_pcBuffer = NULL;
+  setp( NULL, NULL );
+  setg( NULL, NULL, NULL );
+}
+
+// ====================================================================================================================
+// TVideoIOStreamBuf: protected member functions
+// ====================================================================================================================
+
+/// write the buffered data and append one character
+TVideoIOStreamBuf::int_type TVideoIOStreamBuf::overflow( int_type iChar )
+{
+  if ( pbase() == NULL || sync() != 0 )
+  {
+    return traits_type::eof();
+  }
+  if ( !traits_type::eq_int_type( iChar, traits_type::eof() ) )
+  {
+    *pptr() = traits_type::to_char_type( iChar );
+    pbump( 1 );
+  }
+  return traits_type::not_eof( iChar );
+}
+
+/// refill the read buffer, a pipe may return less than the buffer size
+TVideoIOStreamBuf::int_type TVideoIOStreamBuf::underflow()
+{
+  if ( eback() == NULL )
+  {
+    return traits_type::eof();
+  }
+  if ( gptr() < egptr() )
+  {
+    return traits_type::to_int_type( *gptr() );
+  }
+
+  size_t uiBytes = fread( m_pcBuffer, 1, VIDEO_IO_BUF_SIZE, m_pFile );
+  if ( uiBytes == 0 )
+  {
+    return traits_type::eof();
+  }
+  m_iBufferPos += egptr() - eback();
+  setg( m_pcBuffer, m_pcBuffer, m_pcBuffer + uiBytes );
+  return traits_type::to_int_type( *gptr() );
+}
+
+/// write the buffered data
+int TVideoIOStreamBuf::sync()
+{
+  if ( pbase() == NULL )
+  {
+    return 0;
+  }
+
+  size_t uiBytes = pptr() - pbase();
+  if ( uiBytes && fwrite( pbase(), 1, uiBytes, m_pFile ) != uiBytes )
+  {
+    return -1;
+  }
+  m_iBufferPos += uiBytes;
+  setp( pbase(), epptr() );
+  return fflush( m_pFile ) == 0 ? 0 : -1;
+}
+
+/// only the current position can be queried, other offsets are passed to seekpos()
+TVideoIOStreamBuf::pos_type TVideoIOStreamBuf::seekoff( off_type iOff, ios::seekdir eDir, ios::openmode eMode )
+{
+  if ( m_pFile == NULL )
+  {
+    return pos_type( off_type( -1 ) );
+  }
+
+  Int64 iPos = m_iBufferPos + ( pbase() ? pptr() - pbase() : gptr() - eback() );
+  if ( eDir == ios::cur && iOff == 0 )
+  {
+    return pos_type( iPos );
+  }
+  if ( eDir == ios::beg )
+  {
+    return seekpos( pos_type( iOff ), eMode );
+  }
+  if ( eDir == ios::cur )
+  {
+    return seekpos( pos_type( iPos + iOff ), eMode );
+  }
+  return pos_type( off_type( -1 ) );
+}
+
+/// seek to an absolute position, the read buffer is kept when the position is inside of it
+TVideoIOStreamBuf::pos_type TVideoIOStreamBuf::seekpos( pos_type iPos, ios::openmode eMode )
+{
+  if ( m_pFile == NULL || pbase() != NULL )
+  {
+    return pos_type( off_type( -1 ) );
+  }
+
+  Int64 iOff = Int64( iPos );
+  if ( iOff >= m_iBufferPos && iOff <= m_iBufferPos + ( egptr() - eback() ) )
+  {
+    setg( eback(), eback() + ( iOff - m_iBufferPos ), egptr() );
+    return iPos;
+  }
+
+  if ( fseeko( m_pFile, iOff, SEEK_SET ) != 0 )
+  {
+    return pos_type( off_type( -1 ) );
+  }
+  m_iBufferPos = iOff;
+  setg( m_pcBuffer, m_pcBuffer, m_pcBuffer );
+  return iPos;
+}
+
+// ====================================================================================================================
+// TVideoIOStream: public member functions
+// ====================================================================================================================
+
+/** \param pchFile    file name string, "-" for the standard input or output
+    \param bWriteMode file open mode
+ */
+Void TVideoIOStream::open( const char* pchFile, Bool bWriteMode )
+{
+  clear();
+  if ( !m_cBuf.open( pchFile, bWriteMode ) )
+  {
+    setstate( ios::failbit );
+  }
+}
+
+Void TVideoIOStream::close()
+{
+  m_cBuf.close();
+}
+
+/** The original stdout is kept on a duplicate descriptor for the output stream and stdout is redirected to stderr.
+    Calling it again has no effect.
+ */
+Void TVideoIOStream::reserveStdout()
+{
+  if ( s_iStdoutFd >= 0 )
+  {
+    return;
+  }
+
+  fflush( stdout );
+  Int iFd = dup( fileno( stdout ) );
+  if ( iFd < 0 || dup2( fileno( stderr ), fileno( stdout ) ) < 0 )
+  {
+    return;
+  }
+  s_iStdoutFd = iFd;
+}
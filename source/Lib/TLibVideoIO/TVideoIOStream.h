@@ -0,0 +1,103 @@
+/* ====================================================================================================================
+
+  The copyright in this software is being made available under the License included below.
+  This software may be subject to other third party and   contributor rights, including patent rights, and no such
+  rights are granted under this license.
+
+  Copyright (c) 2010, SAMSUNG ELECTRONICS CO., LTD. and BRITISH BROADCASTING CORPORATION
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, are permitted only for
+  the purpose of developing standards within the Joint Collaborative Team on Video Coding and for testing and
+  promoting such standards. The following conditions are required to be met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+      the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+      the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of SAMSUNG ELECTRONICS CO., LTD. nor the name of the BRITISH BROADCASTING CORPORATION
+      may be used to endorse or promote products derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ * ====================================================================================================================
+*/
+
+
+/** \file     TVideoIOStream.h
+    \brief    buffered file and standard stream I/O class (header)
+*/
+
+#ifndef __TVIDEOIOSTREAM__
+#define __TVIDEOIOSTREAM__
+
+#include <stdio.h>
+#include <iostream>
+#include "../TLibCommon/CommonDef.h"
+
+using namespace std;
+
+// ====================================================================================================================
+// Constants
+// ====================================================================================================================
+
+#define VIDEO_IO_BUF_SIZE           (1 << 20)   ///< size of the stream buffer in bytes
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// stream buffer on a stdio file, reads and writes in large blocks
+/** The position is counted, so it can be queried on pipes as well. Seeking is only possible when reading a file. */
+class TVideoIOStreamBuf : public streambuf
+{
+private:
+  FILE*     m_pFile;                                        ///< file handle, NULL if not open
+  Char*     m_pcBuffer;                                     ///< read or write buffer
+  Int64     m_iBufferPos;                                   ///< stream position of the buffer start
+
+protected:
+  virtual int_type  overflow  ( int_type iChar );
+  virtual int_type  underflow ();
+  virtual int       sync      ();
+  virtual pos_type  seekoff   ( off_type iOff, ios::seekdir eDir, ios::openmode eMode );
+  virtual pos_type  seekpos   ( pos_type iPos, ios::openmode eMode );
+
+public:
+  TVideoIOStreamBuf()           { m_pFile = NULL; m_pcBuffer = NULL; m_iBufferPos = 0; }
+  virtual ~TVideoIOStreamBuf()  { close(); }
+
+  Bool  open    ( const char* pchFile, Bool bWriteMode );   ///< open file, "-" selects stdin or stdout
+  Void  close   ();                                         ///< flush and close file
+  Bool  isOpen  ()              { return m_pFile != NULL; }
+};
+
+/// binary stream on a file or on the standard input or output
+/** Data written to stdout is moved to a duplicate of the standard output descriptor and stdout is redirected
+    to stderr, so that console messages do not end up in the stream. Only one stream can be written to stdout.
+    Applications call reserveStdout() before their first message when an output file may be "-".
+ */
+class TVideoIOStream : public iostream
+{
+private:
+  TVideoIOStreamBuf m_cBuf;                                 ///< stream buffer
+
+public:
+  TVideoIOStream() : iostream( NULL ) { init( &m_cBuf ); }
+  virtual ~TVideoIOStream()     {}
+
+  Void  open    ( const char* pchFile, Bool bWriteMode );   ///< open file, sets failbit on failure
+  Void  close   ();                                         ///< flush and close file
+  Bool  is_open ()              { return m_cBuf.isOpen(); }
+
+  static Void reserveStdout();                              ///< move console output to stderr before anything is printed
+};
+
+#endif // __TVIDEOIOSTREAM__
+
@@ -36,26 +36,45 @@
 #include <cstdlib>
 #include <fcntl.h>
 #include <assert.h>
+#include <memory.h>
 #include <sys/stat.h>
 #include <fstream>
 #include <iostream>
 
 #include "TVideoIOYuv.h"
 
+#if ENABLE_SSE2
+#include <emmintrin.h>
+#endif
+
 using namespace std;
 
+/// 16-bit file samples are little-endian, Pel rows are swapped after reading and before writing on big-endian hosts
+static inline Bool xIsBigEndianHost()
+{
+  const UShort uiOne = 1;
+  return *reinterpret_cast<const UChar*>( &uiOne ) == 0;
+}
+
 // ====================================================================================================================
 // Public member functions
 // ====================================================================================================================
 
-/** \param pchFile    file name string
-    \param bWriteMode file open mode
+/** \param pchFile            file name string
+    \param bWriteMode         file open mode
+    \param iFileBitDepth      bit-depth of the file samples, files with more than 8 bits use 16-bit little-endian samples
+    \param iInternalBitDepth  bit-depth of the picture buffers, samples are shifted by the difference while reading and writing
  */
-Void TVideoIOYuv::open( char* pchFile, Bool bWriteMode )
+Void TVideoIOYuv::open( char* pchFile, Bool bWriteMode, Int iFileBitDepth, Int iInternalBitDepth )
 {
+  m_iFileBitDepth     = iFileBitDepth;
+  m_iInternalBitDepth = iInternalBitDepth;
+
+  assert( m_iFileBitDepth > 8 || m_iInternalBitDepth >= m_iFileBitDepth );
+
   if ( bWriteMode )
   {
-     m_cHandle.open( pchFile, ios::binary | ios::out );
+    m_cHandle.open( pchFile, true );
 
     if( m_cHandle.fail() )
     {
@@ -65,7 +84,7 @@ Void TVideoIOYuv::open( char* pchFile, Bool bWriteMode )
   }
   else
   {
-    m_cHandle.open( pchFile, ios::binary | ios::in );
+    m_cHandle.open( pchFile, false );
 
     if( m_cHandle.fail() )
     {
@@ -95,129 +114,376 @@ Void TVideoIOYuv::read ( TComPicYuv*&  rpcPicYuv, Int aiPad[2] )
   // check end-of-file
   if ( isEof() ) return;
 
-  Int   x, y;
-  Int   iWidth, iHeight;
-  Int   iStride = rpcPicYuv->getStride();
-
   // compute actual YUV width & height excluding padding size
-  iWidth  = rpcPicYuv->getWidth () - aiPad[0];
-  iHeight = rpcPicYuv->getHeight() - aiPad[1];
+  Int   iWidth      = rpcPicYuv->getWidth () - aiPad[0];
+  Int   iHeight     = rpcPicYuv->getHeight() - aiPad[1];
+  Int   iFullWidth  = rpcPicYuv->getWidth ();
+  Int   iFullHeight = rpcPicYuv->getHeight();
+
+  xReadPlane( rpcPicYuv->getLumaAddr(), rpcPicYuv->getStride(),  iWidth,      iHeight,      iFullWidth,      iFullHeight      );
+  xReadPlane( rpcPicYuv->getCbAddr(),   rpcPicYuv->getCStride(), iWidth >> 1, iHeight >> 1, iFullWidth >> 1, iFullHeight >> 1 );
+  xReadPlane( rpcPicYuv->getCrAddr(),   rpcPicYuv->getCStride(), iWidth >> 1, iHeight >> 1, iFullWidth >> 1, iFullHeight >> 1 );
+
+  return;
+}
+
+/** \param pcPicYuv     input picture YUV buffer class pointer
+    \param aiPad[2]     source padding size, aiPad[0] = horizontal, aiPad[1] = vertical
+ */
+Void TVideoIOYuv::write( TComPicYuv* pcPicYuv, Int aiPad[2] )
+{
+  // compute actual YUV frame size excluding padding size
+  Int   iWidth  = pcPicYuv->getWidth () - aiPad[0];
+  Int   iHeight = pcPicYuv->getHeight() - aiPad[1];
 
-  // allocate 8-bit buffer
-  Pxl*  apuchBuf = new Pxl[iWidth];
+  xWritePlane( pcPicYuv->getLumaAddr(), pcPicYuv->getStride(),  iWidth,      iHeight      );
+  xWritePlane( pcPicYuv->getCbAddr(),   pcPicYuv->getCStride(), iWidth >> 1, iHeight >> 1 );
+  xWritePlane( pcPicYuv->getCrAddr(),   pcPicYuv->getCStride(), iWidth >> 1, iHeight >> 1 );
+}
+
+// ====================================================================================================================
+// Protected member functions
+// ====================================================================================================================
+
+/** read one plane and convert it to the internal bit-depth, then pad it to the full picture size
+    \param iWidth, iHeight          size of the plane in the file
+    \param iFullWidth, iFullHeight  size of the plane in the picture buffer
+ */
+Void TVideoIOYuv::xReadPlane( Pel* pDst, Int iStride, Int iWidth, Int iHeight, Int iFullWidth, Int iFullHeight )
+{
+  Int     x, y;
+  Int     iShift   = m_iInternalBitDepth - m_iFileBitDepth;
+  Bool    bIs16bit = m_iFileBitDepth > 8;
+  UChar*  puchBuf  = bIs16bit ? NULL : new UChar[iWidth];
 
-  // Y
-  Pel*  pDst = rpcPicYuv->getLumaAddr();
   for ( y = 0; y < iHeight; y++ )
   {
-    m_cHandle.read( reinterpret_cast<char*>(apuchBuf), sizeof (Pxl) * iWidth );
-    for ( x = 0; x < iWidth; x++ ) pDst[x] = (Pel)apuchBuf[x];
+    if ( bIs16bit )
+    {
+      // 16-bit samples are read straight into the picture row
+      m_cHandle.read( reinterpret_cast<char*>(pDst), sizeof(Pel) * iWidth );
+      if ( xIsBigEndianHost() )
+      {
+        xSwapRow( pDst, iWidth );
+      }
+      xScaleRow( pDst, pDst, iWidth, iShift, ( 1 << m_iInternalBitDepth ) - 1 );
+    }
+    else
+    {
+      m_cHandle.read( reinterpret_cast<char*>(puchBuf), sizeof(UChar) * iWidth );
+      xWidenRow( pDst, puchBuf, iWidth, iShift );
+    }
 
     // horizontal-right padding
-    for ( x = iWidth; x < rpcPicYuv->getWidth(); x++ ) pDst[x] = pDst[x-1];
+    for ( x = iWidth; x < iFullWidth; x++ ) pDst[x] = pDst[x-1];
     pDst += iStride;
   }
 
-  // vertial-bottom padding
-  for ( y = iHeight; y < rpcPicYuv->getHeight(); y++ )
+  // vertical-bottom padding
+  for ( y = iHeight; y < iFullHeight; y++ )
   {
-    for ( x = 0; x < rpcPicYuv->getWidth(); x++ ) pDst[x] = pDst[-iStride+x];
+    ::memcpy( pDst, pDst - iStride, sizeof(Pel) * iFullWidth );
     pDst += iStride;
   }
 
-  iWidth   >>= 1;
-  iHeight  >>= 1;
-  iStride  >>= 1;
+  delete [] puchBuf;
+}
+
+/** convert one plane to the file bit-depth and write it
+ */
+Void TVideoIOYuv::xWritePlane( Pel* pSrc, Int iStride, Int iWidth, Int iHeight )
+{
+  Int     y;
+  Int     iShift   = m_iInternalBitDepth - m_iFileBitDepth;
+  Bool    bIs16bit = m_iFileBitDepth > 8;
+  Bool    bDirect  = bIs16bit && iShift == 0 && !xIsBigEndianHost();
+  Pel*    piBuf    = bIs16bit && !bDirect ? new Pel[iWidth] : NULL;
+  UChar*  puchBuf  = bIs16bit ? NULL : new UChar[iWidth];
 
-  //  U
-  pDst = rpcPicYuv->getCbAddr();
   for ( y = 0; y < iHeight; y++ )
   {
-    m_cHandle.read( reinterpret_cast<char*>(apuchBuf), sizeof (Pxl) * iWidth );
-    for ( x = 0; x < iWidth; x++ ) pDst[x] = (Pel)apuchBuf[x];
+    if ( bDirect )
+    {
+      m_cHandle.write( reinterpret_cast<char*>(pSrc), sizeof(Pel) * iWidth );
+    }
+    else if ( bIs16bit )
+    {
+      xScaleRow( piBuf, pSrc, iWidth, -iShift, ( 1 << m_iFileBitDepth ) - 1 );
+      if ( xIsBigEndianHost() )
+      {
+        xSwapRow( piBuf, iWidth );
+      }
+      m_cHandle.write( reinterpret_cast<char*>(piBuf), sizeof(Pel) * iWidth );
+    }
+    else
+    {
+      xNarrowRow( puchBuf, pSrc, iWidth, iShift );
+      m_cHandle.write( reinterpret_cast<char*>(puchBuf), sizeof(UChar) * iWidth );
+    }
+    pSrc += iStride;
+  }
 
-    // horizontal-right padding
-    for ( x = iWidth; x < (rpcPicYuv->getWidth()>>1); x++ ) pDst[x] = pDst[x-1];
-    pDst += iStride;
+  delete [] piBuf;
+  delete [] puchBuf;
+}
+
+/// 8-bit samples to Pel, pDst[x] = pSrc[x] << iShift
+Void TVideoIOYuv::xWidenRow( Pel* pDst, UChar* pSrc, Int iNum, Int iShift )
+{
+  Int x = 0;
+#if ENABLE_SSE2
+  __m128i vShift = _mm_cvtsi32_si128( iShift );
+  __m128i vZero  = _mm_setzero_si128();
+  for ( ; x + 16 <= iNum; x += 16 )
+  {
+    __m128i v = _mm_loadu_si128( (const __m128i*)( pSrc + x ) );
+    _mm_storeu_si128( (__m128i*)( pDst + x     ), _mm_sll_epi16( _mm_unpacklo_epi8( v, vZero ), vShift ) );
+    _mm_storeu_si128( (__m128i*)( pDst + x + 8 ), _mm_sll_epi16( _mm_unpackhi_epi8( v, vZero ), vShift ) );
+  }
+  if ( x + 8 <= iNum )
+  {
+    __m128i v = _mm_loadl_epi64( (const __m128i*)( pSrc + x ) );
+    _mm_storeu_si128( (__m128i*)( pDst + x ), _mm_sll_epi16( _mm_unpacklo_epi8( v, vZero ), vShift ) );
+    x += 8;
+  }
+#endif
+  for ( ; x < iNum; x++ )
+  {
+    pDst[x] = (Pel)pSrc[x] << iShift;
   }
+}
 
-  // vertical-bottom padding
-  for ( y = iHeight; y < (rpcPicYuv->getHeight()>>1); y++ )
+/// Pel to 8-bit samples with rounding and clipping, pDst[x] = Clip3( 0, 255, ( pSrc[x] + offset ) >> iShift )
+Void TVideoIOYuv::xNarrowRow( UChar* pDst, Pel* pSrc, Int iNum, Int iShift )
+{
+  Int x = 0;
+  Int iOffset = iShift > 0 ? 1 << ( iShift - 1 ) : 0;
+#if ENABLE_SSE2
+  __m128i vShift  = _mm_cvtsi32_si128( iShift );
+  __m128i vOffset = _mm_set1_epi32( iOffset );
+  for ( ; x + 8 <= iNum; x += 8 )
   {
-    for ( x = 0; x < (rpcPicYuv->getWidth()>>1); x++ ) pDst[x] = pDst[-iStride+x];
-    pDst += iStride;
+    // widen to 32 bits so that the rounding offset cannot overflow
+    __m128i v   = _mm_loadu_si128( (const __m128i*)( pSrc + x ) );
+    __m128i vLo = _mm_sra_epi32( _mm_add_epi32( _mm_srai_epi32( _mm_unpacklo_epi16( v, v ), 16 ), vOffset ), vShift );
+    __m128i vHi = _mm_sra_epi32( _mm_add_epi32( _mm_srai_epi32( _mm_unpackhi_epi16( v, v ), 16 ), vOffset ), vShift );
+    v = _mm_packs_epi32( vLo, vHi );
+    _mm_storel_epi64( (__m128i*)( pDst + x ), _mm_packus_epi16( v, v ) );
+  }
+#endif
+  for ( ; x < iNum; x++ )
+  {
+    pDst[x] = (UChar)Clip3( 0, 255, ( pSrc[x] + iOffset ) >> iShift );
   }
+}
 
-  //  V
-  pDst = rpcPicYuv->getCrAddr();
-  for ( y = 0; y < iHeight; y++ )
+/** Pel to Pel bit-depth change
+    \param iShift   left shift if positive, rounded right shift with clipping to [0, iMaxVal] if negative
+ */
+Void TVideoIOYuv::xScaleRow( Pel* pDst, Pel* pSrc, Int iNum, Int iShift, Int iMaxVal )
+{
+  Int x = 0;
+
+  if ( iShift >= 0 )
+  {
+#if ENABLE_SSE2
+    __m128i vShift = _mm_cvtsi32_si128( iShift );
+    for ( ; x + 8 <= iNum; x += 8 )
+    {
+      _mm_storeu_si128( (__m128i*)( pDst + x ), _mm_sll_epi16( _mm_loadu_si128( (const __m128i*)( pSrc + x ) ), vShift ) );
+    }
+#endif
+    for ( ; x < iNum; x++ )
+    {
+      pDst[x] = pSrc[x] << iShift;
+    }
+    return;
+  }
+
+  iShift = -iShift;
+  Int iOffset = 1 << ( iShift - 1 );
+#if ENABLE_SSE2
+  __m128i vShift  = _mm_cvtsi32_si128( iShift );
+  __m128i vOffset = _mm_set1_epi32( iOffset );
+  __m128i vMax    = _mm_set1_epi16( (Pel)iMaxVal );
+  __m128i vZero   = _mm_setzero_si128();
+  for ( ; x + 8 <= iNum; x += 8 )
   {
-    m_cHandle.read( reinterpret_cast<char*>(apuchBuf), sizeof (Pxl) * iWidth );
-    for ( x = 0; x < iWidth; x++ ) pDst[x] = (Pel)apuchBuf[x];
+    __m128i v   = _mm_loadu_si128( (const __m128i*)( pSrc + x ) );
+    __m128i vLo = _mm_sra_epi32( _mm_add_epi32( _mm_srai_epi32( _mm_unpacklo_epi16( v, v ), 16 ), vOffset ), vShift );
+    __m128i vHi = _mm_sra_epi32( _mm_add_epi32( _mm_srai_epi32( _mm_unpackhi_epi16( v, v ), 16 ), vOffset ), vShift );
+    v = _mm_packs_epi32( vLo, vHi );
+    _mm_storeu_si128( (__m128i*)( pDst + x ), _mm_min_epi16( _mm_max_epi16( v, vZero ), vMax ) );
+  }
+#endif
+  for ( ; x < iNum; x++ )
+  {
+    pDst[x] = (Pel)Clip3( 0, iMaxVal, ( pSrc[x] + iOffset ) >> iShift );
+  }
+}
 
-    // horizontal-right padding
-    for ( x = iWidth; x < (rpcPicYuv->getWidth()>>1); x++ ) pDst[x] = pDst[x-1];
-    pDst += iStride;
+/// swap the bytes of every sample
+Void TVideoIOYuv::xSwapRow( Pel* pBuf, Int iNum )
+{
+  for ( Int x = 0; x < iNum; x++ )
+  {
+    UShort ui = (UShort)pBuf[x];
+    pBuf[x]   = (Pel)( ( ui >> 8 ) | ( ui << 8 ) );
   }
+}
 
-  // vertical-bottom padding
-  for ( y = iHeight; y < (rpcPicYuv->getHeight()>>1); y++ )
+// ====================================================================================================================
+// TVideoIOYuvWriter: public member functions
+// ====================================================================================================================
+
+/**
+    \param pchFile           file name string
+    \param iFileBitDepth     bit-depth of the file samples
+    \param iInternalBitDepth bit-depth of the picture buffer samples
+    \param uiQueueSize       maximum number of pictures queued for the writer thread
+ */
+Void TVideoIOYuvWriter::open( char* pchFile, Int iFileBitDepth, Int iInternalBitDepth, UInt uiQueueSize )
+{
+  m_cFile.open( pchFile, true, iFileBitDepth, iInternalBitDepth );
+
+  m_uiQueueSize     = Max( uiQueueSize, (UInt)1 );
+  m_pcPicYuvWriting = NULL;
+  m_bStop           = false;
+
+#if YUV_WRITER_THREAD
+  pthread_mutex_init( &m_cMutex,        NULL );
+  pthread_cond_init ( &m_cCondQueued,   NULL );
+  pthread_cond_init ( &m_cCondReleased, NULL );
+
+  if ( pthread_create( &m_cThread, NULL, xThreadMain, this ) )
   {
-    for ( x = 0; x < (rpcPicYuv->getWidth()>>1); x++ ) pDst[x] = pDst[-iStride+x];
-    pDst += iStride;
+    fprintf(stderr, "\nfailed to start the output writer thread\n");
+    exit(0);
   }
+#endif
+}
 
-  delete [] apuchBuf;
+Void TVideoIOYuvWriter::close()
+{
+#if YUV_WRITER_THREAD
+  pthread_mutex_lock( &m_cMutex );
+  m_bStop = true;
+  pthread_cond_signal( &m_cCondQueued );
+  pthread_mutex_unlock( &m_cMutex );
 
-  return;
+  pthread_join( m_cThread, NULL );
+
+  pthread_cond_destroy ( &m_cCondReleased );
+  pthread_cond_destroy ( &m_cCondQueued );
+  pthread_mutex_destroy( &m_cMutex );
+#endif
+
+  m_cFile.close();
 }
 
-/** \param pcPicYuv     input picture YUV buffer class pointer
+/** \param pcPicYuv     picture YUV buffer class pointer, must not be modified until it is released
     \param aiPad[2]     source padding size, aiPad[0] = horizontal, aiPad[1] = vertical
  */
-Void TVideoIOYuv::write( TComPicYuv* pcPicYuv, Int aiPad[2] )
+Void TVideoIOYuvWriter::write( TComPicYuv* pcPicYuv, Int aiPad[2] )
 {
-  Int   x, y;
-
-  // compute actual YUV frame size excluding padding size
-  Int   iWidth  = pcPicYuv->getWidth () - aiPad[0];
-  Int   iHeight = pcPicYuv->getHeight() - aiPad[1];
-  Int   iStride = pcPicYuv->getStride();
+#if YUV_WRITER_THREAD
+  Entry cEntry;
+  cEntry.pcPicYuv = pcPicYuv;
+  cEntry.aiPad[0] = aiPad[0];
+  cEntry.aiPad[1] = aiPad[1];
+
+  pthread_mutex_lock( &m_cMutex );
+  while ( m_cQueue.size() >= m_uiQueueSize )
+  {
+    pthread_cond_wait( &m_cCondReleased, &m_cMutex );
+  }
+  m_cQueue.push_back( cEntry );
+  pthread_cond_signal( &m_cCondQueued );
+  pthread_mutex_unlock( &m_cMutex );
+#else
+  m_cFile.write( pcPicYuv, aiPad );
+#endif
+}
 
-  // allocate 8-bit buffer
-  Pxl*  apuchBuf = new Pxl[iWidth];
+Void TVideoIOYuvWriter::waitRelease( TComPicYuv* pcPicYuv )
+{
+#if YUV_WRITER_THREAD
+  pthread_mutex_lock( &m_cMutex );
+  while ( xIsPending( pcPicYuv ) )
+  {
+    pthread_cond_wait( &m_cCondReleased, &m_cMutex );
+  }
+  pthread_mutex_unlock( &m_cMutex );
+#endif
+}
 
-  //  Y
-  Pel*  pSrc = pcPicYuv->getLumaAddr();
-  for ( y = 0; y < iHeight; y++ )
+Void TVideoIOYuvWriter::flush()
+{
+#if YUV_WRITER_THREAD
+  pthread_mutex_lock( &m_cMutex );
+  while ( !m_cQueue.empty() || m_pcPicYuvWriting )
   {
-    for ( x = 0; x < iWidth; x++ ) apuchBuf[x] = (Pxl)pSrc[x];
-    m_cHandle.write(  reinterpret_cast<char*>(apuchBuf), sizeof(Pxl) * iWidth );
-    pSrc += iStride;
+    pthread_cond_wait( &m_cCondReleased, &m_cMutex );
   }
+  pthread_mutex_unlock( &m_cMutex );
+#endif
+}
 
-  iWidth   >>= 1;
-  iHeight  >>= 1;
-  iStride  >>= 1;
+// ====================================================================================================================
+// TVideoIOYuvWriter: protected member functions
+// ====================================================================================================================
 
-  //  U
-  pSrc = pcPicYuv->getCbAddr();
-  for ( y = 0; y < iHeight; y++ )
+/// check whether a picture is queued or being written, called with the mutex held
+Bool TVideoIOYuvWriter::xIsPending( TComPicYuv* pcPicYuv )
+{
+  if ( m_pcPicYuvWriting == pcPicYuv )
   {
-    for ( x = 0; x < iWidth; x++ ) apuchBuf[x] = (Pxl)pSrc[x];
-    m_cHandle.write( reinterpret_cast<char*>(apuchBuf), sizeof(Pxl) * iWidth );
-    pSrc += iStride;
+    return true;
   }
-
-  //  V
-  pSrc = pcPicYuv->getCrAddr();
-  for ( y = 0; y < iHeight; y++ )
+  for ( std::deque<Entry>::iterator it = m_cQueue.begin(); it != m_cQueue.end(); it++ )
   {
-    for ( x = 0; x < iWidth; x++ ) apuchBuf[x] = (Pxl)pSrc[x];
-    m_cHandle.write( reinterpret_cast<char*>(apuchBuf), sizeof(Pxl) * iWidth );
-    pSrc += iStride;
+    if ( it->pcPicYuv == pcPicYuv )
+    {
+      return true;
+    }
   }
+  return false;
+}
 
-  delete [] apuchBuf;
+#if YUV_WRITER_THREAD
+Void* TVideoIOYuvWriter::xThreadMain( Void* pParam )
+{
+  ((TVideoIOYuvWriter*)pParam)->xRun();
+  return NULL;
 }
 
+/// writer thread, takes the pictures from the queue in output order until stopped
+Void TVideoIOYuvWriter::xRun()
+{
+  pthread_mutex_lock( &m_cMutex );
+  for (;;)
+  {
+    while ( m_cQueue.empty() && !m_bStop )
+    {
+      pthread_cond_wait( &m_cCondQueued, &m_cMutex );
+    }
+    if ( m_cQueue.empty() )
+    {
+      break;
+    }
+
+    Entry cEntry = m_cQueue.front();
+    m_cQueue.pop_front();
+    m_pcPicYuvWriting = cEntry.pcPicYuv;
+
+    // the picture is written without holding the lock, the caller only waits for its release
+    pthread_mutex_unlock( &m_cMutex );
+    m_cFile.write( cEntry.pcPicYuv, cEntry.aiPad );
+    pthread_mutex_lock( &m_cMutex );
+
+    m_pcPicYuvWriting = NULL;
+    pthread_cond_broadcast( &m_cCondReleased );
+  }
+  pthread_mutex_unlock( &m_cMutex );
+}
+#endif
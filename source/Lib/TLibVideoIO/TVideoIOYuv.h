@@ -39,11 +39,29 @@
 #include <stdio.h>
 #include <fstream>
 #include <iostream>
+#include <deque>
 #include "../TLibCommon/CommonDef.h"
+#include "TVideoIOStream.h"
 #include "../TLibCommon/TComPicYuv.h"
 
 using namespace std;
 
+// ====================================================================================================================
+// Constants
+// ====================================================================================================================
+
+#ifndef YUV_WRITER_THREAD
+#ifdef _WIN32
+#define YUV_WRITER_THREAD           0           ///< no POSIX threads, output pictures are written synchronously
+#else
+#define YUV_WRITER_THREAD           1           ///< output pictures are written by a separate thread
+#endif
+#endif
+
+#if YUV_WRITER_THREAD
+#include <pthread.h>
+#endif
+
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
@@ -52,14 +70,26 @@ using namespace std;
 class TVideoIOYuv
 {
 private:
-  fstream   m_cHandle;                                      ///< file handle
+  TVideoIOStream  m_cHandle;                                ///< file handle, "-" selects stdin or stdout
+  Int             m_iFileBitDepth;                          ///< bit-depth of the file samples, 8 bits per byte, more as 16-bit little-endian
+  Int             m_iInternalBitDepth;                      ///< bit-depth of the picture buffer samples
+
+  Void  xReadPlane  ( Pel* pDst, Int iStride, Int iWidth, Int iHeight, Int iFullWidth, Int iFullHeight );
+  Void  xWritePlane ( Pel* pSrc, Int iStride, Int iWidth, Int iHeight );
+
+  // Row conversion kernels, vectorized when ENABLE_SSE2 is set
+  static Void xWidenRow   ( Pel*  pDst, UChar* pSrc, Int iNum, Int iShift );
+  static Void xNarrowRow  ( UChar* pDst, Pel*  pSrc, Int iNum, Int iShift );
+  static Void xScaleRow   ( Pel*  pDst, Pel*   pSrc, Int iNum, Int iShift, Int iMaxVal );
+  static Void xSwapRow    ( Pel*  pBuf,              Int iNum );
 
 public:
-  TVideoIOYuv()           {}
+  TVideoIOYuv()           { m_iFileBitDepth = m_iInternalBitDepth = 8; }
   virtual ~TVideoIOYuv()  {}
 
-  Void  open  ( char* pchFile, Bool bWriteMode );           ///< open or create file
+  Void  open  ( char* pchFile, Bool bWriteMode, Int iFileBitDepth = 8, Int iInternalBitDepth = 8 ); ///< open or create file
   Void  close ();                                           ///< close file
+  Bool  isOpen()          { return m_cHandle.is_open(); }
 
   Void  read  ( TComPicYuv*& rpcPicYuv, Int aiPad[2] );     ///< read  one YUV frame with padding parameter
   Void  write ( TComPicYuv*   pcPicYuv, Int aiPad[2] );     ///< write one YUV frame with padding parameter
@@ -68,5 +98,50 @@ public:
 
 };
 
+/// asynchronous YUV file writer, pictures are queued by reference and written by a separate thread
+/** The caller must not modify a queued picture until it has been released, which is signalled by waitRelease().
+    Without YUV_WRITER_THREAD the pictures are written immediately and are released when write() returns.
+ */
+class TVideoIOYuvWriter
+{
+private:
+  /// queued output picture
+  struct Entry
+  {
+    TComPicYuv* pcPicYuv;
+    Int         aiPad[2];
+  };
+
+  TVideoIOYuv         m_cFile;                              ///< output file
+  std::deque<Entry>   m_cQueue;                             ///< pictures waiting to be written, in output order
+  UInt                m_uiQueueSize;                        ///< maximum number of queued pictures
+  TComPicYuv*         m_pcPicYuvWriting;                    ///< picture being written by the writer thread
+  Bool                m_bStop;                              ///< writer thread should exit when the queue is empty
+
+#if YUV_WRITER_THREAD
+  pthread_t           m_cThread;                            ///< writer thread
+  pthread_mutex_t     m_cMutex;                             ///< protects the queue and the picture being written
+  pthread_cond_t      m_cCondQueued;                        ///< signalled when a picture is queued or on stop
+  pthread_cond_t      m_cCondReleased;                      ///< signalled when a picture has been written
+
+  static Void* xThreadMain  ( Void* pParam );
+  Void  xRun                ();
+#endif
+
+  Bool  xIsPending          ( TComPicYuv* pcPicYuv );
+
+public:
+  TVideoIOYuvWriter()           { m_uiQueueSize = 1; m_pcPicYuvWriting = NULL; m_bStop = false; }
+  virtual ~TVideoIOYuvWriter()  {}
+
+  Void  open        ( char* pchFile, Int iFileBitDepth, Int iInternalBitDepth, UInt uiQueueSize ); ///< create file, start writer thread
+  Void  close       ();                                     ///< write all queued pictures, stop writer thread and close file
+  Bool  isOpen      ()          { return m_cFile.isOpen(); }
+
+  Void  write       ( TComPicYuv* pcPicYuv, Int aiPad[2] ); ///< queue one YUV frame, blocks while the queue is full
+  Void  waitRelease ( TComPicYuv* pcPicYuv );               ///< wait until the picture is no longer queued or being written
+  Void  flush       ();                                     ///< wait until all queued pictures have been written
+};
+
 #endif // __TVIDEOIOYUV__
 